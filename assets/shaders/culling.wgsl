@@ -0,0 +1,179 @@
+const HIZ_WORKGROUP_SIZE: u32   = 8;
+const CULL_WORKGROUP_SIZE: u32  = 64;
+
+struct CullParams
+{
+    occlusionViewproject: mat4x4f,
+    planes: array<vec4f, 6>,
+    depthSize: vec2u,
+    levelCount: u32,
+    drawCount: u32,
+    occlusionEnabled: u32,
+    compact: u32,
+}
+
+struct DrawCullData
+{
+    boundsMin: vec3f,
+    runFirst: u32,
+    boundsMax: vec3f,
+    runIndex: u32,
+}
+
+struct DrawIndexedIndirectArgs
+{
+    indexCount: u32,
+    instanceCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+}
+
+// Hierarchical-Z build bind group, level 0 reads the depth target and every next level reads the previous level
+@group(0) @binding(0) var depthTarget: texture_depth_2d;
+@group(0) @binding(1) var hizSource: texture_2d<f32>;
+@group(0) @binding(2) var hizTarget: texture_storage_2d<r32float, write>;
+
+// Culling bind group, bindings follow the build bindings since resources may not share bindings within a module
+@group(0) @binding(3) var<uniform> params: CullParams;
+@group(0) @binding(4) var<storage, read> draws: array<DrawCullData>;
+@group(0) @binding(5) var<storage, read> drawArgs: array<DrawIndexedIndirectArgs>;
+@group(0) @binding(6) var<storage, read_write> culledDrawArgs: array<DrawIndexedIndirectArgs>;
+@group(0) @binding(7) var<storage, read_write> runCounts: array<atomic<u32>>;
+@group(0) @binding(8) var hiz: texture_2d<f32>;
+
+@compute @workgroup_size(HIZ_WORKGROUP_SIZE, HIZ_WORKGROUP_SIZE)
+fn CSHiZFromDepth(@builtin(global_invocation_id) id: vec3u)
+{
+    if (any(id.xy >= textureDimensions(hizTarget))) {
+        return;
+    }
+
+    // Edge texels are repeated for odd source sizes
+    let sourceMax = vec2i(textureDimensions(depthTarget)) - 1;
+    let base = vec2i(id.xy * 2u);
+    let d00 = textureLoad(depthTarget, min(base, sourceMax), 0);
+    let d10 = textureLoad(depthTarget, min(base + vec2i(1, 0), sourceMax), 0);
+    let d01 = textureLoad(depthTarget, min(base + vec2i(0, 1), sourceMax), 0);
+    let d11 = textureLoad(depthTarget, min(base + vec2i(1, 1), sourceMax), 0);
+    textureStore(hizTarget, vec2i(id.xy), vec4f(max(max(d00, d10), max(d01, d11)), 0.0, 0.0, 0.0));
+}
+
+@compute @workgroup_size(HIZ_WORKGROUP_SIZE, HIZ_WORKGROUP_SIZE)
+fn CSHiZDownsample(@builtin(global_invocation_id) id: vec3u)
+{
+    if (any(id.xy >= textureDimensions(hizTarget))) {
+        return;
+    }
+
+    let sourceMax = vec2i(textureDimensions(hizSource)) - 1;
+    let base = vec2i(id.xy * 2u);
+    let d00 = textureLoad(hizSource, min(base, sourceMax), 0).r;
+    let d10 = textureLoad(hizSource, min(base + vec2i(1, 0), sourceMax), 0).r;
+    let d01 = textureLoad(hizSource, min(base + vec2i(0, 1), sourceMax), 0).r;
+    let d11 = textureLoad(hizSource, min(base + vec2i(1, 1), sourceMax), 0).r;
+    textureStore(hizTarget, vec2i(id.xy), vec4f(max(max(d00, d10), max(d01, d11)), 0.0, 0.0, 0.0));
+}
+
+fn isInsideFrustum(boundsMin: vec3f, boundsMax: vec3f) -> bool
+{
+    let center = (boundsMin + boundsMax) * 0.5;
+    let extent = (boundsMax - boundsMin) * 0.5;
+    for (var i = 0u; i < 6u; i++)
+    {
+        // Signed distance of the box corner furthest along the plane normal
+        let plane = params.planes[i];
+        if (dot(plane.xyz, center) + plane.w + dot(abs(plane.xyz), extent) < 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+fn hizTexel(level: u32, texel: vec2u) -> f32
+{
+    let levelMax = textureDimensions(hiz, level) - 1u;
+    return textureLoad(hiz, vec2i(min(texel, levelMax)), i32(level)).r;
+}
+
+fn isOccluded(boundsMin: vec3f, boundsMax: vec3f) -> bool
+{
+    // Project the box corners to find their screen rectangle and nearest depth
+    var rectMin = vec2f(1.0);
+    var rectMax = vec2f(0.0);
+    var nearestDepth = 1.0;
+    for (var i = 0u; i < 8u; i++)
+    {
+        let corner = select(boundsMin, boundsMax, vec3<bool>((i & 1u) != 0u, (i & 2u) != 0u, (i & 4u) != 0u));
+        let clip = params.occlusionViewproject * vec4f(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false;
+        }
+
+        let ndc = clip.xyz / clip.w;
+        let uv = vec2f(ndc.x * 0.5 + 0.5, 0.5 - ndc.y * 0.5);
+        rectMin = min(rectMin, uv);
+        rectMax = max(rectMax, uv);
+        nearestDepth = min(nearestDepth, ndc.z);
+    }
+
+    // Nothing is known about depth outside the depth target, so boxes extending beyond it are kept
+    if (nearestDepth < 0.0 || any(rectMin < vec2f(0.0)) || any(rectMax > vec2f(1.0))) {
+        return false;
+    }
+
+    let pixelMax = params.depthSize - 1u;
+    let pixelRectMin = min(vec2u(rectMin * vec2f(params.depthSize)), pixelMax);
+    let pixelRectMax = min(vec2u(rectMax * vec2f(params.depthSize)), pixelMax);
+
+    // Use the finest level where the rectangle covers at most 2x2 texels, level texels cover 2^(level + 1) pixels
+    var level = 0u;
+    while (level + 1u < params.levelCount)
+    {
+        let span = (pixelRectMax >> vec2u(level + 1u)) - (pixelRectMin >> vec2u(level + 1u));
+        if (all(span <= vec2u(1u))) {
+            break;
+        }
+
+        level++;
+    }
+
+    let texelMin = pixelRectMin >> vec2u(level + 1u);
+    let texelMax = pixelRectMax >> vec2u(level + 1u);
+    let farthestDepth = max(
+        max(hizTexel(level, texelMin), hizTexel(level, vec2u(texelMax.x, texelMin.y))),
+        max(hizTexel(level, vec2u(texelMin.x, texelMax.y)), hizTexel(level, texelMax))
+    );
+
+    return nearestDepth > farthestDepth;
+}
+
+@compute @workgroup_size(CULL_WORKGROUP_SIZE)
+fn CSCullDraws(@builtin(global_invocation_id) id: vec3u)
+{
+    let drawIndex = id.x;
+    if (drawIndex >= params.drawCount) {
+        return;
+    }
+
+    let draw = draws[drawIndex];
+    let visible = isInsideFrustum(draw.boundsMin, draw.boundsMax)
+        && !(params.occlusionEnabled != 0u && isOccluded(draw.boundsMin, draw.boundsMax));
+
+    // Surviving draws are compacted to the start of their run, the run count limits the multi-draw count
+    if (params.compact != 0u)
+    {
+        if (visible)
+        {
+            let slot = draw.runFirst + atomicAdd(&runCounts[draw.runIndex], 1u);
+            culledDrawArgs[slot] = drawArgs[drawIndex];
+        }
+
+        return;
+    }
+
+    var args = drawArgs[drawIndex];
+    args.instanceCount = select(0u, args.instanceCount, visible);
+    culledDrawArgs[drawIndex] = args;
+}
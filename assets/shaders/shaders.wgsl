@@ -1,6 +1,8 @@
 const GAMMA: f32        = 2.2;
 const INV_GAMMA: f32    = 1.0 / GAMMA;
 
+const VOXEL_MIN_OCCLUSION: f32 = 0.4;
+
 struct VertexInput
 {
     @location(0) position: vec3f,
@@ -9,6 +11,11 @@ struct VertexInput
     @location(3) texcoord: vec2f,
 }
 
+struct VoxelVertexInput
+{
+    @location(0) packed: vec2u,
+}
+
 struct VertexOutput
 {
     @builtin(position) position: vec4f,
@@ -16,6 +23,8 @@ struct VertexOutput
     @location(1) tangent: vec3f,
     @location(2) bitangent: vec3f,
     @location(3) texcoord: vec2f,
+    @location(4) occlusion: f32,
+    @location(5) @interpolate(flat) layer: u32,
 }
 
 struct FragmentOutput
@@ -43,11 +52,14 @@ struct ObjectTransform
     normalTransform: mat4x4f,
 }
 
-// Scene data bind group
+// Scene data bind group, block textures are shared by all voxel meshes
 @group(0) @binding(0) var<uniform> camera: Camera;
+@group(0) @binding(1) var blockSampler: sampler;
+@group(0) @binding(2) var blockTextures: texture_2d_array<f32>;
 
-// Object data bind group
-@group(1) @binding(0) var<uniform> objectTransform: ObjectTransform;
+// Object data bind group, instances index into the object transforms
+@group(1) @binding(0) var<storage, read> objectTransforms: array<ObjectTransform>;
+@group(1) @binding(1) var<storage, read> instanceObjects: array<u32>;
 
 // Material data bind group
 @group(2) @binding(0) var<uniform> material: Material;
@@ -57,9 +69,10 @@ struct ObjectTransform
 @group(2) @binding(4) var normalMap: texture_2d<f32>;
 
 @vertex
-fn VSStaticVert(input: VertexInput) -> VertexOutput
+fn VSStaticVert(input: VertexInput, @builtin(instance_index) instance: u32) -> VertexOutput
 {
     // Transform object position & vectors
+    let objectTransform = objectTransforms[instanceObjects[instance]];
     let position = objectTransform.modelTransform * vec4f(input.position, 1.);
     let normal = objectTransform.normalTransform * vec4f(input.normal, 0);
     let tangent = objectTransform.normalTransform * vec4f(input.tangent, 0);
@@ -76,6 +89,51 @@ fn VSStaticVert(input: VertexInput) -> VertexOutput
     result.tangent = T;
     result.bitangent = B;
     result.texcoord = input.texcoord;
+    result.occlusion = 1.0;
+    result.layer = 0u;
+
+    return result;
+}
+
+// Returns a unit vector along axis 0 (x), 1 (y) or 2 (z)
+fn axisVector(axis: u32) -> vec3f
+{
+    return select(vec3f(0), vec3f(1), vec3u(0u, 1u, 2u) == vec3u(axis));
+}
+
+@vertex
+fn VSVoxelVert(input: VoxelVertexInput, @builtin(instance_index) instance: u32) -> VertexOutput
+{
+    // Unpack chunk-local position, face index & ambient occlusion
+    let localPosition = vec3f(vec3u(input.packed.x, input.packed.x >> 6u, input.packed.x >> 12u) & vec3u(63u));
+    let face = (input.packed.x >> 18u) & 7u;
+    let ao = f32((input.packed.x >> 21u) & 3u) / 3.0;
+
+    // Reconstruct face basis, faces are ordered as (axis * 2 + negative)
+    let axis = face >> 1u;
+    let direction = select(1.0, -1.0, (face & 1u) != 0u);
+    let faceNormal = axisVector(axis) * direction;
+    let faceTangent = axisVector((axis + 1u) % 3u);
+    let faceBitangent = axisVector((axis + 2u) % 3u);
+
+    // Transform object position & vectors
+    let objectTransform = objectTransforms[instanceObjects[instance]];
+    let position = objectTransform.modelTransform * vec4f(localPosition, 1.);
+    let normal = objectTransform.normalTransform * vec4f(faceNormal, 0);
+    let tangent = objectTransform.normalTransform * vec4f(faceTangent, 0);
+
+    var N = normalize(normal.xyz);
+    var T = normalize(tangent.xyz);
+    var B = cross(N, T);
+
+    var result = VertexOutput();
+    result.position = camera.viewproject * position;
+    result.normal = N;
+    result.tangent = T;
+    result.bitangent = B;
+    result.texcoord = vec2f(dot(localPosition, faceTangent), dot(localPosition, faceBitangent)); // Textures tile once per block
+    result.occlusion = mix(VOXEL_MIN_OCCLUSION, 1.0, ao);
+    result.layer = input.packed.y & 0xFFFFu;
 
     return result;
 }
@@ -97,15 +155,28 @@ fn FSForwardShading(input: VertexOutput) -> FragmentOutput
     var normal = vec3f(0, 0, 1);
     if (material.hasNormalMap != 0)
     {
-        normal = textureSample(normalMap, normalSampler, input.texcoord).xyz;
-        normal = 2.0 * normal - 1.0; // Remap normal to range [-1, 1]
+        // Only xy is read, z is reconstructed so 2 channel (BC5) normal maps work as well
+        let normalXY = 2.0 * textureSample(normalMap, normalSampler, input.texcoord).xy - 1.0; // Remap normal to range [-1, 1]
+        normal = vec3f(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
     }
 
     // TODO(nemjit001): do some shading based on light positions in scene
     let shadingNormal = normalize(TBN * normal);
 
     var result = FragmentOutput();
-    result.color = albedo;
+    result.color = vec4f(albedo.rgb * input.occlusion, albedo.a);
+
+    return result;
+}
+
+@fragment
+fn FSVoxelShading(input: VertexOutput) -> FragmentOutput
+{
+    // Voxel faces sample their block texture by layer, material textures are not used
+    let albedo = textureSample(blockTextures, blockSampler, input.texcoord, input.layer);
+
+    var result = FragmentOutput();
+    result.color = vec4f(albedo.rgb * input.occlusion, albedo.a);
 
     return result;
 }
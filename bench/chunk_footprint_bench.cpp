@@ -0,0 +1,42 @@
+#include <cstdint>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/terrain_generator.hpp"
+
+static constexpr uint32_t	WORLD_SEED		= 1337;
+static constexpr int32_t	WORLD_CHUNKS_XZ	= 512 / world::CHUNK_SIZE;
+static constexpr int32_t	WORLD_CHUNKS_Y	= 256 / world::CHUNK_SIZE;
+
+/// @brief Measure the host memory footprint of a generated 512x256x512 block world, against dense block storage.
+int main()
+{
+	world::TerrainGenerator const generator(WORLD_SEED);
+
+	size_t chunkCount = 0;
+	size_t uniformCount = 0;
+	size_t paletteBytes = 0;
+	for (int32_t y = -WORLD_CHUNKS_Y / 2; y < WORLD_CHUNKS_Y / 2; y++)
+	{
+		for (int32_t z = 0; z < WORLD_CHUNKS_XZ; z++)
+		{
+			for (int32_t x = 0; x < WORLD_CHUNKS_XZ; x++)
+			{
+				// Fresh chunks, so storage capacity matches chunks that live in the world
+				world::Chunk chunk{};
+				generator.generate(glm::ivec3(x, y, z), chunk);
+				paletteBytes += chunk.memoryUsage();
+				uniformCount += chunk.isUniform() ? 1 : 0;
+				chunkCount++;
+			}
+		}
+	}
+
+	size_t const denseBytes = chunkCount * world::CHUNK_VOLUME * sizeof(world::BlockID);
+	SPDLOG_INFO("Chunk footprint of a 512x256x512 world: {} chunks ({} uniform), {} bytes paletted, {} bytes dense ({:.1f}x smaller)",
+		chunkCount, uniformCount, paletteBytes, denseBytes, static_cast<double>(denseBytes) / static_cast<double>(paletteBytes));
+
+	return EXIT_SUCCESS;
+}
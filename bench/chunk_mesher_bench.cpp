@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/chunk_mesher.hpp"
+#include "world/terrain_generator.hpp"
+
+static constexpr uint32_t	WORLD_SEED		= 1337;
+static constexpr int32_t	TERRAIN_CHUNKS	= 8;	// Terrain chunk footprint along x & z
+static constexpr uint32_t	MESH_PASSES		= 4;
+
+/// @brief Measure meshing throughput & output size over a set of chunks, using the neighbourless chunk meshing path.
+/// @param name Input name.
+/// @param chunks 
+static void measureMeshing(char const* name, std::vector<world::Chunk> const& chunks)
+{
+	world::ChunkMesher mesher{};
+	world::ChunkNeighbors const neighbors{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+
+	size_t triangleCount = 0;
+	core::Timer timer{};
+	for (uint32_t pass = 0; pass < MESH_PASSES; pass++)
+	{
+		for (world::Chunk const& chunk : chunks) {
+			triangleCount += mesher.mesh(chunk, neighbors, vertices, indices) * 2;
+		}
+	}
+	timer.tick();
+
+	double const chunkCount = static_cast<double>(chunks.size() * MESH_PASSES);
+	double const seconds = timer.delta() / 1000.0;
+	SPDLOG_INFO("Chunk meshing ({}): {:.0f} chunks/s, {:.0f} triangles/chunk",
+		name, (seconds > 0.0) ? chunkCount / seconds : 0.0, static_cast<double>(triangleCount) / chunkCount);
+}
+
+int main()
+{
+	// Generated terrain chunks around sea level, the typical input
+	std::vector<world::Chunk> terrain{};
+	world::TerrainGenerator const generator(WORLD_SEED);
+	for (int32_t y = -1; y <= 1; y++)
+	{
+		for (int32_t z = 0; z < TERRAIN_CHUNKS; z++)
+		{
+			for (int32_t x = 0; x < TERRAIN_CHUNKS; x++)
+			{
+				world::Chunk& chunk = terrain.emplace_back();
+				generator.generate(glm::ivec3(x, y, z), chunk);
+			}
+		}
+	}
+
+	// Half-filled random noise, few faces can be merged
+	std::vector<world::Chunk> noise(64);
+	std::vector<world::BlockID> blocks(world::CHUNK_VOLUME);
+	uint32_t state = WORLD_SEED;
+	for (world::Chunk& chunk : noise)
+	{
+		for (world::BlockID& block : blocks)
+		{
+			state = state * 1664525U + 1013904223U;
+			block = ((state >> 16) % 2 == 0) ? world::BLOCK_STONE : world::BLOCK_AIR;
+		}
+
+		chunk.setBlocks(blocks.data());
+	}
+
+	// Checkerboard, the worst case where no faces can be merged
+	std::vector<world::Chunk> checkerboard(64);
+	for (uint32_t i = 0; i < world::CHUNK_VOLUME; i++)
+	{
+		uint32_t const x = i % world::CHUNK_SIZE;
+		uint32_t const z = (i / world::CHUNK_SIZE) % world::CHUNK_SIZE;
+		uint32_t const y = i / world::CHUNK_AREA;
+		blocks[i] = ((x + y + z) % 2 == 0) ? world::BLOCK_STONE : world::BLOCK_AIR;
+	}
+
+	for (world::Chunk& chunk : checkerboard) {
+		chunk.setBlocks(blocks.data());
+	}
+
+	measureMeshing("terrain", terrain);
+	measureMeshing("noise", noise);
+	measureMeshing("checkerboard", checkerboard);
+
+	return EXIT_SUCCESS;
+}
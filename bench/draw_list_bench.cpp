@@ -0,0 +1,148 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "systems/renderer.hpp"
+
+static constexpr char const* LEGACY_PASS_OPAQUE = "Opaque";
+
+/// @brief Draw command of the draw list that preceded the sorted draw list, one command per object.
+struct LegacyDrawCommand
+{
+	uint32_t					cameraOffset;
+	uint32_t					materialOffset;
+	uint32_t					objectOffset;
+	std::shared_ptr<gfx::Mesh>	mesh;
+};
+
+/// @brief Copy of the draw list that preceded the sorted draw list, storing unsorted per-pass commands by pass name.
+class LegacyDrawList
+{
+public:
+	void append(std::string const& pass, LegacyDrawCommand const& command)
+	{
+		m_commands[pass].push_back(command);
+	}
+
+	std::vector<LegacyDrawCommand> commands(std::string const& pass) const
+	{
+		auto const& it = m_commands.find(pass);
+		if (it == m_commands.end()) {
+			return {};
+		}
+
+		return it->second;
+	}
+
+private:
+	std::unordered_map<std::string, std::vector<LegacyDrawCommand>> m_commands{};
+};
+
+/// @brief Draw list timing & the number of material changes when iterating its commands in draw order.
+struct DrawListResult
+{
+	double	commandsPerSecond	= 0.0;
+	size_t	stateChanges		= 0;
+};
+
+/// @brief Generate a pseudo-random material & mesh id using a 64-bit LCG.
+/// @param state LCG state.
+/// @return
+static uint32_t nextRandom(uint64_t& state)
+{
+	state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return static_cast<uint32_t>(state >> 32);
+}
+
+/// @brief Convert a command count & duration to a rate.
+/// @param commandCount
+/// @param milliseconds
+/// @return
+static double commandRate(size_t commandCount, double milliseconds)
+{
+	return (milliseconds > 0.0) ? static_cast<double>(commandCount) / (milliseconds / 1000.0) : 0.0;
+}
+
+/// @brief Measure build, sort & iteration of the sorted draw list.
+/// @param commandCount
+/// @return
+static DrawListResult measureDrawList(size_t commandCount)
+{
+	DrawListResult result{};
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	core::Timer timer{};
+
+	DrawList drawList{};
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		uint32_t const random = nextRandom(state);
+		void const* pMesh = reinterpret_cast<void const*>(static_cast<uintptr_t>(random & 0xFFF0));
+		float const depth = static_cast<float>(random >> 16) / 65535.0F;
+
+		uint64_t const sortKey = DrawList::makeSortKey(RenderPass::Opaque, random & 1, random % 256, pMesh, depth);
+		drawList.append(sortKey, DrawCommand{ 0, random % 256, 0, 1, gfx::AABB{}, nullptr });
+	}
+
+	drawList.sort();
+
+	// Iterate commands the same way execute does, tracking state changes
+	uint32_t boundMaterial = UINT32_MAX;
+	for (auto const& command : drawList.commands(RenderPass::Opaque))
+	{
+		result.stateChanges += (command.materialOffset != boundMaterial) ? 1 : 0;
+		boundMaterial = command.materialOffset;
+	}
+
+	timer.tick();
+	result.commandsPerSecond = commandRate(commandCount, timer.delta());
+	return result;
+}
+
+/// @brief Measure build & iteration of the legacy draw list, it had no sort step so commands are drawn in append order.
+/// @param commandCount
+/// @return
+static DrawListResult measureLegacyDrawList(size_t commandCount)
+{
+	DrawListResult result{};
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	core::Timer timer{};
+
+	LegacyDrawList drawList{};
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		uint32_t const random = nextRandom(state);
+		drawList.append(LEGACY_PASS_OPAQUE, LegacyDrawCommand{ 0, random % 256, static_cast<uint32_t>(i), nullptr });
+	}
+
+	uint32_t boundMaterial = UINT32_MAX;
+	for (auto const& command : drawList.commands(LEGACY_PASS_OPAQUE))
+	{
+		result.stateChanges += (command.materialOffset != boundMaterial) ? 1 : 0;
+		boundMaterial = command.materialOffset;
+	}
+
+	timer.tick();
+	result.commandsPerSecond = commandRate(commandCount, timer.delta());
+	return result;
+}
+
+/// @brief Measure draw list build, sort & iteration throughput at typical and extreme draw counts, compared to the
+/// legacy per-pass draw list. Both lists draw commands with the same pseudo-random materials.
+int main()
+{
+	for (size_t const commandCount : { 1'000, 10'000, 100'000 })
+	{
+		DrawListResult const sorted = measureDrawList(commandCount);
+		DrawListResult const legacy = measureLegacyDrawList(commandCount);
+		SPDLOG_INFO("Draw list at {} commands: {:.0f} commands/s, {} material changes (sorted) vs {:.0f} commands/s, {} material changes (legacy)",
+			commandCount, sorted.commandsPerSecond, sorted.stateChanges, legacy.commandsPerSecond, legacy.stateChanges);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "rendering/occlusion_culling.hpp"
+
+static constexpr size_t DRAW_COUNT = 100'000;
+
+/// @brief Measure CPU reference culling throughput on the calling thread, using a synthetic depth target with a
+/// wall halfway the depth range and boxes scattered in front of and behind it.
+/// @param drawCount Number of draws to cull.
+/// @param occluded Output number of draws culled by the pyramid.
+/// @return Draws per second.
+static double measureCullRate(size_t drawCount, size_t& occluded)
+{
+	glm::uvec2 const depthSize = { 256, 128 };
+	static constexpr float WALL_DISTANCE = 50.0F;
+
+	// Camera at the origin looking down the negative z axis, the wall fills the entire depth target
+	glm::mat4 const project = glm::perspective(glm::radians(60.0F), static_cast<float>(depthSize.x) / static_cast<float>(depthSize.y), 0.1F, 100.0F);
+	glm::vec4 const wallClip = project * glm::vec4(0.0F, 0.0F, -WALL_DISTANCE, 1.0F);
+	std::vector<float> const depth(depthSize.x * depthSize.y, wallClip.z / wallClip.w);
+
+	gfx::HiZPyramid pyramid{};
+	pyramid.build(depthSize, depth.data());
+
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	auto const random = [&state](float min, float max) {
+		// Pseudo-random box positions & sizes using a 64-bit LCG
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return min + (max - min) * static_cast<float>(state >> 40) / static_cast<float>(1 << 24);
+	};
+
+	std::vector<gfx::DrawCullData> draws(drawCount);
+	for (auto& draw : draws)
+	{
+		glm::vec3 const center = { random(-20.0F, 20.0F), random(-10.0F, 10.0F), random(-95.0F, -5.0F) };
+		glm::vec3 const extent = glm::vec3(random(0.5F, 2.0F));
+		draw = gfx::DrawCullData{ center - extent, 0, center + extent, 0 };
+	}
+
+	gfx::Frustum const frustum = gfx::Frustum::fromMatrix(project);
+	gfx::CullParams params{};
+	params.occlusionViewProject = project;
+	std::copy(std::begin(frustum.planes), std::end(frustum.planes), std::begin(params.planes));
+	params.depthSize = depthSize;
+	params.levelCount = pyramid.levelCount();
+	params.drawCount = static_cast<uint32_t>(drawCount);
+	params.occlusionEnabled = 1;
+
+	core::Timer timer{};
+	std::vector<uint8_t> visible{};
+	size_t const visibleCount = gfx::cullDraws(params, pyramid, draws, visible);
+	timer.tick();
+
+	// Draws passing the frustum test but failing the combined test were culled by the pyramid
+	params.occlusionEnabled = 0;
+	occluded = gfx::cullDraws(params, pyramid, draws, visible) - visibleCount;
+
+	double const seconds = timer.delta() / 1000.0;
+	return (seconds > 0.0) ? static_cast<double>(drawCount) / seconds : 0.0;
+}
+
+/// @brief Measure throughput of the CPU reference of the GPU culling pass, against a synthetic occluder.
+int main()
+{
+	size_t occluded = 0;
+	double const cullRate = measureCullRate(DRAW_COUNT, occluded);
+	SPDLOG_INFO("HiZ reference culling: {:.0f} draws/s, {} of {} draws occluded", cullRate, occluded, DRAW_COUNT);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include <cstdint>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+#include "core/job_system.hpp"
+#include "core/timer.hpp"
+
+static constexpr uint32_t	EMPTY_JOB_COUNT		= 1'000'000;
+static constexpr uint32_t	FAN_OUT_JOB_COUNT	= 64;
+static constexpr uint32_t	FAN_OUT_ITERATIONS	= 10'000;
+
+/// @brief Measure scheduling overhead of the job system, using empty jobs so only queueing & signalling costs are timed.
+int main()
+{
+	core::JobSystem jobSystem{};
+	SPDLOG_INFO("Job system running {} workers", jobSystem.workerCount());
+
+	// Throughput of independent empty jobs, scheduled from the main thread
+	{
+		core::JobCounter counter{};
+		core::Timer timer{};
+		for (uint32_t i = 0; i < EMPTY_JOB_COUNT; i++) {
+			jobSystem.run([]() {}, &counter);
+		}
+		jobSystem.wait(counter);
+		timer.tick();
+
+		double const seconds = timer.delta() / 1000.0;
+		SPDLOG_INFO("Empty job throughput: {:.0f} jobs/s", (seconds > 0.0) ? EMPTY_JOB_COUNT / seconds : 0.0);
+	}
+
+	// Latency from scheduling a fan-out of jobs until a continuation joining them has completed
+	{
+		core::Timer timer{};
+		for (uint32_t i = 0; i < FAN_OUT_ITERATIONS; i++)
+		{
+			core::JobCounter fanOut{};
+			core::JobCounter fanIn{};
+			for (uint32_t j = 0; j < FAN_OUT_JOB_COUNT; j++) {
+				jobSystem.run([]() {}, &fanOut);
+			}
+
+			jobSystem.runAfter(fanOut, []() {}, &fanIn);
+			jobSystem.wait(fanIn);
+		}
+		timer.tick();
+
+		SPDLOG_INFO("Fan-out/fan-in latency of {} jobs: {:.3f} us", FAN_OUT_JOB_COUNT, timer.delta() * 1000.0 / FAN_OUT_ITERATIONS);
+	}
+
+	return EXIT_SUCCESS;
+}
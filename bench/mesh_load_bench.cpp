@@ -0,0 +1,91 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <spdlog/spdlog.h>
+
+#include "assets/mesh_loader.hpp"
+#include "core/timer.hpp"
+
+static constexpr uint32_t LOAD_ITERATIONS = 16;
+
+/// @brief Mesh load times of the glTF parser & the baked mesh cache, averaged over a number of loads.
+struct MeshLoadBenchmark
+{
+	double	parseTime	= 0.0;	// Time to parse, hash & bake the source file in milliseconds
+	double	bakedTime	= 0.0;	// Time to validate & read the baked mesh in milliseconds, without hashing the source file
+};
+
+/// @brief Measure the load time of a mesh file through the glTF parser & through its baked mesh.
+/// The baked mesh is removed before every parsed load, so those loads include hashing the source file & writing the bake.
+/// @param path File path of the source mesh, baked next to it.
+/// @param iterations Number of loads per path.
+/// @return
+static MeshLoadBenchmark measureLoadTime(std::string const& path, uint32_t iterations)
+{
+	assert(iterations > 0 && "Iteration count cannot be 0");
+
+	MeshLoadBenchmark result{};
+	std::string const bakedPath = path + assets::MeshLoader::BAKED_MESH_EXTENSION;
+	assets::MeshLoader loader{};
+
+	std::shared_ptr<gfx::Mesh> parsed{};
+	core::Timer timer{};
+	for (uint32_t i = 0; i < iterations; i++)
+	{
+		std::filesystem::remove(bakedPath);
+		parsed = loader.load(path);
+	}
+
+	timer.tick();
+	result.parseTime = timer.delta() / static_cast<double>(iterations);
+
+	if (!parsed || !std::filesystem::exists(bakedPath)) {
+		return result;
+	}
+
+	timer.reset();
+	for (uint32_t i = 0; i < iterations; i++) {
+		loader.load(path);
+	}
+
+	timer.tick();
+	result.bakedTime = timer.delta() / static_cast<double>(iterations);
+	return result;
+}
+
+/// @brief Measure mesh load times through the glTF parser & through the baked mesh cache, the mesh is copied into a
+/// temporary directory & baked there so the asset tree is left untouched.
+/// Usage: MeshLoadBench <glTF mesh file>
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		SPDLOG_ERROR("Usage: MeshLoadBench <glTF mesh file>");
+		return EXIT_FAILURE;
+	}
+
+	std::error_code error{};
+	std::filesystem::path const sourcePath = argv[1];
+	std::filesystem::path const path = std::filesystem::temp_directory_path() / sourcePath.filename();
+	std::filesystem::copy_file(sourcePath, path, std::filesystem::copy_options::overwrite_existing, error);
+	if (error)
+	{
+		SPDLOG_ERROR("Failed to copy mesh file {} to {}", sourcePath.string(), path.string());
+		return EXIT_FAILURE;
+	}
+
+	MeshLoadBenchmark const meshLoad = measureLoadTime(path.string(), LOAD_ITERATIONS);
+	std::filesystem::remove(path.string() + assets::MeshLoader::BAKED_MESH_EXTENSION);
+	std::filesystem::remove(path);
+	if (meshLoad.bakedTime <= 0.0)
+	{
+		SPDLOG_ERROR("Failed to load & bake mesh file {}", sourcePath.string());
+		return EXIT_FAILURE;
+	}
+
+	SPDLOG_INFO("Mesh load time: {:.3f} ms (glTF), {:.3f} ms (baked)", meshLoad.parseTime, meshLoad.bakedTime);
+	return EXIT_SUCCESS;
+}
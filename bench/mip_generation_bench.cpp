@@ -0,0 +1,45 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "rendering/texture.hpp"
+
+/// @brief Measure mip chain generation throughput on the calling thread, using a synthetic square RGBA texture.
+/// @param size Width & height of the base level.
+/// @param mode Texture mode selecting the downsample filter.
+/// @return Base level texels per second.
+static double measureMipRate(uint32_t size, gfx::TextureMode mode)
+{
+	// Pseudo-random texel data, so the filter cannot take shortcuts on uniform data
+	std::vector<uint8_t> texels(static_cast<size_t>(size) * size * 4);
+	uint32_t state = 0x9E3779B9U;
+	for (auto& texel : texels)
+	{
+		state = state * 1664525U + 1013904223U;
+		texel = static_cast<uint8_t>(state >> 24);
+	}
+
+	gfx::Texture texture(gfx::TextureDimensions::Dim2D, gfx::TextureExtent{ size, size, 1 }, 4, texels.data(), mode);
+	core::Timer timer{};
+	texture.generateMipLevels();
+	timer.tick();
+
+	double const seconds = timer.delta() / 1000.0;
+	return (seconds > 0.0) ? static_cast<double>(size) * static_cast<double>(size) / seconds : 0.0;
+}
+
+/// @brief Measure host-side mip chain generation throughput for large textures, per downsample filter.
+int main()
+{
+	for (uint32_t const size : { 2048U, 4096U })
+	{
+		SPDLOG_INFO("Mip generation texels/s at {}x{}: {:.0f} (color), {:.0f} (non-color), {:.0f} (normal)", size, size,
+			measureMipRate(size, gfx::TextureMode::ColorData),
+			measureMipRate(size, gfx::TextureMode::NonColorData),
+			measureMipRate(size, gfx::TextureMode::NormalData));
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "rendering/occlusion_rasterizer.hpp"
+
+static constexpr size_t OCCLUDER_COUNT = 256;
+static constexpr size_t OCCLUDEE_COUNT = 10'000;
+
+/// @brief Benchmark results for a synthetic scene.
+struct BenchmarkResult
+{
+	double	occludersPerSecond	= 0.0;
+	double	occludeesPerSecond	= 0.0;
+	size_t	occluded			= 0;	// Number of occludees hidden by the occluders
+};
+
+/// @brief Measure rasterization & test throughput on the calling thread, using a synthetic scene of large occluder
+/// boxes in front of the camera and smaller occludee boxes scattered behind and between them.
+/// @param occluderCount Number of occluder boxes rasterized.
+/// @param occludeeCount Number of occludee boxes tested.
+/// @param dumpPath Optional PNG path the resulting depth buffer is written to, may be a nullptr.
+/// @return
+static BenchmarkResult measure(size_t occluderCount, size_t occludeeCount, char const* dumpPath)
+{
+	// Camera at the origin looking down the negative z axis
+	float const aspect = static_cast<float>(gfx::OcclusionRasterizer::WIDTH) / static_cast<float>(gfx::OcclusionRasterizer::HEIGHT);
+	glm::mat4 const project = glm::perspective(glm::radians(60.0F), aspect, 0.1F, 500.0F);
+
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	auto const random = [&state](float min, float max) {
+		// Pseudo-random box positions & sizes using a 64-bit LCG
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return min + (max - min) * static_cast<float>(state >> 40) / static_cast<float>(1 << 24);
+	};
+
+	// Occluders are chunk sized boxes near the camera, occludees are smaller boxes spread out behind them
+	std::vector<gfx::AABB> occluders(occluderCount);
+	for (auto& occluder : occluders)
+	{
+		glm::vec3 const center = { random(-60.0F, 60.0F), random(-30.0F, 30.0F), random(-120.0F, -40.0F) };
+		occluder = gfx::AABB{ center - glm::vec3(16.0F), center + glm::vec3(16.0F) };
+	}
+
+	std::vector<gfx::AABB> occludees(occludeeCount);
+	for (auto& occludee : occludees)
+	{
+		glm::vec3 const center = { random(-150.0F, 150.0F), random(-75.0F, 75.0F), random(-300.0F, -20.0F) };
+		glm::vec3 const extent = glm::vec3(random(1.0F, 8.0F));
+		occludee = gfx::AABB{ center - extent, center + extent };
+	}
+
+	BenchmarkResult result{};
+	gfx::OcclusionRasterizer rasterizer{};
+	core::Timer timer{};
+	rasterizer.begin(project);
+	for (auto const& occluder : occluders) {
+		rasterizer.rasterizeOccluder(occluder);
+	}
+	timer.tick();
+
+	double const rasterSeconds = timer.delta() / 1000.0;
+	for (auto const& occludee : occludees) {
+		result.occluded += rasterizer.isOccluded(occludee) ? 1 : 0;
+	}
+	timer.tick();
+
+	double const testSeconds = timer.delta() / 1000.0;
+	result.occludersPerSecond = (rasterSeconds > 0.0) ? static_cast<double>(occluderCount) / rasterSeconds : 0.0;
+	result.occludeesPerSecond = (testSeconds > 0.0) ? static_cast<double>(occludeeCount) / testSeconds : 0.0;
+
+	if (dumpPath != nullptr) {
+		rasterizer.dumpDepth(dumpPath);
+	}
+
+	return result;
+}
+
+/// @brief Measure software occlusion rasterizer throughput against a synthetic scene.
+/// Usage: OcclusionRasterizerBench [depth PNG output path]
+int main(int argc, char** argv)
+{
+	char const* dumpPath = (argc > 1) ? argv[1] : nullptr;
+	BenchmarkResult const result = measure(OCCLUDER_COUNT, OCCLUDEE_COUNT, dumpPath);
+	SPDLOG_INFO("Software occlusion: {:.0f} occluders/s, {:.0f} occludees/s, {} of {} occludees occluded behind {} occluders",
+		result.occludersPerSecond, result.occludeesPerSecond, result.occluded, OCCLUDEE_COUNT, OCCLUDER_COUNT);
+
+	if (dumpPath != nullptr) {
+		SPDLOG_INFO("Depth buffer written to {}", dumpPath);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/range_allocator.hpp"
+#include "core/timer.hpp"
+
+// Ranges are sized in vertices like chunk meshes, the address space is kept about 70% full
+static constexpr uint64_t	CHURN_CAPACITY		= 16 * 1024 * 1024;
+static constexpr uint64_t	CHURN_MIN_SIZE		= 2 * 1024;
+static constexpr uint64_t	CHURN_MAX_SIZE		= 40 * 1024;
+static constexpr uint64_t	CHURN_FILL			= CHURN_CAPACITY / 10 * 7;
+static constexpr size_t		CHURN_OPERATIONS	= 100'000;
+
+/// @brief Simulated churn results.
+struct ChurnResult
+{
+	double	operationsPerSecond	= 0.0;	// Allocate & free pairs per second, including compactions
+	float	fragmentation		= 0.0F;	// Average fragmentation sampled after each operation
+	size_t	compactions			= 0;
+};
+
+/// @brief Measure allocator throughput & fragmentation under simulated chunk mesh churn on the calling thread.
+/// Random ranges sized like chunk meshes are replaced one at a time, compacting whenever an allocation fails.
+/// @param operations Number of allocate & free pairs to perform.
+/// @return
+static ChurnResult measureChurn(size_t operations)
+{
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	auto const random = [&state]() {
+		// Pseudo-random sizes & victims using a 64-bit LCG
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return state >> 32;
+	};
+
+	core::RangeAllocator allocator(CHURN_CAPACITY);
+	std::vector<uint64_t> live{};
+	while (allocator.used() < CHURN_FILL) {
+		live.push_back(allocator.allocate(CHURN_MIN_SIZE + random() % (CHURN_MAX_SIZE - CHURN_MIN_SIZE)));
+	}
+
+	ChurnResult result{};
+	std::vector<core::RangeMove> moves{};
+	double fragmentation = 0.0;
+	core::Timer timer{};
+	for (size_t i = 0; i < operations; i++)
+	{
+		size_t const victim = random() % live.size();
+		allocator.free(live[victim]);
+
+		uint64_t const size = CHURN_MIN_SIZE + random() % (CHURN_MAX_SIZE - CHURN_MIN_SIZE);
+		uint64_t offset = allocator.allocate(size);
+		if (offset == core::RangeAllocator::INVALID_OFFSET)
+		{
+			// Live offsets are remapped the same way a device heap would update its ranges
+			allocator.compact(CHURN_CAPACITY, moves);
+			for (auto& liveOffset : live)
+			{
+				if (liveOffset == live[victim]) {
+					continue;
+				}
+
+				auto const it = std::lower_bound(moves.begin(), moves.end(), liveOffset,
+					[](core::RangeMove const& move, uint64_t from) { return move.from < from; });
+				liveOffset = it->to;
+			}
+
+			offset = allocator.allocate(size);
+			result.compactions++;
+		}
+
+		live[victim] = offset;
+		fragmentation += allocator.fragmentation();
+	}
+
+	timer.tick();
+
+	double const seconds = timer.delta() / 1000.0;
+	result.operationsPerSecond = (seconds > 0.0) ? static_cast<double>(operations) / seconds : 0.0;
+	result.fragmentation = (operations > 0) ? static_cast<float>(fragmentation / static_cast<double>(operations)) : 0.0F;
+	return result;
+}
+
+/// @brief Measure mesh pool range allocator throughput & fragmentation under simulated chunk mesh churn.
+int main()
+{
+	ChurnResult const churn = measureChurn(CHURN_OPERATIONS);
+	SPDLOG_INFO("Range allocator churn: {:.0f} ops/s, {:.1f}% average fragmentation, {} compactions",
+		churn.operationsPerSecond, churn.fragmentation * 100.0F, churn.compactions);
+
+	return EXIT_SUCCESS;
+}
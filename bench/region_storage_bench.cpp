@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "world/chunk.hpp"
+#include "world/region_file.hpp"
+#include "world/region_storage.hpp"
+#include "world/terrain_generator.hpp"
+
+static constexpr uint32_t	WORLD_SEED			= 1337;
+static constexpr size_t		DEFAULT_WORLD_MB	= 1024;
+static constexpr int32_t	SOURCE_CHUNKS_XZ	= 16;	// Distinct generated chunks are reused to fill the world
+
+/// @brief Measure chunk save & load throughput of region storage over a generated world of a given size on disk.
+/// Usage: RegionStorageBench [world size in MB]
+int main(int argc, char** argv)
+{
+	size_t const worldMB = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_WORLD_MB;
+	size_t const worldBytes = worldMB * 1024 * 1024;
+
+	// Generate a set of surface chunks, the world repeats them so generation does not dominate the run time
+	std::vector<world::Chunk> sourceChunks(static_cast<size_t>(SOURCE_CHUNKS_XZ * SOURCE_CHUNKS_XZ * 2));
+	world::TerrainGenerator const generator(WORLD_SEED);
+	for (size_t i = 0; i < sourceChunks.size(); i++)
+	{
+		int32_t const x = static_cast<int32_t>(i) % SOURCE_CHUNKS_XZ;
+		int32_t const z = (static_cast<int32_t>(i) / SOURCE_CHUNKS_XZ) % SOURCE_CHUNKS_XZ;
+		int32_t const y = static_cast<int32_t>(i) / (SOURCE_CHUNKS_XZ * SOURCE_CHUNKS_XZ) - 1;
+		generator.generate(glm::ivec3(x, y, z), sourceChunks[i]);
+	}
+
+	// Lay out chunks in whole region columns, until the sectors written add up to the world size
+	auto const chunkCoord = [](size_t i) {
+		int32_t const index = static_cast<int32_t>(i);
+		int32_t const perLayer = world::REGION_SIZE_XZ * world::REGION_SIZE_XZ * world::REGION_SIZE_Y;
+		int32_t const local = index % perLayer;
+		int32_t const region = index / perLayer;
+		return glm::ivec3(
+			(region % 64) * world::REGION_SIZE_XZ + local % world::REGION_SIZE_XZ,
+			(local / (world::REGION_SIZE_XZ * world::REGION_SIZE_XZ)),
+			(region / 64) * world::REGION_SIZE_XZ + (local / world::REGION_SIZE_XZ) % world::REGION_SIZE_XZ
+		);
+	};
+
+	std::filesystem::path const directory = std::filesystem::temp_directory_path() / "voxel_game_region_bench";
+	std::filesystem::remove_all(directory);
+
+	size_t chunkCount = 0;
+	{
+		world::RegionStorage storage(directory.string());
+		std::vector<uint8_t> data{};
+		size_t sectorBytes = 0;
+
+		core::Timer timer{};
+		while (sectorBytes < worldBytes)
+		{
+			world::Chunk const& chunk = sourceChunks[chunkCount % sourceChunks.size()];
+			if (!storage.saveChunk(chunkCoord(chunkCount), chunk))
+			{
+				SPDLOG_ERROR("Failed to save chunk {}", chunkCount);
+				return EXIT_FAILURE;
+			}
+
+			world::RegionFile::encodeChunk(chunk, data);
+			sectorBytes += (data.size() + world::REGION_SECTOR_SIZE - 1) / world::REGION_SECTOR_SIZE * world::REGION_SECTOR_SIZE;
+			chunkCount++;
+		}
+		timer.tick();
+
+		double const seconds = timer.delta() / 1000.0;
+		world::RegionStorageStats const stats = storage.stats();
+		SPDLOG_INFO("Saved {} chunks in {} regions ({} MB on disk): {:.0f} chunks/s, {} compressed bytes",
+			chunkCount, stats.openRegions, worldMB, (seconds > 0.0) ? chunkCount / seconds : 0.0, stats.bytesWritten);
+	}
+
+	// Load through a new storage, so region tables are read from disk again
+	{
+		world::RegionStorage storage(directory.string());
+		world::Chunk chunk{};
+
+		core::Timer timer{};
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			if (!storage.loadChunk(chunkCoord(i), chunk))
+			{
+				SPDLOG_ERROR("Failed to load chunk {}", i);
+				return EXIT_FAILURE;
+			}
+		}
+		timer.tick();
+
+		double const seconds = timer.delta() / 1000.0;
+		world::RegionStorageStats const stats = storage.stats();
+		SPDLOG_INFO("Loaded {} chunks: {:.0f} chunks/s, {} compressed bytes", chunkCount, (seconds > 0.0) ? chunkCount / seconds : 0.0, stats.bytesRead);
+	}
+
+	std::filesystem::remove_all(directory);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "world/chunk.hpp"
+#include "world/noise.hpp"
+#include "world/terrain_generator.hpp"
+
+static constexpr uint32_t	WORLD_SEED	= 1337;
+static constexpr uint32_t	CHUNK_COUNT	= 64;
+
+/// @brief Measure column sampling throughput of a generator on the calling thread.
+/// @param generator
+/// @param chunkCount Number of chunk footprints to sample.
+/// @return Sampled columns per second.
+static double measureColumnRate(world::TerrainGenerator const& generator, uint32_t chunkCount)
+{
+	std::array<world::TerrainColumn, world::CHUNK_AREA> columns{};
+	int32_t const size = static_cast<int32_t>(world::CHUNK_SIZE);
+
+	core::Timer timer{};
+	for (uint32_t i = 0; i < chunkCount; i++) {
+		generator.sampleColumns(static_cast<int32_t>(i) * size, 0, columns.data());
+	}
+	timer.tick();
+
+	double const seconds = timer.delta() / 1000.0;
+	return (seconds > 0.0) ? static_cast<double>(chunkCount) * world::CHUNK_AREA / seconds : 0.0;
+}
+
+/// @brief Measure terrain column throughput of the scalar fallback vs the best SIMD path supported by this build & CPU.
+int main()
+{
+	world::TerrainGenerator const scalarGenerator(WORLD_SEED, world::SimdLevel::Scalar);
+	world::TerrainGenerator const simdGenerator(WORLD_SEED);
+	double const scalarRate = measureColumnRate(scalarGenerator, CHUNK_COUNT);
+	double const simdRate = measureColumnRate(simdGenerator, CHUNK_COUNT);
+	SPDLOG_INFO("Terrain columns/s: {:.0f} scalar, {:.0f} {}", scalarRate, simdRate, world::toString(simdGenerator.simdLevel()));
+
+	return EXIT_SUCCESS;
+}
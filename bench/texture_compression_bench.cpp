@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "core/timer.hpp"
+#include "rendering/texture_compression.hpp"
+
+/// @brief Compression quality & throughput of a block format.
+struct CompressionResult
+{
+	double	psnr				= 0.0;	// Peak signal to noise ratio in dB over the channels stored by the format
+	double	texelsPerSecond		= 0.0;
+};
+
+/// @brief Measure compression quality & throughput on the calling thread, using a synthetic image of smooth gradients,
+/// hard edges and texel noise.
+/// @param format
+/// @param size Width & height of the image.
+/// @return
+static CompressionResult measureCompression(gfx::BlockFormat format, uint32_t size)
+{
+	assert(format != gfx::BlockFormat::None && "Cannot measure uncompressed texels");
+	assert(size > 0 && "Image size cannot be 0");
+
+	auto const clampByte = [](int value) { return static_cast<uint8_t>(std::clamp(value, 0, 255)); };
+
+	// Smooth gradients with hard edges every 32 texels & a small amount of per texel noise
+	std::vector<uint8_t> reference(static_cast<size_t>(size) * size * 4);
+	uint32_t state = 0x9E3779B9U;
+	for (uint32_t y = 0; y < size; y++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			state = state * 1664525U + 1013904223U;
+			int const noise = static_cast<int>(state >> 29) - 4;
+			bool const edge = ((x / 32) + (y / 32)) % 2 == 0;
+
+			uint8_t* pTexel = reference.data() + (static_cast<size_t>(y) * size + x) * 4;
+			float const u = static_cast<float>(x) / static_cast<float>(size);
+			float const v = static_cast<float>(y) / static_cast<float>(size);
+			pTexel[0] = clampByte(static_cast<int>(u * 255.0F) + noise);
+			pTexel[1] = clampByte(static_cast<int>(v * 255.0F) + (edge ? 48 : 0) + noise);
+			pTexel[2] = clampByte(static_cast<int>((1.0F - u) * 160.0F) + noise);
+			pTexel[3] = static_cast<uint8_t>(std::clamp(255.0F - v * 128.0F + 0.5F, 0.0F, 255.0F));
+		}
+	}
+
+	std::vector<uint8_t> blocks(gfx::compressedSize(format, size, size));
+	core::Timer timer{};
+	gfx::compressImage(format, size, size, reference.data(), blocks.data());
+	timer.tick();
+
+	std::vector<uint8_t> decoded(reference.size());
+	gfx::decompressImage(format, size, size, blocks.data(), decoded.data());
+
+	CompressionResult result{};
+	result.psnr = gfx::computePsnr(format, reference.data(), decoded.data(), static_cast<size_t>(size) * size);
+	double const seconds = timer.delta() / 1000.0;
+	result.texelsPerSecond = (seconds > 0.0) ? static_cast<double>(size) * static_cast<double>(size) / seconds : 0.0;
+	return result;
+}
+
+/// @brief Measure block compression quality & throughput per format, PSNR below the format minimum indicates an
+/// encoder regression and fails the benchmark.
+int main()
+{
+	bool passed = true;
+	for (auto const& [format, name] : { std::pair{ gfx::BlockFormat::BC1, "BC1" }, std::pair{ gfx::BlockFormat::BC5, "BC5" },
+		std::pair{ gfx::BlockFormat::BC7, "BC7" }, std::pair{ gfx::BlockFormat::ETC2RGB8, "ETC2" } })
+	{
+		CompressionResult const compression = measureCompression(format, 1024);
+		SPDLOG_INFO("{} compression at 1024x1024: {:.2f} dB PSNR, {:.0f} texels/s", name, compression.psnr, compression.texelsPerSecond);
+		if (compression.psnr < gfx::minimumPsnr(format))
+		{
+			SPDLOG_ERROR("{} compression PSNR is below the expected minimum of {:.1f} dB", name, gfx::minimumPsnr(format));
+			passed = false;
+		}
+	}
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,69 @@
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/chunk_mesher.hpp"
+#include "world/terrain_generator.hpp"
+#include "rendering/vertex_layout.hpp"
+
+static constexpr uint32_t	WORLD_SEED		= 1337;
+static constexpr int32_t	WORLD_CHUNKS_XZ	= 16;
+static constexpr int32_t	WORLD_CHUNKS_Y	= 4;
+static constexpr int32_t	WORLD_MIN_Y		= -2;	// Lowest chunk layer, the world spans sea level
+
+/// @brief Measure the vertex memory of a meshed world using the static vertex layout vs the packed voxel vertex layout.
+int main()
+{
+	world::TerrainGenerator const generator(WORLD_SEED);
+	auto const chunkIndex = [](int32_t x, int32_t y, int32_t z) { return static_cast<size_t>(x + z * WORLD_CHUNKS_XZ + y * WORLD_CHUNKS_XZ * WORLD_CHUNKS_XZ); };
+
+	std::vector<world::Chunk> chunks(static_cast<size_t>(WORLD_CHUNKS_XZ * WORLD_CHUNKS_XZ * WORLD_CHUNKS_Y));
+	for (int32_t y = 0; y < WORLD_CHUNKS_Y; y++)
+	{
+		for (int32_t z = 0; z < WORLD_CHUNKS_XZ; z++)
+		{
+			for (int32_t x = 0; x < WORLD_CHUNKS_XZ; x++) {
+				generator.generate(glm::ivec3(x, y + WORLD_MIN_Y, z), chunks[chunkIndex(x, y, z)]);
+			}
+		}
+	}
+
+	// Mesh with neighbours, so only faces visible in the world are counted
+	world::ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+	size_t vertexCount = 0;
+	size_t indexCount = 0;
+	for (int32_t y = 0; y < WORLD_CHUNKS_Y; y++)
+	{
+		for (int32_t z = 0; z < WORLD_CHUNKS_XZ; z++)
+		{
+			for (int32_t x = 0; x < WORLD_CHUNKS_XZ; x++)
+			{
+				world::ChunkNeighbors neighbors{};
+				neighbors[static_cast<size_t>(world::BlockFace::PosX)] = (x + 1 < WORLD_CHUNKS_XZ) ? &chunks[chunkIndex(x + 1, y, z)] : nullptr;
+				neighbors[static_cast<size_t>(world::BlockFace::NegX)] = (x > 0) ? &chunks[chunkIndex(x - 1, y, z)] : nullptr;
+				neighbors[static_cast<size_t>(world::BlockFace::PosY)] = (y + 1 < WORLD_CHUNKS_Y) ? &chunks[chunkIndex(x, y + 1, z)] : nullptr;
+				neighbors[static_cast<size_t>(world::BlockFace::NegY)] = (y > 0) ? &chunks[chunkIndex(x, y - 1, z)] : nullptr;
+				neighbors[static_cast<size_t>(world::BlockFace::PosZ)] = (z + 1 < WORLD_CHUNKS_XZ) ? &chunks[chunkIndex(x, y, z + 1)] : nullptr;
+				neighbors[static_cast<size_t>(world::BlockFace::NegZ)] = (z > 0) ? &chunks[chunkIndex(x, y, z - 1)] : nullptr;
+
+				mesher.mesh(chunks[chunkIndex(x, y, z)], neighbors, vertices, indices);
+				vertexCount += vertices.size();
+				indexCount += indices.size();
+			}
+		}
+	}
+
+	size_t const staticBytes = vertexCount * sizeof(gfx::Vertex);
+	size_t const voxelBytes = vertexCount * sizeof(gfx::VoxelVertex);
+	size_t const indexBytes = indexCount * sizeof(gfx::IndexType);
+	SPDLOG_INFO("Meshed {} chunks into {} vertices & {} indices ({} index bytes)", chunks.size(), vertexCount, indexCount, indexBytes);
+	SPDLOG_INFO("Vertex memory: {} bytes static layout ({} B/vertex), {} bytes voxel layout ({} B/vertex), {:.1f}x smaller",
+		staticBytes, sizeof(gfx::Vertex), voxelBytes, sizeof(gfx::VoxelVertex), static_cast<double>(staticBytes) / static_cast<double>(voxelBytes));
+
+	return EXIT_SUCCESS;
+}
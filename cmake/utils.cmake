@@ -27,3 +27,25 @@ function(target_register_assets TARGET_NAME)
 	add_custom_target(RegisterAssets DEPENDS ${ASSET_OUTPUT_FILES})
 	add_dependencies(${TARGET_NAME} RegisterAssets)
 endfunction()
+
+function(add_game_test TEST_NAME)
+	add_executable(${TEST_NAME} ${ARGN})
+	target_link_libraries(${TEST_NAME} PRIVATE VoxelGameCore)
+	target_enable_extended_warnings(${TEST_NAME})
+	target_copy_webgpu_binaries(${TEST_NAME})
+
+	add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
+	set_tests_properties(${TEST_NAME} PROPERTIES LABELS "test")
+endfunction()
+
+function(add_game_benchmark BENCHMARK_NAME)
+	cmake_parse_arguments(PARSE_ARGV 1 BENCHMARK "" "" "SOURCES;ARGS")
+	add_executable(${BENCHMARK_NAME} ${BENCHMARK_SOURCES})
+	target_link_libraries(${BENCHMARK_NAME} PRIVATE VoxelGameCore)
+	target_enable_extended_warnings(${BENCHMARK_NAME})
+	target_copy_webgpu_binaries(${BENCHMARK_NAME})
+
+	# Benchmarks are slow, run them separately using `ctest -L bench`
+	add_test(NAME ${BENCHMARK_NAME} COMMAND ${BENCHMARK_NAME} ${BENCHMARK_ARGS})
+	set_tests_properties(${BENCHMARK_NAME} PROPERTIES LABELS "bench")
+endfunction()
@@ -0,0 +1,145 @@
+#include "asset_manager.hpp"
+
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+namespace assets
+{
+	/// @brief Find a cached asset, dropping the entry if its asset has been freed.
+	/// @tparam AssetType
+	/// @param cache
+	/// @param key
+	/// @return The cached asset, or nullptr if it is not cached.
+	template<typename AssetType>
+	static std::shared_ptr<AssetType> findCached(std::unordered_map<std::string, std::weak_ptr<AssetType>>& cache, std::string const& key)
+	{
+		auto const it = cache.find(key);
+		if (it == cache.end()) {
+			return {};
+		}
+
+		std::shared_ptr<AssetType> asset = it->second.lock();
+		if (!asset) {
+			cache.erase(it);
+		}
+
+		return asset;
+	}
+
+	/// @brief Drop the entries of freed assets from a cache.
+	/// @tparam AssetType
+	/// @param cache
+	/// @return The number of dropped entries.
+	template<typename AssetType>
+	static size_t evictExpiredEntries(std::unordered_map<std::string, std::weak_ptr<AssetType>>& cache)
+	{
+		size_t evicted = 0;
+		for (auto it = cache.begin(); it != cache.end();)
+		{
+			if (it->second.expired())
+			{
+				it = cache.erase(it);
+				evicted++;
+				continue;
+			}
+
+			++it;
+		}
+
+		return evicted;
+	}
+
+	AssetManager::AssetManager(gfx::BlockFormatSupport const& blockFormats)
+		:
+		m_blockFormats(blockFormats)
+	{
+		//
+	}
+
+	std::shared_ptr<gfx::Mesh> AssetManager::loadMesh(std::string const& path)
+	{
+		std::string const key = cacheKey(path);
+		if (std::shared_ptr<gfx::Mesh> mesh = findCached(m_meshes, key))
+		{
+			SPDLOG_TRACE("Mesh cache hit: {}", key);
+			m_hits++;
+			return mesh;
+		}
+
+		// Failed loads are not cached, so a missing file is retried on the next load
+		m_misses++;
+		std::shared_ptr<gfx::Mesh> mesh = m_meshLoader.load(path);
+		if (mesh) {
+			m_meshes[key] = mesh;
+		}
+
+		return mesh;
+	}
+
+	std::shared_ptr<gfx::Texture> AssetManager::loadTexture(std::string const& path, gfx::TextureMode mode)
+	{
+		std::string const key = cacheKey(path) + "#" + std::to_string(static_cast<int>(mode));
+		if (std::shared_ptr<gfx::Texture> texture = findCached(m_textures, key))
+		{
+			SPDLOG_TRACE("Texture cache hit: {}", key);
+			m_hits++;
+			return texture;
+		}
+
+		m_misses++;
+		std::shared_ptr<gfx::Texture> texture = m_textureLoader.load(path, mode);
+		if (!texture) {
+			return texture;
+		}
+
+		// Compressing here keeps the render thread & upload budget free of uncompressed texture data
+		gfx::BlockFormat const blockFormat = texture->selectBlockFormat(m_blockFormats);
+		if (blockFormat != gfx::BlockFormat::None) {
+			texture->compress(blockFormat);
+		}
+
+		m_textures[key] = texture;
+
+		return texture;
+	}
+
+	size_t AssetManager::evictExpired()
+	{
+		return evictExpiredEntries(m_meshes) + evictExpiredEntries(m_textures);
+	}
+
+	AssetStats AssetManager::stats() const
+	{
+		AssetStats stats{};
+		stats.hits = m_hits;
+		stats.misses = m_misses;
+
+		for (auto const& [key, entry] : m_meshes)
+		{
+			if (std::shared_ptr<gfx::Mesh> const mesh = entry.lock())
+			{
+				stats.meshes++;
+				stats.meshHostBytes += mesh->hostMemoryUsage();
+				stats.meshDeviceBytes += mesh->deviceMemoryUsage();
+			}
+		}
+
+		for (auto const& [key, entry] : m_textures)
+		{
+			if (std::shared_ptr<gfx::Texture> const texture = entry.lock())
+			{
+				stats.textures++;
+				stats.textureHostBytes += texture->size();
+				stats.textureDeviceBytes += (texture->getTexture() != nullptr) ? texture->size() : 0;
+			}
+		}
+
+		return stats;
+	}
+
+	std::string AssetManager::cacheKey(std::string const& path)
+	{
+		// Weakly canonical since missing files are reported by the loaders, not here
+		return std::filesystem::weakly_canonical(std::filesystem::path(path)).string();
+	}
+} // namespace assets
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "assets/mesh_loader.hpp"
+#include "assets/texture_loader.hpp"
+#include "rendering/mesh.hpp"
+#include "rendering/texture.hpp"
+
+namespace assets
+{
+	/// @brief Asset cache counters & memory usage of the assets that are still referenced.
+	struct AssetStats
+	{
+		size_t	meshes				= 0;	// Cached meshes that are still referenced
+		size_t	textures			= 0;	// Cached textures that are still referenced
+		size_t	hits				= 0;	// Loads served from the cache
+		size_t	misses				= 0;	// Loads that read an asset file
+		size_t	meshHostBytes		= 0;
+		size_t	meshDeviceBytes		= 0;
+		size_t	textureHostBytes	= 0;
+		size_t	textureDeviceBytes	= 0;	// Estimated from the (compressed) host-side data of uploaded textures
+	};
+
+	/// @brief The AssetManager class deduplicates asset loads, so every asset file is loaded into host & device memory once.
+	/// Assets are keyed by their canonical path, textures also by their texture mode. The cache only holds weak references,
+	/// so an asset is freed as soon as the last entity or material using it lets go of it.
+	/// Textures are block compressed as they are loaded, so uploads only copy compressed data.
+	/// NOTE: not thread safe, assets are expected to be loaded from the main thread.
+	class AssetManager
+	{
+	public:
+		/// @brief Create a new asset manager.
+		/// @param blockFormats Block formats supported by the device, loaded textures are compressed to these formats.
+		explicit AssetManager(gfx::BlockFormatSupport const& blockFormats = {});
+
+		/// @brief Load a mesh, returning the cached mesh if it is still referenced.
+		/// @param path File path to load the mesh from.
+		/// @return A mesh pointer or nullptr on error.
+		std::shared_ptr<gfx::Mesh> loadMesh(std::string const& path);
+
+		/// @brief Load a texture, returning the cached texture if it is still referenced. Newly loaded textures are block
+		/// compressed if the device supports a suitable block format.
+		/// @param path File path to load the texture from.
+		/// @param mode Interpretation mode, the same file loaded with different modes results in different textures.
+		/// @return A texture pointer or nullptr on error.
+		std::shared_ptr<gfx::Texture> loadTexture(std::string const& path, gfx::TextureMode mode);
+
+		/// @brief Drop cache entries of assets that are no longer referenced.
+		/// @return The number of dropped entries.
+		size_t evictExpired();
+
+		/// @brief Retrieve the cache counters & memory usage of all referenced assets.
+		/// @return
+		AssetStats stats() const;
+
+	private:
+		/// @brief Create the cache key of an asset path, paths naming the same file result in the same key.
+		/// @param path
+		/// @return
+		static std::string cacheKey(std::string const& path);
+
+	private:
+		gfx::BlockFormatSupport											m_blockFormats	= {};
+		MeshLoader														m_meshLoader	= {};
+		TextureLoader													m_textureLoader	= {};
+		std::unordered_map<std::string, std::weak_ptr<gfx::Mesh>>		m_meshes		= {};
+		std::unordered_map<std::string, std::weak_ptr<gfx::Texture>>	m_textures		= {};	// Keys include the texture mode
+		size_t															m_hits			= 0;
+		size_t															m_misses		= 0;
+	};
+} // namespace assets
@@ -5,6 +5,10 @@
 #define TINYGLTF_NO_STB_IMAGE_WRITE
 
 #include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
 #include <vector>
 #include <glm/glm.hpp>
 #include <spdlog/spdlog.h>
@@ -16,16 +20,58 @@
 
 namespace assets
 {
+	static constexpr uint32_t BAKED_MESH_MAGIC		= 0x534D5856U;	// "VXMS"
+	static constexpr uint32_t BAKED_MESH_VERSION	= 2;
+
+	/// @brief Baked mesh header, followed by the vertex data & the index data.
+	struct BakedMeshHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;	// FNV-1a hash of the source file contents, only checked if the source time differs
+		uint64_t sourceSize;	// Size of the source file in bytes
+		int64_t sourceTime;	// Last write time of the source file in file clock ticks
+		uint32_t vertexStride;	// Size of gfx::Vertex when baked, layout changes invalidate baked meshes
+		uint32_t indexSize;
+		uint64_t vertexCount;
+		uint64_t indexCount;
+	};
+
+	static_assert(sizeof(BakedMeshHeader) == 56, "Baked mesh header must be tightly packed");
+
+	/// @brief Hash file contents using 64 bit FNV-1a.
+	/// @param pData 
+	/// @param size 
+	/// @return 
+	static uint64_t hashContents(uint8_t const* pData, size_t size)
+	{
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pData[i];
+			hash *= 0x100000001B3ULL;
+		}
+
+		return hash;
+	}
+
 	template<typename AccessorType>
 	std::vector<AccessorType> readBufferContents(tinygltf::Accessor const& accessor, tinygltf::BufferView const& view, tinygltf::Buffer const& buffer)
 	{
-		assert(accessor.ByteStride(view) != -1);
+		int const stride = accessor.ByteStride(view);
+		assert(stride != -1);
 
-		std::vector<AccessorType> contents{};
-		for (size_t i = 0; i < accessor.count; i++)
+		// Tightly packed attributes are copied at once, interleaved attributes are copied per element
+		size_t const baseOffset = view.byteOffset + accessor.byteOffset;
+		std::vector<AccessorType> contents(accessor.count);
+		if (static_cast<size_t>(stride) == sizeof(AccessorType))
 		{
-			size_t const offset = view.byteOffset + i * accessor.ByteStride(view);
-			contents.push_back(*reinterpret_cast<AccessorType const*>(&buffer.data[offset]));
+			std::memcpy(contents.data(), &buffer.data[baseOffset], accessor.count * sizeof(AccessorType));
+			return contents;
+		}
+
+		for (size_t i = 0; i < accessor.count; i++) {
+			std::memcpy(&contents[i], &buffer.data[baseOffset + i * static_cast<size_t>(stride)], sizeof(AccessorType));
 		}
 
 		return contents;
@@ -35,6 +81,62 @@ namespace assets
 	{
 		SPDLOG_INFO("Loading mesh file {}", path);
 
+		SourceStamp stamp{};
+		if (!readSourceStamp(path, stamp) || stamp.size == 0)
+		{
+			SPDLOG_ERROR("Failed to open mesh file (does it exist?)");
+			return {};
+		}
+
+		// Use the baked mesh if it was baked from the current source file, the source file is not read to validate it
+		std::string const bakedPath = path + BAKED_MESH_EXTENSION;
+		if (std::shared_ptr<gfx::Mesh> mesh = loadBaked(bakedPath, path, stamp))
+		{
+			SPDLOG_INFO("Loaded baked mesh!");
+			return mesh;
+		}
+
+		core::fs::MappedFile source{};
+		if (!source.open(path) || source.size() == 0)
+		{
+			SPDLOG_ERROR("Failed to open mesh file (does it exist?)");
+			return {};
+		}
+
+		std::shared_ptr<gfx::Mesh> mesh = parseGLTF(path, source);
+		if (!mesh) {
+			return {};
+		}
+
+		if (!bake(*mesh, bakedPath, stamp, hashContents(source.data(), source.size()))) {
+			SPDLOG_WARN("Failed to write baked mesh {}, the source file is parsed on the next load", bakedPath);
+		}
+
+		SPDLOG_INFO("Loaded mesh!");
+		return mesh;
+	}
+
+	bool MeshLoader::readSourceStamp(std::string const& path, SourceStamp& stamp)
+	{
+		std::error_code error{};
+		std::filesystem::path const sourcePath(path);
+		uintmax_t const size = std::filesystem::file_size(sourcePath, error);
+		if (error) {
+			return false;
+		}
+
+		std::filesystem::file_time_type const modifiedTime = std::filesystem::last_write_time(sourcePath, error);
+		if (error) {
+			return false;
+		}
+
+		stamp.size = static_cast<uint64_t>(size);
+		stamp.modifiedTime = static_cast<int64_t>(modifiedTime.time_since_epoch().count());
+		return true;
+	}
+
+	std::shared_ptr<gfx::Mesh> MeshLoader::parseGLTF(std::string const& path, core::fs::MappedFile const& source)
+	{
 		std::string const filetype = path.substr(path.find_last_of("."));
 		bool binaryfile = false;
 		if (filetype == ".glb") {
@@ -49,17 +151,18 @@ namespace assets
 			return {};
 		}
 
-		// Load model file using tinygltf based on file type
+		// Parse the mapped model file using tinygltf based on file type, external buffers are resolved from the file directory
+		std::string const baseDirectory = std::filesystem::path(path).parent_path().string();
 		std::string warning{};
 		std::string error{};
 		tinygltf::Model model{};
 		tinygltf::TinyGLTF loader{};
 		bool loadOK = false;
 		if (binaryfile) {
-			loadOK = loader.LoadBinaryFromFile(&model, &error, &warning, path);
+			loadOK = loader.LoadBinaryFromMemory(&model, &error, &warning, source.data(), static_cast<unsigned int>(source.size()), baseDirectory);
 		}
 		else {
-			loadOK = loader.LoadASCIIFromFile(&model, &error, &warning, path);
+			loadOK = loader.LoadASCIIFromString(&model, &error, &warning, reinterpret_cast<char const*>(source.data()), static_cast<unsigned int>(source.size()), baseDirectory);
 		}
 
 		// Check load return code
@@ -180,14 +283,15 @@ namespace assets
 				assert(!positions.empty() && !normals.empty() && !tangents.empty() && !texcoords.empty());
 				assert(positions.size() == normals.size() && positions.size() == tangents.size() && tangents.size() == texcoords.size());
 
+				// Sub mesh indices are relative to the first vertex of the sub mesh
 				size_t const vertexCount = positions.size();
+				uint32_t const vertexOffset = static_cast<uint32_t>(vertices.size());
 				for (size_t i = 0; i < vertexCount; i++) {
 					vertices.push_back(gfx::Vertex{ positions[i], normals[i], tangents[i], texcoords[i] });
 				}
 
-				uint32_t const indexOffset = static_cast<uint32_t>(indices.size());
 				for (auto const& idx : subMeshIndices) {
-					indices.push_back(indexOffset + idx);
+					indices.push_back(vertexOffset + idx);
 				}
 			}
 		}
@@ -202,8 +306,104 @@ namespace assets
 		}
 #endif	// GAME_BUILD_TYPE_DEBUG
 
-		// Done!
-		SPDLOG_INFO("Loaded mesh!");
-		return std::make_shared<gfx::Mesh>(vertices, indices);
+		return std::make_shared<gfx::Mesh>(std::move(vertices), std::move(indices));
+	}
+
+	std::shared_ptr<gfx::Mesh> MeshLoader::loadBaked(std::string const& bakedPath, std::string const& path, SourceStamp const& stamp)
+	{
+		core::fs::MappedFile file{};
+		if (!file.open(bakedPath)) {
+			return {};
+		}
+
+		BakedMeshHeader header{};
+		if (file.size() >= sizeof(header)) {
+			std::memcpy(&header, file.data(), sizeof(header));
+		}
+
+		if (header.magic != BAKED_MESH_MAGIC || header.version != BAKED_MESH_VERSION
+			|| header.vertexStride != sizeof(gfx::Vertex) || header.indexSize != sizeof(gfx::IndexType))
+		{
+			SPDLOG_INFO("Baked mesh {} has an outdated format, rebaking", bakedPath);
+			return {};
+		}
+
+		if (header.sourceSize != stamp.size)
+		{
+			SPDLOG_INFO("Baked mesh {} is out of date, rebaking", bakedPath);
+			return {};
+		}
+
+		// Source files touched without a size change (e.g. by a checkout) are hashed, matching contents keep the bake
+		bool const restamp = header.sourceTime != stamp.modifiedTime;
+		if (restamp)
+		{
+			core::fs::MappedFile source{};
+			if (!source.open(path) || hashContents(source.data(), source.size()) != header.sourceHash)
+			{
+				SPDLOG_INFO("Baked mesh {} is out of date, rebaking", bakedPath);
+				return {};
+			}
+		}
+
+		// Counts are bounded by the file size first, so a corrupted header cannot overflow the size check
+		size_t const vertexSize = header.vertexCount * sizeof(gfx::Vertex);
+		size_t const indexSize = header.indexCount * sizeof(gfx::IndexType);
+		if (header.vertexCount > file.size() / sizeof(gfx::Vertex) || header.indexCount > file.size() / sizeof(gfx::IndexType)
+			|| file.size() != sizeof(header) + vertexSize + indexSize)
+		{
+			SPDLOG_ERROR("Baked mesh {} has an invalid size, rebaking", bakedPath);
+			return {};
+		}
+
+		// Both blobs are copied straight into the mesh buffers, no per element conversion is needed
+		std::vector<gfx::Vertex> vertices(header.vertexCount);
+		std::vector<gfx::IndexType> indices(header.indexCount);
+		std::memcpy(vertices.data(), file.data() + sizeof(header), vertexSize);
+		std::memcpy(indices.data(), file.data() + sizeof(header) + vertexSize, indexSize);
+		file.close();
+
+		// Store the new source time, so the next load skips hashing again. The baked mesh stays valid if this fails
+		if (restamp)
+		{
+			header.sourceTime = stamp.modifiedTime;
+			std::fstream restampFile(bakedPath, std::ios::binary | std::ios::in | std::ios::out);
+			restampFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			if (!restampFile) {
+				SPDLOG_WARN("Failed to restamp baked mesh {}", bakedPath);
+			}
+		}
+
+		return std::make_shared<gfx::Mesh>(std::move(vertices), std::move(indices));
+	}
+
+	bool MeshLoader::bake(gfx::Mesh const& mesh, std::string const& bakedPath, SourceStamp const& stamp, uint64_t sourceHash)
+	{
+		assert(mesh.vertexLayout() == gfx::VertexLayout::Static && "Only meshes using the static vertex layout can be baked");
+
+		core::Span<gfx::Vertex const> const vertices = mesh.vertices();
+		core::Span<gfx::IndexType const> const indices = mesh.indices();
+		BakedMeshHeader const header{
+			BAKED_MESH_MAGIC,
+			BAKED_MESH_VERSION,
+			sourceHash,
+			stamp.size,
+			stamp.modifiedTime,
+			static_cast<uint32_t>(sizeof(gfx::Vertex)),
+			static_cast<uint32_t>(sizeof(gfx::IndexType)),
+			vertices.size(),
+			indices.size(),
+		};
+
+		std::ofstream file(bakedPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		file.write(reinterpret_cast<char const*>(vertices.data()), static_cast<std::streamsize>(vertices.size() * sizeof(gfx::Vertex)));
+		file.write(reinterpret_cast<char const*>(indices.data()), static_cast<std::streamsize>(indices.size() * sizeof(gfx::IndexType)));
+		if (!file) {
+			return false;
+		}
+
+		SPDLOG_INFO("Baked mesh {} ({} vertices, {} indices)", bakedPath, vertices.size(), indices.size());
+		return true;
 	}
 } // namespace assets
@@ -1,20 +1,65 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "core/files.hpp"
 #include "rendering/mesh.hpp"
 
 namespace assets
 {
 	/// @brief The MeshLoader class handles mesh file I/O.
-	/// NOTE: only supports glTF2.0 binary files.
+	/// Parsed meshes are baked next to their source file, as a header followed by the interleaved vertex & index data.
+	/// Baked meshes store the size & modification time of their source file, so they are validated without reading it.
+	/// If only the modification time differs, e.g. after a checkout, the stored source hash decides if the bake is still
+	/// up to date.
+	/// NOTE: only supports glTF2.0 files, baked meshes are stored in native (little endian) byte order.
 	class MeshLoader
 	{
 	public:
-		/// @brief Load a mesh from a file on disk.
+		/// @brief File extension appended to the source file path of baked meshes.
+		static constexpr char const* BAKED_MESH_EXTENSION = ".vxmesh";
+
+		/// @brief Load a mesh from a file on disk, using the baked mesh if it is up to date.
 		/// @param path File path to load mesh from.
 		/// @return A mesh pointer or nullptr on error.
 		std::shared_ptr<gfx::Mesh> load(std::string const& path);
+
+	private:
+		/// @brief Source file properties stored in baked meshes, compared before falling back to the source hash.
+		struct SourceStamp
+		{
+			uint64_t	size			= 0;	// File size in bytes
+			int64_t		modifiedTime	= 0;	// Last write time in file clock ticks
+		};
+
+		/// @brief Read the size & modification time of a source file.
+		/// @param path
+		/// @param stamp
+		/// @return A boolean indicating success.
+		static bool readSourceStamp(std::string const& path, SourceStamp& stamp);
+
+		/// @brief Parse a glTF file into a single mesh.
+		/// @param path File path, used to resolve external buffers.
+		/// @param source Mapped source file contents.
+		/// @return A mesh pointer or nullptr on error.
+		static std::shared_ptr<gfx::Mesh> parseGLTF(std::string const& path, core::fs::MappedFile const& source);
+
+		/// @brief Load a baked mesh, verifying it was baked from the current source file.
+		/// The source file is only hashed if its modification time differs, a matching hash restamps the baked mesh.
+		/// @param bakedPath Baked mesh file path.
+		/// @param path Source file path.
+		/// @param stamp Source file size & modification time.
+		/// @return A mesh pointer or nullptr if the baked mesh is missing, invalid or out of date.
+		static std::shared_ptr<gfx::Mesh> loadBaked(std::string const& bakedPath, std::string const& path, SourceStamp const& stamp);
+
+		/// @brief Write a baked mesh.
+		/// @param mesh Mesh using the static vertex layout.
+		/// @param bakedPath Baked mesh file path.
+		/// @param stamp Source file size & modification time.
+		/// @param sourceHash Hash of the source file contents.
+		/// @return A boolean indicating success.
+		static bool bake(gfx::Mesh const& mesh, std::string const& bakedPath, SourceStamp const& stamp, uint64_t sourceHash);
 	};
 } // namespace assets
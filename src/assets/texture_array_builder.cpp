@@ -0,0 +1,111 @@
+#include "texture_array_builder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <spdlog/spdlog.h>
+#include <stb_image.h>
+
+namespace assets
+{
+	/// @brief Number of RGBA texel components stored per layer texel.
+	static constexpr uint32_t LAYER_COMPONENTS = 4;
+
+	TextureArrayBuilder::TextureArrayBuilder(uint32_t layerSize, gfx::TextureMode mode)
+		:
+		m_layerSize(layerSize),
+		m_mode(mode)
+	{
+		assert(layerSize > 0 && "Layer size cannot be 0");
+	}
+
+	uint32_t TextureArrayBuilder::addLayer(std::string const& path)
+	{
+		SPDLOG_INFO("Loading texture array layer {}", path);
+
+		// Layers are always loaded as RGBA, WebGPU does not support RGB textures
+		int w, h; // width, height
+		stbi_uc* pImageData = stbi_load(path.c_str(), &w, &h, nullptr, LAYER_COMPONENTS);
+		if (!pImageData || w <= 0 || h <= 0)
+		{
+			SPDLOG_ERROR("Failed to load texture array layer (does it exist?), using a placeholder layer");
+			if (pImageData) {
+				STBI_FREE(pImageData);
+			}
+
+			// Magenta & black checkerboard, 8x8 texel cells
+			std::vector<uint8_t> placeholder(m_layerSize * m_layerSize * LAYER_COMPONENTS);
+			for (uint32_t y = 0; y < m_layerSize; y++)
+			{
+				for (uint32_t x = 0; x < m_layerSize; x++)
+				{
+					uint8_t const value = (((x / 8) + (y / 8)) % 2 == 0) ? 255 : 0;
+					uint8_t* pTexel = placeholder.data() + (y * m_layerSize + x) * LAYER_COMPONENTS;
+					pTexel[0] = value;
+					pTexel[1] = 0;
+					pTexel[2] = value;
+					pTexel[3] = 255;
+				}
+			}
+
+			return addLayer(m_layerSize, m_layerSize, placeholder.data());
+		}
+
+		uint32_t const layer = addLayer(static_cast<uint32_t>(w), static_cast<uint32_t>(h), pImageData);
+		STBI_FREE(pImageData);
+		return layer;
+	}
+
+	uint32_t TextureArrayBuilder::addLayer(uint32_t width, uint32_t height, uint8_t const* pTexels)
+	{
+		assert(width > 0 && height > 0 && "Layer extent cannot be 0 in any direction");
+		assert(pTexels != nullptr && "Layer texels cannot be a nullptr");
+
+		size_t const layerTexelCount = static_cast<size_t>(m_layerSize) * m_layerSize;
+		size_t const layerOffset = static_cast<size_t>(m_layerCount) * layerTexelCount * LAYER_COMPONENTS;
+		m_texels.resize(layerOffset + layerTexelCount * LAYER_COMPONENTS);
+
+		// Resample with nearest texels, which keeps the hard edges of pixel art block textures
+		uint8_t* pLayer = m_texels.data() + layerOffset;
+		for (uint32_t y = 0; y < m_layerSize; y++)
+		{
+			size_t const sourceY = static_cast<size_t>(y) * height / m_layerSize;
+			for (uint32_t x = 0; x < m_layerSize; x++)
+			{
+				size_t const sourceX = static_cast<size_t>(x) * width / m_layerSize;
+				uint8_t const* pSource = pTexels + (sourceY * width + sourceX) * LAYER_COMPONENTS;
+				std::copy(pSource, pSource + LAYER_COMPONENTS, pLayer + (static_cast<size_t>(y) * m_layerSize + x) * LAYER_COMPONENTS);
+			}
+		}
+
+		return m_layerCount++;
+	}
+
+	std::shared_ptr<gfx::Texture> TextureArrayBuilder::build(gfx::BlockFormatSupport const& blockFormats) const
+	{
+		if (m_layerCount == 0)
+		{
+			SPDLOG_ERROR("Cannot build a texture array without layers");
+			return {};
+		}
+
+		gfx::TextureExtent const extent{ m_layerSize, m_layerSize, m_layerCount };
+		std::shared_ptr<gfx::Texture> texture = std::make_shared<gfx::Texture>(
+			gfx::TextureDimensions::Dim2DArray,
+			extent,
+			static_cast<uint8_t>(LAYER_COMPONENTS),
+			const_cast<uint8_t*>(m_texels.data()),
+			m_mode
+		);
+
+		// Mip levels are generated per layer, so layers never bleed into each other
+		texture->generateMipLevels();
+
+		gfx::BlockFormat const blockFormat = texture->selectBlockFormat(blockFormats);
+		if (blockFormat != gfx::BlockFormat::None) {
+			texture->compress(blockFormat);
+		}
+
+		SPDLOG_INFO("Built texture array ({}x{}, {} layers)", m_layerSize, m_layerSize, m_layerCount);
+		return texture;
+	}
+} // namespace assets
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rendering/texture.hpp"
+
+namespace assets
+{
+	/// @brief The TextureArrayBuilder class packs equally sized RGBA layers into a single 2D texture array.
+	/// Layers with a different size are resampled to the layer size, layer indices are assigned in insertion order.
+	class TextureArrayBuilder
+	{
+	public:
+		/// @brief Create a new texture array builder.
+		/// @param layerSize Width & height of every layer in texels.
+		/// @param mode Interpretation mode of all layers.
+		TextureArrayBuilder(uint32_t layerSize, gfx::TextureMode mode);
+
+		/// @brief Add a layer loaded from an image file on disk.
+		/// Files that fail to load are replaced by a checkerboard layer, so layer indices stay stable.
+		/// @param path File path to load the layer from.
+		/// @return The layer index.
+		uint32_t addLayer(std::string const& path);
+
+		/// @brief Add a layer from RGBA texel data.
+		/// @param width
+		/// @param height
+		/// @param pTexels Tightly packed RGBA texels, rows are stored top to bottom.
+		/// @return The layer index.
+		uint32_t addLayer(uint32_t width, uint32_t height, uint8_t const* pTexels);
+
+		/// @brief Build a 2D texture array of all added layers, generating a full mip chain per layer.
+		/// @param blockFormats Block formats supported by the device, the texture array is compressed to these formats.
+		/// @return A texture array, or an empty pointer if no layers were added.
+		std::shared_ptr<gfx::Texture> build(gfx::BlockFormatSupport const& blockFormats = {}) const;
+
+		/// @brief Get the number of layers added to the builder.
+		/// @return
+		uint32_t layerCount() const { return m_layerCount; }
+
+	private:
+		uint32_t				m_layerSize		= 0;
+		gfx::TextureMode		m_mode			= gfx::TextureMode::ColorData;
+		uint32_t				m_layerCount	= 0;
+		std::vector<uint8_t>	m_texels		= {};	// RGBA texels of all layers, stored contiguously
+	};
+} // namespace assets
@@ -14,16 +14,15 @@ namespace assets
 	{
 		SPDLOG_INFO("Loading texture file {}", path);
 
-		// Load texture file from disk
+		// Load texture file from disk, RGB files are expanded to RGBA while decoding because WebGPU does not support RGB
+		// textures. The header is parsed first so the image is only decoded once.
 		int w, h, c; // width, height, channels
-		stbi_uc* pImageData = stbi_load(path.c_str(), &w, &h, &c, 0);
-
-		// XXX(nemjit001): This is kinda gross, but we reload the texture with 4 channels forced because WebGPU does not support RGB textures
-		if (pImageData && c == 3)
+		stbi_uc* pImageData = nullptr;
+		if (stbi_info(path.c_str(), &w, &h, &c))
 		{
-			STBI_FREE(pImageData);		
-			pImageData = stbi_load(path.c_str(), &w, &h, nullptr, 4);
-			c = 4;
+			int const desiredChannels = (c == 3) ? 4 : 0;
+			pImageData = stbi_load(path.c_str(), &w, &h, nullptr, desiredChannels);
+			c = (desiredChannels != 0) ? desiredChannels : c;
 		}
 
 		if (!pImageData)
@@ -51,6 +50,9 @@ namespace assets
 		);
 
 		STBI_FREE(pImageData);
+
+		// Generate mip levels on the host, so they are uploaded along with the base level
+		texture->generateMipLevels();
 		SPDLOG_INFO("Loaded texture file!");
 		return texture;
 	}
@@ -11,9 +11,9 @@ namespace assets
 	class TextureLoader
 	{
 	public:
-		/// @brief Load a texture from disk.
+		/// @brief Load a texture from disk, generating a full mip chain.
 		/// @param path File path to load texture from.
-		/// @param mode Interpretation mode (color data indicates SRGB color space)
+		/// @param mode Interpretation mode (color data indicates SRGB color space, normal data is renormalized in mip levels)
 		/// @return 
 		std::shared_ptr<gfx::Texture> load(std::string const& path, gfx::TextureMode mode);
 	};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "world/chunk.hpp"
+
+/// @brief Chunk component that stores the block data for a chunk entity in the game world.
+class ChunkComponent
+{
+public:
+	glm::ivec3		coordinate	= { 0, 0, 0 };	// Chunk coordinate in chunk space
+	world::Chunk	chunk		= {};
+	bool			dirty		= true;			// Block data changed since the chunk was last meshed
+	bool			modified	= false;		// Block data changed since the chunk was loaded or generated, saved on eviction
+};
+
+/// @brief Tag component for chunk entities whose block data still has to be generated, these are not meshed yet.
+class ChunkGenerationTag {};
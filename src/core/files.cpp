@@ -7,6 +7,11 @@
 
 #if		GAME_PLATFORM_WINDOWS
 	#include <windows.h>
+#elif	!GAME_PLATFORM_EMSCRIPTEN
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
 #endif	// GAME_PLATFORM_WINDOWS
 
 namespace core::fs
@@ -51,4 +56,126 @@ namespace core::fs
 
 		return contents;
 	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(std::string const& path)
+	{
+		close();
+
+#if		GAME_PLATFORM_WINDOWS
+		HANDLE const file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		// Empty files cannot be mapped, but are valid to open
+		m_fileHandle = file;
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+		if (m_size > 0)
+		{
+			HANDLE const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void const* pView = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			if (pView == nullptr)
+			{
+				if (mapping != nullptr) {
+					CloseHandle(mapping);
+				}
+
+				CloseHandle(file);
+				m_fileHandle = nullptr;
+				m_size = 0;
+				return false;
+			}
+
+			m_mappingHandle = mapping;
+			m_pData = static_cast<uint8_t const*>(pView);
+		}
+#elif	GAME_PLATFORM_EMSCRIPTEN
+		// NOTE: The Emscripten file system lives in memory already, so reading the file is as cheap as it gets
+		if (!std::filesystem::exists(path)) {
+			return false;
+		}
+
+		m_contents = readBinaryFile(path);
+		m_size = m_contents.size();
+		m_pData = m_contents.empty() ? nullptr : m_contents.data();
+#else
+		int const file = ::open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+
+		struct stat fileStat{};
+		if (fstat(file, &fileStat) != 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		// Empty files cannot be mapped, but are valid to open
+		m_size = static_cast<size_t>(fileStat.st_size);
+		if (m_size > 0)
+		{
+			void* const pView = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, file, 0);
+			if (pView == MAP_FAILED)
+			{
+				::close(file);
+				m_size = 0;
+				return false;
+			}
+
+			m_pData = static_cast<uint8_t const*>(pView);
+		}
+
+		// The mapping keeps the file referenced, so the descriptor is not needed anymore
+		::close(file);
+#endif	// GAME_PLATFORM_WINDOWS
+
+		m_open = true;
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (!m_open) {
+			return;
+		}
+
+#if		GAME_PLATFORM_WINDOWS
+		if (m_pData != nullptr) {
+			UnmapViewOfFile(m_pData);
+		}
+
+		if (m_mappingHandle != nullptr) {
+			CloseHandle(m_mappingHandle);
+		}
+
+		if (m_fileHandle != nullptr) {
+			CloseHandle(m_fileHandle);
+		}
+#elif	GAME_PLATFORM_EMSCRIPTEN
+		m_contents = {};
+#else
+		if (m_pData != nullptr) {
+			munmap(const_cast<uint8_t*>(m_pData), m_size);
+		}
+#endif	// GAME_PLATFORM_WINDOWS
+
+		m_open = false;
+		m_pData = nullptr;
+		m_size = 0;
+		m_fileHandle = nullptr;
+		m_mappingHandle = nullptr;
+	}
 } // namespace core::fs
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -19,4 +20,44 @@ namespace core::fs
 	/// @param path File path.
 	/// @return The binary file contents or an empty vector on failure.
 	std::vector<uint8_t> readBinaryFile(std::string const& path);
+
+	/// @brief The MappedFile class maps a file into memory read-only, only the pages that are accessed are read from disk.
+	/// Platforms without memory mapping support read the entire file instead.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+
+		/// @brief Map a file, closing any previously mapped file.
+		/// @param path File path.
+		/// @return A boolean indicating success.
+		bool open(std::string const& path);
+
+		/// @brief Unmap the mapped file.
+		void close();
+
+		/// @brief Check if a file is mapped.
+		/// @return 
+		bool isOpen() const { return m_open; }
+
+		/// @brief Retrieve the mapped file contents.
+		/// @return A pointer to the file contents, nullptr for empty files.
+		uint8_t const* data() const { return m_pData; }
+
+		/// @brief Retrieve the mapped file size in bytes.
+		/// @return 
+		size_t size() const { return m_size; }
+
+	private:
+		bool					m_open			= false;
+		uint8_t const*			m_pData			= nullptr;
+		size_t					m_size			= 0;
+		void*					m_fileHandle	= nullptr;	// Platform file handle, unused on platforms without mapping support
+		void*					m_mappingHandle	= nullptr;	// Platform mapping handle, unused on platforms without mapping support
+		std::vector<uint8_t>	m_contents		= {};		// File contents on platforms without mapping support
+	};
 } // namespace core::fs
@@ -0,0 +1,55 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+
+#include "core/memory.hpp"
+
+namespace core
+{
+	FrameArena::FrameArena(size_t capacity)
+	{
+		for (auto& frame : m_frames)
+		{
+			frame.data = std::make_unique<uint8_t[]>(capacity);
+			frame.capacity = capacity;
+		}
+	}
+
+	void FrameArena::reset()
+	{
+		m_frameIndex = (m_frameIndex + 1) % FRAMES_IN_FLIGHT;
+		FrameBuffer& frame = m_frames[m_frameIndex];
+
+		// Grow the buffer if its last frame overflowed, the next frame of similar size then fits without heap allocations
+		if (!frame.overflow.empty())
+		{
+			frame.capacity = std::max(frame.capacity * 2, frame.used);
+			frame.data = std::make_unique<uint8_t[]>(frame.capacity);
+			frame.overflow.clear();
+		}
+
+		frame.offset = 0;
+		frame.used = 0;
+	}
+
+	void* FrameArena::allocate(size_t size, size_t alignment)
+	{
+		// Address alignment requires a multiple of 2, smaller alignments are rounded up
+		alignment = std::max(alignment, alignof(void*));
+
+		FrameBuffer& frame = m_frames[m_frameIndex];
+		uintptr_t const base = reinterpret_cast<uintptr_t>(frame.data.get());
+		size_t const offset = alignAddress(base + frame.offset, alignment) - base;
+		frame.used += size;
+		if (offset + size <= frame.capacity)
+		{
+			frame.offset = offset + size;
+			return frame.data.get() + offset;
+		}
+
+		// Over-allocate so the overflow allocation can be aligned
+		frame.overflow.push_back(std::make_unique<uint8_t[]>(size + alignment));
+		uintptr_t const overflowBase = reinterpret_cast<uintptr_t>(frame.overflow.back().get());
+		return reinterpret_cast<void*>(alignAddress(overflowBase, alignment));
+	}
+} // namespace core
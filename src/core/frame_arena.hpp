@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace core
+{
+	/// @brief The FrameArena class is a linear allocator for data that lives for at most FRAMES_IN_FLIGHT frames.
+	/// Allocations bump an offset into the current frame buffer and deallocation is a no-op, all allocations of a frame
+	/// are released at once when its buffer is reused. Allocations that do not fit fall back to the heap, the buffer is
+	/// grown to the frame high water mark once it is reset so steady state frames do not allocate.
+	class FrameArena
+	{
+	public:
+		static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+		static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+		/// @brief Create a new frame arena with the default frame buffer capacity.
+		FrameArena() : FrameArena(DEFAULT_CAPACITY) {}
+
+		/// @brief Create a new frame arena.
+		/// @param capacity Initial capacity of each frame buffer in bytes.
+		explicit FrameArena(size_t capacity);
+		~FrameArena() = default;
+
+		FrameArena(FrameArena const&) = delete;
+		FrameArena& operator=(FrameArena const&) = delete;
+
+		/// @brief Start a new frame, releasing the allocations made FRAMES_IN_FLIGHT frames ago.
+		void reset();
+
+		/// @brief Allocate memory that stays valid until the frame buffer is reused.
+		/// @param size Allocation size in bytes.
+		/// @param alignment Allocation alignment, must be a power of 2.
+		/// @return A pointer to the allocated memory.
+		void* allocate(size_t size, size_t alignment);
+
+		/// @brief Retrieve the number of bytes allocated in the current frame.
+		/// @return 
+		size_t used() const { return m_frames[m_frameIndex].used; }
+
+		/// @brief Retrieve the capacity of the current frame buffer in bytes.
+		/// @return 
+		size_t capacity() const { return m_frames[m_frameIndex].capacity; }
+
+		/// @brief Retrieve the number of allocations in the current frame that did not fit the frame buffer.
+		/// @return 
+		size_t overflowAllocations() const { return m_frames[m_frameIndex].overflow.size(); }
+
+	private:
+		/// @brief Backing memory of a single frame.
+		struct FrameBuffer
+		{
+			std::unique_ptr<uint8_t[]>				data		= {};
+			size_t									capacity	= 0;
+			size_t									offset		= 0;	// Bump offset into data
+			size_t									used		= 0;	// Bytes allocated this frame, including overflow
+			std::vector<std::unique_ptr<uint8_t[]>>	overflow	= {};	// Heap allocations that did not fit data
+		};
+
+		std::array<FrameBuffer, FRAMES_IN_FLIGHT>	m_frames		= {};
+		uint32_t									m_frameIndex	= 0;
+	};
+
+	/// @brief STL-compatible allocator adaptor allocating from a frame arena.
+	/// @tparam T Allocated value type.
+	template<typename T>
+	class FrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocator(FrameArena& arena) noexcept : m_pArena(&arena) {}
+
+		template<typename U>
+		FrameAllocator(FrameAllocator<U> const& other) noexcept : m_pArena(other.arena()) {}
+
+		/// @brief Allocate storage for a number of values.
+		/// @param count 
+		/// @return 
+		T* allocate(size_t count) { return static_cast<T*>(m_pArena->allocate(count * sizeof(T), alignof(T))); }
+
+		/// @brief Deallocation is a no-op, memory is released when the frame arena is reset.
+		void deallocate(T*, size_t) noexcept {}
+
+		/// @brief Retrieve the frame arena this allocator allocates from.
+		/// @return 
+		FrameArena* arena() const noexcept { return m_pArena; }
+
+	private:
+		FrameArena* m_pArena = nullptr;
+	};
+
+	template<typename T, typename U>
+	bool operator==(FrameAllocator<T> const& lhs, FrameAllocator<U> const& rhs) noexcept { return lhs.arena() == rhs.arena(); }
+
+	template<typename T, typename U>
+	bool operator!=(FrameAllocator<T> const& lhs, FrameAllocator<U> const& rhs) noexcept { return lhs.arena() != rhs.arena(); }
+
+	/// @brief Vector allocating from a frame arena.
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+} // namespace core
@@ -0,0 +1,216 @@
+#include "job_system.hpp"
+
+#include <cassert>
+#include <utility>
+
+#include "macros.hpp"
+
+namespace core
+{
+	// Job system & queue owned by the current thread, used to route submissions from worker threads to their own queue
+	static thread_local JobSystem const*	t_pOwnerSystem	= nullptr;
+	static thread_local size_t				t_queueIndex	= 0;
+
+	JobSystem::JobSystem(uint32_t workerCount)
+	{
+		m_queues.reserve(workerCount + 1);
+		for (uint32_t i = 0; i < workerCount + 1; i++) {
+			m_queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		m_running = true;
+		m_workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++) {
+			m_workers.emplace_back(&JobSystem::workerMain, this, i + 1);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// Signal workers to stop after the sleep lock is released, avoids a missed wakeup
+		{
+			std::lock_guard<std::mutex> guard(m_sleepLock);
+			m_running = false;
+		}
+		m_wakeCondition.notify_all();
+
+		for (auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	void JobSystem::run(JobFunction job, JobCounter* pCounter)
+	{
+		assert(job && "Job function cannot be empty");
+
+		if (pCounter) {
+			pCounter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		enqueue(Job{ std::move(job), pCounter });
+	}
+
+	void JobSystem::runAfter(JobCounter& dependency, JobFunction job, JobCounter* pCounter)
+	{
+		assert(job && "Job function cannot be empty");
+
+		if (pCounter) {
+			pCounter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		// Park the job on the dependency, unless it already completed
+		{
+			std::lock_guard<std::mutex> guard(dependency.m_lock);
+			if (!dependency.isDone())
+			{
+				dependency.m_continuations.push_back(JobCounter::Continuation{ std::move(job), pCounter });
+				return;
+			}
+		}
+
+		enqueue(Job{ std::move(job), pCounter });
+	}
+
+	void JobSystem::wait(JobCounter& counter)
+	{
+		while (!counter.isDone())
+		{
+			Job job{};
+			if (dequeue(job)) {
+				execute(job);
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+
+		// Synchronize with the thread that completed the counter, so the counter may be destroyed once this returns
+		std::lock_guard<std::mutex> guard(counter.m_lock);
+	}
+
+	size_t JobSystem::executePending(size_t maxJobs)
+	{
+		size_t executed = 0;
+		Job job{};
+		while (executed < maxJobs && dequeue(job))
+		{
+			execute(job);
+			executed++;
+		}
+
+		return executed;
+	}
+
+	uint32_t JobSystem::defaultWorkerCount()
+	{
+#if		GAME_PLATFORM_EMSCRIPTEN
+		return 0; // Game is built without pthread support, so jobs run on the main thread
+#else
+		uint32_t const hardwareThreads = std::thread::hardware_concurrency();
+		return (hardwareThreads > 1) ? hardwareThreads - 1 : 0; // Leave a core for the main thread
+#endif	// GAME_PLATFORM_EMSCRIPTEN
+	}
+
+	void JobSystem::enqueue(Job job)
+	{
+		WorkQueue& queue = *m_queues[localQueueIndex()];
+		{
+			std::lock_guard<std::mutex> guard(queue.lock);
+			queue.jobs.push_back(std::move(job));
+			m_queuedJobs.fetch_add(1, std::memory_order_release);
+		}
+
+		// Take the sleep lock before notifying so a worker checking the queued job count cannot miss this job
+		{
+			std::lock_guard<std::mutex> guard(m_sleepLock);
+		}
+		m_wakeCondition.notify_one();
+	}
+
+	bool JobSystem::dequeue(Job& job)
+	{
+		size_t const localIndex = localQueueIndex();
+
+		// Pop most recently pushed job from the local queue first, it is most likely to be in cache
+		{
+			WorkQueue& queue = *m_queues[localIndex];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+				m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		// Steal oldest job from another queue
+		for (size_t i = 1; i < m_queues.size(); i++)
+		{
+			WorkQueue& queue = *m_queues[(localIndex + i) % m_queues.size()];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+				m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::execute(Job& job)
+	{
+		job.function();
+
+		JobCounter* pCounter = job.pCounter;
+		if (pCounter == nullptr) {
+			return;
+		}
+
+		// Signal counter under its lock, once it reaches zero the jobs depending on it are scheduled
+		std::vector<JobCounter::Continuation> continuations{};
+		{
+			std::lock_guard<std::mutex> guard(pCounter->m_lock);
+			if (pCounter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				continuations.swap(pCounter->m_continuations);
+			}
+		}
+
+		for (auto& continuation : continuations) {
+			enqueue(Job{ std::move(continuation.job), continuation.pCounter });
+		}
+	}
+
+	size_t JobSystem::localQueueIndex() const
+	{
+		return (t_pOwnerSystem == this) ? t_queueIndex : 0;
+	}
+
+	void JobSystem::workerMain(size_t queueIndex)
+	{
+		t_pOwnerSystem = this;
+		t_queueIndex = queueIndex;
+
+		while (true)
+		{
+			Job job{};
+			if (dequeue(job))
+			{
+				execute(job);
+				continue;
+			}
+
+			// Sleep until new jobs are queued or the job system shuts down
+			std::unique_lock<std::mutex> lock(m_sleepLock);
+			m_wakeCondition.wait(lock, [this]() { return !m_running || m_queuedJobs.load(std::memory_order_acquire) > 0; });
+			if (!m_running) {
+				break;
+			}
+		}
+
+		t_pOwnerSystem = nullptr;
+	}
+} // namespace core
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+	class JobSystem;
+
+	/// @brief Job function executed by the job system.
+	using JobFunction = std::function<void()>;
+
+	/// @brief The JobCounter class tracks completion of a group of jobs, jobs can be scheduled to run once a counter reaches zero.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		~JobCounter() = default;
+
+		JobCounter(JobCounter const&) = delete;
+		JobCounter& operator=(JobCounter const&) = delete;
+
+		/// @brief Check if all jobs tracked by this counter have completed.
+		/// @return 
+		bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+		/// @brief Retrieve the number of jobs still pending for this counter.
+		/// @return 
+		uint32_t pending() const { return m_pending.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		/// @brief A job waiting on this counter, along with the counter it signals itself.
+		struct Continuation
+		{
+			JobFunction	job;
+			JobCounter*	pCounter;
+		};
+
+		std::atomic<uint32_t>		m_pending		= 0;
+		std::mutex					m_lock			= {};
+		std::vector<Continuation>	m_continuations	= {};
+	};
+
+	/// @brief The JobSystem class runs jobs on a pool of worker threads using per-worker work-stealing queues.
+	/// Workers pop their own queue in LIFO order and steal from other queues in FIFO order. Threads waiting on a counter
+	/// help execute queued jobs instead of blocking.
+	class JobSystem
+	{
+	public:
+		/// @brief Create a new job system.
+		/// @param workerCount Number of worker threads to spawn, 0 runs all jobs on threads that wait on them.
+		JobSystem(uint32_t workerCount = JobSystem::defaultWorkerCount());
+		~JobSystem();
+
+		JobSystem(JobSystem const&) = delete;
+		JobSystem& operator=(JobSystem const&) = delete;
+
+		/// @brief Schedule a job.
+		/// @param job Job function.
+		/// @param pCounter Optional counter incremented now and decremented once the job completes.
+		void run(JobFunction job, JobCounter* pCounter = nullptr);
+
+		/// @brief Schedule a job that starts once a dependency counter reaches zero.
+		/// @param dependency Counter to wait on.
+		/// @param job Job function.
+		/// @param pCounter Optional counter incremented now and decremented once the job completes.
+		void runAfter(JobCounter& dependency, JobFunction job, JobCounter* pCounter = nullptr);
+
+		/// @brief Wait for a counter to reach zero, executing queued jobs on the calling thread in the meantime.
+		/// @param counter 
+		void wait(JobCounter& counter);
+
+		/// @brief Execute queued jobs on the calling thread, used to make progress when no worker threads are available.
+		/// @param maxJobs Maximum number of jobs to execute.
+		/// @return The number of jobs executed.
+		size_t executePending(size_t maxJobs);
+
+		/// @brief Run a function for each index in [0, count) in parallel batches, returns once all indices have been processed.
+		/// @param count Number of indices.
+		/// @param batchSize Number of indices processed by a single job.
+		/// @param function Function called as function(index).
+		template<typename Function>
+		void parallelFor(size_t count, size_t batchSize, Function const& function);
+
+		/// @brief Retrieve the number of worker threads.
+		/// @return 
+		uint32_t workerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+		/// @brief Retrieve the default worker count for this platform, one less than the hardware concurrency.
+		/// @return 
+		static uint32_t defaultWorkerCount();
+
+	private:
+		/// @brief Queued job with its completion counter.
+		struct Job
+		{
+			JobFunction	function;
+			JobCounter*	pCounter;
+		};
+
+		/// @brief Lock protected job deque, owners push/pop at the back, thieves steal from the front.
+		struct WorkQueue
+		{
+			std::mutex		lock;
+			std::deque<Job>	jobs;
+		};
+
+		/// @brief Push a job to the queue owned by the calling thread and wake a worker.
+		/// @param job 
+		void enqueue(Job job);
+
+		/// @brief Pop a job from the calling thread's queue, or steal one from another queue.
+		/// @param job Job popped from a queue.
+		/// @return A boolean indicating a job was found.
+		bool dequeue(Job& job);
+
+		/// @brief Execute a job and signal its counter, scheduling any continuations.
+		/// @param job 
+		void execute(Job& job);
+
+		/// @brief Retrieve the queue index owned by the calling thread, external threads share queue 0.
+		/// @return 
+		size_t localQueueIndex() const;
+
+		/// @brief Worker thread entry point.
+		/// @param queueIndex Queue owned by this worker.
+		void workerMain(size_t queueIndex);
+
+	private:
+		std::vector<std::unique_ptr<WorkQueue>>	m_queues		= {};	// Queue 0 is shared by external threads
+		std::vector<std::thread>				m_workers		= {};
+		std::atomic<size_t>						m_queuedJobs	= 0;
+		std::atomic<bool>						m_running		= false;
+		std::mutex								m_sleepLock		= {};
+		std::condition_variable					m_wakeCondition	= {};
+	};
+
+	template<typename Function>
+	void JobSystem::parallelFor(size_t count, size_t batchSize, Function const& function)
+	{
+		batchSize = std::max<size_t>(batchSize, 1);
+
+		JobCounter counter{};
+		for (size_t begin = 0; begin < count; begin += batchSize)
+		{
+			size_t const end = std::min(begin + batchSize, count);
+			run([begin, end, &function]() {
+				for (size_t i = begin; i < end; i++) {
+					function(i);
+				}
+			}, &counter);
+		}
+
+		wait(counter);
+	}
+} // namespace core
@@ -0,0 +1,41 @@
+#include "memory.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if     GAME_TRACK_ALLOCATIONS
+static std::atomic<size_t> s_heapAllocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	s_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pMemory = std::malloc(size > 0 ? size : 1)) {
+		return pMemory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+#endif  // GAME_TRACK_ALLOCATIONS
+
+namespace core
+{
+	size_t heapAllocationCount()
+	{
+#if     GAME_TRACK_ALLOCATIONS
+		return s_heapAllocationCount.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif  // GAME_TRACK_ALLOCATIONS
+	}
+} // namespace core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 
 namespace core
 {
@@ -13,4 +14,9 @@ namespace core
 		assert(alignment % 2 == 0 && "Alignment of memory address must be multiple of 2");
 		return (address + (alignment - 1)) & ~(alignment - 1);
 	}
+
+	/// @brief Retrieve the number of global operator new calls made by this process.
+	/// Allocations are only counted in builds with GAME_TRACK_ALLOCATIONS enabled, otherwise this always returns 0.
+	/// @return 
+	size_t heapAllocationCount();
 } // namespace core
@@ -0,0 +1,120 @@
+#include "range_allocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace core
+{
+	RangeAllocator::RangeAllocator(uint64_t capacity)
+		:
+		m_capacity(capacity)
+	{
+		if (capacity > 0) {
+			insertFreeRange(0, capacity);
+		}
+	}
+
+	uint64_t RangeAllocator::allocate(uint64_t size)
+	{
+		assert(size > 0 && "Range size must be non-zero");
+
+		// Best fit: the smallest free range of at least the requested size, ties are broken by the lowest offset
+		auto const fit = m_freeBySize.lower_bound({ size, 0 });
+		if (fit == m_freeBySize.end()) {
+			return INVALID_OFFSET;
+		}
+
+		uint64_t const offset = fit->second;
+		uint64_t const freeSize = fit->first;
+		eraseFreeRange(m_freeByOffset.find(offset));
+		if (freeSize > size) {
+			insertFreeRange(offset + size, freeSize - size);
+		}
+
+		m_allocations.emplace(offset, size);
+		m_used += size;
+		return offset;
+	}
+
+	void RangeAllocator::free(uint64_t offset)
+	{
+		auto const allocation = m_allocations.find(offset);
+		assert(allocation != m_allocations.end() && "Range was not allocated by this allocator");
+
+		uint64_t begin = offset;
+		uint64_t end = offset + allocation->second;
+		m_used -= allocation->second;
+		m_allocations.erase(allocation);
+
+		// Merge with the free ranges directly before and after the released range
+		auto next = m_freeByOffset.lower_bound(begin);
+		if (next != m_freeByOffset.begin())
+		{
+			auto const prev = std::prev(next);
+			if (prev->first + prev->second == begin)
+			{
+				begin = prev->first;
+				eraseFreeRange(prev);
+			}
+		}
+
+		if (next != m_freeByOffset.end() && next->first == end)
+		{
+			end += next->second;
+			eraseFreeRange(next);
+		}
+
+		insertFreeRange(begin, end - begin);
+	}
+
+	void RangeAllocator::compact(uint64_t capacity, std::vector<RangeMove>& moves)
+	{
+		assert(capacity >= m_used && "Compacted capacity cannot hold all live ranges");
+
+		moves.clear();
+		moves.reserve(m_allocations.size());
+		for (auto const& [offset, size] : m_allocations) {
+			moves.push_back(RangeMove{ offset, 0, size });
+		}
+
+		std::sort(moves.begin(), moves.end(), [](RangeMove const& a, RangeMove const& b) { return a.from < b.from; });
+
+		m_allocations.clear();
+		uint64_t offset = 0;
+		for (auto& move : moves)
+		{
+			move.to = offset;
+			m_allocations.emplace(offset, move.size);
+			offset += move.size;
+		}
+
+		m_capacity = capacity;
+		m_freeByOffset.clear();
+		m_freeBySize.clear();
+		if (m_capacity > offset) {
+			insertFreeRange(offset, m_capacity - offset);
+		}
+	}
+
+	float RangeAllocator::fragmentation() const
+	{
+		uint64_t const freeSpace = m_capacity - m_used;
+		if (freeSpace == 0) {
+			return 0.0F;
+		}
+
+		return 1.0F - static_cast<float>(static_cast<double>(largestFreeRange()) / static_cast<double>(freeSpace));
+	}
+
+	void RangeAllocator::insertFreeRange(uint64_t offset, uint64_t size)
+	{
+		m_freeByOffset.emplace(offset, size);
+		m_freeBySize.emplace(size, offset);
+	}
+
+	void RangeAllocator::eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it)
+	{
+		m_freeBySize.erase({ it->second, it->first });
+		m_freeByOffset.erase(it);
+	}
+} // namespace core
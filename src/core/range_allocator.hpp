@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+	/// @brief Relocation of a live range by compaction.
+	struct RangeMove
+	{
+		uint64_t	from	= 0;
+		uint64_t	to		= 0;
+		uint64_t	size	= 0;
+	};
+
+	/// @brief The RangeAllocator class sub-allocates ranges from a linear address space using a best-fit free list.
+	/// Released ranges are coalesced with adjacent free ranges. The allocator only tracks offsets, so it can manage memory
+	/// it has no access to, such as device buffers. Fragmented space is reclaimed by compacting all live ranges, the
+	/// owner of the memory is responsible for moving range contents and updating offsets.
+	class RangeAllocator
+	{
+	public:
+		static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+		/// @brief Create a new range allocator.
+		/// @param capacity Size of the address space in allocation units.
+		explicit RangeAllocator(uint64_t capacity);
+		~RangeAllocator() = default;
+
+		/// @brief Allocate a range from the smallest free range that fits it.
+		/// @param size Range size in allocation units, must be non-zero.
+		/// @return The range offset, or INVALID_OFFSET if no free range is large enough.
+		uint64_t allocate(uint64_t size);
+
+		/// @brief Release a range, merging it with adjacent free ranges.
+		/// @param offset Offset of a range returned by allocate.
+		void free(uint64_t offset);
+
+		/// @brief Move all live ranges to the start of the address space in offset order, leaving a single free range.
+		/// Ranges never move towards higher offsets, so contents can be moved in place in the returned order.
+		/// @param capacity New address space size, must be at least the number of used units.
+		/// @param moves Receives the relocations of all live ranges in offset order, including ranges that stayed in place.
+		void compact(uint64_t capacity, std::vector<RangeMove>& moves);
+
+		/// @brief Retrieve the size of the address space in allocation units.
+		/// @return 
+		uint64_t capacity() const { return m_capacity; }
+
+		/// @brief Retrieve the number of allocated units.
+		/// @return 
+		uint64_t used() const { return m_used; }
+
+		/// @brief Retrieve the number of live ranges.
+		/// @return 
+		size_t allocationCount() const { return m_allocations.size(); }
+
+		/// @brief Retrieve the number of free ranges.
+		/// @return 
+		size_t freeRangeCount() const { return m_freeByOffset.size(); }
+
+		/// @brief Retrieve the size of the largest free range.
+		/// @return 
+		uint64_t largestFreeRange() const { return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first; }
+
+		/// @brief Retrieve the fraction of free space outside of the largest free range, in range [0, 1].
+		/// @return 
+		float fragmentation() const;
+
+	private:
+		/// @brief Insert a free range into both free lists.
+		/// @param offset 
+		/// @param size 
+		void insertFreeRange(uint64_t offset, uint64_t size);
+
+		/// @brief Remove a free range from both free lists.
+		/// @param it Iterator into the offset ordered free list.
+		void eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it);
+
+	private:
+		uint64_t								m_capacity		= 0;
+		uint64_t								m_used			= 0;
+		std::map<uint64_t, uint64_t>			m_freeByOffset	= {};	// Free range offset to size, used for coalescing
+		std::set<std::pair<uint64_t, uint64_t>>	m_freeBySize	= {};	// Free range size & offset, used for best-fit search
+		std::unordered_map<uint64_t, uint64_t>	m_allocations	= {};	// Live range offset to size
+	};
+} // namespace core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace core
+{
+	/// @brief Non-owning view of a contiguous sequence of values, a minimal stand-in for C++20 std::span.
+	/// @tparam T Viewed value type, const qualified for read-only views.
+	template<typename T>
+	class Span
+	{
+	public:
+		using value_type = std::remove_cv_t<T>;
+
+		Span() = default;
+
+		/// @brief Create a view of a contiguous sequence.
+		/// @param pData 
+		/// @param count Number of values in the sequence.
+		Span(T* pData, size_t count) : m_pData(pData), m_count(count) {}
+
+		/// @brief Create a view of a vector's contents, the view is invalidated when the vector reallocates.
+		/// @param values 
+		template<typename U, typename Allocator, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+		Span(std::vector<U, Allocator>& values) : m_pData(values.data()), m_count(values.size()) {}
+
+		/// @brief Create a read-only view of a vector's contents, the view is invalidated when the vector reallocates.
+		/// @param values 
+		template<typename U, typename Allocator, typename = std::enable_if_t<std::is_convertible_v<U const(*)[], T(*)[]>>>
+		Span(std::vector<U, Allocator> const& values) : m_pData(values.data()), m_count(values.size()) {}
+
+		T* data() const { return m_pData; }
+		size_t size() const { return m_count; }
+		size_t sizeBytes() const { return m_count * sizeof(T); }
+		bool empty() const { return m_count == 0; }
+
+		T* begin() const { return m_pData; }
+		T* end() const { return m_pData + m_count; }
+
+		T& operator[](size_t index) const
+		{
+			assert(index < m_count && "Span index out of range");
+			return m_pData[index];
+		}
+
+	private:
+		T*		m_pData	= nullptr;
+		size_t	m_count	= 0;
+	};
+} // namespace core
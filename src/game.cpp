@@ -1,12 +1,15 @@
 #include "game.hpp"
 
 #include <cassert>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 #include "macros.hpp"
 #include "core/files.hpp"
+#include "assets/asset_manager.hpp"
 #include "assets/mesh_loader.hpp"
-#include "assets/texture_loader.hpp"
+#include "assets/texture_array_builder.hpp"
+#include "world/block.hpp"
 #include "components/camera.hpp"
 #include "components/render_component.hpp"
 #include "components/transform.hpp"
@@ -14,6 +17,15 @@
 static constexpr char const*    WINDOW_TITLE            = "Voxel Game";
 static constexpr uint32_t       DEFAULT_WINDOW_WIDTH    = 1280;
 static constexpr uint32_t       DEFAULT_WINDOW_HEIGHT   = 720;
+static constexpr uint32_t       WORLD_SEED              = 1337;
+static constexpr char const*    SAVE_DIRECTORY          = "saves/world";
+static constexpr uint32_t       BLOCK_TEXTURE_SIZE      = 16;
+#if     GAME_STRESS_SCENE
+static constexpr uint32_t       STRESS_SCENE_ENTITY_COUNT   = 50'000;
+static constexpr uint32_t       STRESS_SCENE_GRID_WIDTH     = 250;
+static constexpr float          STRESS_SCENE_SPACING        = 3.0F;
+static constexpr double         STRESS_SCENE_LOG_INTERVAL   = 1000.0;   // Renderer stats log interval in milliseconds
+#endif  // GAME_STRESS_SCENE
 
 static void windowResizeCallback(GLFWwindow* pWindow, int width, int height)
 {
@@ -80,6 +92,11 @@ Game::Game()
     glfwSetKeyCallback(m_pWindow, keyCallback);
     glfwSetCursorPosCallback(m_pWindow, mousePosCallback);
 
+    // Initialize job system
+    SPDLOG_INFO("Initializing job system");
+    m_jobSystem = std::make_shared<core::JobSystem>();
+    SPDLOG_INFO("Job system running {} worker threads", m_jobSystem->workerCount());
+
     // Initialize render backend
     SPDLOG_INFO("Initializing render backend");
     m_renderbackend = std::make_shared<gfx::RenderBackend>(m_pWindow);
@@ -87,12 +104,17 @@ Game::Game()
     // Initialize game systems
     SPDLOG_INFO("Initializing game systems");
     m_registry = std::make_unique<entt::registry>();
-    m_renderer = std::make_unique<Renderer>(m_renderbackend);
+    m_world = std::make_unique<world::World>(*m_registry);
+    m_regionStorage = std::make_shared<world::RegionStorage>(core::fs::getProgramDirectory() + "/" + SAVE_DIRECTORY);
+    m_chunkStreamingSystem = std::make_unique<ChunkStreamingSystem>(m_regionStorage);
+    m_chunkGenerationSystem = std::make_unique<ChunkGenerationSystem>(m_jobSystem, WORLD_SEED, m_regionStorage);
+    m_renderer = std::make_unique<Renderer>(m_renderbackend, *m_registry);
+    m_assetManager = std::make_unique<assets::AssetManager>(m_renderer->blockFormatSupport());
 
     // Set up simple game world with basic meshes / camera for now
     {
         // Set up a simple camera position w/ lookat to world origin
-        auto cameraTransform = Transform{ { 0.0F, 2.0F, 5.0F } };
+        auto cameraTransform = Transform{ { 0.0F, 64.0F, 96.0F } };
         cameraTransform.lookAt(glm::normalize(Transform::WORLD_ORIGIN - cameraTransform.position));
 
         // Create camera entity
@@ -100,11 +122,11 @@ Game::Game()
         m_registry->emplace<Camera>(camera, PerspectiveCamera{ 60.0F, 0.1F, 1000.0F });
         m_registry->emplace<Transform>(camera, cameraTransform);
 
-        // Set up 2 entities with render components using a mesh file loaded from disk
-        auto suzanneMesh = assets::MeshLoader().load(core::fs::getFullAssetPath("assets/suzanne.glb"));
+        // Set up 2 entities with render components using a mesh file loaded from disk, repeated loads share cached assets
+        auto suzanneMesh = m_assetManager->loadMesh(core::fs::getFullAssetPath("assets/suzanne.glb"));
         auto suzanneMaterial = std::make_shared<gfx::Material>();
-        suzanneMaterial->albedoTexture = assets::TextureLoader().load(core::fs::getFullAssetPath("assets/brickwall.jpg"), gfx::TextureMode::ColorData);
-        suzanneMaterial->normalTexture = assets::TextureLoader().load(core::fs::getFullAssetPath("assets/brickwall_normal.jpg"), gfx::TextureMode::NonColorData);
+        suzanneMaterial->albedoTexture = m_assetManager->loadTexture(core::fs::getFullAssetPath("assets/brickwall.jpg"), gfx::TextureMode::ColorData);
+        suzanneMaterial->normalTexture = m_assetManager->loadTexture(core::fs::getFullAssetPath("assets/brickwall_normal.jpg"), gfx::TextureMode::NormalData);
 
         auto suzanne1 = m_registry->create();
         m_registry->emplace<RenderComponent>(suzanne1, RenderComponent{ suzanneMesh, suzanneMaterial });
@@ -113,6 +135,68 @@ Game::Game()
         auto suzanne2 = m_registry->create();
         m_registry->emplace<RenderComponent>(suzanne2, RenderComponent{ suzanneMesh, suzanneMaterial });
         m_registry->emplace<Transform>(suzanne2, Transform{ { -2.0F, 0.0F, 0.0F } });
+
+#if     GAME_STRESS_SCENE
+        // Spawn a grid of entities sharing a mesh & material, these are drawn using a single instanced draw
+        SPDLOG_INFO("Spawning {} stress scene entities", STRESS_SCENE_ENTITY_COUNT);
+        for (uint32_t i = 0; i < STRESS_SCENE_ENTITY_COUNT; i++)
+        {
+            float const x = (static_cast<float>(i % STRESS_SCENE_GRID_WIDTH) - 0.5F * STRESS_SCENE_GRID_WIDTH) * STRESS_SCENE_SPACING;
+            float const z = (static_cast<float>(i / STRESS_SCENE_GRID_WIDTH) - 0.5F * STRESS_SCENE_GRID_WIDTH) * STRESS_SCENE_SPACING;
+
+            auto entity = m_registry->create();
+            m_registry->emplace<RenderComponent>(entity, RenderComponent{ suzanneMesh, suzanneMaterial });
+            m_registry->emplace<Transform>(entity, Transform{ { x, 48.0F, z } });
+        }
+#endif  // GAME_STRESS_SCENE
+
+        // Pack block textures into a single texture array sampled by all chunk meshes, layers map 1:1 to block ids.
+        // There are no block texture assets yet, so tiles are generated from a base color per block with texel noise
+        auto voxelMaterial = std::make_shared<gfx::Material>();
+        {
+            glm::u8vec3 const blockColors[] = {
+                { 255, 255, 255 },  // Air, never meshed
+                { 125, 125, 125 },  // Stone
+                { 134,  96,  67 },  // Dirt
+                {  95, 159,  53 },  // Grass
+                { 219, 207, 163 },  // Sand
+                { 240, 251, 251 },  // Snow
+                {  63, 118, 228 },  // Water
+            };
+
+            assets::TextureArrayBuilder blockTextureBuilder(BLOCK_TEXTURE_SIZE, gfx::TextureMode::ColorData);
+            std::vector<uint8_t> tile(BLOCK_TEXTURE_SIZE * BLOCK_TEXTURE_SIZE * 4);
+            uint32_t state = WORLD_SEED;
+            for (world::BlockID block = 0; block < std::size(blockColors); block++)
+            {
+                for (size_t texel = 0; texel < BLOCK_TEXTURE_SIZE * BLOCK_TEXTURE_SIZE; texel++)
+                {
+                    state = state * 1664525U + 1013904223U;
+                    float const shade = 0.85F + 0.15F * static_cast<float>(state >> 24) / 255.0F;
+                    glm::vec3 const color = glm::vec3(blockColors[block]) * shade;
+                    tile[texel * 4 + 0] = static_cast<uint8_t>(color.r);
+                    tile[texel * 4 + 1] = static_cast<uint8_t>(color.g);
+                    tile[texel * 4 + 2] = static_cast<uint8_t>(color.b);
+                    tile[texel * 4 + 3] = 255;
+                }
+
+                uint32_t const layer = blockTextureBuilder.addLayer(BLOCK_TEXTURE_SIZE, BLOCK_TEXTURE_SIZE, tile.data());
+                assert(layer == world::blockTextureLayer(block) && "Block texture layers must match block texture layer ids");
+                (void)(layer);
+            }
+
+            // Chunk meshes get a material of their own, without texture maps as voxel shading samples the block texture
+            // array bound with the scene data instead
+            m_renderer->setBlockTextures(blockTextureBuilder.build(m_renderer->blockFormatSupport()));
+            voxelMaterial->albedoColor = glm::vec3(1.0F, 1.0F, 1.0F);
+        }
+
+        // Chunks are streamed in around the camera, then generated and meshed in the background
+        m_chunkMeshSystem = std::make_unique<ChunkMeshSystem>(m_jobSystem, voxelMaterial);
+
+        assets::AssetStats const assetStats = m_assetManager->stats();
+        SPDLOG_INFO("Loaded {} meshes & {} textures ({} cache hits), {} bytes mesh data, {} bytes texture data",
+            assetStats.meshes, assetStats.textures, assetStats.hits, assetStats.meshHostBytes, assetStats.textureHostBytes);
     }
 
     // We are initialized!
@@ -125,6 +209,11 @@ Game::~Game()
 {
     SPDLOG_INFO("Shutting down game...");
 
+    // Persist chunks that were modified but not evicted yet, systems are missing if initialization failed
+    if (m_chunkStreamingSystem) {
+        m_chunkStreamingSystem->saveModifiedChunks(*m_registry);
+    }
+
     // Destroy platform window
     glfwDestroyWindow(m_pWindow);
     glfwTerminate();
@@ -139,11 +228,26 @@ void Game::update()
     glfwPollEvents();
 
     // Handle system updates
-    //
+    m_chunkStreamingSystem->update(*m_registry, *m_world);
+    m_chunkGenerationSystem->update(*m_registry, *m_world);
+    m_chunkMeshSystem->update(*m_registry, *m_world);
 
     // Render grame frame if not minimized
-    if (m_windowVisible) {
+    if (m_windowVisible)
+    {
         m_renderer->render(*m_registry);
+
+#if     GAME_STRESS_SCENE
+        // Logging every frame would dominate the frame time, so only log stats of a single frame per interval
+        m_statsLogTime += m_frameTimer.delta();
+        if (m_statsLogTime >= STRESS_SCENE_LOG_INTERVAL)
+        {
+            RendererStats const& stats = m_renderer->stats();
+            SPDLOG_INFO("Frame {:.3f} ms: {} draw calls ({} encoded) for {} visible objects, encoded in {:.3f} ms ({} heap allocations)",
+                m_frameTimer.delta(), stats.drawCalls, stats.encodedDraws, stats.visibleObjects, stats.encodeTime, stats.heapAllocations);
+            m_statsLogTime = 0.0;
+        }
+#endif  // GAME_STRESS_SCENE
     }
 }
 
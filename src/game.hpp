@@ -4,9 +4,16 @@
 #include <entt/entt.hpp>
 #include <GLFW/glfw3.h>
 
+#include "assets/asset_manager.hpp"
+#include "core/job_system.hpp"
 #include "core/timer.hpp"
 #include "rendering/render_backend.hpp"
+#include "systems/chunk_generation_system.hpp"
+#include "systems/chunk_mesh_system.hpp"
+#include "systems/chunk_streaming_system.hpp"
 #include "systems/renderer.hpp"
+#include "world/region_storage.hpp"
+#include "world/world.hpp"
 
 /// @brief The Game class binds all different game systems together into a cohesive whole.
 class Game
@@ -31,11 +38,21 @@ public:
     void onResize(uint32_t width, uint32_t height);
 
 private:
-    bool                                m_running       = false;
-    bool                                m_windowVisible = true;
-    GLFWwindow*                         m_pWindow       = nullptr;
-    core::Timer                         m_frameTimer    = {};
-    std::shared_ptr<gfx::RenderBackend> m_renderbackend = {};
-    std::unique_ptr<entt::registry>     m_registry      = {};
-    std::unique_ptr<Renderer>           m_renderer      = {};
+    bool                                   m_running               = false;
+    bool                                   m_windowVisible         = true;
+    GLFWwindow*                            m_pWindow               = nullptr;
+    core::Timer                            m_frameTimer            = {};
+    std::shared_ptr<core::JobSystem>       m_jobSystem             = {};
+    std::shared_ptr<gfx::RenderBackend>    m_renderbackend         = {};
+    std::unique_ptr<assets::AssetManager>  m_assetManager          = {};
+    std::unique_ptr<entt::registry>        m_registry              = {};
+    std::unique_ptr<world::World>          m_world                 = {};
+    std::shared_ptr<world::RegionStorage>  m_regionStorage         = {};
+    std::unique_ptr<ChunkStreamingSystem>  m_chunkStreamingSystem  = {};
+    std::unique_ptr<ChunkGenerationSystem> m_chunkGenerationSystem = {};
+    std::unique_ptr<ChunkMeshSystem>       m_chunkMeshSystem       = {};
+    std::unique_ptr<Renderer>              m_renderer              = {};
+#if     GAME_STRESS_SCENE
+    double                                 m_statsLogTime          = 0.0;  // Time since renderer stats were last logged in milliseconds
+#endif  // GAME_STRESS_SCENE
 };
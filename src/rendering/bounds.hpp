@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace gfx
+{
+	/// @brief Axis aligned bounding box.
+	struct AABB
+	{
+		glm::vec3 min = { 0.0F, 0.0F, 0.0F };
+		glm::vec3 max = { 0.0F, 0.0F, 0.0F };
+
+		/// @brief Retrieve the center of this bounding box.
+		/// @return 
+		glm::vec3 center() const { return (min + max) * 0.5F; }
+
+		/// @brief Retrieve the half size of this bounding box along each axis.
+		/// @return 
+		glm::vec3 extent() const { return (max - min) * 0.5F; }
+
+		/// @brief Calculate the bounding box enclosing this bounding box after an affine transformation.
+		/// @param transform Affine transformation matrix.
+		/// @return 
+		AABB transform(glm::mat4 const& transform) const
+		{
+			// Each transformed extent axis is the sum of the absolute matrix columns scaled by the local extents
+			glm::vec3 const center = glm::vec3(transform * glm::vec4(this->center(), 1.0F));
+			glm::vec3 const extent = this->extent();
+			glm::vec3 const worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x
+				+ glm::abs(glm::vec3(transform[1])) * extent.y
+				+ glm::abs(glm::vec3(transform[2])) * extent.z;
+
+			return AABB{ center - worldExtent, center + worldExtent };
+		}
+	};
+} // namespace gfx
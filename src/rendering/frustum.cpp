@@ -0,0 +1,177 @@
+#include "frustum.hpp"
+
+#include <cmath>
+
+#if		defined(__AVX2__)
+#define FRUSTUM_HAS_AVX2	1
+#else
+#define FRUSTUM_HAS_AVX2	0
+#endif	// defined(__AVX2__)
+
+#if		defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_HAS_SSE2	1
+#else
+#define FRUSTUM_HAS_SSE2	0
+#endif	// defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#if		FRUSTUM_HAS_AVX2
+#include <immintrin.h>
+#elif	FRUSTUM_HAS_SSE2
+#include <emmintrin.h>
+#endif	// FRUSTUM_HAS_AVX2
+
+namespace gfx
+{
+	/// @brief Test a single bounding box against all frustum planes.
+	/// @param frustum 
+	/// @param center 
+	/// @param extent 
+	/// @return A boolean indicating the box intersects the frustum.
+	static bool testBox(Frustum const& frustum, glm::vec3 const& center, glm::vec3 const& extent)
+	{
+		for (auto const& plane : frustum.planes)
+		{
+			// Signed distance of the box corner furthest along the plane normal
+			float const distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w
+				+ std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y + std::fabs(plane.z) * extent.z;
+
+			if (distance < 0.0F) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	Frustum Frustum::fromMatrix(glm::mat4 const& viewproject)
+	{
+		// Planes are combinations of the matrix rows, glm matrices are column major
+		glm::vec4 const row0 = { viewproject[0][0], viewproject[1][0], viewproject[2][0], viewproject[3][0] };
+		glm::vec4 const row1 = { viewproject[0][1], viewproject[1][1], viewproject[2][1], viewproject[3][1] };
+		glm::vec4 const row2 = { viewproject[0][2], viewproject[1][2], viewproject[2][2], viewproject[3][2] };
+		glm::vec4 const row3 = { viewproject[0][3], viewproject[1][3], viewproject[2][3], viewproject[3][3] };
+
+		Frustum frustum{};
+		frustum.planes[0] = row3 + row0;	// Left
+		frustum.planes[1] = row3 - row0;	// Right
+		frustum.planes[2] = row3 + row1;	// Bottom
+		frustum.planes[3] = row3 - row1;	// Top
+		frustum.planes[4] = row2;			// Near
+		frustum.planes[5] = row3 - row2;	// Far
+
+		for (auto& plane : frustum.planes) {
+			plane = plane / glm::length(glm::vec3(plane));
+		}
+
+		return frustum;
+	}
+
+	bool Frustum::intersects(AABB const& bounds) const
+	{
+		return testBox(*this, bounds.center(), bounds.extent());
+	}
+
+	void BoundingBoxList::clear()
+	{
+		m_centerX.clear();
+		m_centerY.clear();
+		m_centerZ.clear();
+		m_extentX.clear();
+		m_extentY.clear();
+		m_extentZ.clear();
+	}
+
+	void BoundingBoxList::append(AABB const& bounds)
+	{
+		glm::vec3 const center = bounds.center();
+		glm::vec3 const extent = bounds.extent();
+		m_centerX.push_back(center.x);
+		m_centerY.push_back(center.y);
+		m_centerZ.push_back(center.z);
+		m_extentX.push_back(extent.x);
+		m_extentY.push_back(extent.y);
+		m_extentZ.push_back(extent.z);
+	}
+
+	size_t BoundingBoxList::cull(Frustum const& frustum, std::vector<uint8_t>& visible) const
+	{
+		size_t const count = size();
+		visible.resize(count);
+
+		size_t i = 0;
+		size_t visibleCount = 0;
+#if		FRUSTUM_HAS_AVX2
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 const centerX = _mm256_loadu_ps(m_centerX.data() + i);
+			__m256 const centerY = _mm256_loadu_ps(m_centerY.data() + i);
+			__m256 const centerZ = _mm256_loadu_ps(m_centerZ.data() + i);
+			__m256 const extentX = _mm256_loadu_ps(m_extentX.data() + i);
+			__m256 const extentY = _mm256_loadu_ps(m_extentY.data() + i);
+			__m256 const extentZ = _mm256_loadu_ps(m_extentZ.data() + i);
+
+			// Lanes stay set while every plane has the box on its inner side
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (auto const& plane : frustum.planes)
+			{
+				__m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), centerX), _mm256_set1_ps(plane.w));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.y), centerY));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.z), centerZ));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.x)), extentX));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.y)), extentY));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.z)), extentZ));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+
+			int const mask = _mm256_movemask_ps(inside);
+			for (size_t lane = 0; lane < 8; lane++)
+			{
+				visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+				visibleCount += visible[i + lane];
+			}
+		}
+#endif	// FRUSTUM_HAS_AVX2
+
+#if		FRUSTUM_HAS_SSE2 || FRUSTUM_HAS_AVX2
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 const centerX = _mm_loadu_ps(m_centerX.data() + i);
+			__m128 const centerY = _mm_loadu_ps(m_centerY.data() + i);
+			__m128 const centerZ = _mm_loadu_ps(m_centerZ.data() + i);
+			__m128 const extentX = _mm_loadu_ps(m_extentX.data() + i);
+			__m128 const extentY = _mm_loadu_ps(m_extentY.data() + i);
+			__m128 const extentZ = _mm_loadu_ps(m_extentZ.data() + i);
+
+			// Lanes stay set while every plane has the box on its inner side
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (auto const& plane : frustum.planes)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), centerX), _mm_set1_ps(plane.w));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), centerY));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), centerZ));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), extentX));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), extentY));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), extentZ));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+			}
+
+			int const mask = _mm_movemask_ps(inside);
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+				visibleCount += visible[i + lane];
+			}
+		}
+#endif	// FRUSTUM_HAS_SSE2 || FRUSTUM_HAS_AVX2
+
+		for (; i < count; i++)
+		{
+			glm::vec3 const center = { m_centerX[i], m_centerY[i], m_centerZ[i] };
+			glm::vec3 const extent = { m_extentX[i], m_extentY[i], m_extentZ[i] };
+			visible[i] = testBox(frustum, center, extent) ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+} // namespace gfx
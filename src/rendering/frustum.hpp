@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "bounds.hpp"
+
+namespace gfx
+{
+	/// @brief Frustum planes facing inwards, a point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0.
+	struct Frustum
+	{
+		static constexpr size_t PLANE_COUNT = 6;
+
+		glm::vec4 planes[PLANE_COUNT];
+
+		/// @brief Extract the frustum planes from a view projection matrix with a [0, 1] clip space depth range.
+		/// @param viewproject View projection matrix.
+		/// @return 
+		static Frustum fromMatrix(glm::mat4 const& viewproject);
+
+		/// @brief Test a single bounding box against the frustum planes.
+		/// @param bounds 
+		/// @return A boolean indicating the box intersects the frustum.
+		bool intersects(AABB const& bounds) const;
+	};
+
+	/// @brief Bounding boxes stored as separate center and extent component arrays, so they can be culled several at a time.
+	class BoundingBoxList
+	{
+	public:
+		/// @brief Remove all bounding boxes, keeping allocated memory.
+		void clear();
+
+		/// @brief Append a bounding box.
+		/// @param bounds 
+		void append(AABB const& bounds);
+
+		/// @brief Retrieve the number of bounding boxes.
+		/// @return 
+		size_t size() const { return m_centerX.size(); }
+
+		/// @brief Test the bounding boxes against a frustum, 8 (AVX2 builds) or 4 (SSE2 builds) boxes at a time.
+		/// @param frustum 
+		/// @param visible Output visibility per bounding box, 1 for boxes intersecting the frustum and 0 otherwise.
+		/// @return The number of visible bounding boxes.
+		size_t cull(Frustum const& frustum, std::vector<uint8_t>& visible) const;
+
+	private:
+		std::vector<float> m_centerX	= {};
+		std::vector<float> m_centerY	= {};
+		std::vector<float> m_centerZ	= {};
+		std::vector<float> m_extentX	= {};
+		std::vector<float> m_extentY	= {};
+		std::vector<float> m_extentZ	= {};
+	};
+} // namespace gfx
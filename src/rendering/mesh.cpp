@@ -1,60 +1,115 @@
 #include "mesh.hpp"
 
 #include <cassert>
+#include <limits>
+#include <utility>
 
 namespace gfx
 {
-	Mesh::Mesh(std::vector<Vertex> const& vertices, std::vector<IndexType> const& indices)
+	Mesh::Mesh(std::vector<Vertex> vertices, std::vector<IndexType> indices)
 		:
-		m_vertices(vertices),
-		m_indices(indices)
+		m_vertices(std::move(vertices)),
+		m_indices(std::move(indices))
 	{
-		//
+		updateBounds();
 	}
 
-	Mesh::~Mesh()
+	Mesh::Mesh(std::vector<VoxelVertex> vertices, std::vector<IndexType> indices)
+		:
+		m_vertexLayout(VertexLayout::Voxel),
+		m_voxelVertices(std::move(vertices)),
+		m_indices(std::move(indices))
 	{
-		if (m_vertexBuffer) {
-			wgpuBufferRelease(m_vertexBuffer);
-		}
+		updateBounds();
+	}
 
-		if (m_indexBuffer) {
-			wgpuBufferRelease(m_indexBuffer);
-		}
+	Mesh::~Mesh() = default;
+
+	void Mesh::setBuffers(std::vector<Vertex> vertices, std::vector<IndexType> indices)
+	{
+		m_dirty = true;
+		m_vertexLayout = VertexLayout::Static;
+		m_vertices = std::move(vertices);
+		m_voxelVertices = {};
+		m_indices = std::move(indices);
+		updateBounds();
 	}
 
-	void Mesh::setBuffers(std::vector<Vertex> const& vertices, std::vector<IndexType> const& indices)
+	void Mesh::setBuffers(std::vector<VoxelVertex> vertices, std::vector<IndexType> indices)
 	{
 		m_dirty = true;
-		m_vertices = vertices;
-		m_indices = indices;
+		m_vertexLayout = VertexLayout::Voxel;
+		m_vertices = {};
+		m_voxelVertices = std::move(vertices);
+		m_indices = std::move(indices);
+		updateBounds();
 	}
 
-	void Mesh::getBuffers(std::vector<Vertex>& vertices, std::vector<IndexType>& indices)
+	core::Span<Vertex const> Mesh::vertices() const
 	{
-		vertices = m_vertices;
-		indices = m_indices;
+		assert(m_vertexLayout == VertexLayout::Static && "Mesh does not use the static vertex layout");
+		return m_vertices;
 	}
 
-	void Mesh::setVertexBuffer(WGPUBuffer buffer)
+	core::Span<VoxelVertex const> Mesh::voxelVertices() const
 	{
-		assert(buffer != nullptr && "Buffer handle cannot be a nullptr");
+		assert(m_vertexLayout == VertexLayout::Voxel && "Mesh does not use the voxel vertex layout");
+		return m_voxelVertices;
+	}
 
-		if (m_vertexBuffer) {
-			wgpuBufferRelease(m_vertexBuffer);
-		}
+	core::Span<uint8_t const> Mesh::vertexBytes() const
+	{
+		void const* pData = (m_vertexLayout == VertexLayout::Voxel) ? static_cast<void const*>(m_voxelVertices.data()) : m_vertices.data();
+		return core::Span<uint8_t const>(static_cast<uint8_t const*>(pData), vertexCount() * vertexStride());
+	}
 
-		m_vertexBuffer = buffer;
+	void Mesh::releaseDeviceAllocation()
+	{
+		m_deviceAllocation.reset();
+		m_dirty = true;
+	}
+
+	size_t Mesh::hostMemoryUsage() const
+	{
+		return m_vertices.capacity() * sizeof(Vertex)
+			+ m_voxelVertices.capacity() * sizeof(VoxelVertex)
+			+ m_indices.capacity() * sizeof(IndexType);
 	}
 
-	void Mesh::setIndexBuffer(WGPUBuffer buffer)
+	size_t Mesh::deviceMemoryUsage() const
 	{
-		assert(buffer != nullptr && "Buffer handle cannot be a nullptr");
+		return m_deviceAllocation ? m_deviceAllocation->sizeBytes() : 0;
+	}
+
+	void Mesh::updateBounds()
+	{
+		if (vertexCount() == 0)
+		{
+			m_bounds = AABB{};
+			return;
+		}
+
+		glm::vec3 min(std::numeric_limits<float>::max());
+		glm::vec3 max(std::numeric_limits<float>::lowest());
+		for (auto const& vertex : m_vertices)
+		{
+			min = glm::min(min, vertex.position);
+			max = glm::max(max, vertex.position);
+		}
+
+		// Voxel positions are chunk-local block corners packed into 6 bits per axis
+		for (auto const& vertex : m_voxelVertices)
+		{
+			glm::vec3 const position(
+				static_cast<float>(vertex.positionFace & 63U),
+				static_cast<float>((vertex.positionFace >> 6) & 63U),
+				static_cast<float>((vertex.positionFace >> 12) & 63U)
+			);
 
-		if (m_indexBuffer) {
-			wgpuBufferRelease(m_indexBuffer);
+			min = glm::min(min, position);
+			max = glm::max(max, position);
 		}
 
-		m_indexBuffer = buffer;
+		m_bounds = AABB{ min, max };
 	}
 } // namespace gfx
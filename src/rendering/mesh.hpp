@@ -1,16 +1,20 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
-#include <webgpu/webgpu.h>
 
+#include "core/span.hpp"
+#include "bounds.hpp"
+#include "mesh_pool.hpp"
 #include "vertex_layout.hpp"
 
 namespace gfx
 {
 	using IndexType = uint32_t;
 
-	/// @brief The Mesh class stores host-side and device-side mesh data.
+	/// @brief The Mesh class stores host-side mesh data along with its device-side allocation in the mesh pool.
+	/// Host-side buffers are taken by value, so callers can move their buffers in without copying them.
 	class Mesh
 	{
 	public:
@@ -20,7 +24,12 @@ namespace gfx
 		/// @brief Create a new Mesh.
 		/// @param vertices 
 		/// @param indices 
-		Mesh(std::vector<Vertex> const& vertices, std::vector<IndexType> const& indices);
+		Mesh(std::vector<Vertex> vertices, std::vector<IndexType> indices);
+
+		/// @brief Create a new Mesh using the packed voxel vertex layout.
+		/// @param vertices 
+		/// @param indices 
+		Mesh(std::vector<VoxelVertex> vertices, std::vector<IndexType> indices);
 
 		/// @brief Destructor.
 		~Mesh();
@@ -31,12 +40,26 @@ namespace gfx
 		/// @brief Set the host-side vertex and index buffers for this mesh.
 		/// @param vertices Buffer containing vertex data.
 		/// @param indices Buffer containing indices for mesh triangles.
-		void setBuffers(std::vector<Vertex> const& vertices, std::vector<IndexType> const& indices);
+		void setBuffers(std::vector<Vertex> vertices, std::vector<IndexType> indices);
 
-		/// @brief Retrieve the stored host-side mesh buffers.
-		/// @param vertices Buffer containing vertex data.
+		/// @brief Set the host-side vertex and index buffers for this mesh, switching to the packed voxel vertex layout.
+		/// @param vertices Buffer containing packed voxel vertex data.
 		/// @param indices Buffer containing indices for mesh triangles.
-		void getBuffers(std::vector<Vertex>& vertices, std::vector<IndexType>& indices);
+		void setBuffers(std::vector<VoxelVertex> vertices, std::vector<IndexType> indices);
+
+		/// @brief Retrieve a view of the host-side vertices, the mesh must use the static vertex layout.
+		/// Views are invalidated when the host-side buffers are set.
+		/// @return 
+		core::Span<Vertex const> vertices() const;
+
+		/// @brief Retrieve a view of the host-side vertices, the mesh must use the packed voxel vertex layout.
+		/// Views are invalidated when the host-side buffers are set.
+		/// @return 
+		core::Span<VoxelVertex const> voxelVertices() const;
+
+		/// @brief Retrieve a view of the host-side indices.
+		/// @return 
+		core::Span<IndexType const> indices() const { return m_indices; }
 
 		/// @brief Check if this mesh is dirty, i.e. its host-side buffers have been updated.
 		/// @return 
@@ -45,35 +68,61 @@ namespace gfx
 		/// @brief Clear the mesh dirty flag to indicate host and device buffers are in sync.
 		void clearDirtyFlag() { m_dirty = false; }
 
+		/// @brief Retrieve the vertex layout used by this mesh.
+		/// @return 
+		VertexLayout vertexLayout() const { return m_vertexLayout; }
+
+		/// @brief Retrieve the size of a single vertex in bytes.
+		/// @return 
+		size_t vertexStride() const { return (m_vertexLayout == VertexLayout::Voxel) ? sizeof(VoxelVertex) : sizeof(Vertex); }
+
+		/// @brief Retrieve a view of the host-side vertex data as raw bytes, vertexCount() * vertexStride() in size.
+		/// @return 
+		core::Span<uint8_t const> vertexBytes() const;
+
 		/// @brief Retrieve the number of vertices of this mesh.
 		/// @return 
-		size_t vertexCount() const { return m_vertices.size(); }
+		size_t vertexCount() const { return (m_vertexLayout == VertexLayout::Voxel) ? m_voxelVertices.size() : m_vertices.size(); }
 
 		/// @brief Retrieve the number of indices of this mesh.
 		/// @return 
 		size_t indexCount() const { return m_indices.size(); }
 
-		/// @brief Set the device-side vertex buffer for this mesh. Takes ownership of this buffer.
-		/// @param buffer 
-		void setVertexBuffer(WGPUBuffer buffer);
+		/// @brief Retrieve the local-space bounding box of this mesh, updated when its host-side buffers are set.
+		/// @return 
+		AABB const& bounds() const { return m_bounds; }
+
+		/// @brief Set the mesh pool allocation holding the device-side data of this mesh, releasing the previous allocation.
+		/// The allocation must contain the current host-side data, it is kept until the next allocation is set.
+		/// @param allocation 
+		void setDeviceAllocation(std::unique_ptr<MeshAllocation> allocation) { m_deviceAllocation = std::move(allocation); }
+
+		/// @brief Retrieve the mesh pool allocation holding the device-side data, which may lag behind dirty host-side data.
+		/// @return The allocation, or nullptr if the mesh has not been uploaded.
+		MeshAllocation const* deviceAllocation() const { return m_deviceAllocation.get(); }
 
-		/// @brief Set the device-side index buffer for this mesh. Takes ownership of this buffer.
-		/// @param buffer 
-		void setIndexBuffer(WGPUBuffer buffer);
+		/// @brief Release the device-side data of this mesh, marking it dirty so it is uploaded again if the mesh is drawn again.
+		void releaseDeviceAllocation();
 
-		/// @brief Get the device-side vertex buffer for this mesh.
+		/// @brief Retrieve the host memory used by the mesh buffers in bytes.
 		/// @return 
-		WGPUBuffer getVertexBuffer() const { return m_vertexBuffer; }
+		size_t hostMemoryUsage() const;
 
-		/// @brief Get the device-side index buffer for this mesh.
+		/// @brief Retrieve the device memory allocated to the mesh in the mesh pool in bytes.
 		/// @return 
-		WGPUBuffer getIndexBuffer() const { return m_indexBuffer; }
+		size_t deviceMemoryUsage() const;
+
+	private:
+		/// @brief Recalculate the local-space bounding box from the host-side vertex data.
+		void updateBounds();
 
 	private:
-		bool					m_dirty			= true;
-		std::vector<Vertex>		m_vertices		= {};
-		std::vector<IndexType>	m_indices		= {};
-		WGPUBuffer				m_vertexBuffer	= nullptr;
-		WGPUBuffer				m_indexBuffer	= nullptr;
+		bool							m_dirty				= true;
+		VertexLayout					m_vertexLayout		= VertexLayout::Static;
+		std::vector<Vertex>				m_vertices			= {};
+		std::vector<VoxelVertex>		m_voxelVertices		= {};	// Only used with the voxel vertex layout
+		std::vector<IndexType>			m_indices			= {};
+		std::unique_ptr<MeshAllocation>	m_deviceAllocation	= {};
+		AABB							m_bounds			= {};
 	};
 } // namespace gfx
@@ -0,0 +1,218 @@
+#include "mesh_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+#include "mesh.hpp"
+#include "upload_manager.hpp"
+
+namespace gfx
+{
+	MeshAllocation::MeshAllocation(std::shared_ptr<MeshPool> pool, uint32_t handle)
+		:
+		m_pool(std::move(pool)),
+		m_handle(handle)
+	{
+		assert(m_pool != nullptr && "Mesh allocation requires a valid pool");
+	}
+
+	MeshAllocation::~MeshAllocation()
+	{
+		m_pool->release(m_handle);
+	}
+
+	MeshRange const& MeshAllocation::range() const
+	{
+		return m_pool->range(m_handle);
+	}
+
+	size_t MeshAllocation::sizeBytes() const
+	{
+		MeshRange const& range = m_pool->range(m_handle);
+		uint64_t const vertexSize = (range.layout == VertexLayout::Voxel) ? m_pool->m_voxelVertices.elementSize : m_pool->m_staticVertices.elementSize;
+		return static_cast<size_t>(range.vertexCount * vertexSize + range.indexCount * m_pool->m_indices.elementSize);
+	}
+
+	MeshPool::Heap::Heap(char const* label, WGPUBufferUsageFlags usage, uint64_t elementSize, uint64_t capacity)
+		:
+		label(label),
+		usage(usage | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc),
+		elementSize(elementSize),
+		allocator(capacity)
+	{
+		//
+	}
+
+	MeshPool::MeshPool(WGPUDevice device)
+		:
+		m_device(device),
+		m_staticVertices("Mesh Pool Static Vertices", WGPUBufferUsage_Vertex, sizeof(Vertex), STATIC_VERTEX_CAPACITY),
+		m_voxelVertices("Mesh Pool Voxel Vertices", WGPUBufferUsage_Vertex, sizeof(VoxelVertex), VOXEL_VERTEX_CAPACITY),
+		m_indices("Mesh Pool Indices", WGPUBufferUsage_Index, sizeof(IndexType), INDEX_CAPACITY)
+	{
+		assert(m_device != nullptr && "Mesh pool requires a valid device");
+
+		for (Heap* pHeap : { &m_staticVertices, &m_voxelVertices, &m_indices }) {
+			pHeap->buffer = createBuffer(*pHeap, pHeap->allocator.capacity());
+		}
+	}
+
+	MeshPool::~MeshPool()
+	{
+		for (Heap* pHeap : { &m_staticVertices, &m_voxelVertices, &m_indices })
+		{
+			if (pHeap->buffer) wgpuBufferRelease(pHeap->buffer);
+		}
+	}
+
+	std::unique_ptr<MeshAllocation> MeshPool::upload(UploadManager& uploadManager, Mesh const& mesh)
+	{
+		if (mesh.vertexCount() == 0 || mesh.indexCount() == 0) {
+			return nullptr;
+		}
+
+		// Allocate ranges before uploading, compaction copies have to be recorded before new data is written
+		Heap& vertexHeap = (mesh.vertexLayout() == VertexLayout::Voxel) ? m_voxelVertices : m_staticVertices;
+		uint64_t const vertexOffset = allocate(vertexHeap, uploadManager, mesh.vertexCount());
+		uint64_t const indexOffset = allocate(m_indices, uploadManager, mesh.indexCount());
+
+		core::Span<uint8_t const> const vertexBytes = mesh.vertexBytes();
+		core::Span<IndexType const> const indices = mesh.indices();
+		uploadManager.uploadBuffer(vertexHeap.buffer, vertexOffset * vertexHeap.elementSize, vertexBytes.data(), vertexBytes.sizeBytes());
+		uploadManager.uploadBuffer(m_indices.buffer, indexOffset * m_indices.elementSize, indices.data(), indices.sizeBytes());
+
+		uint32_t handle = static_cast<uint32_t>(m_ranges.size());
+		if (!m_freeHandles.empty())
+		{
+			handle = m_freeHandles.back();
+			m_freeHandles.pop_back();
+		}
+		else
+		{
+			m_ranges.emplace_back();
+		}
+
+		m_ranges[handle] = MeshRange{
+			mesh.vertexLayout(),
+			static_cast<uint32_t>(vertexOffset),
+			static_cast<uint32_t>(mesh.vertexCount()),
+			static_cast<uint32_t>(indexOffset),
+			static_cast<uint32_t>(mesh.indexCount()),
+		};
+
+		return std::make_unique<MeshAllocation>(shared_from_this(), handle);
+	}
+
+	MeshPoolStats MeshPool::stats() const
+	{
+		MeshPoolStats stats{};
+		stats.allocations = m_ranges.size() - m_freeHandles.size();
+		stats.compactions = m_compactions;
+		for (Heap const* pHeap : { &m_staticVertices, &m_voxelVertices, &m_indices })
+		{
+			stats.usedBytes += static_cast<size_t>(pHeap->allocator.used() * pHeap->elementSize);
+			stats.capacityBytes += static_cast<size_t>(pHeap->allocator.capacity() * pHeap->elementSize);
+			stats.fragmentation = std::max(stats.fragmentation, pHeap->allocator.fragmentation());
+		}
+
+		return stats;
+	}
+
+	uint64_t MeshPool::allocate(Heap& heap, UploadManager& uploadManager, uint64_t count)
+	{
+		uint64_t offset = heap.allocator.allocate(count);
+		if (offset != core::RangeAllocator::INVALID_OFFSET) {
+			return offset;
+		}
+
+		// Grow geometrically until a quarter of the buffer stays free, so compactions do not repeat every few uploads
+		uint64_t const required = heap.allocator.used() + count;
+		uint64_t capacity = heap.allocator.capacity();
+		while (required > capacity / 4 * 3) {
+			capacity *= 2;
+		}
+
+		compact(heap, uploadManager, capacity);
+		offset = heap.allocator.allocate(count);
+		assert(offset != core::RangeAllocator::INVALID_OFFSET && "Compacted heap cannot fit allocation");
+		return offset;
+	}
+
+	void MeshPool::compact(Heap& heap, UploadManager& uploadManager, uint64_t capacity)
+	{
+		// Buffers cannot be copied onto themselves, so live ranges are always moved into a new buffer
+		WGPUBuffer const buffer = createBuffer(heap, capacity);
+		heap.allocator.compact(capacity, m_moves);
+
+		// Ranges adjacent in the old buffer stay adjacent, so each run of them is moved with a single copy
+		size_t runBegin = 0;
+		for (size_t i = 1; i <= m_moves.size(); i++)
+		{
+			core::RangeMove const& prev = m_moves[i - 1];
+			if (i < m_moves.size() && m_moves[i].from == prev.from + prev.size) {
+				continue;
+			}
+
+			uint64_t const runSize = prev.from + prev.size - m_moves[runBegin].from;
+			uploadManager.copyBuffer(heap.buffer, m_moves[runBegin].from * heap.elementSize, buffer, m_moves[runBegin].to * heap.elementSize,
+				static_cast<size_t>(runSize * heap.elementSize));
+			runBegin = i;
+		}
+
+		auto const remap = [this](uint32_t offset) {
+			auto const it = std::lower_bound(m_moves.begin(), m_moves.end(), offset,
+				[](core::RangeMove const& move, uint64_t from) { return move.from < from; });
+			assert(it != m_moves.end() && it->from == offset && "Mesh range is not allocated in heap");
+			return static_cast<uint32_t>(it->to);
+		};
+
+		for (auto& range : m_ranges)
+		{
+			// Free handles have empty ranges
+			if (range.indexCount == 0) {
+				continue;
+			}
+
+			Heap const& vertexHeap = (range.layout == VertexLayout::Voxel) ? m_voxelVertices : m_staticVertices;
+			if (&heap == &m_indices) {
+				range.indexOffset = remap(range.indexOffset);
+			}
+			else if (&heap == &vertexHeap) {
+				range.vertexOffset = remap(range.vertexOffset);
+			}
+		}
+
+		// Recorded copies keep the old buffer alive until they have executed
+		wgpuBufferRelease(heap.buffer);
+		heap.buffer = buffer;
+		m_compactions++;
+
+		SPDLOG_DEBUG("Compacted {} ({} ranges, {} used bytes, {} capacity bytes)",
+			heap.label, m_moves.size(), heap.allocator.used() * heap.elementSize, capacity * heap.elementSize);
+	}
+
+	WGPUBuffer MeshPool::createBuffer(Heap const& heap, uint64_t capacity) const
+	{
+		WGPUBufferDescriptor bufferDesc{};
+		bufferDesc.nextInChain = nullptr;
+		bufferDesc.label = heap.label;
+		bufferDesc.usage = heap.usage;
+		bufferDesc.size = capacity * heap.elementSize;
+		bufferDesc.mappedAtCreation = false;
+
+		return wgpuDeviceCreateBuffer(m_device, &bufferDesc);
+	}
+
+	void MeshPool::release(uint32_t handle)
+	{
+		MeshRange const& range = m_ranges[handle];
+		Heap& vertexHeap = (range.layout == VertexLayout::Voxel) ? m_voxelVertices : m_staticVertices;
+		vertexHeap.allocator.free(range.vertexOffset);
+		m_indices.allocator.free(range.indexOffset);
+
+		m_ranges[handle] = MeshRange{};
+		m_freeHandles.push_back(handle);
+	}
+} // namespace gfx
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <webgpu/webgpu.h>
+
+#include "core/range_allocator.hpp"
+#include "vertex_layout.hpp"
+
+namespace gfx
+{
+	class Mesh;
+	class MeshPool;
+	class UploadManager;
+
+	/// @brief Device ranges of a mesh in the mesh pool, offsets & counts are in vertices and indices.
+	struct MeshRange
+	{
+		VertexLayout	layout			= VertexLayout::Static;
+		uint32_t		vertexOffset	= 0;	// Base vertex added to all mesh indices
+		uint32_t		vertexCount		= 0;
+		uint32_t		indexOffset		= 0;	// First index in the shared index buffer
+		uint32_t		indexCount		= 0;
+	};
+
+	/// @brief Mesh pool counters.
+	struct MeshPoolStats
+	{
+		size_t	allocations		= 0;	// Live mesh allocations
+		size_t	usedBytes		= 0;	// Bytes allocated to meshes across all pool buffers
+		size_t	capacityBytes	= 0;	// Total size of all pool buffers
+		float	fragmentation	= 0.0F;	// Highest free space fragmentation of all pool buffers
+		size_t	compactions		= 0;	// Pool buffer compactions since creation
+	};
+
+	/// @brief Handle to the device ranges of a mesh, the ranges are released back to the pool when the handle is destroyed.
+	/// Range offsets may change when the pool is compacted, so they should be read through the handle when drawing.
+	class MeshAllocation
+	{
+	public:
+		/// @brief Create a new mesh allocation handle.
+		/// @param pool Pool owning the ranges, kept alive until the handle is destroyed.
+		/// @param handle Index of the ranges in the pool.
+		MeshAllocation(std::shared_ptr<MeshPool> pool, uint32_t handle);
+		~MeshAllocation();
+
+		MeshAllocation(MeshAllocation const&) = delete;
+		MeshAllocation& operator=(MeshAllocation const&) = delete;
+
+		/// @brief Retrieve the current device ranges of the mesh.
+		/// @return 
+		MeshRange const& range() const;
+
+		/// @brief Retrieve the number of pool bytes allocated to the mesh.
+		/// @return 
+		size_t sizeBytes() const;
+
+	private:
+		std::shared_ptr<MeshPool>	m_pool		= {};
+		uint32_t					m_handle	= 0;
+	};
+
+	/// @brief The MeshPool class sub-allocates mesh vertex and index ranges from a few large device buffers.
+	/// Each vertex layout has its own vertex buffer, so ranges are addressed in whole vertices and draws select them with
+	/// a base vertex, all layouts share one index buffer. When a buffer has no free range large enough for an upload, its
+	/// live ranges are compacted into a new buffer, which is grown to keep a quarter of it free after compaction.
+	class MeshPool : public std::enable_shared_from_this<MeshPool>
+	{
+	public:
+		static constexpr uint64_t STATIC_VERTEX_CAPACITY = 64 * 1024;
+		static constexpr uint64_t VOXEL_VERTEX_CAPACITY = 1024 * 1024;
+		static constexpr uint64_t INDEX_CAPACITY = 2 * 1024 * 1024;
+
+		/// @brief Create a new mesh pool, pools must be owned by a shared pointer as allocations keep them alive.
+		/// @param device Device used to create pool buffers.
+		explicit MeshPool(WGPUDevice device);
+		~MeshPool();
+
+		MeshPool(MeshPool const&) = delete;
+		MeshPool& operator=(MeshPool const&) = delete;
+
+		/// @brief Allocate device ranges for the host-side data of a mesh and upload it.
+		/// Compaction copies are recorded through the upload manager, ordered before the uploaded mesh data.
+		/// @param uploadManager Upload manager recording the uploads of the current frame.
+		/// @param mesh Mesh whose host-side data is uploaded.
+		/// @return The mesh allocation, or nullptr if the mesh has no vertices or indices.
+		std::unique_ptr<MeshAllocation> upload(UploadManager& uploadManager, Mesh const& mesh);
+
+		/// @brief Retrieve the device ranges of an allocation handle.
+		/// @param handle 
+		/// @return 
+		MeshRange const& range(uint32_t handle) const { return m_ranges[handle]; }
+
+		/// @brief Retrieve the vertex buffer holding meshes of a vertex layout.
+		/// @param layout 
+		/// @return 
+		WGPUBuffer vertexBuffer(VertexLayout layout) const { return (layout == VertexLayout::Voxel) ? m_voxelVertices.buffer : m_staticVertices.buffer; }
+
+		/// @brief Retrieve the index buffer shared by all meshes.
+		/// @return 
+		WGPUBuffer indexBuffer() const { return m_indices.buffer; }
+
+		/// @brief Retrieve the current pool counters.
+		/// @return 
+		MeshPoolStats stats() const;
+
+	private:
+		friend class MeshAllocation;
+
+		/// @brief Device buffer along with the allocator tracking its ranges, in elements of a fixed size.
+		struct Heap
+		{
+			char const*				label		= nullptr;
+			WGPUBufferUsageFlags	usage		= WGPUBufferUsage_None;
+			uint64_t				elementSize	= 0;
+			core::RangeAllocator	allocator;
+			WGPUBuffer				buffer		= nullptr;
+
+			Heap(char const* label, WGPUBufferUsageFlags usage, uint64_t elementSize, uint64_t capacity);
+		};
+
+		/// @brief Allocate a range from a heap, compacting the heap if no free range is large enough.
+		/// @param heap 
+		/// @param uploadManager 
+		/// @param count Range size in elements.
+		/// @return The range offset in elements.
+		uint64_t allocate(Heap& heap, UploadManager& uploadManager, uint64_t count);
+
+		/// @brief Move all live ranges of a heap into a new device buffer, updating the ranges referencing them.
+		/// @param heap 
+		/// @param uploadManager 
+		/// @param capacity Capacity of the new device buffer in elements.
+		void compact(Heap& heap, UploadManager& uploadManager, uint64_t capacity);
+
+		/// @brief Create the device buffer of a heap.
+		/// @param heap 
+		/// @param capacity Buffer capacity in elements.
+		/// @return 
+		WGPUBuffer createBuffer(Heap const& heap, uint64_t capacity) const;
+
+		/// @brief Release the ranges of an allocation handle.
+		/// @param handle 
+		void release(uint32_t handle);
+
+	private:
+		WGPUDevice						m_device			= nullptr;
+		Heap							m_staticVertices;
+		Heap							m_voxelVertices;
+		Heap							m_indices;
+		std::vector<MeshRange>			m_ranges			= {};	// Indexed by allocation handle, empty if the handle is free
+		std::vector<uint32_t>			m_freeHandles		= {};
+		std::vector<core::RangeMove>	m_moves				= {};	// Compaction scratch buffer
+		size_t							m_compactions		= 0;
+	};
+} // namespace gfx
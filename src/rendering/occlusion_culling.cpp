@@ -0,0 +1,150 @@
+#include "occlusion_culling.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace gfx
+{
+	glm::uvec2 HiZPyramid::baseSize(glm::uvec2 depthSize)
+	{
+		return glm::max((depthSize + 1U) / 2U, glm::uvec2(1, 1));
+	}
+
+	uint32_t HiZPyramid::levelCount(glm::uvec2 depthSize)
+	{
+		glm::uvec2 size = baseSize(depthSize);
+		uint32_t levels = 1;
+		while (size.x > 1 || size.y > 1)
+		{
+			size = glm::max((size + 1U) / 2U, glm::uvec2(1, 1));
+			levels++;
+		}
+
+		return levels;
+	}
+
+	void HiZPyramid::build(glm::uvec2 depthSize, float const* pDepth)
+	{
+		assert(pDepth != nullptr && "Depth data cannot be a nullptr");
+
+		m_depthSize = depthSize;
+		m_sizes.resize(levelCount(depthSize));
+		m_levels.resize(m_sizes.size());
+
+		// Every level stores the farthest of the 2x2 values below it, edge values are repeated for odd source sizes
+		glm::uvec2 sourceSize = depthSize;
+		float const* pSource = pDepth;
+		for (size_t level = 0; level < m_levels.size(); level++)
+		{
+			glm::uvec2 const size = baseSize(sourceSize);
+			std::vector<float>& texels = m_levels[level];
+			texels.resize(size.x * size.y);
+			for (uint32_t y = 0; y < size.y; y++)
+			{
+				uint32_t const y0 = std::min(y * 2, sourceSize.y - 1);
+				uint32_t const y1 = std::min(y * 2 + 1, sourceSize.y - 1);
+				for (uint32_t x = 0; x < size.x; x++)
+				{
+					uint32_t const x0 = std::min(x * 2, sourceSize.x - 1);
+					uint32_t const x1 = std::min(x * 2 + 1, sourceSize.x - 1);
+					texels[y * size.x + x] = std::max(
+						std::max(pSource[y0 * sourceSize.x + x0], pSource[y0 * sourceSize.x + x1]),
+						std::max(pSource[y1 * sourceSize.x + x0], pSource[y1 * sourceSize.x + x1])
+					);
+				}
+			}
+
+			m_sizes[level] = size;
+			sourceSize = size;
+			pSource = texels.data();
+		}
+	}
+
+	bool HiZPyramid::isOccluded(glm::mat4 const& viewproject, AABB const& bounds) const
+	{
+		if (m_levels.empty()) {
+			return false;
+		}
+
+		// Project the box corners to find their screen rectangle and nearest depth
+		glm::vec2 rectMin = { 1.0F, 1.0F };
+		glm::vec2 rectMax = { 0.0F, 0.0F };
+		float nearestDepth = 1.0F;
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec3 const corner = {
+				(i & 1) ? bounds.max.x : bounds.min.x,
+				(i & 2) ? bounds.max.y : bounds.min.y,
+				(i & 4) ? bounds.max.z : bounds.min.z,
+			};
+
+			glm::vec4 const clip = viewproject * glm::vec4(corner, 1.0F);
+			if (clip.w <= 0.0F) {
+				return false;
+			}
+
+			glm::vec3 const ndc = glm::vec3(clip) / clip.w;
+			glm::vec2 const uv = { ndc.x * 0.5F + 0.5F, 0.5F - ndc.y * 0.5F };
+			rectMin = glm::min(rectMin, uv);
+			rectMax = glm::max(rectMax, uv);
+			nearestDepth = std::min(nearestDepth, ndc.z);
+		}
+
+		// Nothing is known about depth outside the depth target, so boxes extending beyond it are kept
+		if (nearestDepth < 0.0F || rectMin.x < 0.0F || rectMin.y < 0.0F || rectMax.x > 1.0F || rectMax.y > 1.0F) {
+			return false;
+		}
+
+		glm::uvec2 const pixelMax = m_depthSize - 1U;
+		glm::uvec2 const pixelRectMin = glm::min(glm::uvec2(rectMin * glm::vec2(m_depthSize)), pixelMax);
+		glm::uvec2 const pixelRectMax = glm::min(glm::uvec2(rectMax * glm::vec2(m_depthSize)), pixelMax);
+
+		// Use the finest level where the rectangle covers at most 2x2 texels, level texels cover 2^(level + 1) pixels
+		uint32_t level = 0;
+		while (level + 1 < levelCount())
+		{
+			glm::uvec2 const span = (pixelRectMax >> (level + 1)) - (pixelRectMin >> (level + 1));
+			if (span.x <= 1 && span.y <= 1) {
+				break;
+			}
+
+			level++;
+		}
+
+		glm::uvec2 const texelMin = pixelRectMin >> (level + 1);
+		glm::uvec2 const texelMax = pixelRectMax >> (level + 1);
+		float const farthestDepth = std::max(
+			std::max(texel(level, texelMin.x, texelMin.y), texel(level, texelMax.x, texelMin.y)),
+			std::max(texel(level, texelMin.x, texelMax.y), texel(level, texelMax.x, texelMax.y))
+		);
+
+		return nearestDepth > farthestDepth;
+	}
+
+	float HiZPyramid::texel(uint32_t level, uint32_t x, uint32_t y) const
+	{
+		assert(level < m_levels.size() && "Pyramid level out of range");
+		glm::uvec2 const size = m_sizes[level];
+		return m_levels[level][std::min(y, size.y - 1) * size.x + std::min(x, size.x - 1)];
+	}
+
+	size_t cullDraws(CullParams const& params, HiZPyramid const& pyramid, core::Span<DrawCullData const> draws, std::vector<uint8_t>& visible)
+	{
+		Frustum frustum{};
+		std::copy(std::begin(params.planes), std::end(params.planes), std::begin(frustum.planes));
+
+		visible.resize(draws.size());
+		size_t visibleCount = 0;
+		for (size_t i = 0; i < draws.size(); i++)
+		{
+			AABB const bounds{ draws[i].boundsMin, draws[i].boundsMax };
+			bool const isVisible = frustum.intersects(bounds)
+				&& !(params.occlusionEnabled != 0 && pyramid.isOccluded(params.occlusionViewProject, bounds));
+
+			visible[i] = isVisible ? 1 : 0;
+			visibleCount += visible[i];
+		}
+
+		return visibleCount;
+	}
+} // namespace gfx
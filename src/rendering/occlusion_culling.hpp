@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "core/span.hpp"
+#include "bounds.hpp"
+#include "frustum.hpp"
+
+namespace gfx
+{
+	/// @brief Per-draw culling input, matching the layout read by the culling compute shader.
+	/// Draws sharing render state form a run, surviving draws of a run are compacted to the start of its argument range.
+	struct DrawCullData
+	{
+		glm::vec3	boundsMin;
+		uint32_t	runFirst;	// Indirect argument slot of the first draw in the run
+		glm::vec3	boundsMax;
+		uint32_t	runIndex;
+	};
+
+	/// @brief Culling parameters, matching the uniform layout read by the culling compute shader.
+	struct CullParams
+	{
+		glm::mat4	occlusionViewProject;			// View projection of the frame the hierarchical-Z pyramid was built from
+		glm::vec4	planes[Frustum::PLANE_COUNT];	// Frustum planes of the current frame
+		glm::uvec2	depthSize;						// Size of the depth target the pyramid was built from
+		uint32_t	levelCount;
+		uint32_t	drawCount;
+		uint32_t	occlusionEnabled;				// Zero if no pyramid of a previous frame is available
+		uint32_t	compact;						// Zero if culled draws keep their slot with an instance count of zero
+		uint32_t	_pad0[2];
+	};
+
+	/// @brief Host-side hierarchical-Z pyramid storing the farthest depth per texel, the CPU reference of the pyramid built
+	/// by the culling compute pass. Level 0 is half the depth target size, texels of each next level cover 2x2 texels of
+	/// the previous level.
+	class HiZPyramid
+	{
+	public:
+		/// @brief Calculate the size of the pyramid base level for a depth target.
+		/// @param depthSize
+		/// @return
+		static glm::uvec2 baseSize(glm::uvec2 depthSize);
+
+		/// @brief Calculate the number of pyramid levels for a depth target, the last level is a single texel.
+		/// @param depthSize
+		/// @return
+		static uint32_t levelCount(glm::uvec2 depthSize);
+
+		/// @brief Build the pyramid from a depth target.
+		/// @param depthSize
+		/// @param pDepth Depth values in range [0, 1], row major with depthSize.x values per row.
+		void build(glm::uvec2 depthSize, float const* pDepth);
+
+		/// @brief Test if a bounding box is hidden behind the depth the pyramid was built from.
+		/// Boxes crossing the camera plane or extending beyond the depth target are never occluded.
+		/// @param viewproject View projection matrix the depth target was rendered with.
+		/// @param bounds
+		/// @return
+		bool isOccluded(glm::mat4 const& viewproject, AABB const& bounds) const;
+
+		/// @brief Retrieve the farthest depth stored in a pyramid texel.
+		/// @param level
+		/// @param x
+		/// @param y
+		/// @return
+		float texel(uint32_t level, uint32_t x, uint32_t y) const;
+
+		glm::uvec2 depthSize() const { return m_depthSize; }
+		uint32_t levelCount() const { return static_cast<uint32_t>(m_levels.size()); }
+
+	private:
+		glm::uvec2						m_depthSize	= { 0, 0 };
+		std::vector<glm::uvec2>			m_sizes		= {};
+		std::vector<std::vector<float>>	m_levels	= {};
+	};
+
+	/// @brief Cull draws against the frustum & pyramid, the CPU reference of the culling compute pass.
+	/// @param params Culling parameters as written to the culling uniform.
+	/// @param pyramid Pyramid built from the depth target params.occlusionViewProject was rendered with.
+	/// @param draws
+	/// @param visible Output visibility per draw, 1 for draws passing both tests and 0 otherwise.
+	/// @return The number of visible draws.
+	size_t cullDraws(CullParams const& params, HiZPyramid const& pyramid, core::Span<DrawCullData const> draws, std::vector<uint8_t>& visible);
+} // namespace gfx
@@ -0,0 +1,256 @@
+#include "occlusion_rasterizer.hpp"
+
+#include <algorithm>
+#include <stb_image_write.h>
+
+#if		defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_RASTERIZER_HAS_SSE2	1
+#else
+#define OCCLUSION_RASTERIZER_HAS_SSE2	0
+#endif	// defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#if		OCCLUSION_RASTERIZER_HAS_SSE2
+#include <emmintrin.h>
+#endif	// OCCLUSION_RASTERIZER_HAS_SSE2
+
+namespace gfx
+{
+	/// @brief Minimum clip space w of projected corners, boxes with corners closer to the camera plane are not clipped
+	/// but skipped as occluders & kept as occludees.
+	static constexpr float MIN_CLIP_W = 1e-4F;
+
+	/// @brief Box faces as corner index quads, corner bits select the max bound along x (1), y (2) & z (4).
+	static constexpr uint8_t BOX_FACES[6][4] = {
+		{ 0, 2, 6, 4 }, { 1, 5, 7, 3 },	// -x, +x
+		{ 0, 4, 5, 1 }, { 2, 3, 7, 6 },	// -y, +y
+		{ 0, 1, 3, 2 }, { 4, 6, 7, 5 },	// -z, +z
+	};
+
+	/// @brief Convert a screen coordinate to a pixel index, clamped to the pixel range before conversion.
+	/// @param coordinate 
+	/// @param size Number of pixels along the axis.
+	/// @return 
+	static int32_t toPixel(float coordinate, uint32_t size)
+	{
+		return static_cast<int32_t>(std::clamp(coordinate, 0.0F, static_cast<float>(size - 1)));
+	}
+
+	OcclusionRasterizer::OcclusionRasterizer()
+		:
+		m_depth(WIDTH * HEIGHT, 1.0F)
+	{
+		//
+	}
+
+	void OcclusionRasterizer::begin(glm::mat4 const& viewproject)
+	{
+		m_viewProject = viewproject;
+		std::fill(m_depth.begin(), m_depth.end(), 1.0F);
+	}
+
+	bool OcclusionRasterizer::rasterizeOccluder(AABB const& bounds)
+	{
+		glm::vec3 corners[8]{};
+		if (!projectCorners(bounds, corners)) {
+			return false;
+		}
+
+		// Back faces are rasterized as well, they never pass the depth test behind the front faces
+		for (auto const& face : BOX_FACES)
+		{
+			rasterizeTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+			rasterizeTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+		}
+
+		return true;
+	}
+
+	bool OcclusionRasterizer::isOccluded(AABB const& bounds) const
+	{
+		glm::vec3 corners[8]{};
+		if (!projectCorners(bounds, corners)) {
+			return false;
+		}
+
+		glm::vec3 rectMin = corners[0];
+		glm::vec3 rectMax = corners[0];
+		for (auto const& corner : corners)
+		{
+			rectMin = glm::min(rectMin, corner);
+			rectMax = glm::max(rectMax, corner);
+		}
+
+		// Parts of the box outside the screen are outside the frustum, so the rectangle is clamped to the screen
+		float const nearestDepth = rectMin.z;
+		if (nearestDepth < 0.0F || rectMax.x < 0.0F || rectMax.y < 0.0F || rectMin.x >= WIDTH || rectMin.y >= HEIGHT) {
+			return false;
+		}
+
+		// Occluders cover pixels whose center they contain, which may leave part of the pixel uncovered. Growing the rectangle
+		// by a pixel adds a neighbour whose center lies outside the occluder edge for every partly covered pixel
+		int32_t const x0 = toPixel(rectMin.x - 1.0F, WIDTH);
+		int32_t const y0 = toPixel(rectMin.y - 1.0F, HEIGHT);
+		int32_t const x1 = toPixel(rectMax.x + 1.0F, WIDTH);
+		int32_t const y1 = toPixel(rectMax.y + 1.0F, HEIGHT);
+
+		// The box is occluded if its nearest depth lies behind the stored depth of every pixel it covers
+		for (int32_t y = y0; y <= y1; y++)
+		{
+			float const* pRow = m_depth.data() + static_cast<size_t>(y) * WIDTH;
+			int32_t x = x0;
+#if		OCCLUSION_RASTERIZER_HAS_SSE2
+			__m128 const nearest = _mm_set1_ps(nearestDepth);
+			for (; x + 4 <= x1 + 1; x += 4)
+			{
+				__m128 const depth = _mm_loadu_ps(pRow + x);
+				if (_mm_movemask_ps(_mm_cmple_ps(nearest, depth)) != 0) {
+					return false;
+				}
+			}
+#endif	// OCCLUSION_RASTERIZER_HAS_SSE2
+
+			for (; x <= x1; x++)
+			{
+				if (nearestDepth <= pRow[x]) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool OcclusionRasterizer::dumpDepth(std::string const& path) const
+	{
+		// Depth is stretched over the written depth range, since perspective depth is packed closely near 1
+		float minDepth = 1.0F;
+		float maxDepth = 0.0F;
+		for (float const depth : m_depth)
+		{
+			if (depth < 1.0F)
+			{
+				minDepth = std::min(minDepth, depth);
+				maxDepth = std::max(maxDepth, depth);
+			}
+		}
+
+		float const range = std::max(maxDepth - minDepth, 1e-6F);
+		std::vector<uint8_t> pixels(m_depth.size(), 0);
+		for (size_t i = 0; i < m_depth.size(); i++)
+		{
+			if (m_depth[i] < 1.0F) {
+				pixels[i] = static_cast<uint8_t>(64.0F + 191.0F * (1.0F - (m_depth[i] - minDepth) / range));
+			}
+		}
+
+		return stbi_write_png(path.c_str(), static_cast<int>(WIDTH), static_cast<int>(HEIGHT), 1, pixels.data(), static_cast<int>(WIDTH)) != 0;
+	}
+
+	void OcclusionRasterizer::rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2)
+	{
+		// Edge functions are positive inside the triangle for one winding, so the other winding is swapped
+		float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+		if (area < 0.0F)
+		{
+			std::swap(v1, v2);
+			area = -area;
+		}
+
+		if (area <= 1e-6F) {
+			return;
+		}
+
+		// Triangles entirely outside the screen are skipped, others are bounded by their pixel rectangle
+		glm::vec2 const rectMin = glm::min(glm::min(glm::vec2(v0), glm::vec2(v1)), glm::vec2(v2));
+		glm::vec2 const rectMax = glm::max(glm::max(glm::vec2(v0), glm::vec2(v1)), glm::vec2(v2));
+		if (rectMax.x < 0.0F || rectMax.y < 0.0F || rectMin.x >= WIDTH || rectMin.y >= HEIGHT) {
+			return;
+		}
+
+		int32_t const x0 = toPixel(rectMin.x, WIDTH);
+		int32_t const y0 = toPixel(rectMin.y, HEIGHT);
+		int32_t const x1 = toPixel(rectMax.x, WIDTH);
+		int32_t const y1 = toPixel(rectMax.y, HEIGHT);
+
+		// Edge functions e(x, y) = a * x + b * y + c for edges v1-v2, v2-v0 & v0-v1, weighting v0, v1 & v2 respectively
+		glm::vec3 const a = { v1.y - v2.y, v2.y - v0.y, v0.y - v1.y };
+		glm::vec3 const b = { v2.x - v1.x, v0.x - v2.x, v1.x - v0.x };
+		glm::vec3 const c = {
+			v1.x * v2.y - v1.y * v2.x,
+			v2.x * v0.y - v2.y * v0.x,
+			v0.x * v1.y - v0.y * v1.x,
+		};
+
+		// Depth is linear in screen space, so it follows the plane z(x, y) = dzdx * x + dzdy * y + z0
+		glm::vec3 const depths = glm::vec3(v0.z, v1.z, v2.z) / area;
+		float const dzdx = glm::dot(a, depths);
+		float const dzdy = glm::dot(b, depths);
+		float const dz0 = glm::dot(c, depths);
+
+		for (int32_t y = y0; y <= y1; y++)
+		{
+			float const py = static_cast<float>(y) + 0.5F;
+			glm::vec3 const rowEdge = b * py + c;
+			float const rowDepth = dzdy * py + dz0;
+			float* pRow = m_depth.data() + static_cast<size_t>(y) * WIDTH;
+
+			int32_t x = x0;
+#if		OCCLUSION_RASTERIZER_HAS_SSE2
+			__m128 const zero = _mm_setzero_ps();
+			__m128 const offsets = _mm_set_ps(3.5F, 2.5F, 1.5F, 0.5F);
+			for (; x + 4 <= x1 + 1; x += 4)
+			{
+				__m128 const px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+				__m128 const e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.x), px), _mm_set1_ps(rowEdge.x));
+				__m128 const e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.y), px), _mm_set1_ps(rowEdge.y));
+				__m128 const e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.z), px), _mm_set1_ps(rowEdge.z));
+				__m128 const inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				// Keep the nearest depth in covered pixels, uncovered pixels keep their stored depth
+				__m128 const depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), _mm_set1_ps(rowDepth));
+				__m128 const stored = _mm_loadu_ps(pRow + x);
+				__m128 const nearest = _mm_min_ps(stored, depth);
+				_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, stored)));
+			}
+#endif	// OCCLUSION_RASTERIZER_HAS_SSE2
+
+			for (; x <= x1; x++)
+			{
+				float const px = static_cast<float>(x) + 0.5F;
+				glm::vec3 const edge = a * px + rowEdge;
+				if (edge.x >= 0.0F && edge.y >= 0.0F && edge.z >= 0.0F) {
+					pRow[x] = std::min(pRow[x], dzdx * px + rowDepth);
+				}
+			}
+		}
+	}
+
+	bool OcclusionRasterizer::projectCorners(AABB const& bounds, glm::vec3 (&corners)[8]) const
+	{
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec3 const corner = {
+				(i & 1) ? bounds.max.x : bounds.min.x,
+				(i & 2) ? bounds.max.y : bounds.min.y,
+				(i & 4) ? bounds.max.z : bounds.min.z,
+			};
+
+			glm::vec4 const clip = m_viewProject * glm::vec4(corner, 1.0F);
+			if (clip.w <= MIN_CLIP_W) {
+				return false;
+			}
+
+			glm::vec3 const ndc = glm::vec3(clip) / clip.w;
+			corners[i] = {
+				(ndc.x * 0.5F + 0.5F) * static_cast<float>(WIDTH),
+				(0.5F - ndc.y * 0.5F) * static_cast<float>(HEIGHT),
+				ndc.z,
+			};
+		}
+
+		return true;
+	}
+} // namespace gfx
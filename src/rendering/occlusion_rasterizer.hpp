@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "bounds.hpp"
+
+namespace gfx
+{
+	/// @brief The OcclusionRasterizer class rasterizes occluder boxes into a low resolution depth buffer on the CPU, then
+	/// tests bounding boxes against it. Depth is stored in [0, 1] clip space depth with the nearest depth kept per pixel,
+	/// rows are rasterized & tested 4 pixels at a time in SSE2 builds. Coverage is sampled at pixel centers, so tested boxes
+	/// are grown by a pixel to stay conservative along occluder edges.
+	class OcclusionRasterizer
+	{
+	public:
+		static constexpr uint32_t WIDTH		= 256;
+		static constexpr uint32_t HEIGHT	= 128;
+
+		OcclusionRasterizer();
+
+		/// @brief Clear the depth buffer and start rasterizing occluders for a view.
+		/// @param viewproject View projection matrix with a [0, 1] clip space depth range.
+		void begin(glm::mat4 const& viewproject);
+
+		/// @brief Rasterize the faces of an occluder box, the box must be fully opaque.
+		/// Boxes crossing the near plane are skipped, since they are not clipped.
+		/// @param bounds
+		/// @return A boolean indicating the box was rasterized.
+		bool rasterizeOccluder(AABB const& bounds);
+
+		/// @brief Test if a bounding box is hidden behind the rasterized occluders.
+		/// Boxes crossing the near plane are never occluded.
+		/// @param bounds
+		/// @return
+		bool isOccluded(AABB const& bounds) const;
+
+		/// @brief Write the depth buffer to a grayscale PNG file, nearer depths are brighter and empty pixels are black.
+		/// @param path
+		/// @return A boolean indicating the file was written.
+		bool dumpDepth(std::string const& path) const;
+
+		/// @brief Retrieve the depth buffer, row major with WIDTH values per row and the top row first.
+		/// @return
+		float const* depth() const { return m_depth.data(); }
+
+	private:
+		/// @brief Rasterize a triangle in screen space, keeping the nearest depth per covered pixel.
+		/// @param v0 Vertex with pixel x, y coordinates & clip space depth.
+		/// @param v1
+		/// @param v2
+		void rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2);
+
+		/// @brief Project the corners of a bounding box to screen space.
+		/// @param bounds
+		/// @param corners Output pixel x, y coordinates & clip space depth per corner.
+		/// @return A boolean indicating all corners are in front of the near plane.
+		bool projectCorners(AABB const& bounds, glm::vec3 (&corners)[8]) const;
+
+	private:
+		glm::mat4			m_viewProject	= glm::mat4(1.0F);
+		std::vector<float>	m_depth			= {};
+	};
+} // namespace gfx
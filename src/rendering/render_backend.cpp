@@ -68,11 +68,38 @@ namespace gfx
 		deviceLimits.limits.maxInterStageShaderComponents = WGPU_LIMIT_U32_UNDEFINED;
 #endif
 
+		// Request optional features used by indirect draws & compressed textures when the adapter supports them
+		WGPUFeatureName requiredFeatures[5]{};
+		size_t requiredFeatureCount = 0;
+		if (wgpuAdapterHasFeature(m_adapter, WGPUFeatureName_IndirectFirstInstance)) {
+			requiredFeatures[requiredFeatureCount++] = WGPUFeatureName_IndirectFirstInstance;
+		}
+
+		if (wgpuAdapterHasFeature(m_adapter, WGPUFeatureName_TextureCompressionBC)) {
+			requiredFeatures[requiredFeatureCount++] = WGPUFeatureName_TextureCompressionBC;
+		}
+
+		if (wgpuAdapterHasFeature(m_adapter, WGPUFeatureName_TextureCompressionETC2)) {
+			requiredFeatures[requiredFeatureCount++] = WGPUFeatureName_TextureCompressionETC2;
+		}
+
+#if		WEBGPU_BACKEND_WGPU
+		WGPUFeatureName const multiDrawIndirect = static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirect);
+		if (wgpuAdapterHasFeature(m_adapter, multiDrawIndirect)) {
+			requiredFeatures[requiredFeatureCount++] = multiDrawIndirect;
+		}
+
+		WGPUFeatureName const multiDrawIndirectCount = static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirectCount);
+		if (wgpuAdapterHasFeature(m_adapter, multiDrawIndirectCount)) {
+			requiredFeatures[requiredFeatureCount++] = multiDrawIndirectCount;
+		}
+#endif	// WEBGPU_BACKEND_WGPU
+
 		WGPUDeviceDescriptor deviceDesc{};
 		deviceDesc.nextInChain = nullptr;
 		deviceDesc.label = "WGPU device";
-		deviceDesc.requiredFeatureCount = 0;
-		deviceDesc.requiredFeatures = nullptr;
+		deviceDesc.requiredFeatureCount = requiredFeatureCount;
+		deviceDesc.requiredFeatures = requiredFeatures;
 		deviceDesc.requiredLimits = &deviceLimits;
 		deviceDesc.defaultQueue.nextInChain = nullptr;
 		deviceDesc.defaultQueue.label = "WGPU queue";
@@ -221,6 +248,16 @@ namespace gfx
 
 		BackendCapabilities caps{};
 		caps.minUniformBufferOffsetAlignment = limits.limits.minUniformBufferOffsetAlignment;
+		caps.indirectFirstInstance = wgpuDeviceHasFeature(m_device, WGPUFeatureName_IndirectFirstInstance);
+		caps.textureCompressionBC = wgpuDeviceHasFeature(m_device, WGPUFeatureName_TextureCompressionBC);
+		caps.textureCompressionETC2 = wgpuDeviceHasFeature(m_device, WGPUFeatureName_TextureCompressionETC2);
+#if		WEBGPU_BACKEND_WGPU
+		caps.multiDrawIndirect = wgpuDeviceHasFeature(m_device, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirect));
+		caps.multiDrawIndirectCount = wgpuDeviceHasFeature(m_device, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirectCount));
+#else
+		caps.multiDrawIndirect = false;
+		caps.multiDrawIndirectCount = false;
+#endif	// WEBGPU_BACKEND_WGPU
 
 		return caps;
 	}
@@ -16,7 +16,12 @@ namespace gfx
 	/// @brief Backend capabilities for the render backend.
 	struct BackendCapabilities
 	{
-		uint32_t minUniformBufferOffsetAlignment;
+		uint32_t	minUniformBufferOffsetAlignment;
+		bool		indirectFirstInstance;	// Indirect draws may use a non-zero first instance
+		bool		multiDrawIndirect;		// Multiple indirect draws may be encoded with a single command, native only
+		bool		multiDrawIndirectCount;	// Multi-draws may read their draw count from a buffer, native only
+		bool		textureCompressionBC;	// BC compressed texture formats are supported, typically desktop devices
+		bool		textureCompressionETC2;	// ETC2 compressed texture formats are supported, typically mobile & web devices
 	};
 
 	/// @brief The FrameState struct contains per-frame data for the render-backend.
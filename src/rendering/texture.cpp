@@ -1,14 +1,196 @@
 #include "texture.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+
+#if		defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_HAS_SSE2	1
+#else
+#define TEXTURE_HAS_SSE2	0
+#endif	// defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#if		TEXTURE_HAS_SSE2
+#include <emmintrin.h>
+#endif	// TEXTURE_HAS_SSE2
 
 namespace gfx
 {
+	/// @brief Number of entries in the linear to sRGB encoding table, fine enough to round trip all 8-bit sRGB values.
+	static constexpr size_t SRGB_ENCODE_TABLE_SIZE = 1 << 14;
+
+	/// @brief Lookup tables converting between 8-bit sRGB values & linear values.
+	struct SrgbTables
+	{
+		std::array<float, 256>						decode = {};
+		std::array<uint8_t, SRGB_ENCODE_TABLE_SIZE>	encode = {};
+
+		SrgbTables()
+		{
+			for (size_t i = 0; i < decode.size(); i++)
+			{
+				float const value = static_cast<float>(i) / 255.0F;
+				decode[i] = (value <= 0.04045F) ? value / 12.92F : std::pow((value + 0.055F) / 1.055F, 2.4F);
+			}
+
+			for (size_t i = 0; i < encode.size(); i++)
+			{
+				float const value = static_cast<float>(i) / static_cast<float>(encode.size() - 1);
+				float const srgb = (value <= 0.0031308F) ? value * 12.92F : 1.055F * std::pow(value, 1.0F / 2.4F) - 0.055F;
+				encode[i] = static_cast<uint8_t>(std::clamp(srgb, 0.0F, 1.0F) * 255.0F + 0.5F);
+			}
+		}
+
+		uint8_t toSrgb(float value) const
+		{
+			return encode[static_cast<size_t>(std::clamp(value, 0.0F, 1.0F) * static_cast<float>(encode.size() - 1) + 0.5F)];
+		}
+	};
+
+	/// @brief Retrieve the sRGB lookup tables, built on first use.
+	/// @return
+	static SrgbTables const& srgbTables()
+	{
+		static SrgbTables const tables{};
+		return tables;
+	}
+
+	/// @brief Convert a normalized value to an 8-bit value.
+	/// @param value
+	/// @return
+	static uint8_t toUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::clamp(value, 0.0F, 1.0F) * 255.0F + 0.5F);
+	}
+
+	/// @brief Downsample a mip level with a 2x2 box filter, edge texels are repeated for single texel wide sources.
+	/// Color channels of color data are averaged in linear space, normal data is renormalized after averaging. Alpha
+	/// channels (the last channel of 2 & 4 component textures) are always averaged as stored.
+	/// @param pSource Source level texels.
+	/// @param sourceWidth
+	/// @param sourceHeight
+	/// @param pTarget Target level texels.
+	/// @param width Target level width.
+	/// @param height Target level height.
+	/// @param components
+	/// @param mode
+	static void downsample(uint8_t const* pSource, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t* pTarget, uint32_t width, uint32_t height, uint8_t components, TextureMode mode)
+	{
+		SrgbTables const& tables = srgbTables();
+		bool const hasAlpha = (components == 2 || components == 4);
+		uint8_t const colorComponents = hasAlpha ? components - 1 : components;
+		bool const isSrgb = (mode == TextureMode::ColorData);
+		bool const isNormal = (mode == TextureMode::NormalData && colorComponents == 3);
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			uint8_t const* pRow0 = pSource + static_cast<size_t>(std::min(y * 2, sourceHeight - 1)) * sourceWidth * components;
+			uint8_t const* pRow1 = pSource + static_cast<size_t>(std::min(y * 2 + 1, sourceHeight - 1)) * sourceWidth * components;
+			uint8_t* pTargetRow = pTarget + static_cast<size_t>(y) * width * components;
+
+			uint32_t x = 0;
+#if		TEXTURE_HAS_SSE2
+			// Stored values of RGBA data are averaged 2 target texels at a time as 16-bit sums, rounding to nearest
+			if (components == 4 && mode == TextureMode::NonColorData && sourceWidth >= width * 2)
+			{
+				__m128i const zero = _mm_setzero_si128();
+				__m128i const bias = _mm_set1_epi16(2);
+				for (; x + 2 <= width; x += 2)
+				{
+					__m128i const row0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pRow0 + x * 8));
+					__m128i const row1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pRow1 + x * 8));
+					__m128i const sumLo = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero));
+					__m128i const sumHi = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+
+					// Low & high halves hold the even & odd source texels of both target texels
+					__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(sumLo, sumHi), _mm_unpackhi_epi64(sumLo, sumHi));
+					sum = _mm_srli_epi16(_mm_add_epi16(sum, bias), 2);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pTargetRow + x * 8), _mm_packus_epi16(sum, sum));
+				}
+			}
+			else if (components == 4 && isSrgb)
+			{
+				// Linear color & stored alpha of a single texel fit a single register
+				auto const loadTexel = [&tables](uint8_t const* pTexel) {
+					return _mm_set_ps(static_cast<float>(pTexel[3]) / 255.0F, tables.decode[pTexel[2]], tables.decode[pTexel[1]], tables.decode[pTexel[0]]);
+				};
+
+				__m128 const quarter = _mm_set1_ps(0.25F);
+				for (; x < width; x++)
+				{
+					size_t const x0 = static_cast<size_t>(std::min(x * 2, sourceWidth - 1)) * 4;
+					size_t const x1 = static_cast<size_t>(std::min(x * 2 + 1, sourceWidth - 1)) * 4;
+					__m128 sum = _mm_add_ps(loadTexel(pRow0 + x0), loadTexel(pRow0 + x1));
+					sum = _mm_add_ps(sum, _mm_add_ps(loadTexel(pRow1 + x0), loadTexel(pRow1 + x1)));
+
+					alignas(16) float average[4];
+					_mm_store_ps(average, _mm_mul_ps(sum, quarter));
+					uint8_t* pTexel = pTargetRow + static_cast<size_t>(x) * 4;
+					pTexel[0] = tables.toSrgb(average[0]);
+					pTexel[1] = tables.toSrgb(average[1]);
+					pTexel[2] = tables.toSrgb(average[2]);
+					pTexel[3] = toUnorm8(average[3]);
+				}
+			}
+#endif	// TEXTURE_HAS_SSE2
+
+			for (; x < width; x++)
+			{
+				size_t const x0 = static_cast<size_t>(std::min(x * 2, sourceWidth - 1)) * components;
+				size_t const x1 = static_cast<size_t>(std::min(x * 2 + 1, sourceWidth - 1)) * components;
+				uint8_t const* pTexels[4] = { pRow0 + x0, pRow0 + x1, pRow1 + x0, pRow1 + x1 };
+
+				float average[4] = { 0.0F, 0.0F, 0.0F, 0.0F };
+				for (uint8_t c = 0; c < components; c++)
+				{
+					for (uint8_t const* pTexel : pTexels) {
+						average[c] += (isSrgb && c < colorComponents) ? tables.decode[pTexel[c]] : static_cast<float>(pTexel[c]) / 255.0F;
+					}
+
+					average[c] *= 0.25F;
+				}
+
+				if (isNormal)
+				{
+					// Averaged normals shorten where the source normals diverge, so they are rescaled to unit length
+					glm::vec3 normal = glm::vec3(average[0], average[1], average[2]) * 2.0F - 1.0F;
+					float const length = glm::length(normal);
+					normal = (length > 1e-6F) ? normal / length : glm::vec3(0.0F, 0.0F, 1.0F);
+					average[0] = normal.x * 0.5F + 0.5F;
+					average[1] = normal.y * 0.5F + 0.5F;
+					average[2] = normal.z * 0.5F + 0.5F;
+				}
+
+				uint8_t* pTexel = pTargetRow + static_cast<size_t>(x) * components;
+				for (uint8_t c = 0; c < components; c++) {
+					pTexel[c] = (isSrgb && c < colorComponents) ? tables.toSrgb(average[c]) : toUnorm8(average[c]);
+				}
+			}
+		}
+	}
+
+	uint32_t Texture::mipChainLength(uint32_t width, uint32_t height)
+	{
+		uint32_t levels = 1;
+		while (width > 1 || height > 1)
+		{
+			width = std::max(width / 2, 1U);
+			height = std::max(height / 2, 1U);
+			levels++;
+		}
+
+		return levels;
+	}
+
 	Texture::Texture(TextureDimensions dimensions, TextureExtent const& extent, uint8_t components, void* pTextureData, TextureMode mode)
 		:
 		m_dimensions(dimensions),
 		m_extent(extent),
 		m_components(components),
+		m_mipOffsets{ 0 },
 		m_textureMode(mode)
 	{
 		assert(extent.width > 0 && extent.height > 0 && extent.depthOrArrayLayers > 0 && "Texture extent cannot be 0 in any direction");
@@ -38,6 +220,134 @@ namespace gfx
 		}
 	}
 
+	TextureExtent Texture::mipExtent(uint32_t level) const
+	{
+		assert(level < mipLevelCount() && "Mip level out of range");
+		return TextureExtent{
+			std::max(m_extent.width >> level, 1U),
+			std::max(m_extent.height >> level, 1U),
+			m_extent.depthOrArrayLayers
+		};
+	}
+
+	uint8_t const* Texture::mipData(uint32_t level) const
+	{
+		assert(level < mipLevelCount() && "Mip level out of range");
+		return m_data.data() + m_mipOffsets[level];
+	}
+
+	void Texture::generateMipLevels()
+	{
+		assert(m_blockFormat == BlockFormat::None && "Cannot generate mip levels of a compressed texture");
+		if (m_dimensions != TextureDimensions::Dim2D && m_dimensions != TextureDimensions::Dim2DArray) {
+			return;
+		}
+
+		// Drop existing mip levels, then append each level downsampled from the previous one
+		size_t const layerCount = m_extent.depthOrArrayLayers;
+		size_t const baseSize = static_cast<size_t>(m_extent.width) * m_extent.height * layerCount * m_components;
+		uint32_t const levelCount = mipChainLength(m_extent.width, m_extent.height);
+
+		size_t totalSize = 0;
+		m_mipOffsets.resize(levelCount);
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			TextureExtent const extent = mipExtent(level);
+			m_mipOffsets[level] = totalSize;
+			totalSize += static_cast<size_t>(extent.width) * extent.height * layerCount * m_components;
+		}
+
+		m_data.resize(baseSize);
+		m_data.resize(totalSize);
+		for (uint32_t level = 1; level < levelCount; level++)
+		{
+			TextureExtent const source = mipExtent(level - 1);
+			TextureExtent const target = mipExtent(level);
+			size_t const sourceLayerSize = static_cast<size_t>(source.width) * source.height * m_components;
+			size_t const targetLayerSize = static_cast<size_t>(target.width) * target.height * m_components;
+			for (size_t layer = 0; layer < layerCount; layer++)
+			{
+				downsample(
+					m_data.data() + m_mipOffsets[level - 1] + layer * sourceLayerSize, source.width, source.height,
+					m_data.data() + m_mipOffsets[level] + layer * targetLayerSize, target.width, target.height,
+					m_components, m_textureMode
+				);
+			}
+		}
+
+		m_dirty = true;
+	}
+
+	void Texture::compress(BlockFormat format)
+	{
+		assert(m_components == 4 && "Only RGBA textures can be block compressed");
+		assert(m_blockFormat == BlockFormat::None && "Texture is already block compressed");
+		if (format == BlockFormat::None) {
+			return;
+		}
+
+		// Blocks keep the level-major layout, every level stores the blocks of all of its layers
+		size_t const layerCount = m_extent.depthOrArrayLayers;
+		uint32_t const levelCount = mipLevelCount();
+		std::vector<size_t> offsets(levelCount);
+		size_t totalSize = 0;
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			TextureExtent const extent = mipExtent(level);
+			offsets[level] = totalSize;
+			totalSize += compressedSize(format, extent.width, extent.height) * layerCount;
+		}
+
+		std::vector<uint8_t> blocks(totalSize);
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			TextureExtent const extent = mipExtent(level);
+			size_t const texelLayerSize = static_cast<size_t>(extent.width) * extent.height * m_components;
+			size_t const blockLayerSize = compressedSize(format, extent.width, extent.height);
+			for (size_t layer = 0; layer < layerCount; layer++)
+			{
+				compressImage(
+					format, extent.width, extent.height,
+					mipData(level) + layer * texelLayerSize,
+					blocks.data() + offsets[level] + layer * blockLayerSize
+				);
+			}
+		}
+
+		m_data.swap(blocks);
+		m_mipOffsets.swap(offsets);
+		m_blockFormat = format;
+		m_dirty = true;
+	}
+
+	BlockFormat Texture::selectBlockFormat(BlockFormatSupport const& support) const
+	{
+		bool const is2D = m_dimensions == TextureDimensions::Dim2D || m_dimensions == TextureDimensions::Dim2DArray;
+		if (!is2D || m_components != 4 || m_blockFormat != BlockFormat::None
+			|| m_extent.width % COMPRESSION_BLOCK_SIZE != 0 || m_extent.height % COMPRESSION_BLOCK_SIZE != 0)
+		{
+			return BlockFormat::None;
+		}
+
+		if (m_textureMode == TextureMode::NormalData) {
+			return support.bc ? BlockFormat::BC5 : BlockFormat::None;
+		}
+
+		size_t const texelCount = static_cast<size_t>(m_extent.width) * m_extent.height * m_extent.depthOrArrayLayers;
+		uint8_t const* pTexels = mipData(0);
+
+		bool opaque = true;
+		for (size_t i = 0; i < texelCount && opaque; i++) {
+			opaque = pTexels[i * 4 + 3] == 255;
+		}
+
+		if (support.bc) {
+			return opaque ? BlockFormat::BC1 : BlockFormat::BC7;
+		}
+
+		return (support.etc2 && opaque) ? BlockFormat::ETC2RGB8 : BlockFormat::None;
+	}
+
 	void Texture::setTexture(WGPUTexture texture)
 	{
 		assert(texture != nullptr && "Texture handle cannot be a nullptr");
@@ -48,7 +358,24 @@ namespace gfx
 		}
 
 		m_texture = texture;
-		m_textureView = wgpuTextureCreateView(m_texture, nullptr /* assume default view */);
+		if (m_dimensions != TextureDimensions::Dim2DArray)
+		{
+			m_textureView = wgpuTextureCreateView(m_texture, nullptr /* assume default view */);
+			return;
+		}
+
+		// The default view of a single layer texture is not an array view, so array views are always explicit
+		WGPUTextureViewDescriptor arrayViewDesc{};
+		arrayViewDesc.nextInChain = nullptr;
+		arrayViewDesc.label = "Texture Array View";
+		arrayViewDesc.format = WGPUTextureFormat_Undefined;
+		arrayViewDesc.dimension = WGPUTextureViewDimension_2DArray;
+		arrayViewDesc.baseMipLevel = 0;
+		arrayViewDesc.mipLevelCount = mipLevelCount();
+		arrayViewDesc.baseArrayLayer = 0;
+		arrayViewDesc.arrayLayerCount = m_extent.depthOrArrayLayers;
+		arrayViewDesc.aspect = WGPUTextureAspect_All;
+		m_textureView = wgpuTextureCreateView(m_texture, &arrayViewDesc);
 	}
 
 	void Texture::setSampler(WGPUSampler sampler)
@@ -4,6 +4,8 @@
 #include <vector>
 #include <webgpu/webgpu.h>
 
+#include "rendering/texture_compression.hpp"
+
 namespace gfx
 {
 	/// @brief Texture dimensions for interpreting extent variables.
@@ -11,6 +13,7 @@ namespace gfx
 	{
 		Dim1D,
 		Dim2D,
+		Dim2DArray,		// 2D texture viewed as a texture array, extent depth is the layer count
 		Dim3D,
 	};
 
@@ -19,6 +22,7 @@ namespace gfx
 	{
 		NonColorData,
 		ColorData,
+		NormalData,		// Tangent space normals encoded as unsigned color, mip levels are renormalized
 	};
 
 	/// @brief Texture extent in 3 directions.
@@ -30,9 +34,17 @@ namespace gfx
 	};
 
 	/// @brief The Texture class stores host-side and device-side texture data.
+	/// Host-side data stores all mip levels contiguously, every level stores all of its array layers. Compressed textures
+	/// store blocks instead of texels, with block rows tightly packed.
 	class Texture
 	{
 	public:
+		/// @brief Calculate the length of a full mip chain, the last level is a single texel.
+		/// @param width 
+		/// @param height 
+		/// @return 
+		static uint32_t mipChainLength(uint32_t width, uint32_t height);
+
 		/// @brief Create a new texture object.
 		/// @param dimensions Texture dimensions, used to interpret extent values.
 		/// @param extent Texture extent in x/y/z directions, supports layered texturees.
@@ -68,6 +80,45 @@ namespace gfx
 		/// @return 
 		uint8_t const* data() const { return m_data.data(); }
 
+		/// @brief Get the size of the host-side texture data of all mip levels in bytes.
+		/// @return 
+		size_t size() const { return m_data.size(); }
+
+		/// @brief Get the number of mip levels stored in this texture.
+		/// @return 
+		uint32_t mipLevelCount() const { return static_cast<uint32_t>(m_mipOffsets.size()); }
+
+		/// @brief Get the extent of a mip level, array layers are not reduced.
+		/// @param level 
+		/// @return 
+		TextureExtent mipExtent(uint32_t level) const;
+
+		/// @brief Get the host-side texture data of a mip level as bytes.
+		/// @param level 
+		/// @return 
+		uint8_t const* mipData(uint32_t level) const;
+
+		/// @brief Generate a full mip chain from the base level, replacing existing mip levels. Only 2D textures & 2D texture
+		/// arrays have mip levels, color data is filtered in linear space & normal data is renormalized.
+		void generateMipLevels();
+
+		/// @brief Compress all mip levels & array layers into blocks, mip levels must be generated beforehand.
+		/// Only RGBA textures can be compressed, the texture stays uncompressed for BlockFormat::None.
+		/// @param format 
+		void compress(BlockFormat format);
+
+		/// @brief Select the block format to compress this texture to, based on its mode & alpha channel.
+		/// Normal maps only need 2 channels, opaque textures fit in 8 byte blocks. Textures with alpha need BC7, ETC2 alpha
+		/// blocks are not encoded so those stay uncompressed on ETC2 only devices. Only uncompressed RGBA 2D textures & 2D
+		/// texture arrays with a base level of whole blocks are compressed.
+		/// @param support Block formats supported by the device.
+		/// @return BlockFormat::None if the texture should stay uncompressed.
+		BlockFormat selectBlockFormat(BlockFormatSupport const& support) const;
+
+		/// @brief Get the block format of the host-side texture data.
+		/// @return BlockFormat::None for uncompressed textures.
+		BlockFormat blockFormat() const { return m_blockFormat; }
+
 		/// @brief Check if this texture is in SRGB color space.
 		/// @return 
 		TextureMode textureMode() const { return m_textureMode; }
@@ -98,7 +149,9 @@ namespace gfx
 		TextureExtent			m_extent		= {};
 		uint8_t					m_components	= 0;	// Color components
 		std::vector<uint8_t>	m_data			= {};	// Texture data stored as byte array.
+		std::vector<size_t>		m_mipOffsets	= {};	// Byte offset of each mip level in the texture data
 		TextureMode				m_textureMode	= TextureMode::NonColorData;
+		BlockFormat				m_blockFormat	= BlockFormat::None;
 		WGPUTexture				m_texture		= nullptr;
 		WGPUTextureView			m_textureView	= nullptr;
 		WGPUSampler				m_sampler		= nullptr;
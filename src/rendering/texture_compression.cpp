@@ -0,0 +1,849 @@
+#include "texture_compression.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace gfx
+{
+	/// @brief Number of texels in a compressed block.
+	static constexpr uint32_t BLOCK_TEXELS = COMPRESSION_BLOCK_SIZE * COMPRESSION_BLOCK_SIZE;
+
+	/// @brief Interpolation weights of 4 bit BC7 indices, in 1/64 units.
+	static constexpr uint32_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	/// @brief ETC intensity modifier tables, the sign of each modifier is stored in the texel index MSB.
+	static constexpr int ETC_MODIFIERS[8][2] = {
+		{  2,   8 }, {  5,  17 }, {  9,  29 }, { 13,  42 },
+		{ 18,  60 }, { 24,  80 }, { 33, 106 }, { 47, 183 },
+	};
+
+	/// @brief A 4x4 block of RGBA texels, stored row major.
+	using TexelBlock = uint8_t[BLOCK_TEXELS][4];
+
+	static uint8_t clampByte(int value)
+	{
+		return static_cast<uint8_t>(std::clamp(value, 0, 255));
+	}
+
+	/// @brief Gather a block of texels, repeating edge texels for blocks that cross the image edge.
+	static void loadBlock(uint8_t const* pTexels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, TexelBlock& block)
+	{
+		for (uint32_t y = 0; y < COMPRESSION_BLOCK_SIZE; y++)
+		{
+			uint32_t const texelY = std::min(blockY * COMPRESSION_BLOCK_SIZE + y, height - 1);
+			for (uint32_t x = 0; x < COMPRESSION_BLOCK_SIZE; x++)
+			{
+				uint32_t const texelX = std::min(blockX * COMPRESSION_BLOCK_SIZE + x, width - 1);
+				std::memcpy(block[y * COMPRESSION_BLOCK_SIZE + x], pTexels + (static_cast<size_t>(texelY) * width + texelX) * 4, 4);
+			}
+		}
+	}
+
+	/// @brief Scatter a block of texels, discarding texels outside the image.
+	static void storeBlock(TexelBlock const& block, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* pTexels)
+	{
+		for (uint32_t y = 0; y < COMPRESSION_BLOCK_SIZE; y++)
+		{
+			uint32_t const texelY = blockY * COMPRESSION_BLOCK_SIZE + y;
+			for (uint32_t x = 0; x < COMPRESSION_BLOCK_SIZE; x++)
+			{
+				uint32_t const texelX = blockX * COMPRESSION_BLOCK_SIZE + x;
+				if (texelX < width && texelY < height) {
+					std::memcpy(pTexels + (static_cast<size_t>(texelY) * width + texelX) * 4, block[y * COMPRESSION_BLOCK_SIZE + x], 4);
+				}
+			}
+		}
+	}
+
+	/// @brief Find the endpoints of a block along the principal axis of its texels.
+	/// @param block
+	/// @param channels Number of channels to fit, starting at red.
+	/// @param low Endpoint with the lowest projection.
+	/// @param high Endpoint with the highest projection.
+	static void fitEndpoints(TexelBlock const& block, uint32_t channels, float low[4], float high[4])
+	{
+		float mean[4] = { 0.0F, 0.0F, 0.0F, 0.0F };
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			for (uint32_t c = 0; c < channels; c++) {
+				mean[c] += block[i][c];
+			}
+		}
+
+		for (uint32_t c = 0; c < channels; c++) {
+			mean[c] /= static_cast<float>(BLOCK_TEXELS);
+		}
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			for (uint32_t a = 0; a < channels; a++)
+			{
+				for (uint32_t b = 0; b < channels; b++) {
+					covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+				}
+			}
+		}
+
+		// Power iteration converges on the principal axis in a handful of steps for 4x4 blocks
+		float axis[4] = { 1.0F, 1.0F, 1.0F, 1.0F };
+		for (uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = { 0.0F, 0.0F, 0.0F, 0.0F };
+			float length = 0.0F;
+			for (uint32_t a = 0; a < channels; a++)
+			{
+				for (uint32_t b = 0; b < channels; b++) {
+					next[a] += covariance[a][b] * axis[b];
+				}
+
+				length = std::max(length, std::abs(next[a]));
+			}
+
+			if (length <= std::numeric_limits<float>::epsilon()) {
+				break;
+			}
+
+			for (uint32_t c = 0; c < channels; c++) {
+				axis[c] = next[c] / length;
+			}
+		}
+
+		float axisLength = 0.0F;
+		for (uint32_t c = 0; c < channels; c++) {
+			axisLength += axis[c] * axis[c];
+		}
+
+		float minProjection = 0.0F;
+		float maxProjection = 0.0F;
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			float projection = 0.0F;
+			for (uint32_t c = 0; c < channels; c++) {
+				projection += (block[i][c] - mean[c]) * axis[c];
+			}
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			low[c] = std::clamp(mean[c] + axis[c] * minProjection / axisLength, 0.0F, 255.0F);
+			high[c] = std::clamp(mean[c] + axis[c] * maxProjection / axisLength, 0.0F, 255.0F);
+		}
+	}
+
+	/// @brief Get the squared distance between two colors over the first channels.
+	static int colorDistance(uint8_t const* pA, int const* pB, uint32_t channels)
+	{
+		int distance = 0;
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			int const delta = static_cast<int>(pA[c]) - pB[c];
+			distance += delta * delta;
+		}
+
+		return distance;
+	}
+
+	static uint16_t packRGB565(float const color[3])
+	{
+		uint16_t const r = static_cast<uint16_t>(std::clamp(color[0] * 31.0F / 255.0F + 0.5F, 0.0F, 31.0F));
+		uint16_t const g = static_cast<uint16_t>(std::clamp(color[1] * 63.0F / 255.0F + 0.5F, 0.0F, 63.0F));
+		uint16_t const b = static_cast<uint16_t>(std::clamp(color[2] * 31.0F / 255.0F + 0.5F, 0.0F, 31.0F));
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	static void unpackRGB565(uint16_t packed, int color[3])
+	{
+		int const r = (packed >> 11) & 0x1F;
+		int const g = (packed >> 5) & 0x3F;
+		int const b = packed & 0x1F;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	static void encodeBC1(TexelBlock const& block, uint8_t* pBlock)
+	{
+		float low[4], high[4];
+		fitEndpoints(block, 3, low, high);
+
+		// 4 color mode requires color0 > color1, equal endpoints encode a solid block using index 0
+		uint16_t color0 = packRGB565(high);
+		uint16_t color1 = packRGB565(low);
+		if (color0 < color1) {
+			std::swap(color0, color1);
+		}
+
+		int palette[4][3];
+		unpackRGB565(color0, palette[0]);
+		unpackRGB565(color1, palette[1]);
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		uint32_t indices = 0;
+		if (color0 != color1)
+		{
+			for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+			{
+				uint32_t bestIndex = 0;
+				int bestDistance = std::numeric_limits<int>::max();
+				for (uint32_t index = 0; index < 4; index++)
+				{
+					int const distance = colorDistance(block[i], palette[index], 3);
+					if (distance < bestDistance)
+					{
+						bestIndex = index;
+						bestDistance = distance;
+					}
+				}
+
+				indices |= bestIndex << (2 * i);
+			}
+		}
+
+		pBlock[0] = static_cast<uint8_t>(color0 & 0xFF);
+		pBlock[1] = static_cast<uint8_t>(color0 >> 8);
+		pBlock[2] = static_cast<uint8_t>(color1 & 0xFF);
+		pBlock[3] = static_cast<uint8_t>(color1 >> 8);
+		for (uint32_t i = 0; i < 4; i++) {
+			pBlock[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+		}
+	}
+
+	static void decodeBC1(uint8_t const* pBlock, TexelBlock& block)
+	{
+		uint16_t const color0 = static_cast<uint16_t>(pBlock[0] | (pBlock[1] << 8));
+		uint16_t const color1 = static_cast<uint16_t>(pBlock[2] | (pBlock[3] << 8));
+
+		int palette[4][4];
+		unpackRGB565(color0, palette[0]);
+		unpackRGB565(color1, palette[1]);
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			if (color0 > color1)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+
+		palette[0][3] = palette[1][3] = palette[2][3] = 255;
+		palette[3][3] = (color0 > color1) ? 255 : 0;
+
+		uint32_t const indices = pBlock[4] | (pBlock[5] << 8) | (pBlock[6] << 16) | (static_cast<uint32_t>(pBlock[7]) << 24);
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			int const* pColor = palette[(indices >> (2 * i)) & 0x3];
+			for (uint32_t c = 0; c < 4; c++) {
+				block[i][c] = static_cast<uint8_t>(pColor[c]);
+			}
+		}
+	}
+
+	/// @brief Get the 8 palette values of a BC4 block.
+	static void paletteBC4(int endpoint0, int endpoint1, int palette[8])
+	{
+		palette[0] = endpoint0;
+		palette[1] = endpoint1;
+		if (endpoint0 > endpoint1)
+		{
+			for (int i = 2; i < 8; i++) {
+				palette[i] = ((8 - i) * endpoint0 + (i - 1) * endpoint1) / 7;
+			}
+		}
+		else
+		{
+			for (int i = 2; i < 6; i++) {
+				palette[i] = ((6 - i) * endpoint0 + (i - 1) * endpoint1) / 5;
+			}
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	static void encodeBC4(TexelBlock const& block, uint32_t channel, uint8_t* pBlock)
+	{
+		int minValue = 255;
+		int maxValue = 0;
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			minValue = std::min<int>(minValue, block[i][channel]);
+			maxValue = std::max<int>(maxValue, block[i][channel]);
+		}
+
+		// 8 value mode requires endpoint0 > endpoint1, solid blocks use index 0 only
+		int palette[8];
+		paletteBC4(maxValue, minValue, palette);
+
+		uint64_t indices = 0;
+		for (uint32_t i = 0; i < BLOCK_TEXELS && maxValue != minValue; i++)
+		{
+			uint64_t bestIndex = 0;
+			int bestDistance = std::numeric_limits<int>::max();
+			for (uint32_t index = 0; index < 8; index++)
+			{
+				int const distance = std::abs(palette[index] - block[i][channel]);
+				if (distance < bestDistance)
+				{
+					bestIndex = index;
+					bestDistance = distance;
+				}
+			}
+
+			indices |= bestIndex << (3 * i);
+		}
+
+		pBlock[0] = static_cast<uint8_t>(maxValue);
+		pBlock[1] = static_cast<uint8_t>(minValue);
+		for (uint32_t i = 0; i < 6; i++) {
+			pBlock[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+		}
+	}
+
+	static void decodeBC4(uint8_t const* pBlock, uint32_t channel, TexelBlock& block)
+	{
+		int palette[8];
+		paletteBC4(pBlock[0], pBlock[1], palette);
+
+		uint64_t indices = 0;
+		for (uint32_t i = 0; i < 6; i++) {
+			indices |= static_cast<uint64_t>(pBlock[2 + i]) << (8 * i);
+		}
+
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++) {
+			block[i][channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 0x7]);
+		}
+	}
+
+	/// @brief Little endian bit writer for 128 bit blocks.
+	struct BlockBitWriter
+	{
+		uint8_t*	pBlock;
+		uint32_t	offset;
+
+		void write(uint32_t value, uint32_t bits)
+		{
+			for (uint32_t i = 0; i < bits; i++, offset++)
+			{
+				if ((value >> i) & 1) {
+					pBlock[offset / 8] |= static_cast<uint8_t>(1 << (offset % 8));
+				}
+			}
+		}
+	};
+
+	/// @brief Little endian bit reader for 128 bit blocks.
+	struct BlockBitReader
+	{
+		uint8_t const*	pBlock;
+		uint32_t		offset;
+
+		uint32_t read(uint32_t bits)
+		{
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < bits; i++, offset++) {
+				value |= static_cast<uint32_t>((pBlock[offset / 8] >> (offset % 8)) & 1) << i;
+			}
+
+			return value;
+		}
+	};
+
+	/// @brief Quantize an endpoint to 7 bits per channel & a shared p-bit, picking the p-bit with the lowest error.
+	static void quantizeBC7Endpoint(float const endpoint[4], uint32_t quantized[4], uint32_t& pBit)
+	{
+		float bestError = std::numeric_limits<float>::max();
+		for (uint32_t p = 0; p < 2; p++)
+		{
+			uint32_t candidate[4];
+			float error = 0.0F;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				float const value = std::clamp((endpoint[c] - static_cast<float>(p)) * 0.5F + 0.5F, 0.0F, 127.0F);
+				candidate[c] = static_cast<uint32_t>(value);
+
+				float const delta = static_cast<float>((candidate[c] << 1) | p) - endpoint[c];
+				error += delta * delta;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				pBit = p;
+				std::copy(candidate, candidate + 4, quantized);
+			}
+		}
+	}
+
+	static void encodeBC7(TexelBlock const& block, uint8_t* pBlock)
+	{
+		float low[4], high[4];
+		fitEndpoints(block, 4, low, high);
+
+		uint32_t endpoints[2][4];
+		uint32_t pBits[2];
+		quantizeBC7Endpoint(low, endpoints[0], pBits[0]);
+		quantizeBC7Endpoint(high, endpoints[1], pBits[1]);
+
+		int palette[16][4];
+		for (uint32_t index = 0; index < 16; index++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				int const endpoint0 = static_cast<int>((endpoints[0][c] << 1) | pBits[0]);
+				int const endpoint1 = static_cast<int>((endpoints[1][c] << 1) | pBits[1]);
+				palette[index][c] = ((64 - BC7_WEIGHTS[index]) * endpoint0 + BC7_WEIGHTS[index] * endpoint1 + 32) >> 6;
+			}
+		}
+
+		uint32_t indices[BLOCK_TEXELS];
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			int bestDistance = std::numeric_limits<int>::max();
+			for (uint32_t index = 0; index < 16; index++)
+			{
+				int const distance = colorDistance(block[i], palette[index], 4);
+				if (distance < bestDistance)
+				{
+					indices[i] = index;
+					bestDistance = distance;
+				}
+			}
+		}
+
+		// The anchor texel index MSB is implicitly 0, swapping the endpoints inverts the indices
+		if (indices[0] & 0x8)
+		{
+			std::swap(endpoints[0], endpoints[1]);
+			std::swap(pBits[0], pBits[1]);
+			for (uint32_t i = 0; i < BLOCK_TEXELS; i++) {
+				indices[i] = 15 - indices[i];
+			}
+		}
+
+		std::memset(pBlock, 0, 16);
+		BlockBitWriter writer{ pBlock, 0 };
+		writer.write(1 << 6, 7);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			writer.write(endpoints[0][c], 7);
+			writer.write(endpoints[1][c], 7);
+		}
+
+		writer.write(pBits[0], 1);
+		writer.write(pBits[1], 1);
+		writer.write(indices[0], 3);
+		for (uint32_t i = 1; i < BLOCK_TEXELS; i++) {
+			writer.write(indices[i], 4);
+		}
+	}
+
+	static void decodeBC7(uint8_t const* pBlock, TexelBlock& block)
+	{
+		// Only mode 6 blocks are produced by the encoder, other modes decode to transparent black
+		if ((pBlock[0] & 0x7F) != (1 << 6))
+		{
+			std::memset(block, 0, sizeof(TexelBlock));
+			return;
+		}
+
+		BlockBitReader reader{ pBlock, 7 };
+		uint32_t endpoints[2][4];
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = reader.read(7);
+			endpoints[1][c] = reader.read(7);
+		}
+
+		uint32_t const pBit0 = reader.read(1);
+		uint32_t const pBit1 = reader.read(1);
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			uint32_t const weight = BC7_WEIGHTS[reader.read(i == 0 ? 3 : 4)];
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				uint32_t const endpoint0 = (endpoints[0][c] << 1) | pBit0;
+				uint32_t const endpoint1 = (endpoints[1][c] << 1) | pBit1;
+				block[i][c] = static_cast<uint8_t>(((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6);
+			}
+		}
+	}
+
+	/// @brief Check if a texel belongs to the second ETC sub block.
+	static bool etcSecondSubBlock(uint32_t x, uint32_t y, bool flip)
+	{
+		return flip ? (y >= 2) : (x >= 2);
+	}
+
+	/// @brief Pick the best modifier table & texel indices for an ETC sub block.
+	/// @return The squared error of the sub block.
+	static int fitETCSubBlock(TexelBlock const& block, bool flip, bool second, int const baseColor[3], uint32_t& table, uint32_t indices[BLOCK_TEXELS])
+	{
+		int bestError = std::numeric_limits<int>::max();
+		for (uint32_t candidate = 0; candidate < 8; candidate++)
+		{
+			int const modifiers[4] = {
+				ETC_MODIFIERS[candidate][0], ETC_MODIFIERS[candidate][1],
+				-ETC_MODIFIERS[candidate][0], -ETC_MODIFIERS[candidate][1],
+			};
+
+			int error = 0;
+			uint32_t candidateIndices[BLOCK_TEXELS] = {};
+			for (uint32_t i = 0; i < BLOCK_TEXELS && error < bestError; i++)
+			{
+				if (etcSecondSubBlock(i % COMPRESSION_BLOCK_SIZE, i / COMPRESSION_BLOCK_SIZE, flip) != second) {
+					continue;
+				}
+
+				int bestDistance = std::numeric_limits<int>::max();
+				for (uint32_t index = 0; index < 4; index++)
+				{
+					int const color[3] = {
+						clampByte(baseColor[0] + modifiers[index]),
+						clampByte(baseColor[1] + modifiers[index]),
+						clampByte(baseColor[2] + modifiers[index]),
+					};
+
+					int const distance = colorDistance(block[i], color, 3);
+					if (distance < bestDistance)
+					{
+						candidateIndices[i] = index;
+						bestDistance = distance;
+					}
+				}
+
+				error += bestDistance;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				table = candidate;
+				for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+				{
+					if (etcSecondSubBlock(i % COMPRESSION_BLOCK_SIZE, i / COMPRESSION_BLOCK_SIZE, flip) == second) {
+						indices[i] = candidateIndices[i];
+					}
+				}
+			}
+		}
+
+		return bestError;
+	}
+
+	static void encodeETC2(TexelBlock const& block, uint8_t* pBlock)
+	{
+		uint64_t bestBits = 0;
+		int bestError = std::numeric_limits<int>::max();
+		for (uint32_t flip = 0; flip < 2; flip++)
+		{
+			float average[2][3] = {};
+			for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+			{
+				uint32_t const subBlock = etcSecondSubBlock(i % COMPRESSION_BLOCK_SIZE, i / COMPRESSION_BLOCK_SIZE, flip != 0) ? 1 : 0;
+				for (uint32_t c = 0; c < 3; c++) {
+					average[subBlock][c] += block[i][c] / 8.0F;
+				}
+			}
+
+			// Differential mode stores 5 bit base colors, used when the second color is within reach of a 3 bit delta
+			int quantized[2][3];
+			int baseColors[2][3];
+			bool differential = true;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				quantized[0][c] = static_cast<int>(average[0][c] * 31.0F / 255.0F + 0.5F);
+				quantized[1][c] = static_cast<int>(average[1][c] * 31.0F / 255.0F + 0.5F);
+				int const delta = quantized[1][c] - quantized[0][c];
+				differential = differential && delta >= -4 && delta <= 3;
+			}
+
+			for (uint32_t s = 0; s < 2; s++)
+			{
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					if (!differential) {
+						quantized[s][c] = static_cast<int>(average[s][c] * 15.0F / 255.0F + 0.5F);
+					}
+
+					baseColors[s][c] = differential
+						? (quantized[s][c] << 3) | (quantized[s][c] >> 2)
+						: (quantized[s][c] << 4) | quantized[s][c];
+				}
+			}
+
+			uint32_t tables[2] = {};
+			uint32_t indices[BLOCK_TEXELS] = {};
+			int const error = fitETCSubBlock(block, flip != 0, false, baseColors[0], tables[0], indices)
+				+ fitETCSubBlock(block, flip != 0, true, baseColors[1], tables[1], indices);
+			if (error >= bestError) {
+				continue;
+			}
+
+			uint64_t bits = 0;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				uint32_t const shift = 59 - 8 * c;
+				if (differential)
+				{
+					bits |= static_cast<uint64_t>(quantized[0][c]) << shift;
+					bits |= static_cast<uint64_t>((quantized[1][c] - quantized[0][c]) & 0x7) << (shift - 3);
+				}
+				else
+				{
+					bits |= static_cast<uint64_t>(quantized[0][c]) << (shift + 1);
+					bits |= static_cast<uint64_t>(quantized[1][c]) << (shift - 3);
+				}
+			}
+
+			bits |= static_cast<uint64_t>(tables[0]) << 37;
+			bits |= static_cast<uint64_t>(tables[1]) << 34;
+			bits |= static_cast<uint64_t>(differential ? 1 : 0) << 33;
+			bits |= static_cast<uint64_t>(flip) << 32;
+
+			// Texel indices are stored column major, split into an MSB & an LSB plane
+			for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+			{
+				uint32_t const bit = (i % COMPRESSION_BLOCK_SIZE) * COMPRESSION_BLOCK_SIZE + (i / COMPRESSION_BLOCK_SIZE);
+				bits |= static_cast<uint64_t>(indices[i] >> 1) << (16 + bit);
+				bits |= static_cast<uint64_t>(indices[i] & 1) << bit;
+			}
+
+			bestBits = bits;
+			bestError = error;
+		}
+
+		for (uint32_t i = 0; i < 8; i++) {
+			pBlock[i] = static_cast<uint8_t>(bestBits >> (56 - 8 * i));
+		}
+	}
+
+	static void decodeETC2(uint8_t const* pBlock, TexelBlock& block)
+	{
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < 8; i++) {
+			bits = (bits << 8) | pBlock[i];
+		}
+
+		bool const differential = ((bits >> 33) & 1) != 0;
+		bool const flip = ((bits >> 32) & 1) != 0;
+		uint32_t const tables[2] = { static_cast<uint32_t>((bits >> 37) & 0x7), static_cast<uint32_t>((bits >> 34) & 0x7) };
+
+		// Only ETC1 compatible blocks are produced by the encoder, overflowing differential blocks (T, H & planar modes)
+		// decode to black
+		int baseColors[2][3];
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			uint32_t const shift = 59 - 8 * c;
+			if (differential)
+			{
+				int const base = static_cast<int>((bits >> shift) & 0x1F);
+				int const delta = static_cast<int>((bits >> (shift - 3)) & 0x7);
+				int const second = base + ((delta & 0x4) ? delta - 8 : delta);
+				if (second < 0 || second > 31)
+				{
+					std::memset(block, 0, sizeof(TexelBlock));
+					return;
+				}
+
+				baseColors[0][c] = (base << 3) | (base >> 2);
+				baseColors[1][c] = (second << 3) | (second >> 2);
+			}
+			else
+			{
+				int const first = static_cast<int>((bits >> (shift + 1)) & 0xF);
+				int const second = static_cast<int>((bits >> (shift - 3)) & 0xF);
+				baseColors[0][c] = (first << 4) | first;
+				baseColors[1][c] = (second << 4) | second;
+			}
+		}
+
+		for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+		{
+			uint32_t const x = i % COMPRESSION_BLOCK_SIZE;
+			uint32_t const y = i / COMPRESSION_BLOCK_SIZE;
+			uint32_t const subBlock = etcSecondSubBlock(x, y, flip) ? 1 : 0;
+			uint32_t const bit = x * COMPRESSION_BLOCK_SIZE + y;
+			uint32_t const index = static_cast<uint32_t>((((bits >> (16 + bit)) & 1) << 1) | ((bits >> bit) & 1));
+
+			int const magnitude = ETC_MODIFIERS[tables[subBlock]][index & 1];
+			int const modifier = (index & 2) ? -magnitude : magnitude;
+			for (uint32_t c = 0; c < 3; c++) {
+				block[i][c] = clampByte(baseColors[subBlock][c] + modifier);
+			}
+
+			block[i][3] = 255;
+		}
+	}
+
+	uint32_t blockBytes(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:
+		case BlockFormat::ETC2RGB8:
+			return 8;
+		case BlockFormat::BC5:
+		case BlockFormat::BC7:
+			return 16;
+		case BlockFormat::None:
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	size_t compressedSize(BlockFormat format, uint32_t width, uint32_t height)
+	{
+		size_t const blocksX = (width + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		size_t const blocksY = (height + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		return blocksX * blocksY * blockBytes(format);
+	}
+
+	double minimumPsnr(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:
+		case BlockFormat::ETC2RGB8:
+			return 30.0;
+		case BlockFormat::BC5:
+			return 38.0;
+		case BlockFormat::BC7:
+			return 34.0;
+		case BlockFormat::None:
+		default:
+			break;
+		}
+
+		return std::numeric_limits<double>::infinity();
+	}
+
+	void compressImage(BlockFormat format, uint32_t width, uint32_t height, uint8_t const* pTexels, uint8_t* pBlocks)
+	{
+		assert(format != BlockFormat::None && "Cannot compress to uncompressed texels");
+		assert(width > 0 && height > 0 && "Image extent cannot be 0 in any direction");
+
+		uint32_t const blocksX = (width + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		uint32_t const blocksY = (height + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		uint32_t const bytes = blockBytes(format);
+
+		TexelBlock block;
+		for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+		{
+			for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+			{
+				loadBlock(pTexels, width, height, blockX, blockY, block);
+				uint8_t* pBlock = pBlocks + (static_cast<size_t>(blockY) * blocksX + blockX) * bytes;
+				switch (format)
+				{
+				case BlockFormat::BC1:
+					encodeBC1(block, pBlock);
+					break;
+				case BlockFormat::BC5:
+					encodeBC4(block, 0, pBlock);
+					encodeBC4(block, 1, pBlock + 8);
+					break;
+				case BlockFormat::BC7:
+					encodeBC7(block, pBlock);
+					break;
+				case BlockFormat::ETC2RGB8:
+					encodeETC2(block, pBlock);
+					break;
+				case BlockFormat::None:
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	void decompressImage(BlockFormat format, uint32_t width, uint32_t height, uint8_t const* pBlocks, uint8_t* pTexels)
+	{
+		assert(format != BlockFormat::None && "Cannot decompress uncompressed texels");
+
+		uint32_t const blocksX = (width + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		uint32_t const blocksY = (height + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		uint32_t const bytes = blockBytes(format);
+
+		TexelBlock block;
+		for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+		{
+			for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+			{
+				uint8_t const* pBlock = pBlocks + (static_cast<size_t>(blockY) * blocksX + blockX) * bytes;
+				switch (format)
+				{
+				case BlockFormat::BC1:
+					decodeBC1(pBlock, block);
+					break;
+				case BlockFormat::BC5:
+					for (uint32_t i = 0; i < BLOCK_TEXELS; i++)
+					{
+						block[i][2] = 0;
+						block[i][3] = 255;
+					}
+
+					decodeBC4(pBlock, 0, block);
+					decodeBC4(pBlock + 8, 1, block);
+					break;
+				case BlockFormat::BC7:
+					decodeBC7(pBlock, block);
+					break;
+				case BlockFormat::ETC2RGB8:
+					decodeETC2(pBlock, block);
+					break;
+				case BlockFormat::None:
+				default:
+					break;
+				}
+
+				storeBlock(block, width, height, blockX, blockY, pTexels);
+			}
+		}
+	}
+
+	double computePsnr(BlockFormat format, uint8_t const* pReference, uint8_t const* pTexels, size_t texelCount)
+	{
+		uint32_t channels = 4;
+		if (format == BlockFormat::BC5) {
+			channels = 2;
+		}
+		else if (format == BlockFormat::BC1 || format == BlockFormat::ETC2RGB8) {
+			channels = 3;
+		}
+
+		double squaredError = 0.0;
+		for (size_t i = 0; i < texelCount; i++)
+		{
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				double const delta = static_cast<double>(pReference[i * 4 + c]) - static_cast<double>(pTexels[i * 4 + c]);
+				squaredError += delta * delta;
+			}
+		}
+
+		if (squaredError == 0.0 || texelCount == 0) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		double const meanSquaredError = squaredError / static_cast<double>(texelCount * channels);
+		return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+} // namespace gfx
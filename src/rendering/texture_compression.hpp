@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gfx
+{
+	/// @brief Block compressed texture formats, every block stores 4x4 texels.
+	enum class BlockFormat
+	{
+		None,		// Uncompressed texels
+		BC1,		// Opaque RGB, 8 bytes per block
+		BC5,		// Two channel RG, used for normal maps, 16 bytes per block
+		BC7,		// RGBA, 16 bytes per block, only mode 6 blocks are encoded
+		ETC2RGB8,	// Opaque RGB, 8 bytes per block, only ETC1 compatible blocks are encoded
+	};
+
+	/// @brief Block formats supported by the device, textures are compressed to supported formats only.
+	struct BlockFormatSupport
+	{
+		bool	bc		= false;	// BC1/BC5/BC7
+		bool	etc2	= false;	// ETC2RGB8
+	};
+
+	static constexpr uint32_t COMPRESSION_BLOCK_SIZE = 4;
+
+	/// @brief Get the size of a compressed block in bytes.
+	/// @param format
+	/// @return The block size, 0 for uncompressed texels.
+	uint32_t blockBytes(BlockFormat format);
+
+	/// @brief Get the size of a compressed image in bytes, partial blocks at the image edges count as full blocks.
+	/// @param format
+	/// @param width
+	/// @param height
+	/// @return
+	size_t compressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+	/// @brief Get the minimum PSNR expected of a block format, lower values indicate an encoder regression.
+	/// @param format
+	/// @return
+	double minimumPsnr(BlockFormat format);
+
+	/// @brief Compress an RGBA image into blocks, edge texels are repeated to fill partial blocks.
+	/// @param format
+	/// @param width
+	/// @param height
+	/// @param pTexels Tightly packed RGBA texels.
+	/// @param pBlocks Output blocks, must hold compressedSize(format, width, height) bytes.
+	void compressImage(BlockFormat format, uint32_t width, uint32_t height, uint8_t const* pTexels, uint8_t* pBlocks);
+
+	/// @brief Decompress blocks into an RGBA image, channels not stored by the format are 0, alpha defaults to 255.
+	/// @param format
+	/// @param width
+	/// @param height
+	/// @param pBlocks
+	/// @param pTexels Output texels, must hold width * height RGBA texels.
+	void decompressImage(BlockFormat format, uint32_t width, uint32_t height, uint8_t const* pBlocks, uint8_t* pTexels);
+
+	/// @brief Compute the PSNR between two RGBA images over the channels stored by a block format.
+	/// @param format
+	/// @param pReference
+	/// @param pTexels
+	/// @param texelCount
+	/// @return The PSNR in dB, infinity for identical images.
+	double computePsnr(BlockFormat format, uint8_t const* pReference, uint8_t const* pTexels, size_t texelCount);
+} // namespace gfx
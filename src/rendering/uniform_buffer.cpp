@@ -0,0 +1,99 @@
+#include "uniform_buffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "core/memory.hpp"
+
+namespace gfx
+{
+	UniformBuffer::UniformBuffer(char const* label, size_t uniformSize, size_t alignment, WGPUBufferUsageFlags usage)
+		:
+		m_label(label),
+		m_usage(usage | WGPUBufferUsage_CopyDst),
+		m_uniformSize(uniformSize),
+		m_stride(core::alignAddress(uniformSize, alignment)),
+		m_data(MIN_SLOT_CAPACITY * m_stride, 0)
+	{
+		//
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		if (m_buffer) {
+			wgpuBufferRelease(m_buffer);
+		}
+	}
+
+	bool UniformBuffer::update(uint32_t slot, void const* pData)
+	{
+		assert(pData != nullptr && "Uniform data cannot be a nullptr");
+
+		// Grow capacity geometrically, the device buffer is recreated on the next upload
+		size_t const offset = slot * m_stride;
+		if (offset + m_stride > m_data.size()) {
+			m_data.resize(std::max(offset + m_stride, m_data.size() * 2), 0);
+		}
+
+		if (std::memcmp(m_data.data() + offset, pData, m_uniformSize) == 0) {
+			return false;
+		}
+
+		std::memcpy(m_data.data() + offset, pData, m_uniformSize);
+		if (m_dirtyBegin >= m_dirtyEnd)
+		{
+			m_dirtyBegin = offset;
+			m_dirtyEnd = offset + m_stride;
+		}
+		else
+		{
+			m_dirtyBegin = std::min(m_dirtyBegin, offset);
+			m_dirtyEnd = std::max(m_dirtyEnd, offset + m_stride);
+		}
+
+		return true;
+	}
+
+	void const* UniformBuffer::data(uint32_t slot) const
+	{
+		assert((slot + 1) * m_stride <= m_data.size() && "Uniform slot out of range");
+		return m_data.data() + slot * m_stride;
+	}
+
+	bool UniformBuffer::upload(WGPUDevice device, WGPUQueue queue)
+	{
+		m_uploadedBytes = 0;
+
+		bool recreated = false;
+		if (m_buffer == nullptr || wgpuBufferGetSize(m_buffer) < m_data.size())
+		{
+			if (m_buffer) {
+				wgpuBufferRelease(m_buffer);
+			}
+
+			WGPUBufferDescriptor bufferDesc{};
+			bufferDesc.nextInChain = nullptr;
+			bufferDesc.label = m_label;
+			bufferDesc.usage = m_usage;
+			bufferDesc.size = m_data.size();
+			bufferDesc.mappedAtCreation = false;
+
+			// New buffers start out empty, so all host-side data has to be written
+			m_buffer = wgpuDeviceCreateBuffer(device, &bufferDesc);
+			m_dirtyBegin = 0;
+			m_dirtyEnd = m_data.size();
+			recreated = true;
+		}
+
+		if (m_dirtyBegin < m_dirtyEnd)
+		{
+			wgpuQueueWriteBuffer(queue, m_buffer, m_dirtyBegin, m_data.data() + m_dirtyBegin, m_dirtyEnd - m_dirtyBegin);
+			m_uploadedBytes = m_dirtyEnd - m_dirtyBegin;
+			m_dirtyBegin = 0;
+			m_dirtyEnd = 0;
+		}
+
+		return recreated;
+	}
+} // namespace gfx
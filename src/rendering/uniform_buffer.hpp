@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <webgpu/webgpu.h>
+
+namespace gfx
+{
+	/// @brief The UniformBuffer class stores fixed size uniform slots in a device buffer along with a host-side copy.
+	/// Slots are only marked dirty when their contents change, all dirty slots are written to the device in a single
+	/// contiguous write. The device buffer may also be bound as a storage buffer, with slots as array elements.
+	class UniformBuffer
+	{
+	public:
+		static constexpr uint32_t MIN_SLOT_CAPACITY = 64;
+
+		/// @brief Create a new uniform buffer, the device buffer is created on the first upload.
+		/// @param label Device buffer label.
+		/// @param uniformSize Size of a single uniform slot in bytes.
+		/// @param alignment Minimum uniform buffer offset alignment of the device, or the array stride for storage buffers.
+		/// @param usage Device buffer usage, copy destination usage is always added.
+		UniformBuffer(char const* label, size_t uniformSize, size_t alignment, WGPUBufferUsageFlags usage = WGPUBufferUsage_Uniform);
+		~UniformBuffer();
+
+		UniformBuffer(UniformBuffer const&) = delete;
+		UniformBuffer& operator=(UniformBuffer const&) = delete;
+
+		/// @brief Update the host-side data of a slot, growing the buffer if needed.
+		/// @param slot Slot index.
+		/// @param pData Uniform data, uniformSize bytes in size.
+		/// @return A boolean indicating the slot contents changed.
+		bool update(uint32_t slot, void const* pData);
+
+		/// @brief Write all dirty slots to the device buffer, recreating it if the slot capacity grew.
+		/// @param device Device used to create the buffer.
+		/// @param queue Queue used to write buffer data.
+		/// @return A boolean indicating the device buffer was recreated, bind groups referencing it must be recreated.
+		bool upload(WGPUDevice device, WGPUQueue queue);
+
+		/// @brief Retrieve the host-side data of a slot.
+		/// @param slot Slot index, must have been updated before.
+		/// @return 
+		void const* data(uint32_t slot) const;
+
+		/// @brief Retrieve the device buffer.
+		/// @return 
+		WGPUBuffer buffer() const { return m_buffer; }
+
+		/// @brief Retrieve the distance between slots in bytes.
+		/// @return 
+		size_t stride() const { return m_stride; }
+
+		/// @brief Retrieve the number of bytes written to the device by the last upload.
+		/// @return 
+		size_t uploadedBytes() const { return m_uploadedBytes; }
+
+	private:
+		char const*				m_label			= nullptr;
+		WGPUBufferUsageFlags	m_usage			= WGPUBufferUsage_None;
+		size_t					m_uniformSize	= 0;
+		size_t					m_stride		= 0;
+		std::vector<uint8_t>	m_data			= {};	// Host-side copy of the device buffer contents
+		size_t					m_dirtyBegin	= 0;	// Dirty byte range, empty if begin >= end
+		size_t					m_dirtyEnd		= 0;
+		size_t					m_uploadedBytes	= 0;
+		WGPUBuffer				m_buffer		= nullptr;
+	};
+} // namespace gfx
@@ -0,0 +1,283 @@
+#include "upload_manager.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+#include "core/memory.hpp"
+#include "core/timer.hpp"
+#include "rendering/texture_compression.hpp"
+
+namespace gfx
+{
+	/// @brief Required alignment of buffer copy offsets & sizes.
+	static constexpr size_t COPY_BUFFER_ALIGNMENT = 4;
+
+	/// @brief Required alignment of bytes per row in buffer to texture copies.
+	static constexpr size_t COPY_BYTES_PER_ROW_ALIGNMENT = 256;
+
+	UploadManager::UploadManager(WGPUDevice device, WGPUQueue queue, size_t frameBudget)
+		:
+		m_device(device),
+		m_queue(queue),
+		m_frameBudget(frameBudget),
+		m_maxRingBuffers(std::max<size_t>(frameBudget / STAGING_BUFFER_SIZE, 1))
+	{
+		assert(m_device != nullptr && m_queue != nullptr && "Upload manager requires a valid device & queue");
+	}
+
+	UploadManager::~UploadManager()
+	{
+		if (m_encoder) wgpuCommandEncoderRelease(m_encoder);
+
+		// Destroying a buffer with a pending map fires its callback, so buffers are destroyed before their state is freed
+		for (auto& pStaging : m_stagingBuffers)
+		{
+			wgpuBufferDestroy(pStaging->buffer);
+			wgpuBufferRelease(pStaging->buffer);
+		}
+	}
+
+	void UploadManager::beginFrame()
+	{
+		releaseIdleBuffers();
+
+		m_stats.bytesUploaded = 0;
+		m_stats.uploads = 0;
+		m_stats.uploadTime = 0.0;
+	}
+
+	bool UploadManager::canUpload(size_t size) const
+	{
+		return m_stats.bytesUploaded == 0 || m_stats.bytesUploaded + size <= m_frameBudget;
+	}
+
+	void UploadManager::uploadBuffer(WGPUBuffer buffer, uint64_t offset, void const* pData, size_t size)
+	{
+		assert(offset % COPY_BUFFER_ALIGNMENT == 0 && size % COPY_BUFFER_ALIGNMENT == 0 && "Buffer uploads must be 4 byte aligned");
+		if (size == 0) {
+			return;
+		}
+
+		core::Timer timer{};
+		StagingAllocation const staging = allocate(size, COPY_BUFFER_ALIGNMENT);
+		std::memcpy(staging.pData, pData, size);
+		wgpuCommandEncoderCopyBufferToBuffer(encoder(), staging.buffer, staging.offset, buffer, offset, size);
+
+		timer.tick();
+		m_stats.bytesUploaded += size;
+		m_stats.uploads++;
+		m_stats.uploadTime += timer.delta();
+	}
+
+	void UploadManager::copyBuffer(WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, size_t size)
+	{
+		assert(sourceOffset % COPY_BUFFER_ALIGNMENT == 0 && destinationOffset % COPY_BUFFER_ALIGNMENT == 0
+			&& size % COPY_BUFFER_ALIGNMENT == 0 && "Buffer copies must be 4 byte aligned");
+		if (size == 0) {
+			return;
+		}
+
+		wgpuCommandEncoderCopyBufferToBuffer(encoder(), source, sourceOffset, destination, destinationOffset, size);
+	}
+
+	void UploadManager::uploadTexture(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& extent, uint32_t bytesPerTexel, void const* pData)
+	{
+		uploadTextureRows(texture, mipLevel, extent, static_cast<size_t>(extent.width) * bytesPerTexel, extent.height, pData);
+	}
+
+	void UploadManager::uploadCompressedTexture(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& extent, uint32_t bytesPerBlock, void const* pData)
+	{
+		// Copies of compressed textures cover whole blocks, small mip levels are padded to the physical block size
+		uint32_t const blocksX = (extent.width + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		uint32_t const blocksY = (extent.height + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+		WGPUExtent3D const copyExtent{ blocksX * COMPRESSION_BLOCK_SIZE, blocksY * COMPRESSION_BLOCK_SIZE, extent.depthOrArrayLayers };
+		uploadTextureRows(texture, mipLevel, copyExtent, static_cast<size_t>(blocksX) * bytesPerBlock, blocksY, pData);
+	}
+
+	void UploadManager::uploadTextureRows(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& copyExtent, size_t rowSize, uint32_t rowsPerImage, void const* pData)
+	{
+		core::Timer timer{};
+
+		// Buffer to texture copies require aligned rows, so rows are repacked while writing the staging buffer
+		size_t const stagingRowSize = core::alignAddress(rowSize, COPY_BYTES_PER_ROW_ALIGNMENT);
+		size_t const rowCount = static_cast<size_t>(rowsPerImage) * static_cast<size_t>(copyExtent.depthOrArrayLayers);
+		StagingAllocation const staging = allocate(stagingRowSize * rowCount, COPY_BYTES_PER_ROW_ALIGNMENT);
+
+		uint8_t const* pSource = static_cast<uint8_t const*>(pData);
+		for (size_t row = 0; row < rowCount; row++) {
+			std::memcpy(staging.pData + row * stagingRowSize, pSource + row * rowSize, rowSize);
+		}
+
+		WGPUImageCopyBuffer source{};
+		source.nextInChain = nullptr;
+		source.buffer = staging.buffer;
+		source.layout.nextInChain = nullptr;
+		source.layout.offset = staging.offset;
+		source.layout.bytesPerRow = static_cast<uint32_t>(stagingRowSize);
+		source.layout.rowsPerImage = rowsPerImage;
+
+		WGPUImageCopyTexture destination{};
+		destination.nextInChain = nullptr;
+		destination.texture = texture;
+		destination.mipLevel = mipLevel;
+		destination.origin = { 0, 0, 0 };
+		destination.aspect = WGPUTextureAspect_All;
+
+		wgpuCommandEncoderCopyBufferToTexture(encoder(), &source, &destination, &copyExtent);
+
+		timer.tick();
+		m_stats.bytesUploaded += rowSize * rowCount;
+		m_stats.uploads++;
+		m_stats.uploadTime += timer.delta();
+	}
+
+	void UploadManager::submit()
+	{
+		if (m_encoder == nullptr) {
+			return;
+		}
+
+		core::Timer timer{};
+
+		// Staging buffers written this frame must be unmapped before the copies are submitted
+		for (auto& pStaging : m_stagingBuffers)
+		{
+			if (pStaging->state == StagingState::Mapped && pStaging->offset > 0)
+			{
+				wgpuBufferUnmap(pStaging->buffer);
+				pStaging->pMapped = nullptr;
+				pStaging->state = StagingState::Pending;
+			}
+		}
+
+		WGPUCommandBufferDescriptor commandBufferDesc{};
+		commandBufferDesc.nextInChain = nullptr;
+		commandBufferDesc.label = "Upload Commands";
+		WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(m_encoder, &commandBufferDesc);
+		wgpuQueueSubmit(m_queue, 1, &commandBuffer);
+		wgpuCommandBufferRelease(commandBuffer);
+		wgpuCommandEncoderRelease(m_encoder);
+		m_encoder = nullptr;
+
+		// Map submitted buffers again, they are reused once the device has finished the copies
+		// NOTE: dedicated buffers are mapped as well, a completed map signals they can be destroyed
+		auto const callback = [](WGPUBufferMapAsyncStatus status, void* pUserData)
+		{
+			StagingBuffer& staging = *static_cast<StagingBuffer*>(pUserData);
+			if (status != WGPUBufferMapAsyncStatus_Success)
+			{
+				SPDLOG_WARN("Staging buffer map failed with status {}", static_cast<uint32_t>(status));
+				return;
+			}
+
+			staging.pMapped = static_cast<uint8_t*>(wgpuBufferGetMappedRange(staging.buffer, 0, staging.size));
+			staging.offset = 0;
+			staging.state = StagingState::Mapped;
+		};
+
+		for (auto& pStaging : m_stagingBuffers)
+		{
+			if (pStaging->state == StagingState::Pending && pStaging->offset > 0)
+			{
+				pStaging->offset = 0;
+				wgpuBufferMapAsync(pStaging->buffer, WGPUMapMode_Write, 0, pStaging->size, callback, pStaging.get());
+			}
+		}
+
+		timer.tick();
+		m_stats.uploadTime += timer.delta();
+	}
+
+	UploadManager::StagingAllocation UploadManager::allocate(size_t size, size_t alignment)
+	{
+		// Search the ring for a mapped buffer with enough space, starting at the last used buffer
+		for (size_t i = 0; i < m_stagingBuffers.size(); i++)
+		{
+			size_t const index = (m_ringIndex + i) % m_stagingBuffers.size();
+			StagingBuffer& staging = *m_stagingBuffers[index];
+			if (staging.state != StagingState::Mapped || staging.dedicated) {
+				continue;
+			}
+
+			size_t const offset = core::alignAddress(staging.offset, alignment);
+			if (offset + size <= staging.size)
+			{
+				staging.offset = offset + size;
+				staging.idleFrames = 0;
+				m_ringIndex = index;
+				return StagingAllocation{ staging.buffer, offset, staging.pMapped + offset };
+			}
+		}
+
+		// Create a new staging buffer, uploads larger than the default size get a dedicated buffer
+		auto pStaging = std::make_unique<StagingBuffer>();
+		pStaging->size = std::max(STAGING_BUFFER_SIZE, core::alignAddress(size, COPY_BUFFER_ALIGNMENT));
+		pStaging->dedicated = (size > STAGING_BUFFER_SIZE);
+
+		WGPUBufferDescriptor bufferDesc{};
+		bufferDesc.nextInChain = nullptr;
+		bufferDesc.label = "Staging Buffer";
+		bufferDesc.usage = WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc;
+		bufferDesc.size = pStaging->size;
+		bufferDesc.mappedAtCreation = true;
+
+		pStaging->buffer = wgpuDeviceCreateBuffer(m_device, &bufferDesc);
+		pStaging->pMapped = static_cast<uint8_t*>(wgpuBufferGetMappedRange(pStaging->buffer, 0, pStaging->size));
+		pStaging->offset = size;
+		pStaging->state = StagingState::Mapped;
+		SPDLOG_TRACE("Created {} staging buffer ({} bytes)", pStaging->dedicated ? "dedicated" : "ring", pStaging->size);
+
+		m_ringIndex = pStaging->dedicated ? m_ringIndex : m_stagingBuffers.size();
+		m_stagingBuffers.push_back(std::move(pStaging));
+		m_stats.stagingBuffers = m_stagingBuffers.size();
+
+		StagingBuffer const& staging = *m_stagingBuffers.back();
+		return StagingAllocation{ staging.buffer, 0, staging.pMapped };
+	}
+
+	void UploadManager::releaseIdleBuffers()
+	{
+		size_t ringBufferCount = static_cast<size_t>(std::count_if(m_stagingBuffers.begin(), m_stagingBuffers.end(),
+			[](std::unique_ptr<StagingBuffer> const& pStaging) { return !pStaging->dedicated; }));
+
+		for (size_t i = 0; i < m_stagingBuffers.size();)
+		{
+			// Buffers that are not mapped yet still have copies in flight, and are referenced by their map callback
+			StagingBuffer& staging = *m_stagingBuffers[i];
+			bool const idle = (staging.state == StagingState::Mapped && staging.offset == 0);
+			if (idle && !staging.dedicated) {
+				staging.idleFrames++;
+			}
+
+			bool const trimmed = idle && !staging.dedicated && ringBufferCount > m_maxRingBuffers && staging.idleFrames >= STAGING_TRIM_FRAMES;
+			if (!(idle && staging.dedicated) && !trimmed)
+			{
+				i++;
+				continue;
+			}
+
+			SPDLOG_TRACE("Released {} staging buffer ({} bytes)", staging.dedicated ? "dedicated" : "idle ring", staging.size);
+			ringBufferCount -= staging.dedicated ? 0 : 1;
+			wgpuBufferDestroy(staging.buffer);
+			wgpuBufferRelease(staging.buffer);
+			m_stagingBuffers.erase(m_stagingBuffers.begin() + static_cast<std::ptrdiff_t>(i));
+		}
+
+		m_stats.stagingBuffers = m_stagingBuffers.size();
+	}
+
+	WGPUCommandEncoder UploadManager::encoder()
+	{
+		if (m_encoder == nullptr)
+		{
+			WGPUCommandEncoderDescriptor encoderDesc{};
+			encoderDesc.nextInChain = nullptr;
+			encoderDesc.label = "Upload Command Encoder";
+			m_encoder = wgpuDeviceCreateCommandEncoder(m_device, &encoderDesc);
+		}
+
+		return m_encoder;
+	}
+} // namespace gfx
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <webgpu/webgpu.h>
+
+namespace gfx
+{
+	/// @brief Upload counters, reset at the start of each frame.
+	struct UploadStats
+	{
+		size_t	bytesUploaded	= 0;	// Bytes copied through staging buffers this frame
+		size_t	uploads			= 0;	// Buffer & texture uploads recorded this frame
+		size_t	stagingBuffers	= 0;	// Staging buffers owned by the upload manager
+		double	uploadTime		= 0.0;	// CPU time spent staging & submitting uploads in milliseconds
+	};
+
+	/// @brief The UploadManager class batches buffer and texture uploads through a ring of staging buffers.
+	/// Staging buffers stay mapped while they are being written, all copies of a frame are recorded into a single command
+	/// encoder and submitted at once. Submitted staging buffers are mapped again asynchronously and reused once the device
+	/// is done with them. Uploads are limited by a per-frame byte budget so that streaming bursts are spread over frames.
+	/// Uploads larger than a staging buffer get a dedicated buffer that is destroyed once its copy completed, and the ring
+	/// is trimmed back to the frame budget once a burst has passed.
+	class UploadManager
+	{
+	public:
+		static constexpr size_t STAGING_BUFFER_SIZE = 4 * 1024 * 1024;
+		static constexpr size_t DEFAULT_FRAME_BUDGET = 16 * 1024 * 1024;
+		static constexpr uint32_t STAGING_TRIM_FRAMES = 120;	// Frames a ring buffer must stay unused before it can be trimmed
+
+		/// @brief Create a new upload manager.
+		/// @param device Device used to create staging buffers & command encoders.
+		/// @param queue Queue uploads are submitted to.
+		/// @param frameBudget Maximum number of bytes uploaded per frame.
+		UploadManager(WGPUDevice device, WGPUQueue queue, size_t frameBudget = DEFAULT_FRAME_BUDGET);
+		~UploadManager();
+
+		UploadManager(UploadManager const&) = delete;
+		UploadManager& operator=(UploadManager const&) = delete;
+
+		/// @brief Start a new upload frame, resetting the frame budget & counters and releasing idle staging buffers.
+		void beginFrame();
+
+		/// @brief Check if an upload fits in the remaining frame budget.
+		/// The first upload of a frame always fits, so uploads larger than the budget still make progress.
+		/// @param size Upload size in bytes.
+		/// @return 
+		bool canUpload(size_t size) const;
+
+		/// @brief Upload data to a device buffer.
+		/// @param buffer Destination buffer, must have CopyDst usage.
+		/// @param offset Destination offset in bytes, must be a multiple of 4.
+		/// @param pData Source data.
+		/// @param size Source data size in bytes, must be a multiple of 4.
+		void uploadBuffer(WGPUBuffer buffer, uint64_t offset, void const* pData, size_t size);
+
+		/// @brief Copy data between device buffers, ordered after all uploads recorded before it this frame.
+		/// Copies are not counted against the frame budget, as no data passes through staging buffers.
+		/// @param source Source buffer, must have CopySrc usage.
+		/// @param sourceOffset Source offset in bytes, must be a multiple of 4.
+		/// @param destination Destination buffer, must have CopyDst usage.
+		/// @param destinationOffset Destination offset in bytes, must be a multiple of 4.
+		/// @param size Copy size in bytes, must be a multiple of 4.
+		void copyBuffer(WGPUBuffer source, uint64_t sourceOffset, WGPUBuffer destination, uint64_t destinationOffset, size_t size);
+
+		/// @brief Upload tightly packed texel data to a texture mip level.
+		/// @param texture Destination texture, must have CopyDst usage.
+		/// @param mipLevel Destination mip level.
+		/// @param extent Extent of the mip level.
+		/// @param bytesPerTexel Size of a single texel in bytes.
+		/// @param pData Source texel data, rows are tightly packed.
+		void uploadTexture(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& extent, uint32_t bytesPerTexel, void const* pData);
+
+		/// @brief Upload tightly packed 4x4 compressed blocks to a texture mip level.
+		/// @param texture Destination texture, must have CopyDst usage & a block compressed format.
+		/// @param mipLevel Destination mip level.
+		/// @param extent Extent of the mip level in texels, partial blocks are copied as full blocks.
+		/// @param bytesPerBlock Size of a single block in bytes.
+		/// @param pData Source block data, block rows are tightly packed.
+		void uploadCompressedTexture(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& extent, uint32_t bytesPerBlock, void const* pData);
+
+		/// @brief Submit all uploads recorded this frame in a single command buffer.
+		void submit();
+
+		/// @brief Retrieve the upload counters of the current frame.
+		/// @return 
+		UploadStats const& stats() const { return m_stats; }
+
+	private:
+		/// @brief Staging buffer mapping state.
+		enum class StagingState
+		{
+			Mapped,		// Mapped and available for writes
+			Pending,	// Submitted, waiting to be mapped again
+		};
+
+		/// @brief Staging buffer in the ring along with its write offset.
+		struct StagingBuffer
+		{
+			WGPUBuffer		buffer		= nullptr;
+			size_t			size		= 0;
+			size_t			offset		= 0;		// Write offset, non-zero if written this frame
+			uint8_t*		pMapped		= nullptr;
+			StagingState	state		= StagingState::Mapped;
+			uint32_t		idleFrames	= 0;		// Consecutive frames this buffer was mapped but not written
+			bool			dedicated	= false;	// Created for a single upload, never part of the ring
+		};
+
+		/// @brief Staging memory for a single upload.
+		struct StagingAllocation
+		{
+			WGPUBuffer	buffer	= nullptr;
+			uint64_t	offset	= 0;
+			uint8_t*	pData	= nullptr;
+		};
+
+		/// @brief Allocate staging memory from the first mapped staging buffer with enough space, creating a new
+		/// staging buffer if none are available.
+		/// @param size 
+		/// @param alignment 
+		/// @return 
+		StagingAllocation allocate(size_t size, size_t alignment);
+
+		/// @brief Destroy dedicated staging buffers whose copies have completed, and ring buffers that stayed unused for
+		/// STAGING_TRIM_FRAMES while the ring holds more buffers than the frame budget needs.
+		void releaseIdleBuffers();
+
+		/// @brief Upload tightly packed rows to a texture mip level, repacking rows to the copy row alignment.
+		/// @param texture 
+		/// @param mipLevel 
+		/// @param copyExtent Copy extent in texels, a multiple of the block size for compressed textures.
+		/// @param rowSize Size of a texel or block row in bytes.
+		/// @param rowsPerImage Number of texel or block rows per array layer.
+		/// @param pData 
+		void uploadTextureRows(WGPUTexture texture, uint32_t mipLevel, WGPUExtent3D const& copyExtent, size_t rowSize, uint32_t rowsPerImage, void const* pData);
+
+		/// @brief Retrieve the frame command encoder, creating it for the first upload of a frame.
+		/// @return 
+		WGPUCommandEncoder encoder();
+
+	private:
+		WGPUDevice									m_device			= nullptr;
+		WGPUQueue									m_queue				= nullptr;
+		size_t										m_frameBudget		= 0;
+		size_t										m_maxRingBuffers	= 0;	// Ring size kept after trimming idle buffers
+		WGPUCommandEncoder							m_encoder			= nullptr;
+		size_t										m_ringIndex			= 0;	// Staging buffer to start allocation searches at
+		std::vector<std::unique_ptr<StagingBuffer>>	m_stagingBuffers	= {};	// Heap allocated, map callbacks reference them
+		UploadStats									m_stats				= {};
+	};
+} // namespace gfx
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace gfx
 {
+	/// @brief Vertex layouts supported by meshes, each layout maps to a render pipeline.
+	enum class VertexLayout
+	{
+		Static,
+		Voxel,
+	};
+
 	/// @brief Simple layout for static vertices.
 	struct Vertex
 	{
@@ -12,4 +20,30 @@ namespace gfx
 		glm::vec3 tangent;
 		glm::vec2 texcoord;
 	};
+
+	/// @brief Packed layout for axis aligned voxel faces.
+	/// Normal, tangent and texcoords are reconstructed from the face index and chunk-local position in the vertex shader.
+	struct VoxelVertex
+	{
+		uint32_t positionFace;	// x: 6 bits | y: 6 bits | z: 6 bits | face: 3 bits | ambient occlusion: 2 bits
+		uint32_t material;		// texture layer: 16 bits
+
+		/// @brief Pack voxel vertex data.
+		/// @param x Chunk-local x position in range [0, 63].
+		/// @param y Chunk-local y position in range [0, 63].
+		/// @param z Chunk-local z position in range [0, 63].
+		/// @param face Block face index in range [0, 5].
+		/// @param ao Ambient occlusion level in range [0, 3], 3 being unoccluded.
+		/// @param layer Texture layer.
+		/// @return 
+		static constexpr VoxelVertex pack(uint32_t x, uint32_t y, uint32_t z, uint32_t face, uint32_t ao, uint32_t layer)
+		{
+			return VoxelVertex{
+				(x & 63U) | ((y & 63U) << 6) | ((z & 63U) << 12) | ((face & 7U) << 18) | ((ao & 3U) << 21),
+				layer & 0xFFFFU,
+			};
+		}
+	};
+
+	static_assert(sizeof(VoxelVertex) == 8, "Voxel vertex must be tightly packed");
 } // namespace gfx
@@ -0,0 +1,138 @@
+#include "chunk_generation_system.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+#include "components/camera.hpp"
+#include "components/chunk_component.hpp"
+#include "components/transform.hpp"
+#include "core/timer.hpp"
+
+static constexpr size_t MAX_INLINE_JOBS_PER_FRAME = 4; // Generation jobs executed on the main thread per frame when no workers are available
+
+ChunkGenerationSystem::ChunkGenerationSystem(std::shared_ptr<core::JobSystem> jobSystem, uint32_t seed, std::shared_ptr<world::RegionStorage> storage, size_t maxInFlight)
+	:
+	m_jobSystem(std::move(jobSystem)),
+	m_generator(seed),
+	m_storage(std::move(storage)),
+	m_maxInFlight(std::max<size_t>(maxInFlight, 1))
+{
+    assert(m_jobSystem != nullptr && "Chunk generation system requires a job system");
+}
+
+ChunkGenerationSystem::~ChunkGenerationSystem()
+{
+    // Jobs push results into this system, so they must finish before it is destroyed
+    m_jobSystem->wait(m_jobs);
+}
+
+void ChunkGenerationSystem::update(entt::registry& registry, world::World& world)
+{
+    collectResults(registry, world);
+    scheduleJobs(registry);
+
+    // Without workers nobody else runs the jobs, so make some progress on the main thread
+    if (m_jobSystem->workerCount() == 0) {
+        m_jobSystem->executePending(MAX_INLINE_JOBS_PER_FRAME);
+    }
+
+    m_stats.inFlight = m_inFlight.size();
+
+    SPDLOG_TRACE("Chunk generation: {} pending, {} in flight, {} completed, {} loaded, {:.2f} ms average time",
+        m_stats.pending, m_stats.inFlight, m_stats.completed, m_stats.loaded, m_stats.averageTime);
+}
+
+void ChunkGenerationSystem::collectResults(entt::registry& registry, world::World& world)
+{
+    std::vector<GenerationResult> results{};
+    {
+        std::lock_guard<std::mutex> guard(m_resultLock);
+        results.swap(m_results);
+    }
+
+    double totalTime = 0.0;
+    m_stats.loaded = 0;
+    for (auto& result : results)
+    {
+        m_inFlight.erase(result.entity);
+        totalTime += result.generationTime;
+        m_stats.loaded += result.loaded ? 1 : 0;
+
+        // Chunk may have been destroyed while its generation job was running
+        if (!registry.valid(result.entity) || !registry.all_of<ChunkComponent, ChunkGenerationTag>(result.entity)) {
+            continue;
+        }
+
+        // Neighbours meshed against this chunk while it was empty need to pick up its border blocks
+        ChunkComponent& chunk = registry.get<ChunkComponent>(result.entity);
+        chunk.chunk = std::move(result.chunk);
+        chunk.dirty = true;
+        registry.remove<ChunkGenerationTag>(result.entity);
+        world.markNeighborsDirty(chunk.coordinate);
+    }
+
+    m_stats.completed = results.size();
+    if (!results.empty()) {
+        m_stats.averageTime = totalTime / static_cast<double>(results.size());
+    }
+}
+
+void ChunkGenerationSystem::scheduleJobs(entt::registry& registry)
+{
+    // Find active camera position to prioritize nearby chunks
+    glm::vec3 cameraPosition = Transform::WORLD_ORIGIN;
+    auto const cameras = registry.view<Camera, Transform>();
+    for (auto const& [_entity, _camera, transform] : cameras.each())
+    {
+        cameraPosition = transform.position;
+        break;
+    }
+
+    std::vector<std::pair<float, entt::entity>> candidates{};
+    auto const chunks = registry.view<ChunkComponent, ChunkGenerationTag>();
+    for (auto const entity : chunks)
+    {
+        if (m_inFlight.count(entity) != 0) {
+            continue;
+        }
+
+        ChunkComponent const& chunk = chunks.get<ChunkComponent>(entity);
+        glm::vec3 const center = (glm::vec3(chunk.coordinate) + 0.5F) * static_cast<float>(world::CHUNK_SIZE);
+        glm::vec3 const delta = center - cameraPosition;
+        candidates.emplace_back(glm::dot(delta, delta), entity);
+    }
+
+    m_stats.pending = candidates.size();
+    if (candidates.empty() || m_inFlight.size() >= m_maxInFlight) {
+        return;
+    }
+
+    size_t const jobCount = std::min(candidates.size(), m_maxInFlight - m_inFlight.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + jobCount, candidates.end(),
+        [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < jobCount; i++)
+    {
+        entt::entity const entity = candidates[i].second;
+        glm::ivec3 const coord = registry.get<ChunkComponent>(entity).coordinate;
+        m_inFlight.insert(entity);
+        m_stats.pending--;
+
+        m_jobSystem->run([this, entity, coord]() {
+            core::Timer timer{};
+            GenerationResult result{ entity, world::Chunk(), 0.0, false };
+            result.loaded = m_storage && m_storage->loadChunk(coord, result.chunk);
+            if (!result.loaded) {
+                m_generator.generate(coord, result.chunk);
+            }
+
+            timer.tick();
+            result.generationTime = timer.delta();
+
+            std::lock_guard<std::mutex> guard(m_resultLock);
+            m_results.push_back(std::move(result));
+        }, &m_jobs);
+    }
+}
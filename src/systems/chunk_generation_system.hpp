@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <entt/entt.hpp>
+
+#include "core/job_system.hpp"
+#include "world/chunk.hpp"
+#include "world/region_storage.hpp"
+#include "world/terrain_generator.hpp"
+#include "world/world.hpp"
+
+/// @brief Chunk generation counters, updated once per frame.
+struct ChunkGenerationStats
+{
+    size_t  pending         = 0;    // Tagged chunks without a generation job
+    size_t  inFlight        = 0;    // Generation jobs scheduled but not yet handed back
+    size_t  completed       = 0;    // Chunks handed back to the main thread this frame
+    size_t  loaded          = 0;    // Completed chunks loaded from region storage instead of generated this frame
+    double  averageTime     = 0.0;  // Average job time in milliseconds, over chunks completed this frame
+};
+
+/// @brief The ChunkGenerationSystem generates block data for chunk entities tagged with ChunkGenerationTag on job system workers.
+/// Chunks saved to region storage are loaded instead of generated. Chunks nearest to the active camera are generated first.
+/// Generated chunks and their neighbours are marked dirty for meshing.
+class ChunkGenerationSystem
+{
+public:
+    static constexpr size_t DEFAULT_MAX_IN_FLIGHT = 64;
+
+    /// @brief Create a new chunk generation system.
+    /// @param jobSystem Job system used to run generation jobs.
+    /// @param seed World seed.
+    /// @param storage Region storage to load saved chunks from, or nullptr to always generate chunks.
+    /// @param maxInFlight Maximum number of generation jobs scheduled at once.
+    ChunkGenerationSystem(std::shared_ptr<core::JobSystem> jobSystem, uint32_t seed, std::shared_ptr<world::RegionStorage> storage, size_t maxInFlight = DEFAULT_MAX_IN_FLIGHT);
+    ~ChunkGenerationSystem();
+
+    ChunkGenerationSystem(ChunkGenerationSystem const&) = delete;
+    ChunkGenerationSystem& operator=(ChunkGenerationSystem const&) = delete;
+
+    /// @brief Hand back generated chunks and schedule generation jobs for tagged chunks.
+    /// @param registry ECS registry containing chunk and camera entities.
+    /// @param world World used to mark neighbouring chunks dirty.
+    void update(entt::registry& registry, world::World& world);
+
+    /// @brief Retrieve the terrain generator used by this system.
+    /// @return 
+    world::TerrainGenerator const& generator() const { return m_generator; }
+
+    /// @brief Retrieve the counters of the last update.
+    /// @return 
+    ChunkGenerationStats const& stats() const { return m_stats; }
+
+private:
+    /// @brief Generated chunk waiting to be handed back to the main thread.
+    struct GenerationResult
+    {
+        entt::entity    entity;
+        world::Chunk    chunk;
+        double          generationTime;
+        bool            loaded;         // Chunk was loaded from region storage
+    };
+
+    /// @brief Move generated block data into chunk entities.
+    /// @param registry 
+    /// @param world 
+    void collectResults(entt::registry& registry, world::World& world);
+
+    /// @brief Schedule generation jobs for the tagged chunks closest to the camera.
+    /// @param registry 
+    void scheduleJobs(entt::registry& registry);
+
+private:
+    std::shared_ptr<core::JobSystem>        m_jobSystem;
+    world::TerrainGenerator                 m_generator;
+    std::shared_ptr<world::RegionStorage>   m_storage;
+    size_t                                  m_maxInFlight   = DEFAULT_MAX_IN_FLIGHT;
+    core::JobCounter                        m_jobs          = {};
+    std::mutex                              m_resultLock    = {};
+    std::vector<GenerationResult>           m_results       = {};   // Completed results, guarded by m_resultLock
+    std::unordered_set<entt::entity>        m_inFlight      = {};
+    ChunkGenerationStats                    m_stats         = {};
+};
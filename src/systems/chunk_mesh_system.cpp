@@ -0,0 +1,178 @@
+#include "chunk_mesh_system.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+#include "components/camera.hpp"
+#include "components/chunk_component.hpp"
+#include "components/render_component.hpp"
+#include "components/transform.hpp"
+#include "world/chunk_mesher.hpp"
+
+static constexpr size_t MAX_INLINE_JOBS_PER_FRAME = 4; // Mesh jobs executed on the main thread per frame when no workers are available
+
+ChunkMeshSystem::ChunkMeshSystem(std::shared_ptr<core::JobSystem> jobSystem, std::shared_ptr<gfx::Material> material, size_t maxInFlight)
+    :
+    m_jobSystem(std::move(jobSystem)),
+    m_material(std::move(material)),
+    m_maxInFlight(std::max<size_t>(maxInFlight, 1))
+{
+    assert(m_jobSystem != nullptr && "Chunk mesh system requires a job system");
+}
+
+ChunkMeshSystem::~ChunkMeshSystem()
+{
+    // Jobs push results into this system, so they must finish before it is destroyed
+    m_jobSystem->wait(m_jobs);
+}
+
+void ChunkMeshSystem::update(entt::registry& registry, world::World const& world)
+{
+    collectResults(registry);
+    scheduleJobs(registry, world);
+
+    // Without workers nobody else runs the jobs, so make some progress on the main thread
+    if (m_jobSystem->workerCount() == 0) {
+        m_jobSystem->executePending(MAX_INLINE_JOBS_PER_FRAME);
+    }
+
+    m_stats.queued = m_queued.size();
+    m_stats.inFlight = m_inFlight.size();
+
+    SPDLOG_TRACE("Chunk meshing: {} queued, {} in flight, {} completed, {:.2f} ms average latency",
+        m_stats.queued, m_stats.inFlight, m_stats.completed, m_stats.averageLatency);
+}
+
+void ChunkMeshSystem::collectResults(entt::registry& registry)
+{
+    std::vector<MeshResult> results{};
+    {
+        std::lock_guard<std::mutex> guard(m_resultLock);
+        results.swap(m_results);
+    }
+
+    TimePoint const now = Clock::now();
+    double totalLatency = 0.0;
+    for (auto& result : results)
+    {
+        m_inFlight.erase(result.entity);
+        totalLatency += std::chrono::duration<double, std::milli>(now - result.queuedAt).count();
+
+        // Chunk may have been destroyed while its mesh job was running
+        if (!registry.valid(result.entity) || !registry.all_of<ChunkComponent>(result.entity)) {
+            continue;
+        }
+
+        // Empty chunks do not need to be rendered at all
+        if (result.indices.empty())
+        {
+            registry.remove<RenderComponent>(result.entity);
+            continue;
+        }
+
+        RenderComponent* pRenderComponent = registry.try_get<RenderComponent>(result.entity);
+        if (pRenderComponent == nullptr) {
+            pRenderComponent = &registry.emplace<RenderComponent>(result.entity, RenderComponent{ std::make_shared<gfx::Mesh>(), m_material });
+        }
+
+        // Marks the mesh dirty, the renderer uploads it during its next frame
+        pRenderComponent->mesh->setBuffers(std::move(result.vertices), std::move(result.indices));
+    }
+
+    m_stats.completed = results.size();
+    m_stats.averageLatency = !results.empty() ? totalLatency / static_cast<double>(results.size()) : 0.0;
+}
+
+void ChunkMeshSystem::scheduleJobs(entt::registry& registry, world::World const& world)
+{
+    // Queue dirty chunks, a chunk that changes again before its job is scheduled keeps its original queue time
+    // NOTE: chunks pending generation stay dirty, they are queued once their blocks have been generated
+    TimePoint const now = Clock::now();
+    auto const chunks = registry.view<ChunkComponent>(entt::exclude<ChunkGenerationTag>);
+    for (auto const& [entity, chunk] : chunks.each())
+    {
+        if (!chunk.dirty) {
+            continue;
+        }
+
+        chunk.dirty = false;
+        m_queued.emplace(entity, now);
+    }
+
+    if (m_queued.empty() || m_inFlight.size() >= m_maxInFlight) {
+        return;
+    }
+
+    // Find active camera position to prioritize nearby chunks
+    glm::vec3 cameraPosition = Transform::WORLD_ORIGIN;
+    auto const cameras = registry.view<Camera, Transform>();
+    for (auto const& [_entity, _camera, transform] : cameras.each())
+    {
+        cameraPosition = transform.position;
+        break;
+    }
+
+    // Collect candidates, chunks with a job in flight wait until it is handed back so results arrive in order
+    std::vector<std::pair<float, entt::entity>> candidates{};
+    candidates.reserve(m_queued.size());
+    for (auto it = m_queued.begin(); it != m_queued.end();)
+    {
+        entt::entity const entity = it->first;
+        if (!registry.valid(entity) || !registry.all_of<ChunkComponent>(entity))
+        {
+            it = m_queued.erase(it);
+            continue;
+        }
+
+        if (m_inFlight.count(entity) == 0)
+        {
+            ChunkComponent const& chunk = registry.get<ChunkComponent>(entity);
+            glm::vec3 const center = (glm::vec3(chunk.coordinate) + 0.5F) * static_cast<float>(world::CHUNK_SIZE);
+            glm::vec3 const delta = center - cameraPosition;
+            candidates.emplace_back(glm::dot(delta, delta), entity);
+        }
+
+        ++it;
+    }
+
+    size_t const jobCount = std::min(candidates.size(), m_maxInFlight - m_inFlight.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + jobCount, candidates.end(),
+        [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < jobCount; i++)
+    {
+        entt::entity const entity = candidates[i].second;
+        ChunkComponent const& chunk = registry.get<ChunkComponent>(entity);
+
+        // Snapshot chunk and neighbour data, the originals may be edited while the job runs
+        auto pJob = std::make_shared<MeshJob>(MeshJob{ entity, chunk.chunk, {}, m_queued[entity] });
+        world::ChunkNeighbors const neighbors = world.getNeighbors(chunk.coordinate);
+        for (size_t face = 0; face < world::BLOCK_FACE_COUNT; face++)
+        {
+            if (neighbors[face] != nullptr) {
+                pJob->neighbors[face] = *neighbors[face];
+            }
+        }
+
+        m_queued.erase(entity);
+        m_inFlight.insert(entity);
+
+        m_jobSystem->run([this, pJob]() {
+            // NOTE: mesher scratch buffers are reused by all jobs running on the same thread
+            thread_local world::ChunkMesher mesher{};
+
+            world::ChunkNeighbors neighbors{};
+            for (size_t face = 0; face < world::BLOCK_FACE_COUNT; face++) {
+                neighbors[face] = pJob->neighbors[face] ? &pJob->neighbors[face].value() : nullptr;
+            }
+
+            MeshResult result{ pJob->entity, {}, {}, pJob->queuedAt };
+            mesher.mesh(pJob->chunk, neighbors, result.vertices, result.indices);
+
+            std::lock_guard<std::mutex> guard(m_resultLock);
+            m_results.push_back(std::move(result));
+        }, &m_jobs);
+    }
+}
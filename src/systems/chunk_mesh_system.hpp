@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <entt/entt.hpp>
+
+#include "core/job_system.hpp"
+#include "rendering/material.hpp"
+#include "rendering/mesh.hpp"
+#include "rendering/vertex_layout.hpp"
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/world.hpp"
+
+/// @brief Chunk meshing counters, updated once per frame.
+struct ChunkMeshStats
+{
+    size_t  queued          = 0;    // Dirty chunks waiting for a mesh job
+    size_t  inFlight        = 0;    // Mesh jobs scheduled but not yet handed back
+    size_t  completed       = 0;    // Meshes handed back to the main thread this frame
+    double  averageLatency  = 0.0;  // Average time from queueing to hand back in milliseconds, over meshes completed this frame
+};
+
+/// @brief The ChunkMeshSystem meshes dirty chunks on job system workers and hands the results back to the main thread.
+/// Chunks nearest to the active camera are meshed first. Results are stored in the chunk entity's RenderComponent mesh,
+/// whose dirty flag makes the renderer upload it.
+class ChunkMeshSystem
+{
+public:
+    static constexpr size_t DEFAULT_MAX_IN_FLIGHT = 64;
+
+    /// @brief Create a new chunk mesh system.
+    /// @param jobSystem Job system used to run mesh jobs.
+    /// @param material Material assigned to chunk render components.
+    /// @param maxInFlight Maximum number of mesh jobs scheduled at once, bounds the snapshot work done per frame.
+    ChunkMeshSystem(std::shared_ptr<core::JobSystem> jobSystem, std::shared_ptr<gfx::Material> material, size_t maxInFlight = DEFAULT_MAX_IN_FLIGHT);
+    ~ChunkMeshSystem();
+
+    ChunkMeshSystem(ChunkMeshSystem const&) = delete;
+    ChunkMeshSystem& operator=(ChunkMeshSystem const&) = delete;
+
+    /// @brief Hand back completed meshes and schedule mesh jobs for dirty chunks.
+    /// @param registry ECS registry containing chunk and camera entities.
+    /// @param world World used to look up chunk neighbours.
+    void update(entt::registry& registry, world::World const& world);
+
+    /// @brief Retrieve the counters of the last update.
+    /// @return 
+    ChunkMeshStats const& stats() const { return m_stats; }
+
+private:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    /// @brief Chunk data copied on the main thread, so jobs never touch chunks that may be edited meanwhile.
+    struct MeshJob
+    {
+        entt::entity                                                        entity;
+        world::Chunk                                                        chunk;
+        std::array<std::optional<world::Chunk>, world::BLOCK_FACE_COUNT>    neighbors;
+        TimePoint                                                           queuedAt;
+    };
+
+    /// @brief Mesh data produced by a job, waiting to be handed back to the main thread.
+    struct MeshResult
+    {
+        entt::entity                    entity;
+        std::vector<gfx::VoxelVertex>   vertices;
+        std::vector<gfx::IndexType>     indices;
+        TimePoint                       queuedAt;
+    };
+
+    /// @brief Store completed meshes in their chunk's render component.
+    /// @param registry 
+    void collectResults(entt::registry& registry);
+
+    /// @brief Queue dirty chunks and schedule mesh jobs for the ones closest to the camera.
+    /// @param registry 
+    /// @param world 
+    void scheduleJobs(entt::registry& registry, world::World const& world);
+
+private:
+    std::shared_ptr<core::JobSystem>                m_jobSystem;
+    std::shared_ptr<gfx::Material>                  m_material;
+    size_t                                          m_maxInFlight   = DEFAULT_MAX_IN_FLIGHT;
+    core::JobCounter                                m_jobs          = {};
+    std::mutex                                      m_resultLock    = {};
+    std::vector<MeshResult>                         m_results       = {};   // Completed results, guarded by m_resultLock
+    std::unordered_map<entt::entity, TimePoint>     m_queued        = {};   // Dirty chunks waiting for a job, with the time they were queued
+    std::unordered_set<entt::entity>                m_inFlight      = {};
+    ChunkMeshStats                                  m_stats         = {};
+};
@@ -0,0 +1,216 @@
+#include "chunk_streaming_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+#include "components/camera.hpp"
+#include "components/chunk_component.hpp"
+#include "components/render_component.hpp"
+#include "components/transform.hpp"
+
+static constexpr int32_t    EVICTION_MARGIN = 1;        // Extra ring of chunks kept resident, avoids thrashing when moving back and forth over a chunk border
+static constexpr double     GROWTH_HEADROOM = 0.95;     // Fraction of a budget the estimated usage of a larger radius must fit in
+
+ChunkStreamingSystem::ChunkStreamingSystem(std::shared_ptr<world::RegionStorage> storage, ChunkStreamingConfig const& config)
+	:
+	m_storage(std::move(storage)),
+	m_config(config),
+	m_viewRadius(std::max(config.viewRadius, 1))
+{
+    // Precompute horizontal offsets in the maximum radius, nearest first, so creation can stop at any budget
+    int32_t const radius = m_viewRadius;
+    for (int32_t z = -radius; z <= radius; z++)
+    {
+        for (int32_t x = -radius; x <= radius; x++)
+        {
+            if (x * x + z * z <= radius * radius) {
+                m_offsets.emplace_back(x, z);
+            }
+        }
+    }
+
+    std::sort(m_offsets.begin(), m_offsets.end(), [](glm::ivec2 const& a, glm::ivec2 const& b) {
+        return (a.x * a.x + a.y * a.y) < (b.x * b.x + b.y * b.y);
+    });
+}
+
+void ChunkStreamingSystem::update(entt::registry& registry, world::World& world)
+{
+    // Track the chunk the active camera is in, moving to another chunk changes the streamed region
+    auto const cameras = registry.view<Camera, Transform>();
+    for (auto const& [_entity, _camera, transform] : cameras.each())
+    {
+        glm::ivec3 const cameraChunk = world::World::toChunkCoord(glm::ivec3(glm::floor(transform.position)));
+        if (cameraChunk != m_cameraChunk)
+        {
+            m_cameraChunk = cameraChunk;
+            m_rescan = true;
+        }
+
+        break;
+    }
+
+    m_stats.created = 0;
+    m_stats.evicted = 0;
+    m_stats.saved = 0;
+
+    updateBudget(registry);
+    evictChunks(registry, world);
+    createChunks(registry, world);
+
+    m_stats.residentChunks = world.chunkCount();
+    m_stats.viewRadius = m_viewRadius;
+
+    SPDLOG_TRACE("Chunk streaming: {} resident, {} created, {} evicted, {} saved, radius {}, {} host bytes, {} device bytes",
+        m_stats.residentChunks, m_stats.created, m_stats.evicted, m_stats.saved, m_stats.viewRadius, m_stats.hostBytes, m_stats.deviceBytes);
+}
+
+void ChunkStreamingSystem::saveModifiedChunks(entt::registry& registry)
+{
+    auto const chunks = registry.view<ChunkComponent>();
+    for (auto const entity : chunks) {
+        saveChunk(registry, entity);
+    }
+
+    if (m_storage)
+    {
+        world::RegionStorageStats const storageStats = m_storage->stats();
+        SPDLOG_INFO("Region storage: {} chunks loaded ({} bytes), {} chunks saved ({} bytes), {} open regions ({} closed)",
+            storageStats.chunksLoaded, storageStats.bytesRead, storageStats.chunksSaved, storageStats.bytesWritten, storageStats.openRegions,
+            storageStats.closedRegions);
+    }
+}
+
+void ChunkStreamingSystem::updateBudget(entt::registry const& registry)
+{
+    size_t hostBytes = 0;
+    size_t deviceBytes = 0;
+    auto const chunks = registry.view<ChunkComponent>();
+    for (auto const& [entity, chunk] : chunks.each())
+    {
+        hostBytes += chunk.chunk.memoryUsage();
+        if (RenderComponent const* pRenderComponent = registry.try_get<RenderComponent>(entity); pRenderComponent && pRenderComponent->mesh)
+        {
+            hostBytes += pRenderComponent->mesh->hostMemoryUsage();
+            deviceBytes += pRenderComponent->mesh->deviceMemoryUsage();
+        }
+    }
+
+    m_stats.hostBytes = hostBytes;
+    m_stats.deviceBytes = deviceBytes;
+
+    // Shrink the radius while over budget, once earlier evictions have gone through
+    if (hostBytes > m_config.hostBudget || deviceBytes > m_config.deviceBudget)
+    {
+        if (!m_evictionPending && m_viewRadius > 1)
+        {
+            m_viewRadius--;
+            m_rescan = true;
+            SPDLOG_WARN("Chunk memory over budget, streaming radius reduced to {}", m_viewRadius);
+        }
+
+        return;
+    }
+
+    // Grow the radius back if the usage of a larger radius, which scales with its area, is estimated to fit
+    if (m_viewRadius < m_config.viewRadius)
+    {
+        double const growth = std::pow(static_cast<double>(m_viewRadius + 1) / static_cast<double>(m_viewRadius), 2.0);
+        if (static_cast<double>(hostBytes) * growth < static_cast<double>(m_config.hostBudget) * GROWTH_HEADROOM
+            && static_cast<double>(deviceBytes) * growth < static_cast<double>(m_config.deviceBudget) * GROWTH_HEADROOM)
+        {
+            m_viewRadius++;
+            m_rescan = true;
+        }
+    }
+}
+
+void ChunkStreamingSystem::createChunks(entt::registry& registry, world::World& world)
+{
+    if (!m_rescan) {
+        return;
+    }
+
+    for (auto const& offset : m_offsets)
+    {
+        if (offset.x * offset.x + offset.y * offset.y > m_viewRadius * m_viewRadius) {
+            break;
+        }
+
+        for (int32_t y = m_config.minChunkY; y <= m_config.maxChunkY; y++)
+        {
+            glm::ivec3 const coord = { m_cameraChunk.x + offset.x, y, m_cameraChunk.z + offset.y };
+            if (world.findChunk(coord) != entt::null) {
+                continue;
+            }
+
+            // Keep scanning next frame once the per-frame creation cap is hit
+            if (m_stats.created >= m_config.maxCreatesPerFrame) {
+                return;
+            }
+
+            registry.emplace<ChunkGenerationTag>(world.createChunk(coord));
+            m_stats.created++;
+        }
+    }
+
+    m_rescan = false;
+}
+
+void ChunkStreamingSystem::evictChunks(entt::registry& registry, world::World& world)
+{
+    if (!m_rescan && !m_evictionPending) {
+        return;
+    }
+
+    // Collect chunks outside the streamed region including its eviction margin
+    int32_t const evictRadius = m_viewRadius + EVICTION_MARGIN;
+    std::vector<std::pair<int32_t, glm::ivec3>> candidates{};
+    auto const chunks = registry.view<ChunkComponent>();
+    for (auto const& [_entity, chunk] : chunks.each())
+    {
+        glm::ivec3 const delta = chunk.coordinate - m_cameraChunk;
+        int32_t const distance = delta.x * delta.x + delta.z * delta.z;
+        if (distance > evictRadius * evictRadius || chunk.coordinate.y < m_config.minChunkY || chunk.coordinate.y > m_config.maxChunkY) {
+            candidates.emplace_back(distance, chunk.coordinate);
+        }
+    }
+
+    size_t const evictCount = std::min(candidates.size(), m_config.maxEvictsPerFrame);
+    std::partial_sort(candidates.begin(), candidates.begin() + evictCount, candidates.end(),
+        [](auto const& a, auto const& b) { return a.first > b.first; });
+
+    for (size_t i = 0; i < evictCount; i++)
+    {
+        glm::ivec3 const& coord = candidates[i].second;
+        entt::entity const entity = world.findChunk(coord);
+        saveChunk(registry, entity);
+
+        // Release device ranges right away, draw data may still hold a reference to the mesh itself
+        if (RenderComponent* pRenderComponent = registry.try_get<RenderComponent>(entity); pRenderComponent && pRenderComponent->mesh) {
+            pRenderComponent->mesh->releaseDeviceAllocation();
+        }
+
+        world.destroyChunk(coord);
+    }
+
+    m_stats.evicted = evictCount;
+    m_evictionPending = (candidates.size() > evictCount);
+}
+
+void ChunkStreamingSystem::saveChunk(entt::registry& registry, entt::entity entity)
+{
+    // Chunks still waiting for generation have no block data worth saving
+    ChunkComponent& chunk = registry.get<ChunkComponent>(entity);
+    if (!m_storage || !chunk.modified || registry.all_of<ChunkGenerationTag>(entity)) {
+        return;
+    }
+
+    if (m_storage->saveChunk(chunk.coordinate, chunk.chunk))
+    {
+        chunk.modified = false;
+        m_stats.saved++;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "world/region_storage.hpp"
+#include "world/world.hpp"
+
+/// @brief Chunk streaming configuration.
+struct ChunkStreamingConfig
+{
+    int32_t viewRadius          = 12;                   // Horizontal streaming radius in chunks
+    int32_t minChunkY           = -2;                   // Lowest streamed chunk layer
+    int32_t maxChunkY           = 4;                    // Highest streamed chunk layer
+    size_t  hostBudget          = 512ULL * 1024 * 1024; // Host bytes used by chunk blocks and mesh data
+    size_t  deviceBudget        = 256ULL * 1024 * 1024; // Device bytes used by chunk mesh buffers
+    size_t  maxCreatesPerFrame  = 64;                   // Chunks created per frame, bounds generation and meshing spikes
+    size_t  maxEvictsPerFrame   = 128;                  // Chunks evicted per frame
+};
+
+/// @brief Chunk streaming counters, updated once per frame.
+struct ChunkStreamingStats
+{
+    size_t  residentChunks  = 0;
+    size_t  hostBytes       = 0;
+    size_t  deviceBytes     = 0;
+    size_t  created         = 0;    // Chunks created this frame
+    size_t  evicted         = 0;    // Chunks evicted this frame
+    size_t  saved           = 0;    // Modified chunks saved this frame
+    int32_t viewRadius      = 0;    // Radius currently streamed, shrinks while over budget
+};
+
+/// @brief The ChunkStreamingSystem keeps the chunks around the active camera resident.
+/// Missing chunks inside the view radius are created nearest first and tagged for generation. Chunks outside the radius
+/// are evicted, and the radius temporarily shrinks while host or device memory exceeds its budget. Evicted chunks with
+/// modified blocks are saved to region storage first.
+class ChunkStreamingSystem
+{
+public:
+    /// @brief Create a new chunk streaming system.
+    /// @param storage Region storage used to save modified chunks, or nullptr to discard them.
+    /// @param config Streaming configuration.
+    ChunkStreamingSystem(std::shared_ptr<world::RegionStorage> storage, ChunkStreamingConfig const& config = ChunkStreamingConfig{});
+
+    /// @brief Create chunks near the camera and evict far away chunks.
+    /// @param registry ECS registry containing chunk and camera entities.
+    /// @param world World that owns the chunk entities.
+    void update(entt::registry& registry, world::World& world);
+
+    /// @brief Save all resident chunks with modified blocks, e.g. before shutting down.
+    /// @param registry ECS registry containing chunk entities.
+    void saveModifiedChunks(entt::registry& registry);
+
+    /// @brief Retrieve the streaming configuration.
+    /// @return 
+    ChunkStreamingConfig const& config() const { return m_config; }
+
+    /// @brief Retrieve the counters of the last update.
+    /// @return 
+    ChunkStreamingStats const& stats() const { return m_stats; }
+
+private:
+    /// @brief Update memory counters and adjust the streamed radius to the memory budgets.
+    /// @param registry 
+    void updateBudget(entt::registry const& registry);
+
+    /// @brief Create missing chunks inside the streamed radius, nearest to the camera first.
+    /// @param registry 
+    /// @param world 
+    void createChunks(entt::registry& registry, world::World& world);
+
+    /// @brief Evict chunks outside the streamed radius, farthest from the camera first.
+    /// @param registry 
+    /// @param world 
+    void evictChunks(entt::registry& registry, world::World& world);
+
+    /// @brief Save a chunk if its blocks were modified since it was loaded or generated.
+    /// @param registry 
+    /// @param entity Chunk entity.
+    void saveChunk(entt::registry& registry, entt::entity entity);
+
+private:
+    std::shared_ptr<world::RegionStorage>   m_storage;
+    ChunkStreamingConfig                    m_config;
+    std::vector<glm::ivec2>                 m_offsets           = {};           // Horizontal offsets within the view radius, sorted by distance
+    glm::ivec3                              m_cameraChunk       = { 0, 0, 0 };
+    int32_t                                 m_viewRadius        = 0;
+    bool                                    m_rescan            = true;         // Streamed region changed or creation was capped last frame
+    bool                                    m_evictionPending   = false;        // Eviction was capped last frame
+    ChunkStreamingStats                     m_stats             = {};
+};
@@ -1,56 +1,291 @@
 #include "renderer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <set>
 #include <unordered_map>
 #include <spdlog/spdlog.h>
 
+#include "macros.hpp"
 #include "core/files.hpp"
 #include "core/memory.hpp"
+#include "core/timer.hpp"
 #include "rendering/vertex_layout.hpp"
+#include "world/block.hpp"
 #include "components/camera.hpp"
+#include "components/chunk_component.hpp"
 #include "components/render_component.hpp"
 #include "components/transform.hpp"
 
-void DrawList::append(std::string const& pass, DrawCommand const& command)
+#if     WEBGPU_BACKEND_WGPU
+    #include <webgpu/wgpu.h>
+#endif  // WEBGPU_BACKEND_WGPU
+
+/// @brief Array stride alignment of object transforms in storage buffers, matching the WGSL mat4x4f alignment.
+static constexpr size_t OBJECT_TRANSFORM_STORAGE_ALIGNMENT = 16;
+
+/// @brief Array stride alignment of draw culling inputs in storage buffers, matching the WGSL vec3f alignment.
+static constexpr size_t DRAW_CULL_DATA_STORAGE_ALIGNMENT = 16;
+
+/// @brief Compute workgroup sizes, matching the workgroup sizes declared in culling.wgsl.
+static constexpr uint32_t HIZ_WORKGROUP_SIZE = 8;
+static constexpr uint32_t CULL_WORKGROUP_SIZE = 64;
+
+/// @brief Minimum size of device-only buffers in bytes.
+static constexpr uint64_t MIN_DEVICE_BUFFER_SIZE = 256;
+
+/// @brief Maximum number of chunk occluders rasterized per frame by the software occlusion rasterizer.
+static constexpr size_t MAX_SOFTWARE_OCCLUDERS = 64;
+
+/// @brief Inset of software occluder boxes in world units, so faces lying on an occluder surface are not hidden by it.
+static constexpr float SOFTWARE_OCCLUDER_INSET = 0.05F;
+
+/// @brief Number of bits sorted per radix sort pass.
+static constexpr uint32_t RADIX_BITS = 8;
+static constexpr uint32_t RADIX_BUCKETS = 1 << RADIX_BITS;
+static constexpr uint32_t RADIX_PASSES = 64 / RADIX_BITS;
+
+/// @brief Mask a value to the lower bits of a sort key field.
+/// @param value 
+/// @param bits 
+/// @return 
+static constexpr uint64_t sortKeyField(uint64_t value, uint32_t bits)
 {
-    m_commands[pass].push_back(command);
+    return value & ((uint64_t(1) << bits) - 1);
 }
 
-std::vector<DrawCommand> DrawList::commands(std::string const& pass) const
+uint64_t DrawList::makeSortKey(RenderPass pass, uint32_t pipeline, uint32_t material, void const* pMesh, float depth)
 {
-    auto const& it = m_commands.find(pass);
-    if (it == m_commands.end()) {
-        return {};
-    }
+    // Mesh addresses are hashed down to their key bits, the high bits of a multiplicative hash are the best mixed
+    uint64_t const meshHash = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pMesh)) * 0x9E3779B97F4A7C15ULL) >> (64 - MESH_BITS);
+    uint64_t const depthBits = static_cast<uint64_t>(std::clamp(depth, 0.0F, 1.0F) * static_cast<float>((1 << DEPTH_BITS) - 1));
+
+    uint64_t key = sortKeyField(static_cast<uint64_t>(pass), PASS_BITS);
+    key = (key << PIPELINE_BITS) | sortKeyField(pipeline, PIPELINE_BITS);
+    key = (key << MATERIAL_BITS) | sortKeyField(material, MATERIAL_BITS);
+    key = (key << MESH_BITS) | meshHash;
+    key = (key << DEPTH_BITS) | depthBits;
+    return key;
+}
 
-    return it->second;
+void DrawList::clear()
+{
+    m_commands.clear();
+    m_sortedCommands.clear();
+    m_entries.clear();
 }
 
-Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend)
-	:
-	m_renderbackend(renderbackend)
+void DrawList::append(uint64_t sortKey, DrawCommand&& command)
+{
+    m_entries.push_back(SortEntry{ sortKey, static_cast<uint32_t>(m_commands.size()) });
+    m_commands.push_back(std::move(command));
+}
+
+void DrawList::sort()
 {
-    // Set up a depth-stencil target for rendering
+    // Build histograms for all digits in a single pass over the keys
+    std::array<std::array<uint32_t, RADIX_BUCKETS>, RADIX_PASSES> histograms{};
+    for (auto const& entry : m_entries)
+    {
+        for (uint32_t pass = 0; pass < RADIX_PASSES; pass++) {
+            histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    // Stable counting sort per digit, least significant digit first, skipping digits that are equal for all keys
+    m_scratch.resize(m_entries.size());
+    for (uint32_t pass = 0; pass < RADIX_PASSES; pass++)
     {
-        gfx::FramebufferSize const swapFramebufferSize = m_renderbackend->getFramebufferSize();
-        WGPUTextureDescriptor depthStencilTargetDesc{};
-        depthStencilTargetDesc.nextInChain = nullptr;
-        depthStencilTargetDesc.label = "Depth Stencil Target";
-        depthStencilTargetDesc.usage = WGPUTextureUsage_RenderAttachment;
-        depthStencilTargetDesc.dimension = WGPUTextureDimension_2D;
-        depthStencilTargetDesc.size.width = swapFramebufferSize.width;
-        depthStencilTargetDesc.size.height = swapFramebufferSize.height;
-        depthStencilTargetDesc.size.depthOrArrayLayers = 1;
-        depthStencilTargetDesc.format = WGPUTextureFormat_Depth24PlusStencil8;
-        depthStencilTargetDesc.mipLevelCount = 1;
-        depthStencilTargetDesc.sampleCount = 1;
-        depthStencilTargetDesc.viewFormatCount = 0;
-        depthStencilTargetDesc.viewFormats = nullptr;
+        std::array<uint32_t, RADIX_BUCKETS>& histogram = histograms[pass];
+        uint32_t const shift = pass * RADIX_BITS;
+        if (m_entries.empty() || histogram[(m_entries.front().key >> shift) & (RADIX_BUCKETS - 1)] == m_entries.size()) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (auto& count : histogram)
+        {
+            uint32_t const bucketCount = count;
+            count = offset;
+            offset += bucketCount;
+        }
+
+        for (auto const& entry : m_entries) {
+            m_scratch[histogram[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+        }
 
-        m_depthStencilTarget = wgpuDeviceCreateTexture(m_renderbackend->getDevice(), &depthStencilTargetDesc);
-        m_depthStencilTargetView = wgpuTextureCreateView(m_depthStencilTarget, nullptr /* default view */);
+        m_entries.swap(m_scratch);
     }
 
+    // Move commands into sorted order so passes can be iterated as contiguous ranges
+    m_sortedCommands.clear();
+    m_sortedCommands.reserve(m_commands.size());
+    for (auto const& entry : m_entries) {
+        m_sortedCommands.push_back(std::move(m_commands[entry.index]));
+    }
+}
+
+DrawCommandRange DrawList::commands() const
+{
+    assert(m_sortedCommands.size() == m_commands.size() && "Draw list must be sorted before retrieving commands");
+    return DrawCommandRange{ m_sortedCommands.data(), m_sortedCommands.data() + m_sortedCommands.size() };
+}
+
+DrawCommandRange DrawList::commands(RenderPass pass) const
+{
+    assert(m_sortedCommands.size() == m_commands.size() && "Draw list must be sorted before retrieving commands");
+
+    // Passes occupy the most significant key bits, so each pass is a contiguous range of sorted entries
+    uint32_t const passShift = 64 - PASS_BITS;
+    uint64_t const passBits = static_cast<uint64_t>(pass);
+    auto const first = std::partition_point(m_entries.begin(), m_entries.end(), [&](SortEntry const& entry) { return (entry.key >> passShift) < passBits; });
+    auto const last = std::partition_point(first, m_entries.end(), [&](SortEntry const& entry) { return (entry.key >> passShift) == passBits; });
+
+    DrawCommand const* pCommands = m_sortedCommands.data();
+    return DrawCommandRange{
+        pCommands + (first - m_entries.begin()),
+        pCommands + (last - m_entries.begin())
+    };
+}
+
+/// @brief Check if two transforms result in the same transformation matrix.
+/// @param a 
+/// @param b 
+/// @return 
+static bool isSameTransform(Transform const& a, Transform const& b)
+{
+    return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
+}
+
+/// @brief Check if two bounding boxes are equal.
+/// @param a 
+/// @param b 
+/// @return 
+static bool isSameBounds(gfx::AABB const& a, gfx::AABB const& b)
+{
+    return a.min == b.min && a.max == b.max;
+}
+
+/// @brief Check if the device resources of a render component have been uploaded at least once.
+/// Uploads may be deferred by the upload budget, resources that were uploaded before keep their previous device data.
+/// @param object 
+/// @return 
+static bool isDrawable(RenderComponent const& object)
+{
+    auto const isTextureUploaded = [](std::shared_ptr<gfx::Texture> const& texture) {
+        return texture == nullptr || texture->getTextureView() != nullptr;
+    };
+
+    return object.mesh->deviceAllocation() != nullptr
+        && isTextureUploaded(object.material->albedoTexture) && isTextureUploaded(object.material->normalTexture);
+}
+
+DrawIndexedIndirectArgs directDrawArgs(gfx::MeshRange const& range, uint32_t firstInstance, uint32_t instanceCount)
+{
+    DrawIndexedIndirectArgs args{};
+    args.indexCount = range.indexCount;
+    args.instanceCount = instanceCount;
+    args.firstIndex = range.indexOffset;
+    args.baseVertex = static_cast<int32_t>(range.vertexOffset);
+    args.firstInstance = firstInstance;
+    return args;
+}
+
+/// @brief Calculate the indirect draw arguments of a draw command from the mesh pool range of its mesh.
+/// Meshes with deferred uploads are drawn using their previous device ranges.
+/// @param command 
+/// @return 
+static DrawIndexedIndirectArgs makeDrawArgs(DrawCommand const& command)
+{
+    gfx::MeshRange const& range = command.mesh->deviceAllocation()->range();
+    return DrawIndexedIndirectArgs{
+        range.indexCount,
+        command.instanceCount,
+        range.indexOffset,
+        static_cast<int32_t>(range.vertexOffset),
+        command.firstInstance,
+    };
+}
+
+/// @brief Load a WGSL shader module from an asset file.
+/// @param device 
+/// @param assetPath Shader asset path, relative to the program directory.
+/// @param label Shader module label.
+/// @return 
+static WGPUShaderModule createShaderModule(WGPUDevice device, char const* assetPath, char const* label)
+{
+    std::string const shaderFilePath = core::fs::getFullAssetPath(assetPath);
+    std::vector<uint8_t> const shaderBinary = core::fs::readBinaryFile(shaderFilePath);
+    std::string const shaderCode(shaderBinary.begin(), shaderBinary.end()); // Convert byte vector to string
+    if (shaderCode.empty()) {
+        SPDLOG_ERROR("Failed to load shader file from path {}", shaderFilePath); // FIXME(nemtji001): Throw fatal error here
+    }
+
+    WGPUShaderModuleWGSLDescriptor wgslShaderDesc{};
+    wgslShaderDesc.chain.next = nullptr;
+    wgslShaderDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
+    wgslShaderDesc.code = shaderCode.data();
+
+    WGPUShaderModuleDescriptor shaderDesc{};
+    shaderDesc.nextInChain = &wgslShaderDesc.chain;
+    shaderDesc.label = label;
+#if     WEBGPU_BACKEND_WGPU
+    shaderDesc.hintCount = 0;
+    shaderDesc.hints = nullptr;
+#endif  // WEBGPU_BACKEND_WGPU
+
+    return wgpuDeviceCreateShaderModule(device, &shaderDesc);
+}
+
+/// @brief Make sure a buffer that is only written on the device holds at least a number of bytes, growing it geometrically.
+/// Buffer contents are not preserved when the buffer is recreated.
+/// @param device 
+/// @param buffer Buffer handle, created if it is a nullptr.
+/// @param label 
+/// @param usage 
+/// @param size Required size in bytes.
+/// @return A boolean indicating the buffer was recreated, bind groups referencing it must be recreated.
+static bool reserveDeviceBuffer(WGPUDevice device, WGPUBuffer& buffer, char const* label, WGPUBufferUsageFlags usage, uint64_t size)
+{
+    uint64_t const currentSize = (buffer != nullptr) ? wgpuBufferGetSize(buffer) : 0;
+    if (buffer != nullptr && currentSize >= size) {
+        return false;
+    }
+
+    if (buffer) wgpuBufferRelease(buffer);
+
+    WGPUBufferDescriptor bufferDesc{};
+    bufferDesc.nextInChain = nullptr;
+    bufferDesc.label = label;
+    bufferDesc.usage = usage;
+    bufferDesc.size = std::max({ size, currentSize * 2, MIN_DEVICE_BUFFER_SIZE });
+    bufferDesc.mappedAtCreation = false;
+
+    buffer = wgpuDeviceCreateBuffer(device, &bufferDesc);
+    return true;
+}
+
+size_t Renderer::InstanceBatchKeyHash::operator()(InstanceBatchKey const& key) const
+{
+    size_t const hash = std::hash<gfx::Mesh const*>()(key.mesh);
+    return hash ^ (std::hash<uint32_t>()(key.materialSlot) + 0x9E3779B9 + (hash << 6) + (hash >> 2));
+}
+
+Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend, entt::registry& registry)
+	:
+	m_renderbackend(renderbackend),
+	m_cameraData("Camera UBO", sizeof(CameraUniform), renderbackend->getBackendCapabilities().minUniformBufferOffsetAlignment),
+	m_objectTransformData("Object Transform Buffer", sizeof(ObjectTranformUniform), OBJECT_TRANSFORM_STORAGE_ALIGNMENT, WGPUBufferUsage_Storage),
+	m_instanceData("Instance Buffer", sizeof(uint32_t), sizeof(uint32_t), WGPUBufferUsage_Storage),
+	m_materialData("Material UBO", sizeof(MaterialUniform), renderbackend->getBackendCapabilities().minUniformBufferOffsetAlignment),
+	m_indirectData("Indirect Draw Buffer", sizeof(DrawIndexedIndirectArgs), sizeof(uint32_t), WGPUBufferUsage_Indirect | WGPUBufferUsage_Storage),
+	m_uploadManager(renderbackend->getDevice(), renderbackend->getQueue()),
+	m_meshPool(std::make_shared<gfx::MeshPool>(renderbackend->getDevice())),
+	m_registry(registry),
+	m_cullParams("Cull Params UBO", sizeof(gfx::CullParams), renderbackend->getBackendCapabilities().minUniformBufferOffsetAlignment),
+	m_drawCullData("Draw Cull Buffer", sizeof(gfx::DrawCullData), DRAW_CULL_DATA_STORAGE_ALIGNMENT, WGPUBufferUsage_Storage)
+{
     // Set up a graphics pipeline for rendering
     {
         // Create scene data bind group
@@ -63,7 +298,23 @@ Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend)
         sceneDataCameraBinding.buffer.hasDynamicOffset = true;
         sceneDataCameraBinding.buffer.minBindingSize = 0;
 
-        WGPUBindGroupLayoutEntry sceneDataBindGroupEntries[] = { sceneDataCameraBinding, };
+        WGPUBindGroupLayoutEntry sceneDataBlockSamplerBinding{};
+        sceneDataBlockSamplerBinding.nextInChain = nullptr;
+        sceneDataBlockSamplerBinding.binding = 1;
+        sceneDataBlockSamplerBinding.visibility = WGPUShaderStage_Fragment;
+        sceneDataBlockSamplerBinding.sampler.nextInChain = nullptr;
+        sceneDataBlockSamplerBinding.sampler.type = WGPUSamplerBindingType_Filtering;
+
+        WGPUBindGroupLayoutEntry sceneDataBlockTexturesBinding{};
+        sceneDataBlockTexturesBinding.nextInChain = nullptr;
+        sceneDataBlockTexturesBinding.binding = 2;
+        sceneDataBlockTexturesBinding.visibility = WGPUShaderStage_Fragment;
+        sceneDataBlockTexturesBinding.texture.nextInChain = nullptr;
+        sceneDataBlockTexturesBinding.texture.sampleType = WGPUTextureSampleType_Float;
+        sceneDataBlockTexturesBinding.texture.viewDimension = WGPUTextureViewDimension_2DArray;
+        sceneDataBlockTexturesBinding.texture.multisampled = false;
+
+        WGPUBindGroupLayoutEntry sceneDataBindGroupEntries[] = { sceneDataCameraBinding, sceneDataBlockSamplerBinding, sceneDataBlockTexturesBinding, };
         WGPUBindGroupLayoutDescriptor sceneDataBindGroupLayoutDesc{};
         sceneDataBindGroupLayoutDesc.nextInChain = nullptr;
         sceneDataBindGroupLayoutDesc.label = "Scene Data Bind Group Layout";
@@ -72,17 +323,26 @@ Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend)
 
         m_sceneDataBindGroupLayout = wgpuDeviceCreateBindGroupLayout(m_renderbackend->getDevice(), &sceneDataBindGroupLayoutDesc);
 
-        // Create object data bind group
+        // Create object data bind group, instances are mapped to object transforms through the instance buffer
         WGPUBindGroupLayoutEntry objectDataObjectTransformBinding{};
         objectDataObjectTransformBinding.nextInChain = nullptr;
         objectDataObjectTransformBinding.binding = 0;
         objectDataObjectTransformBinding.visibility = WGPUShaderStage_Vertex;
         objectDataObjectTransformBinding.buffer.nextInChain = nullptr;
-        objectDataObjectTransformBinding.buffer.type = WGPUBufferBindingType_Uniform;
-        objectDataObjectTransformBinding.buffer.hasDynamicOffset = true;
+        objectDataObjectTransformBinding.buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
+        objectDataObjectTransformBinding.buffer.hasDynamicOffset = false;
         objectDataObjectTransformBinding.buffer.minBindingSize = 0;
 
-        WGPUBindGroupLayoutEntry objectDataBindGroupEntries[] = { objectDataObjectTransformBinding, };
+        WGPUBindGroupLayoutEntry objectDataInstanceBinding{};
+        objectDataInstanceBinding.nextInChain = nullptr;
+        objectDataInstanceBinding.binding = 1;
+        objectDataInstanceBinding.visibility = WGPUShaderStage_Vertex;
+        objectDataInstanceBinding.buffer.nextInChain = nullptr;
+        objectDataInstanceBinding.buffer.type = WGPUBufferBindingType_ReadOnlyStorage;
+        objectDataInstanceBinding.buffer.hasDynamicOffset = false;
+        objectDataInstanceBinding.buffer.minBindingSize = 0;
+
+        WGPUBindGroupLayoutEntry objectDataBindGroupEntries[] = { objectDataObjectTransformBinding, objectDataInstanceBinding, };
         WGPUBindGroupLayoutDescriptor objectDataBindGroupLayoutDesc{};
         objectDataBindGroupLayoutDesc.nextInChain = nullptr;
         objectDataBindGroupLayoutDesc.label = "Object Data Bind Group Layout";
@@ -153,27 +413,7 @@ Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend)
         m_pipelineLayout = wgpuDeviceCreatePipelineLayout(m_renderbackend->getDevice(), &layoutDesc);
 
         // Load shader module
-        std::string const shaderFilePath = core::fs::getFullAssetPath("assets/shaders/shaders.wgsl");
-        std::vector<uint8_t> const shaderBinary = core::fs::readBinaryFile(shaderFilePath);
-        std::string const shaderCode(shaderBinary.begin(), shaderBinary.end()); // Convert byte vector to string
-        if (shaderCode.empty()) {
-            SPDLOG_ERROR("Failed to load shader file from path {}", shaderFilePath); // FIXME(nemtji001): Throw fatal error here
-        }
-
-        WGPUShaderModuleWGSLDescriptor wgslShaderDesc{};
-        wgslShaderDesc.chain.next = nullptr;
-        wgslShaderDesc.chain.sType = WGPUSType_ShaderModuleWGSLDescriptor;
-        wgslShaderDesc.code = shaderCode.data();
-
-        WGPUShaderModuleDescriptor shaderDesc{};
-        shaderDesc.nextInChain = &wgslShaderDesc.chain;
-        shaderDesc.label = "Shader";
-#if     WEBGPU_BACKEND_WGPU
-        shaderDesc.hintCount = 0;
-        shaderDesc.hints = nullptr;
-#endif  // WEBGPU_BACKEND_WGPU
-
-        WGPUShaderModule shader = wgpuDeviceCreateShaderModule(m_renderbackend->getDevice(), &shaderDesc);
+        WGPUShaderModule shader = createShaderModule(m_renderbackend->getDevice(), "assets/shaders/shaders.wgsl", "Shader");
 
         // Set up pipeline state
         WGPUVertexAttribute vertexAttributes[] = {
@@ -256,26 +496,220 @@ Renderer::Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend)
         pipelineDesc.multisample = multisampleState;
 
         m_pipeline = wgpuDeviceCreateRenderPipeline(m_renderbackend->getDevice(), &pipelineDesc);
+
+        // Set up voxel pipeline state, voxel faces sample the block textures by layer instead of material textures
+        WGPUVertexAttribute voxelVertexAttributes[] = {
+            { WGPUVertexFormat_Uint32x2, 0, 0 },
+        };
+
+        WGPUVertexBufferLayout voxelVertexBufferLayouts[] = {
+            { sizeof(gfx::VoxelVertex), WGPUVertexStepMode_Vertex, std::size(voxelVertexAttributes), voxelVertexAttributes},
+        };
+
+        pipelineDesc.label = "Voxel Render Pipeline";
+        pipelineDesc.vertex.entryPoint = "VSVoxelVert";
+        pipelineDesc.vertex.bufferCount = std::size(voxelVertexBufferLayouts);
+        pipelineDesc.vertex.buffers = voxelVertexBufferLayouts;
+        fragmentState.entryPoint = "FSVoxelShading";
+
+        m_voxelPipeline = wgpuDeviceCreateRenderPipeline(m_renderbackend->getDevice(), &pipelineDesc);
         wgpuShaderModuleRelease(shader);
     }
+
+    // Set up compute pipelines for GPU culling
+    {
+        WGPUDevice const device = m_renderbackend->getDevice();
+
+        // Create pyramid build bind groups, level 0 reads the depth target and every next level the previous level
+        WGPUBindGroupLayoutEntry hizDepthBinding{};
+        hizDepthBinding.nextInChain = nullptr;
+        hizDepthBinding.binding = 0;
+        hizDepthBinding.visibility = WGPUShaderStage_Compute;
+        hizDepthBinding.texture.nextInChain = nullptr;
+        hizDepthBinding.texture.sampleType = WGPUTextureSampleType_Depth;
+        hizDepthBinding.texture.viewDimension = WGPUTextureViewDimension_2D;
+        hizDepthBinding.texture.multisampled = false;
+
+        WGPUBindGroupLayoutEntry hizSourceBinding{};
+        hizSourceBinding.nextInChain = nullptr;
+        hizSourceBinding.binding = 1;
+        hizSourceBinding.visibility = WGPUShaderStage_Compute;
+        hizSourceBinding.texture.nextInChain = nullptr;
+        hizSourceBinding.texture.sampleType = WGPUTextureSampleType_UnfilterableFloat;
+        hizSourceBinding.texture.viewDimension = WGPUTextureViewDimension_2D;
+        hizSourceBinding.texture.multisampled = false;
+
+        WGPUBindGroupLayoutEntry hizTargetBinding{};
+        hizTargetBinding.nextInChain = nullptr;
+        hizTargetBinding.binding = 2;
+        hizTargetBinding.visibility = WGPUShaderStage_Compute;
+        hizTargetBinding.storageTexture.nextInChain = nullptr;
+        hizTargetBinding.storageTexture.access = WGPUStorageTextureAccess_WriteOnly;
+        hizTargetBinding.storageTexture.format = WGPUTextureFormat_R32Float;
+        hizTargetBinding.storageTexture.viewDimension = WGPUTextureViewDimension_2D;
+
+        WGPUBindGroupLayoutEntry hizDepthBindGroupEntries[] = { hizDepthBinding, hizTargetBinding, };
+        WGPUBindGroupLayoutDescriptor hizDepthBindGroupLayoutDesc{};
+        hizDepthBindGroupLayoutDesc.nextInChain = nullptr;
+        hizDepthBindGroupLayoutDesc.label = "HiZ Depth Bind Group Layout";
+        hizDepthBindGroupLayoutDesc.entryCount = std::size(hizDepthBindGroupEntries);
+        hizDepthBindGroupLayoutDesc.entries = hizDepthBindGroupEntries;
+
+        m_hizDepthBindGroupLayout = wgpuDeviceCreateBindGroupLayout(device, &hizDepthBindGroupLayoutDesc);
+
+        WGPUBindGroupLayoutEntry hizDownsampleBindGroupEntries[] = { hizSourceBinding, hizTargetBinding, };
+        WGPUBindGroupLayoutDescriptor hizDownsampleBindGroupLayoutDesc{};
+        hizDownsampleBindGroupLayoutDesc.nextInChain = nullptr;
+        hizDownsampleBindGroupLayoutDesc.label = "HiZ Downsample Bind Group Layout";
+        hizDownsampleBindGroupLayoutDesc.entryCount = std::size(hizDownsampleBindGroupEntries);
+        hizDownsampleBindGroupLayoutDesc.entries = hizDownsampleBindGroupEntries;
+
+        m_hizDownsampleBindGroupLayout = wgpuDeviceCreateBindGroupLayout(device, &hizDownsampleBindGroupLayoutDesc);
+
+        // Create culling bind group, draws read the source arguments and write the culled arguments
+        auto const bufferBinding = [](uint32_t binding, WGPUBufferBindingType type) {
+            WGPUBindGroupLayoutEntry entry{};
+            entry.nextInChain = nullptr;
+            entry.binding = binding;
+            entry.visibility = WGPUShaderStage_Compute;
+            entry.buffer.nextInChain = nullptr;
+            entry.buffer.type = type;
+            entry.buffer.hasDynamicOffset = false;
+            entry.buffer.minBindingSize = 0;
+            return entry;
+        };
+
+        WGPUBindGroupLayoutEntry cullHiZBinding{};
+        cullHiZBinding.nextInChain = nullptr;
+        cullHiZBinding.binding = 8;
+        cullHiZBinding.visibility = WGPUShaderStage_Compute;
+        cullHiZBinding.texture.nextInChain = nullptr;
+        cullHiZBinding.texture.sampleType = WGPUTextureSampleType_UnfilterableFloat;
+        cullHiZBinding.texture.viewDimension = WGPUTextureViewDimension_2D;
+        cullHiZBinding.texture.multisampled = false;
+
+        WGPUBindGroupLayoutEntry cullBindGroupEntries[] = {
+            bufferBinding(3, WGPUBufferBindingType_Uniform),            // Culling parameters
+            bufferBinding(4, WGPUBufferBindingType_ReadOnlyStorage),    // Draw culling inputs
+            bufferBinding(5, WGPUBufferBindingType_ReadOnlyStorage),    // Source indirect arguments
+            bufferBinding(6, WGPUBufferBindingType_Storage),            // Culled indirect arguments
+            bufferBinding(7, WGPUBufferBindingType_Storage),            // Run draw counts
+            cullHiZBinding,
+        };
+        WGPUBindGroupLayoutDescriptor cullBindGroupLayoutDesc{};
+        cullBindGroupLayoutDesc.nextInChain = nullptr;
+        cullBindGroupLayoutDesc.label = "Cull Bind Group Layout";
+        cullBindGroupLayoutDesc.entryCount = std::size(cullBindGroupEntries);
+        cullBindGroupLayoutDesc.entries = cullBindGroupEntries;
+
+        m_cullBindGroupLayout = wgpuDeviceCreateBindGroupLayout(device, &cullBindGroupLayoutDesc);
+
+        // Create compute pipelines, each using a single bind group
+        WGPUShaderModule shader = createShaderModule(device, "assets/shaders/culling.wgsl", "Culling Shader");
+        auto const createComputePipeline = [&](char const* label, WGPUBindGroupLayout bindGroupLayout, char const* entryPoint) {
+            WGPUPipelineLayoutDescriptor layoutDesc{};
+            layoutDesc.nextInChain = nullptr;
+            layoutDesc.label = label;
+            layoutDesc.bindGroupLayoutCount = 1;
+            layoutDesc.bindGroupLayouts = &bindGroupLayout;
+
+            WGPUPipelineLayout layout = wgpuDeviceCreatePipelineLayout(device, &layoutDesc);
+
+            WGPUComputePipelineDescriptor pipelineDesc{};
+            pipelineDesc.nextInChain = nullptr;
+            pipelineDesc.label = label;
+            pipelineDesc.layout = layout;
+            pipelineDesc.compute.nextInChain = nullptr;
+            pipelineDesc.compute.module = shader;
+            pipelineDesc.compute.entryPoint = entryPoint;
+            pipelineDesc.compute.constantCount = 0;
+            pipelineDesc.compute.constants = nullptr;
+
+            WGPUComputePipeline pipeline = wgpuDeviceCreateComputePipeline(device, &pipelineDesc);
+            wgpuPipelineLayoutRelease(layout);
+            return pipeline;
+        };
+
+        m_hizDepthPipeline = createComputePipeline("HiZ Depth Pipeline", m_hizDepthBindGroupLayout, "CSHiZFromDepth");
+        m_hizDownsamplePipeline = createComputePipeline("HiZ Downsample Pipeline", m_hizDownsampleBindGroupLayout, "CSHiZDownsample");
+        m_cullPipeline = createComputePipeline("Cull Pipeline", m_cullBindGroupLayout, "CSCullDraws");
+        wgpuShaderModuleRelease(shader);
+    }
+
+    // Set up the depth-stencil target & pyramid, pyramid bind groups use the layouts created above
+    createRenderTargets();
+
+    // Indirect draws select instances with their first instance, which requires device support. Culling writes the
+    // indirect arguments, so it is only available along with indirect draws. Compute support is patchy on web targets,
+    // there and without indirect draws occlusion culling falls back to the software rasterizer
+    {
+        gfx::BackendCapabilities const capabilities = m_renderbackend->getBackendCapabilities();
+        m_indirectDraws = capabilities.indirectFirstInstance;
+        m_multiDrawIndirect = capabilities.indirectFirstInstance && capabilities.multiDrawIndirect;
+        m_gpuCulling = m_indirectDraws && !GAME_PLATFORM_EMSCRIPTEN;
+        m_compactDraws = m_gpuCulling && m_multiDrawIndirect && capabilities.multiDrawIndirectCount;
+        m_softwareOcclusion = !m_gpuCulling;
+        m_blockFormatSupport = gfx::BlockFormatSupport{ capabilities.textureCompressionBC, capabilities.textureCompressionETC2 };
+        SPDLOG_INFO("Renderer draw path: {} ({})", m_multiDrawIndirect ? "multi-draw indirect" : (m_indirectDraws ? "indirect" : "direct"),
+            m_compactDraws ? "GPU culling, compacted" : (m_gpuCulling ? "GPU culling" : "CPU frustum & software occlusion culling"));
+        SPDLOG_INFO("Renderer texture compression: {}",
+            m_blockFormatSupport.bc ? "BC1/BC5/BC7" : (m_blockFormatSupport.etc2 ? "ETC2" : "none"));
+    }
+
+    // Block textures default to a single white layer until block textures are set
+    {
+        uint8_t whiteTexel[] = { 255, 255, 255, 255 };
+        m_blockTextures = std::make_shared<gfx::Texture>(gfx::TextureDimensions::Dim2DArray, gfx::TextureExtent{ 1, 1, 1 }, 4, whiteTexel, gfx::TextureMode::ColorData);
+    }
+
+    // Materials without albedo or normal maps bind a single white texel instead, the shader does not sample it
+    {
+        uint8_t whiteTexel[] = { 255, 255, 255, 255 };
+        m_defaultTexture = std::make_shared<gfx::Texture>(gfx::TextureDimensions::Dim2D, gfx::TextureExtent{ 1, 1, 1 }, 4, whiteTexel, gfx::TextureMode::NonColorData);
+    }
+
+    // Allocate uniform slots for render components, including those that exist already
+    m_registry.on_construct<RenderComponent>().connect<&Renderer::onRenderComponentConstruct>(this);
+    m_registry.on_destroy<RenderComponent>().connect<&Renderer::onRenderComponentDestroy>(this);
+    for (auto const entity : m_registry.view<RenderComponent>()) {
+        onRenderComponentConstruct(m_registry, entity);
+    }
 }
 
 Renderer::~Renderer()
 {
+    m_registry.on_construct<RenderComponent>().disconnect<&Renderer::onRenderComponentConstruct>(this);
+    m_registry.on_destroy<RenderComponent>().disconnect<&Renderer::onRenderComponentDestroy>(this);
+
+    // Destroy bind groups
+    for (auto& slot : m_materialSlots)
+    {
+        if (slot.bindGroup) wgpuBindGroupRelease(slot.bindGroup);
+    }
+
+    if (m_objectDataBindGroup) wgpuBindGroupRelease(m_objectDataBindGroup);
+    if (m_sceneDataBindGroup) wgpuBindGroupRelease(m_sceneDataBindGroup);
+
+    // Destroy render targets & culling resources
+    destroyRenderTargets();
+    if (m_cullBindGroup) wgpuBindGroupRelease(m_cullBindGroup);
+    if (m_runCountBuffer) wgpuBufferRelease(m_runCountBuffer);
+    if (m_culledArgsBuffer) wgpuBufferRelease(m_culledArgsBuffer);
+
+    wgpuComputePipelineRelease(m_cullPipeline);
+    wgpuComputePipelineRelease(m_hizDownsamplePipeline);
+    wgpuComputePipelineRelease(m_hizDepthPipeline);
+    wgpuBindGroupLayoutRelease(m_cullBindGroupLayout);
+    wgpuBindGroupLayoutRelease(m_hizDownsampleBindGroupLayout);
+    wgpuBindGroupLayoutRelease(m_hizDepthBindGroupLayout);
+
     // Destroy pipeline state
+    wgpuRenderPipelineRelease(m_voxelPipeline);
     wgpuRenderPipelineRelease(m_pipeline);
     wgpuPipelineLayoutRelease(m_pipelineLayout);
     wgpuBindGroupLayoutRelease(m_objectDataBindGroupLayout);
     wgpuBindGroupLayoutRelease(m_materialDataBindGroupLayout);
     wgpuBindGroupLayoutRelease(m_sceneDataBindGroupLayout);
-
-    // Destroy render pass resources
-    wgpuBufferDestroy(m_objectTransformDataUBO);
-    wgpuBufferDestroy(m_materialDataUBO);
-    wgpuBufferDestroy(m_cameraDataUBO);
-
-    wgpuTextureViewRelease(m_depthStencilTargetView);
-    wgpuTextureRelease(m_depthStencilTarget);
 }
 
 void Renderer::render(entt::registry const& registry)
@@ -290,40 +724,306 @@ void Renderer::render(entt::registry const& registry)
         return;
     }
 
+    // Per-frame data of the previous use of this frame's arena buffer is no longer referenced
+    size_t const heapAllocationCount = core::heapAllocationCount();
+    m_frameArena.reset();
+
     // Handle data upload for this frame
     uploadSceneData(registry);
 
     // Execute frame draws with draw list from frame preparation
     execute(frame, prepare(registry));
+
+    m_stats.frameArenaBytes = m_frameArena.used();
+    m_stats.heapAllocations = core::heapAllocationCount() - heapAllocationCount;
+}
+
+void Renderer::setBlockTextures(std::shared_ptr<gfx::Texture> blockTextures)
+{
+    assert(blockTextures != nullptr && blockTextures->dimensions() == gfx::TextureDimensions::Dim2DArray && "Block textures must be a 2D texture array");
+    m_blockTextures = std::move(blockTextures);
 }
 
 void Renderer::onResize(uint32_t width, uint32_t height)
 {
     m_renderbackend->resizeSwapBuffers({ width, height });
 
-    // Recreate depth-stencil target
+    // Recreate render targets
+    destroyRenderTargets();
+    createRenderTargets();
+}
+
+void Renderer::createRenderTargets()
+{
+    WGPUDevice const device = m_renderbackend->getDevice();
+    gfx::FramebufferSize const swapFramebufferSize = m_renderbackend->getFramebufferSize();
+
+    // Set up a depth-stencil target for rendering, its depth is read back by the pyramid build
+    WGPUTextureDescriptor depthStencilTargetDesc{};
+    depthStencilTargetDesc.nextInChain = nullptr;
+    depthStencilTargetDesc.label = "Depth Stencil Target";
+    depthStencilTargetDesc.usage = WGPUTextureUsage_RenderAttachment | WGPUTextureUsage_TextureBinding;
+    depthStencilTargetDesc.dimension = WGPUTextureDimension_2D;
+    depthStencilTargetDesc.size.width = swapFramebufferSize.width;
+    depthStencilTargetDesc.size.height = swapFramebufferSize.height;
+    depthStencilTargetDesc.size.depthOrArrayLayers = 1;
+    depthStencilTargetDesc.format = WGPUTextureFormat_Depth24PlusStencil8;
+    depthStencilTargetDesc.mipLevelCount = 1;
+    depthStencilTargetDesc.sampleCount = 1;
+    depthStencilTargetDesc.viewFormatCount = 0;
+    depthStencilTargetDesc.viewFormats = nullptr;
+
+    m_depthStencilTarget = wgpuDeviceCreateTexture(device, &depthStencilTargetDesc);
+    m_depthStencilTargetView = wgpuTextureCreateView(m_depthStencilTarget, nullptr /* default view */);
+
+    WGPUTextureViewDescriptor depthSampleViewDesc{};
+    depthSampleViewDesc.nextInChain = nullptr;
+    depthSampleViewDesc.label = "Depth Sample View";
+    depthSampleViewDesc.format = WGPUTextureFormat_Undefined; // Resolved to the depth aspect format
+    depthSampleViewDesc.dimension = WGPUTextureViewDimension_2D;
+    depthSampleViewDesc.baseMipLevel = 0;
+    depthSampleViewDesc.mipLevelCount = 1;
+    depthSampleViewDesc.baseArrayLayer = 0;
+    depthSampleViewDesc.arrayLayerCount = 1;
+    depthSampleViewDesc.aspect = WGPUTextureAspect_DepthOnly;
+
+    m_depthSampleView = wgpuTextureCreateView(m_depthStencilTarget, &depthSampleViewDesc);
+
+    // Set up the hierarchical-Z pyramid, levels are written as storage textures and read by the culling pass
+    m_hizDepthSize = { swapFramebufferSize.width, swapFramebufferSize.height };
+    glm::uvec2 const baseSize = gfx::HiZPyramid::baseSize(m_hizDepthSize);
+    uint32_t const levelCount = gfx::HiZPyramid::levelCount(m_hizDepthSize);
+
+    WGPUTextureDescriptor hizDesc{};
+    hizDesc.nextInChain = nullptr;
+    hizDesc.label = "HiZ Pyramid";
+    hizDesc.usage = WGPUTextureUsage_StorageBinding | WGPUTextureUsage_TextureBinding;
+    hizDesc.dimension = WGPUTextureDimension_2D;
+    hizDesc.size.width = baseSize.x;
+    hizDesc.size.height = baseSize.y;
+    hizDesc.size.depthOrArrayLayers = 1;
+    hizDesc.format = WGPUTextureFormat_R32Float;
+    hizDesc.mipLevelCount = levelCount;
+    hizDesc.sampleCount = 1;
+    hizDesc.viewFormatCount = 0;
+    hizDesc.viewFormats = nullptr;
+
+    m_hizTexture = wgpuDeviceCreateTexture(device, &hizDesc);
+    m_hizView = wgpuTextureCreateView(m_hizTexture, nullptr /* default view */);
+
+    glm::uvec2 levelSize = baseSize;
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        WGPUTextureViewDescriptor levelViewDesc{};
+        levelViewDesc.nextInChain = nullptr;
+        levelViewDesc.label = "HiZ Level View";
+        levelViewDesc.format = WGPUTextureFormat_R32Float;
+        levelViewDesc.dimension = WGPUTextureViewDimension_2D;
+        levelViewDesc.baseMipLevel = level;
+        levelViewDesc.mipLevelCount = 1;
+        levelViewDesc.baseArrayLayer = 0;
+        levelViewDesc.arrayLayerCount = 1;
+        levelViewDesc.aspect = WGPUTextureAspect_All;
+
+        m_hizLevelViews.push_back(wgpuTextureCreateView(m_hizTexture, &levelViewDesc));
+        m_hizLevelSizes.push_back(levelSize);
+        levelSize = gfx::HiZPyramid::baseSize(levelSize);
+    }
+
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        WGPUBindGroupEntry hizSourceBinding{};
+        hizSourceBinding.nextInChain = nullptr;
+        hizSourceBinding.binding = (level == 0) ? 0 : 1;
+        hizSourceBinding.textureView = (level == 0) ? m_depthSampleView : m_hizLevelViews[level - 1];
+
+        WGPUBindGroupEntry hizTargetBinding{};
+        hizTargetBinding.nextInChain = nullptr;
+        hizTargetBinding.binding = 2;
+        hizTargetBinding.textureView = m_hizLevelViews[level];
+
+        WGPUBindGroupEntry hizBindGroupEntries[] = { hizSourceBinding, hizTargetBinding, };
+        WGPUBindGroupDescriptor hizBindGroupDesc{};
+        hizBindGroupDesc.nextInChain = nullptr;
+        hizBindGroupDesc.label = "HiZ Bind Group";
+        hizBindGroupDesc.layout = (level == 0) ? m_hizDepthBindGroupLayout : m_hizDownsampleBindGroupLayout;
+        hizBindGroupDesc.entryCount = std::size(hizBindGroupEntries);
+        hizBindGroupDesc.entries = hizBindGroupEntries;
+
+        m_hizBindGroups.push_back(wgpuDeviceCreateBindGroup(device, &hizBindGroupDesc));
+    }
+
+    // The new pyramid holds no depth yet, the culling bind group still references the previous pyramid
+    m_hizValid = false;
+    if (m_cullBindGroup)
+    {
+        wgpuBindGroupRelease(m_cullBindGroup);
+        m_cullBindGroup = nullptr;
+    }
+}
+
+void Renderer::destroyRenderTargets()
+{
+    for (auto& bindGroup : m_hizBindGroups) {
+        wgpuBindGroupRelease(bindGroup);
+    }
+
+    for (auto& levelView : m_hizLevelViews) {
+        wgpuTextureViewRelease(levelView);
+    }
+
+    m_hizBindGroups.clear();
+    m_hizLevelViews.clear();
+    m_hizLevelSizes.clear();
+    wgpuTextureViewRelease(m_hizView);
+    wgpuTextureRelease(m_hizTexture);
+
+    wgpuTextureViewRelease(m_depthSampleView);
+    wgpuTextureViewRelease(m_depthStencilTargetView);
+    wgpuTextureRelease(m_depthStencilTarget);
+}
+
+void Renderer::onRenderComponentConstruct(entt::registry& registry, entt::entity entity)
+{
+    (void)(registry);
+
+    uint32_t slotIndex = static_cast<uint32_t>(m_objectSlots.size());
+    if (!m_freeObjectSlots.empty())
     {
-        wgpuTextureViewRelease(m_depthStencilTargetView);
-        wgpuTextureRelease(m_depthStencilTarget);
+        slotIndex = m_freeObjectSlots.back();
+        m_freeObjectSlots.pop_back();
+    }
+    else
+    {
+        m_objectSlots.emplace_back();
+    }
 
-        gfx::FramebufferSize const swapFramebufferSize = m_renderbackend->getFramebufferSize();
-        WGPUTextureDescriptor depthStencilTargetDesc{};
-        depthStencilTargetDesc.nextInChain = nullptr;
-        depthStencilTargetDesc.label = "Depth Stencil Target";
-        depthStencilTargetDesc.usage = WGPUTextureUsage_RenderAttachment;
-        depthStencilTargetDesc.dimension = WGPUTextureDimension_2D;
-        depthStencilTargetDesc.size.width = swapFramebufferSize.width;
-        depthStencilTargetDesc.size.height = swapFramebufferSize.height;
-        depthStencilTargetDesc.size.depthOrArrayLayers = 1;
-        depthStencilTargetDesc.format = WGPUTextureFormat_Depth24PlusStencil8;
-        depthStencilTargetDesc.mipLevelCount = 1;
-        depthStencilTargetDesc.sampleCount = 1;
-        depthStencilTargetDesc.viewFormatCount = 0;
-        depthStencilTargetDesc.viewFormats = nullptr;
+    m_objectSlots[slotIndex] = ObjectSlot{};
+    m_objectSlotIndices[entity] = slotIndex;
+}
 
-        m_depthStencilTarget = wgpuDeviceCreateTexture(m_renderbackend->getDevice(), &depthStencilTargetDesc);
-        m_depthStencilTargetView = wgpuTextureCreateView(m_depthStencilTarget, nullptr /* default view */);
+void Renderer::onRenderComponentDestroy(entt::registry& registry, entt::entity entity)
+{
+    (void)(registry);
+
+    auto const& it = m_objectSlotIndices.find(entity);
+    if (it == m_objectSlotIndices.end()) {
+        return;
+    }
+
+    ObjectSlot& slot = m_objectSlots[it->second];
+    if (slot.materialSlot != INVALID_SLOT)
+    {
+        releaseMaterialSlot(slot.materialSlot);
+        slot.materialSlot = INVALID_SLOT;
     }
+
+    m_freeObjectSlots.push_back(it->second);
+    m_objectSlotIndices.erase(it);
+}
+
+uint32_t Renderer::acquireMaterialSlot(std::shared_ptr<gfx::Material> const& material)
+{
+    assert(material != nullptr && "Material cannot be a nullptr");
+
+    auto const& it = m_materialSlotIndices.find(material.get());
+    if (it != m_materialSlotIndices.end())
+    {
+        m_materialSlots[it->second].references++;
+        return it->second;
+    }
+
+    uint32_t slotIndex = static_cast<uint32_t>(m_materialSlots.size());
+    if (!m_freeMaterialSlots.empty())
+    {
+        slotIndex = m_freeMaterialSlots.back();
+        m_freeMaterialSlots.pop_back();
+    }
+    else
+    {
+        m_materialSlots.emplace_back();
+    }
+
+    // Holding a reference keeps the material address stable while it is used as a key
+    MaterialSlot& slot = m_materialSlots[slotIndex];
+    slot.material = material;
+    slot.references = 1;
+    m_materialSlotIndices[material.get()] = slotIndex;
+    return slotIndex;
+}
+
+void Renderer::releaseMaterialSlot(uint32_t slotIndex)
+{
+    MaterialSlot& slot = m_materialSlots[slotIndex];
+    assert(slot.references > 0 && "Material slot is not referenced");
+    if (--slot.references > 0) {
+        return;
+    }
+
+    m_materialSlotIndices.erase(slot.material.get());
+    if (slot.bindGroup) wgpuBindGroupRelease(slot.bindGroup);
+    slot = MaterialSlot{};
+    m_freeMaterialSlots.push_back(slotIndex);
+}
+
+void Renderer::updateMaterialBindGroup(uint32_t slotIndex)
+{
+    MaterialSlot& slot = m_materialSlots[slotIndex];
+    gfx::Material const& material = *slot.material;
+    gfx::Texture const& albedoTexture = material.albedoTexture ? *material.albedoTexture : *m_defaultTexture;
+    gfx::Texture const& normalTexture = material.normalTexture ? *material.normalTexture : *m_defaultTexture;
+    WGPUTextureView const albedoView = albedoTexture.getTextureView();
+    WGPUTextureView const normalView = normalTexture.getTextureView();
+    if (slot.bindGroup != nullptr && slot.albedoView == albedoView && slot.normalView == normalView) {
+        return;
+    }
+
+    WGPUBindGroupEntry materialDataMaterialBinding{};
+    materialDataMaterialBinding.nextInChain = nullptr;
+    materialDataMaterialBinding.binding = 0;
+    materialDataMaterialBinding.buffer = m_materialData.buffer();
+    materialDataMaterialBinding.offset = slotIndex * m_materialData.stride();
+    materialDataMaterialBinding.size = m_materialData.stride();
+
+    WGPUBindGroupEntry materialDataAlbedoSamplerBinding{};
+    materialDataAlbedoSamplerBinding.nextInChain = nullptr;
+    materialDataAlbedoSamplerBinding.binding = 1;
+    materialDataAlbedoSamplerBinding.sampler = albedoTexture.getSampler();
+
+    WGPUBindGroupEntry materialDataAlbedoMapBinding{};
+    materialDataAlbedoMapBinding.nextInChain = nullptr;
+    materialDataAlbedoMapBinding.binding = 2;
+    materialDataAlbedoMapBinding.textureView = albedoView;
+
+    WGPUBindGroupEntry materialDataNormalSamplerBinding{};
+    materialDataNormalSamplerBinding.nextInChain = nullptr;
+    materialDataNormalSamplerBinding.binding = 3;
+    materialDataNormalSamplerBinding.sampler = normalTexture.getSampler();
+
+    WGPUBindGroupEntry materialDataNormalMapBinding{};
+    materialDataNormalMapBinding.nextInChain = nullptr;
+    materialDataNormalMapBinding.binding = 4;
+    materialDataNormalMapBinding.textureView = normalView;
+
+    WGPUBindGroupEntry materialDataBindGroupEntries[] = {
+        materialDataMaterialBinding,
+        materialDataAlbedoSamplerBinding,
+        materialDataAlbedoMapBinding,
+        materialDataNormalSamplerBinding,
+        materialDataNormalMapBinding,
+    };
+    WGPUBindGroupDescriptor materialDataBindGroupDesc{};
+    materialDataBindGroupDesc.nextInChain = nullptr;
+    materialDataBindGroupDesc.label = "Material Data Bind Group";
+    materialDataBindGroupDesc.layout = m_materialDataBindGroupLayout;
+    materialDataBindGroupDesc.entryCount = std::size(materialDataBindGroupEntries);
+    materialDataBindGroupDesc.entries = materialDataBindGroupEntries;
+
+    if (slot.bindGroup) wgpuBindGroupRelease(slot.bindGroup);
+    slot.bindGroup = wgpuDeviceCreateBindGroup(m_renderbackend->getDevice(), &materialDataBindGroupDesc);
+    slot.albedoView = albedoView;
+    slot.normalView = normalView;
+    m_stats.materialBindGroupsCreated++;
 }
 
 void Renderer::uploadSceneData(entt::registry const& registry)
@@ -360,163 +1060,205 @@ void Renderer::uploadSceneData(entt::registry const& registry)
         }
     }
 
-    // Create and populate GPU objects with host-side data
+    // Create and populate GPU objects with host-side data, uploads exceeding the frame budget are deferred
+    m_uploadManager.beginFrame();
+    m_stats.deferredUploads = 0;
     {
+        // Block & default textures are never deferred, bind groups must reference uploaded textures
+        if (m_blockTextures->isDirty()) {
+            uploadTexture(*m_blockTextures);
+        }
+
+        if (m_defaultTexture->isDirty()) {
+            uploadTexture(*m_defaultTexture);
+        }
+
         for (auto& mesh : dirtyMeshes)
         {
-            // Create buffers
-            WGPUBufferDescriptor vertexBufferDesc{};
-            vertexBufferDesc.nextInChain = nullptr;
-            vertexBufferDesc.label = "Vertex Buffer (managed)";
-            vertexBufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Vertex;
-            vertexBufferDesc.size = mesh->vertexCount() * sizeof(gfx::Vertex);
-            vertexBufferDesc.mappedAtCreation = false;
-
-            WGPUBufferDescriptor indexBufferDesc{};
-            indexBufferDesc.nextInChain = nullptr;
-            indexBufferDesc.label = "Index Buffer (managed)";
-            indexBufferDesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Index;
-            indexBufferDesc.size = mesh->indexCount() * sizeof(gfx::IndexType);
-            indexBufferDesc.mappedAtCreation = false;
-
-            WGPUBuffer vertexBuffer = wgpuDeviceCreateBuffer(m_renderbackend->getDevice(), &vertexBufferDesc);
-            WGPUBuffer indexBuffer = wgpuDeviceCreateBuffer(m_renderbackend->getDevice(), &indexBufferDesc);
-            SPDLOG_TRACE("Created mesh buffers (vertex bytes: {} | index bytes: {})", vertexBufferDesc.size, indexBufferDesc.size);
-
-            // Upload buffer data
-            std::vector<gfx::Vertex> vertices{};
-            std::vector<gfx::IndexType> indices{};
-            mesh->getBuffers(vertices, indices);
-            wgpuQueueWriteBuffer(m_renderbackend->getQueue(), vertexBuffer, 0, vertices.data(), wgpuBufferGetSize(vertexBuffer));
-            wgpuQueueWriteBuffer(m_renderbackend->getQueue(), indexBuffer, 0, indices.data(), wgpuBufferGetSize(indexBuffer));
-
-            // Update mesh
-            mesh->setVertexBuffer(vertexBuffer);
-            mesh->setIndexBuffer(indexBuffer);
+            size_t const uploadSize = mesh->vertexCount() * mesh->vertexStride() + mesh->indexCount() * sizeof(gfx::IndexType);
+            if (!m_uploadManager.canUpload(uploadSize))
+            {
+                m_stats.deferredUploads++;
+                continue;
+            }
+
+            // Allocate new pool ranges & upload, the previous ranges are released once the new allocation is set
+            mesh->setDeviceAllocation(m_meshPool->upload(m_uploadManager, *mesh));
             mesh->clearDirtyFlag(); // done :)
         }
 
+        // Textures are compressed when loaded, so their host-side size is the size of the upload
         for (auto& texture : dirtyTextures)
         {
-            // Get texture data
-            gfx::TextureDimensions const dimensions = texture->dimensions();
-            gfx::TextureExtent const extent = texture->extent();
-            uint8_t const components = texture->components();
-
-            // Parse dimensions
-            WGPUTextureDimension dim = WGPUTextureDimension_Force32;
-            switch (dimensions)
+            if (!m_uploadManager.canUpload(texture->size()))
             {
-            case gfx::TextureDimensions::Dim1D:
-                dim = WGPUTextureDimension_1D;
-                break;
-            case gfx::TextureDimensions::Dim2D:
-                dim = WGPUTextureDimension_2D;
-                break;
-            case gfx::TextureDimensions::Dim3D:
-                dim = WGPUTextureDimension_3D;
-                break;
-            default:
-                break;
+                m_stats.deferredUploads++;
+                continue;
             }
 
-            // Guess a good format based on components
-            WGPUTextureFormat format = WGPUTextureFormat_Undefined;
-            switch (components)
-            {
-            case 1:
-                format = WGPUTextureFormat_R8Unorm;
-                break;
-            case 2:
-                format = WGPUTextureFormat_RG8Unorm;
-                break;
-            case 3:
-                throw std::runtime_error("WGPU does not support 3 channel textures");
-                break;
-            case 4:
-                format = (texture->textureMode() == gfx::TextureMode::ColorData) ?
-                    WGPUTextureFormat_RGBA8UnormSrgb : WGPUTextureFormat_RGBA8Unorm;
-                break;
-            default:
-                break;
-            }
+            uploadTexture(*texture);
+        }
+    }
+
+    // Submit all uploads of this frame before the frame commands that use them
+    m_uploadManager.submit();
+
+    gfx::UploadStats const& uploadStats = m_uploadManager.stats();
+    m_stats.uploadBytes = uploadStats.bytesUploaded;
+    m_stats.uploadTime = uploadStats.uploadTime;
+
+    gfx::MeshPoolStats const meshPoolStats = m_meshPool->stats();
+    m_stats.meshPoolBytes = meshPoolStats.usedBytes;
+    m_stats.meshPoolFragmentation = meshPoolStats.fragmentation;
+    SPDLOG_TRACE("Uploads: {} bytes in {:.3f} ms ({} uploads, {} deferred, {} staging buffers)",
+        uploadStats.bytesUploaded, uploadStats.uploadTime, uploadStats.uploads, m_stats.deferredUploads, uploadStats.stagingBuffers);
+}
+
+void Renderer::uploadTexture(gfx::Texture& texture)
+{
+    // Get texture data
+    gfx::TextureDimensions const dimensions = texture.dimensions();
+    gfx::TextureExtent const extent = texture.extent();
+    uint8_t const components = texture.components();
+
+    // Textures are compressed when loaded, uploads only map their block format to a device format
+    gfx::BlockFormat const blockFormat = texture.blockFormat();
+    bool const etc2 = blockFormat == gfx::BlockFormat::ETC2RGB8;
+    if (blockFormat != gfx::BlockFormat::None && !(etc2 ? m_blockFormatSupport.etc2 : m_blockFormatSupport.bc)) {
+        throw std::runtime_error("Texture block format is not supported by the device");
+    }
+
+    bool const srgb = texture.textureMode() == gfx::TextureMode::ColorData;
+
+    // Parse dimensions
+    WGPUTextureDimension dim = WGPUTextureDimension_Force32;
+    switch (dimensions)
+    {
+    case gfx::TextureDimensions::Dim1D:
+        dim = WGPUTextureDimension_1D;
+        break;
+    case gfx::TextureDimensions::Dim2D:
+    case gfx::TextureDimensions::Dim2DArray:
+        dim = WGPUTextureDimension_2D;
+        break;
+    case gfx::TextureDimensions::Dim3D:
+        dim = WGPUTextureDimension_3D;
+        break;
+    default:
+        break;
+    }
+
+    // Guess a good format based on components
+    WGPUTextureFormat format = WGPUTextureFormat_Undefined;
+    switch (components)
+    {
+    case 1:
+        format = WGPUTextureFormat_R8Unorm;
+        break;
+    case 2:
+        format = WGPUTextureFormat_RG8Unorm;
+        break;
+    case 3:
+        throw std::runtime_error("WGPU does not support 3 channel textures");
+        break;
+    case 4:
+        format = srgb ? WGPUTextureFormat_RGBA8UnormSrgb : WGPUTextureFormat_RGBA8Unorm;
+        break;
+    default:
+        break;
+    }
+
+    switch (blockFormat)
+    {
+    case gfx::BlockFormat::BC1:
+        format = srgb ? WGPUTextureFormat_BC1RGBAUnormSrgb : WGPUTextureFormat_BC1RGBAUnorm;
+        break;
+    case gfx::BlockFormat::BC5:
+        format = WGPUTextureFormat_BC5RGUnorm;
+        break;
+    case gfx::BlockFormat::BC7:
+        format = srgb ? WGPUTextureFormat_BC7RGBAUnormSrgb : WGPUTextureFormat_BC7RGBAUnorm;
+        break;
+    case gfx::BlockFormat::ETC2RGB8:
+        format = srgb ? WGPUTextureFormat_ETC2RGB8UnormSrgb : WGPUTextureFormat_ETC2RGB8Unorm;
+        break;
+    case gfx::BlockFormat::None:
+    default:
+        break;
+    }
+
+    // Create texture
+    WGPUTextureDescriptor textureDesc{};
+    textureDesc.nextInChain = nullptr;
+    textureDesc.label = "Image Texture (managed)";
+    textureDesc.usage = WGPUTextureUsage_CopyDst | WGPUTextureUsage_TextureBinding;
+    textureDesc.dimension = dim;
+    textureDesc.size.width = extent.width;
+    textureDesc.size.height = extent.height;
+    textureDesc.size.depthOrArrayLayers = extent.depthOrArrayLayers;
+    textureDesc.format = format;
+    textureDesc.mipLevelCount = texture.mipLevelCount();
+    textureDesc.sampleCount = 1;
+    textureDesc.viewFormatCount = 0;
+    textureDesc.viewFormats = nullptr;
+
+    WGPUTexture gpuTexture = wgpuDeviceCreateTexture(m_renderbackend->getDevice(), &textureDesc);
+    SPDLOG_TRACE("Created texture handle (size: {}x{}x{})", textureDesc.size.width, textureDesc.size.height, textureDesc.size.depthOrArrayLayers);
+
+    // Create sampler
+    // TODO(nemjit001): Provide these params in texture object
+    WGPUSamplerDescriptor samplerDesc{};
+    samplerDesc.nextInChain = nullptr;
+    samplerDesc.label = "Texture Sampler (managed)";
+    samplerDesc.addressModeU = WGPUAddressMode_Repeat;
+    samplerDesc.addressModeV = WGPUAddressMode_Repeat;
+    samplerDesc.addressModeW = WGPUAddressMode_Repeat;
+    samplerDesc.magFilter = WGPUFilterMode_Linear;
+    samplerDesc.minFilter = WGPUFilterMode_Linear;
+    samplerDesc.mipmapFilter = WGPUMipmapFilterMode_Linear;
+    samplerDesc.lodMinClamp = 0.0F;
+    samplerDesc.lodMaxClamp = static_cast<float>(textureDesc.mipLevelCount);
+    samplerDesc.compare = WGPUCompareFunction_Undefined;
+    samplerDesc.maxAnisotropy = 1;
+
+    WGPUSampler sampler = wgpuDeviceCreateSampler(m_renderbackend->getDevice(), &samplerDesc);
+    SPDLOG_TRACE("Created texture sampler");
+
+    // Upload texture data, all mip levels are generated & compressed on the host
+    for (uint32_t level = 0; level < textureDesc.mipLevelCount; level++)
+    {
+        gfx::TextureExtent const mipExtent = texture.mipExtent(level);
+        WGPUExtent3D const mipSize{ mipExtent.width, mipExtent.height, mipExtent.depthOrArrayLayers };
+        if (blockFormat != gfx::BlockFormat::None)
+        {
+            m_uploadManager.uploadCompressedTexture(gpuTexture, level, mipSize, gfx::blockBytes(blockFormat), texture.mipData(level));
+        }
+        else
+        {
+            m_uploadManager.uploadTexture(gpuTexture, level, mipSize, components, texture.mipData(level));
+        }
+    }
 
-            // Create texture
-            WGPUTextureDescriptor textureDesc{};
-            textureDesc.nextInChain = nullptr;
-            textureDesc.label = "Image Texture (managed)";
-            textureDesc.usage = WGPUTextureUsage_CopyDst | WGPUTextureUsage_TextureBinding;
-            textureDesc.dimension = dim;
-            textureDesc.size.width = extent.width;
-            textureDesc.size.height = extent.height;
-            textureDesc.size.depthOrArrayLayers = extent.depthOrArrayLayers;
-            textureDesc.format = format;
-            textureDesc.mipLevelCount = 1; // TODO(nemjit001): implement mip levels on host side, then upload as bytes into texture
-            textureDesc.sampleCount = 1;
-            textureDesc.viewFormatCount = 0;
-            textureDesc.viewFormats = nullptr;
-
-            WGPUTexture gpuTexture = wgpuDeviceCreateTexture(m_renderbackend->getDevice(), &textureDesc);
-            SPDLOG_TRACE("Created texture handle (size: {}x{}x{})", textureDesc.size.width, textureDesc.size.height, textureDesc.size.depthOrArrayLayers);
-
-            // Create sampler
-            // TODO(nemjit001): Provide these params in texture object
-            WGPUSamplerDescriptor samplerDesc{};
-            samplerDesc.nextInChain = nullptr;
-            samplerDesc.label = "Texture Sampler (managed)";
-            samplerDesc.addressModeU = WGPUAddressMode_Repeat;
-            samplerDesc.addressModeV = WGPUAddressMode_Repeat;
-            samplerDesc.addressModeW = WGPUAddressMode_Repeat;
-            samplerDesc.magFilter = WGPUFilterMode_Linear;
-            samplerDesc.minFilter = WGPUFilterMode_Linear;
-            samplerDesc.mipmapFilter = WGPUMipmapFilterMode_Linear;
-            samplerDesc.lodMinClamp = 0.0F;
-            samplerDesc.lodMaxClamp = 0.0F;
-            samplerDesc.compare = WGPUCompareFunction_Undefined;
-            samplerDesc.maxAnisotropy = 1;
-
-            WGPUSampler sampler = wgpuDeviceCreateSampler(m_renderbackend->getDevice(), &samplerDesc);
-            SPDLOG_TRACE("Created texture sampler");
-
-            // Upload texture data
-            WGPUImageCopyTexture destination{};
-            destination.nextInChain = nullptr;
-            destination.texture = gpuTexture;
-            destination.mipLevel = 0;
-            destination.origin = { 0, 0, 0 }; // Always 0, 0, 0 for now
-            destination.aspect = WGPUTextureAspect_All;
-
-            WGPUTextureDataLayout layout{};
-            layout.nextInChain = nullptr;
-            layout.offset = 0;
-            layout.bytesPerRow = components * extent.width;
-            layout.rowsPerImage = extent.height;
-
-            size_t const dataSize = extent.width * extent.height * extent.depthOrArrayLayers * components;
-            wgpuQueueWriteTexture(m_renderbackend->getQueue(), &destination, texture->data(), dataSize, &layout, &textureDesc.size);
-
-            // Update texture
-            texture->setTexture(gpuTexture);
-            texture->setSampler(sampler);
-            texture->clearDirtyFlag(); // Done :)
-        }
-    }
-}
-
-DrawList Renderer::prepare(entt::registry const& registry)
-{
-    // Get backend capabilities for data population
-    gfx::BackendCapabilities const backendCaps = m_renderbackend->getBackendCapabilities();
+    // Update texture
+    texture.setTexture(gpuTexture);
+    texture.setSampler(sampler);
+    texture.clearDirtyFlag(); // Done :)
+}
 
+DrawList const& Renderer::prepare(entt::registry const& registry)
+{
     // Gather render data from ECS registry
     auto const cameras = registry.view<Camera, Transform>();
     auto const objects = registry.view<RenderComponent, Transform>();
 
-    // Set up draw list for frame
-    DrawList drawList{};
+    // Set up draw list for frame, storage is reused between frames
+    m_drawList.clear();
 
-    // Gather camera uniform data
-    std::vector<CameraUniform> cameraUniforms{};
+    // Update camera uniform data
+    uint32_t cameraCount = 0;
+    gfx::Frustum cullingFrustum{};
+    glm::mat4 cullingViewProject(1.0F);
+    glm::vec3 cullingPosition(0.0F);
     for (auto const& [_entity, camera, transform] : cameras.each())
     {
         gfx::FramebufferSize const framebufferSize = m_renderbackend->getFramebufferSize();
@@ -524,17 +1266,28 @@ DrawList Renderer::prepare(entt::registry const& registry)
 
         glm::mat4 const view = glm::inverse(transform.matrix()); // World -> View is inverse transform matrix
         glm::mat4 const project = camera.matrix(aspectRatio);
-        cameraUniforms.push_back({
+        CameraUniform const cameraUniform{
             view,
             project,
             project * view
-        });
+        };
+
+        if (cameraCount == 0) {
+            cullingFrustum = gfx::Frustum::fromMatrix(cameraUniform.viewproject);
+            cullingViewProject = cameraUniform.viewproject;
+            cullingPosition = transform.position;
+        }
+
+        m_cameraData.update(cameraCount, &cameraUniform);
+        cameraCount++;
     }
 
-    // Gather material/object uniform data & record opaque draw data
-    std::vector<std::shared_ptr<gfx::Material>> materialEntries{};
-    std::vector<MaterialUniform> materialUniforms{};
-    std::vector<ObjectTranformUniform> objectTransformUniforms{};
+    // Update object slots, transform uniforms and world bounds are only recalculated when the transform or mesh changed
+    core::FrameVector<entt::entity> candidates(m_frameArena);
+    core::FrameVector<uint32_t> candidateSlots(m_frameArena);
+    candidates.reserve(objects.size_hint());
+    candidateSlots.reserve(objects.size_hint());
+    m_cullingBounds.clear();
     for (auto const& [_entity, object, transform] : objects.each())
     {
         if (!object.material || !object.mesh)
@@ -543,108 +1296,163 @@ DrawList Renderer::prepare(entt::registry const& registry)
             continue;
         }
 
-        bool const hasAlbedoMap = (object.material->albedoTexture != nullptr);
-        bool const hasNormalMap = (object.material->normalTexture != nullptr);
-        materialEntries.push_back(object.material);
-        materialUniforms.push_back({
-            object.material->albedoColor, 1.0F /* padding */,
-            hasAlbedoMap,
-            hasNormalMap
-        });
+        if (!isDrawable(object)) {
+            continue;
+        }
 
-        glm::mat4 const modelTransform = transform.matrix();
-        glm::mat4 const normalTransform = glm::inverse(glm::transpose(glm::mat3(modelTransform)));
-        objectTransformUniforms.push_back({
-            modelTransform,
-            normalTransform
-        });
+        auto const& it = m_objectSlotIndices.find(_entity);
+        assert(it != m_objectSlotIndices.end() && "Render component has no uniform slot");
+        uint32_t const slotIndex = it->second;
+        ObjectSlot& slot = m_objectSlots[slotIndex];
 
-        size_t const materialOffset = materialUniforms.size() - 1;
-        size_t const objectOffset = objectTransformUniforms.size() - 1;
-        drawList.append(RENDERER_PASS_OPAQUE, {
-            0, // Always use camera 0 for now since multiple cameras are not yet supported...
-            static_cast<uint32_t>(materialOffset),
-            static_cast<uint32_t>(objectOffset),
-            object.mesh
-        });
+        gfx::AABB const& localBounds = object.mesh->bounds();
+        if (!slot.valid || !isSameTransform(slot.transform, transform) || !isSameBounds(slot.localBounds, localBounds))
+        {
+            glm::mat4 const modelTransform = transform.matrix();
+            glm::mat4 const normalTransform = glm::inverse(glm::transpose(glm::mat3(modelTransform)));
+            ObjectTranformUniform const objectTransformUniform{
+                modelTransform,
+                normalTransform
+            };
+
+            m_objectTransformData.update(slotIndex, &objectTransformUniform);
+            slot.valid = true;
+            slot.transform = transform;
+            slot.localBounds = localBounds;
+            slot.worldBounds = localBounds.transform(modelTransform);
+        }
+
+        // Objects only hold a material reference, swapping the material moves the object to another material slot
+        if (slot.materialSlot == INVALID_SLOT || m_materialSlots[slot.materialSlot].material != object.material)
+        {
+            uint32_t const materialSlot = acquireMaterialSlot(object.material);
+            if (slot.materialSlot != INVALID_SLOT) {
+                releaseMaterialSlot(slot.materialSlot);
+            }
+
+            slot.materialSlot = materialSlot;
+        }
+
+        candidates.push_back(_entity);
+        candidateSlots.push_back(slotIndex);
+        m_cullingBounds.append(slot.worldBounds);
     }
 
-    // Populate camera UBO
+    // Materials are shared between entities and have no change tracking, but their uniform data is cheap to compare
+    m_stats.materials = m_materialSlotIndices.size();
+    for (auto const& [_material, materialSlot] : m_materialSlotIndices)
     {
-        size_t const cameraUniformAlignment = core::alignAddress(sizeof(CameraUniform), backendCaps.minUniformBufferOffsetAlignment);
-        size_t const cameraUniformBufferSize = cameraUniforms.size() * cameraUniformAlignment;
-        if (m_cameraDataUBO == nullptr || wgpuBufferGetSize(m_cameraDataUBO) < cameraUniformBufferSize) {
-            WGPUBufferDescriptor cameraUBODesc{};
-            cameraUBODesc.nextInChain = nullptr;
-            cameraUBODesc.label = "Camera UBO";
-            cameraUBODesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Uniform;
-            cameraUBODesc.size = cameraUniformBufferSize;
-            cameraUBODesc.mappedAtCreation = false;
+        bool const hasAlbedoMap = (_material->albedoTexture != nullptr);
+        bool const hasNormalMap = (_material->normalTexture != nullptr);
+        MaterialUniform const materialUniform{
+            _material->albedoColor, 1.0F /* padding */,
+            hasAlbedoMap,
+            hasNormalMap
+        };
 
-            m_cameraDataUBO = wgpuDeviceCreateBuffer(m_renderbackend->getDevice(), &cameraUBODesc);
-        }
+        m_materialData.update(materialSlot, &materialUniform);
+    }
+
+    // Cull objects outside the camera frustum
+    m_cullingResults.assign(candidates.size(), 1);
+    m_stats.visibleObjects = candidates.size();
+    if (cameraCount > 0) {
+        m_stats.visibleObjects = m_cullingBounds.cull(cullingFrustum, m_cullingResults);
+    }
+
+    m_stats.culledObjects = candidates.size() - m_stats.visibleObjects;
 
-        for (size_t i = 0; i < cameraUniforms.size(); i++)
+    // Test objects inside the frustum against the nearest fully solid chunks, rasterized in software
+    m_stats.occludedObjects = 0;
+    if (m_softwareOcclusion && cameraCount > 0 && m_stats.visibleObjects > 0)
+    {
+        rasterizeOccluders(registry, cullingFrustum, cullingViewProject, cullingPosition);
+        for (size_t i = 0; i < candidates.size(); i++)
         {
-            size_t const offset = cameraUniformAlignment * i;
-            wgpuQueueWriteBuffer(m_renderbackend->getQueue(), m_cameraDataUBO, offset, &cameraUniforms[i], sizeof(CameraUniform));
+            if (m_cullingResults[i] && m_occlusionRasterizer.isOccluded(m_objectSlots[candidateSlots[i]].worldBounds))
+            {
+                m_cullingResults[i] = 0;
+                m_stats.occludedObjects++;
+            }
         }
+
+        m_stats.visibleObjects -= m_stats.occludedObjects;
     }
 
-    // Populate object transform UBO
+    // Group visible objects sharing a mesh and material into batches, then write the object slot of each instance
+    // so that batch instances are contiguous in the instance buffer
+    InstanceBatchMap instanceBatchIndices(m_instanceBatches.size(), InstanceBatchKeyHash{}, std::equal_to<InstanceBatchKey>{}, m_frameArena);
+    core::FrameVector<uint32_t> candidateBatches(candidates.size(), 0, m_frameArena);
+    m_instanceBatches.clear();
+    for (size_t i = 0; i < candidates.size(); i++)
     {
-        size_t const objectTransformUniformAlignment = core::alignAddress(sizeof(ObjectTranformUniform), backendCaps.minUniformBufferOffsetAlignment);
-        size_t const objectTransformUniformBufferSize = objectTransformUniforms.size() * objectTransformUniformAlignment;
-        if (m_objectTransformDataUBO == nullptr || wgpuBufferGetSize(m_objectTransformDataUBO) < objectTransformUniformBufferSize) {
-            WGPUBufferDescriptor objectTransformUBODesc{};
-            objectTransformUBODesc.nextInChain = nullptr;
-            objectTransformUBODesc.label = "Object Transform UBO";
-            objectTransformUBODesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Uniform;
-            objectTransformUBODesc.size = objectTransformUniformBufferSize;
-            objectTransformUBODesc.mappedAtCreation = false;
-
-            m_objectTransformDataUBO = wgpuDeviceCreateBuffer(m_renderbackend->getDevice(), &objectTransformUBODesc);
+        if (!m_cullingResults[i]) {
+            continue;
         }
 
-        for (size_t i = 0; i < objectTransformUniforms.size(); i++)
-        {
-            size_t const offset = objectTransformUniformAlignment * i;
-            wgpuQueueWriteBuffer(m_renderbackend->getQueue(), m_objectTransformDataUBO, offset, &objectTransformUniforms[i], sizeof(ObjectTranformUniform));
+        RenderComponent const& object = objects.get<RenderComponent>(candidates[i]);
+        ObjectSlot const& slot = m_objectSlots[candidateSlots[i]];
+        InstanceBatchKey const key{ object.mesh.get(), slot.materialSlot };
+        auto const& [it, inserted] = instanceBatchIndices.try_emplace(key, static_cast<uint32_t>(m_instanceBatches.size()));
+        if (inserted) {
+            m_instanceBatches.push_back(InstanceBatch{ object.mesh, key.materialSlot, 0, 0 });
         }
+
+        // Batches are sorted by their nearest instance, using the normalized device depth of the bounds center
+        glm::vec4 const clipCenter = cullingViewProject * glm::vec4(slot.worldBounds.center(), 1.0F);
+        float const depth = (clipCenter.w > 0.0F) ? clipCenter.z / clipCenter.w : 0.0F;
+
+        InstanceBatch& batch = m_instanceBatches[it->second];
+        batch.bounds = (batch.instanceCount == 0) ? slot.worldBounds
+            : gfx::AABB{ glm::min(batch.bounds.min, slot.worldBounds.min), glm::max(batch.bounds.max, slot.worldBounds.max) };
+        batch.instanceCount++;
+        batch.depth = std::min(batch.depth, depth);
+        candidateBatches[i] = it->second;
     }
 
-    // Populate material UBO
+    uint32_t instanceCount = 0;
+    for (auto& batch : m_instanceBatches)
     {
-        size_t const materialUniformAlignment = core::alignAddress(sizeof(MaterialUniform), backendCaps.minUniformBufferOffsetAlignment);
-        size_t const materialUniformBufferSize = materialUniforms.size() * materialUniformAlignment;
-        if (m_materialDataUBO == nullptr || wgpuBufferGetSize(m_materialDataUBO) < materialUniformBufferSize) {
-            WGPUBufferDescriptor materialUBODesc{};
-            materialUBODesc.nextInChain = nullptr;
-            materialUBODesc.label = "Material UBO";
-            materialUBODesc.usage = WGPUBufferUsage_CopyDst | WGPUBufferUsage_Uniform;
-            materialUBODesc.size = materialUniformBufferSize;
-            materialUBODesc.mappedAtCreation = false;
+        batch.firstInstance = instanceCount;
+        instanceCount += batch.instanceCount;
+        batch.instanceCount = 0;
+    }
 
-            m_materialDataUBO = wgpuDeviceCreateBuffer(m_renderbackend->getDevice(), &materialUBODesc);
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        if (!m_cullingResults[i]) {
+            continue;
         }
 
-        for (size_t i = 0; i < materialUniforms.size(); i++)
-        {
-            size_t const offset = materialUniformAlignment * i;
-            wgpuQueueWriteBuffer(m_renderbackend->getQueue(), m_materialDataUBO, offset, &materialUniforms[i], sizeof(MaterialUniform));
-        }
+        InstanceBatch& batch = m_instanceBatches[candidateBatches[i]];
+        m_instanceData.update(batch.firstInstance + batch.instanceCount, &candidateSlots[i]);
+        batch.instanceCount++;
     }
 
-    // Recreate scene data bind group
+    // Write changed uniform slots, bind groups only need to be recreated when their buffer was recreated
+    WGPUDevice const device = m_renderbackend->getDevice();
+    WGPUQueue const queue = m_renderbackend->getQueue();
+    WGPUTextureView const blockTexturesView = m_blockTextures->getTextureView();
+    if (m_cameraData.upload(device, queue) || m_sceneDataBindGroup == nullptr || m_sceneBlockTexturesView != blockTexturesView)
     {
         WGPUBindGroupEntry sceneDataCameraBinding{};
         sceneDataCameraBinding.nextInChain = nullptr;
         sceneDataCameraBinding.binding = 0;
-        sceneDataCameraBinding.buffer = m_cameraDataUBO;
+        sceneDataCameraBinding.buffer = m_cameraData.buffer();
         sceneDataCameraBinding.offset = 0;
-        sceneDataCameraBinding.size = core::alignAddress(sizeof(CameraUniform), backendCaps.minUniformBufferOffsetAlignment);
+        sceneDataCameraBinding.size = m_cameraData.stride();
+
+        WGPUBindGroupEntry sceneDataBlockSamplerBinding{};
+        sceneDataBlockSamplerBinding.nextInChain = nullptr;
+        sceneDataBlockSamplerBinding.binding = 1;
+        sceneDataBlockSamplerBinding.sampler = m_blockTextures->getSampler();
 
-        WGPUBindGroupEntry sceneDataBindGroupEntries[] = { sceneDataCameraBinding, };
+        WGPUBindGroupEntry sceneDataBlockTexturesBinding{};
+        sceneDataBlockTexturesBinding.nextInChain = nullptr;
+        sceneDataBlockTexturesBinding.binding = 2;
+        sceneDataBlockTexturesBinding.textureView = blockTexturesView;
+
+        WGPUBindGroupEntry sceneDataBindGroupEntries[] = { sceneDataCameraBinding, sceneDataBlockSamplerBinding, sceneDataBlockTexturesBinding, };
         WGPUBindGroupDescriptor sceneDataBindGroupDesc{};
         sceneDataBindGroupDesc.nextInChain = nullptr;
         sceneDataBindGroupDesc.label = "Scene Data Bind Group";
@@ -653,19 +1461,29 @@ DrawList Renderer::prepare(entt::registry const& registry)
         sceneDataBindGroupDesc.entries = sceneDataBindGroupEntries;
 
         if (m_sceneDataBindGroup) wgpuBindGroupRelease(m_sceneDataBindGroup);
-        m_sceneDataBindGroup = wgpuDeviceCreateBindGroup(m_renderbackend->getDevice(), &sceneDataBindGroupDesc);
+        m_sceneDataBindGroup = wgpuDeviceCreateBindGroup(device, &sceneDataBindGroupDesc);
+        m_sceneBlockTexturesView = blockTexturesView;
     }
 
-    // Recreate object data bind group
+    bool const objectTransformsRecreated = m_objectTransformData.upload(device, queue);
+    bool const instancesRecreated = m_instanceData.upload(device, queue);
+    if (objectTransformsRecreated || instancesRecreated || m_objectDataBindGroup == nullptr)
     {
         WGPUBindGroupEntry objectDataObjectTransformBinding{};
         objectDataObjectTransformBinding.nextInChain = nullptr;
         objectDataObjectTransformBinding.binding = 0;
-        objectDataObjectTransformBinding.buffer = m_objectTransformDataUBO;
+        objectDataObjectTransformBinding.buffer = m_objectTransformData.buffer();
         objectDataObjectTransformBinding.offset = 0;
-        objectDataObjectTransformBinding.size = core::alignAddress(sizeof(ObjectTranformUniform), backendCaps.minUniformBufferOffsetAlignment);
+        objectDataObjectTransformBinding.size = wgpuBufferGetSize(m_objectTransformData.buffer());
+
+        WGPUBindGroupEntry objectDataInstanceBinding{};
+        objectDataInstanceBinding.nextInChain = nullptr;
+        objectDataInstanceBinding.binding = 1;
+        objectDataInstanceBinding.buffer = m_instanceData.buffer();
+        objectDataInstanceBinding.offset = 0;
+        objectDataInstanceBinding.size = wgpuBufferGetSize(m_instanceData.buffer());
 
-        WGPUBindGroupEntry objectDataBindGroupEntries[] = { objectDataObjectTransformBinding, };
+        WGPUBindGroupEntry objectDataBindGroupEntries[] = { objectDataObjectTransformBinding, objectDataInstanceBinding, };
         WGPUBindGroupDescriptor objectDataBindGroupDesc{};
         objectDataBindGroupDesc.nextInChain = nullptr;
         objectDataBindGroupDesc.label = "Object Data Bind Group";
@@ -674,85 +1492,324 @@ DrawList Renderer::prepare(entt::registry const& registry)
         objectDataBindGroupDesc.entries = objectDataBindGroupEntries;
 
         if (m_objectDataBindGroup) wgpuBindGroupRelease(m_objectDataBindGroup);
-        m_objectDataBindGroup = wgpuDeviceCreateBindGroup(m_renderbackend->getDevice(), &objectDataBindGroupDesc);
+        m_objectDataBindGroup = wgpuDeviceCreateBindGroup(device, &objectDataBindGroupDesc);
     }
 
-    // Recreate material data bind groups
+    if (m_materialData.upload(device, queue))
     {
-        for (auto& bindGroup : m_materialDataBindGroups) {
-            wgpuBindGroupRelease(bindGroup);
+        for (auto& slot : m_materialSlots)
+        {
+            if (slot.bindGroup) wgpuBindGroupRelease(slot.bindGroup);
+            slot.bindGroup = nullptr;
         }
-        m_materialDataBindGroups.clear();
+    }
+
+    // Material bind groups are cached per material, they are only created for new materials, changed texture views
+    // or after the material buffer was recreated
+    m_stats.materialBindGroupsCreated = 0;
+    for (auto const& [_material, materialSlot] : m_materialSlotIndices) {
+        updateMaterialBindGroup(materialSlot);
+    }
+
+    m_stats.uniformBytes = m_cameraData.uploadedBytes() + m_objectTransformData.uploadedBytes() + m_instanceData.uploadedBytes() + m_materialData.uploadedBytes();
+
+    // Record a single instanced opaque draw per batch, sorted so that draws sharing render state are adjacent
+    for (auto& batch : m_instanceBatches)
+    {
+        uint32_t const pipelineIndex = (batch.mesh->vertexLayout() == gfx::VertexLayout::Voxel) ? 1 : 0;
+        uint64_t const sortKey = DrawList::makeSortKey(RenderPass::Opaque, pipelineIndex, batch.materialSlot, batch.mesh.get(), batch.depth);
+        m_drawList.append(sortKey, {
+            0, // Always use camera 0 for now since multiple cameras are not yet supported...
+            batch.materialSlot,
+            batch.firstInstance,
+            batch.instanceCount,
+            batch.bounds,
+            std::move(batch.mesh)
+        });
+    }
+
+    m_drawList.sort();
+    m_stats.drawCalls = m_drawList.size();
+
+    if (m_indirectDraws)
+    {
+        writeIndirectArgs(m_drawList);
+#if     GAME_BUILD_TYPE_DEBUG
+        size_t const mismatches = validateIndirectArgs(m_drawList);
+        assert(mismatches == 0 && "Indirect draw arguments do not match direct draw arguments");
+        (void)(mismatches);
+#endif  // GAME_BUILD_TYPE_DEBUG
+    }
+
+    if (m_gpuCulling) {
+        writeCullData(m_drawList, cullingFrustum, cullingViewProject, cameraCount > 0);
+    }
+
+    // Dump some draw call stats
+    SPDLOG_TRACE("Opaque Draw Calls: {} ({} objects visible, {} objects culled, {} uniform bytes written, {} material bind groups created)",
+        m_stats.drawCalls, m_stats.visibleObjects, m_stats.culledObjects, m_stats.uniformBytes, m_stats.materialBindGroupsCreated);
+    return m_drawList;
+}
 
-        for (size_t i = 0; i < materialEntries.size(); i++)
+void Renderer::rasterizeOccluders(entt::registry const& registry, gfx::Frustum const& frustum, glm::mat4 const& viewproject, glm::vec3 const& position)
+{
+    struct Occluder
+    {
+        float       distance;
+        gfx::AABB   bounds;
+    };
+
+    // Chunks filled with a single solid block are fully opaque boxes, chunks with any other blocks are not occluders
+    core::FrameVector<Occluder> occluders(m_frameArena);
+    for (auto const& [_entity, chunk] : registry.view<ChunkComponent>().each())
+    {
+        if (!chunk.chunk.isUniform() || !world::isSolidBlock(chunk.chunk.getBlock(0, 0, 0))) {
+            continue;
+        }
+
+        glm::vec3 const chunkMin = glm::vec3(chunk.coordinate) * static_cast<float>(world::CHUNK_SIZE);
+        gfx::AABB const bounds{
+            chunkMin + SOFTWARE_OCCLUDER_INSET,
+            chunkMin + static_cast<float>(world::CHUNK_SIZE) - SOFTWARE_OCCLUDER_INSET
+        };
+
+        if (frustum.intersects(bounds))
         {
-            auto const& material = materialEntries[i];
-            size_t const materialUniformAlignment = core::alignAddress(sizeof(MaterialUniform), backendCaps.minUniformBufferOffsetAlignment);
-            std::vector<WGPUBindGroupEntry> materialDataBindGroupEntries{};
-            materialDataBindGroupEntries.reserve(5);
+            glm::vec3 const offset = bounds.center() - position;
+            occluders.push_back(Occluder{ glm::dot(offset, offset), bounds });
+        }
+    }
 
-            WGPUBindGroupEntry materialDataMaterialBinding{};
-            materialDataMaterialBinding.nextInChain = nullptr;
-            materialDataMaterialBinding.binding = 0;
-            materialDataMaterialBinding.buffer = m_materialDataUBO;
-            materialDataMaterialBinding.offset = i * materialUniformAlignment;
-            materialDataMaterialBinding.size = materialUniformAlignment;
-            materialDataBindGroupEntries.push_back(materialDataMaterialBinding);
+    // Only the nearest occluders are rasterized, distant occluders cover few pixels of the depth buffer
+    size_t const occluderCount = std::min(occluders.size(), MAX_SOFTWARE_OCCLUDERS);
+    std::nth_element(occluders.begin(), occluders.begin() + occluderCount, occluders.end(), [](Occluder const& lhs, Occluder const& rhs) {
+        return lhs.distance < rhs.distance;
+    });
 
-            WGPUBindGroupEntry materialDataAlbedoSamplerBinding{};
-            materialDataAlbedoSamplerBinding.nextInChain = nullptr;
-            materialDataAlbedoSamplerBinding.binding = 1;
-            materialDataAlbedoSamplerBinding.sampler = material->albedoTexture->getSampler();
+    m_occlusionRasterizer.begin(viewproject);
+    for (size_t i = 0; i < occluderCount; i++) {
+        m_occlusionRasterizer.rasterizeOccluder(occluders[i].bounds);
+    }
 
-            WGPUBindGroupEntry materialDataAlbedoMapBinding{};
-            materialDataAlbedoMapBinding.nextInChain = nullptr;
-            materialDataAlbedoMapBinding.binding = 2;
-            materialDataAlbedoMapBinding.textureView = material->albedoTexture->getTextureView();
+    m_stats.occluders = occluderCount;
+}
 
-            materialDataBindGroupEntries.push_back(materialDataAlbedoSamplerBinding);
-            materialDataBindGroupEntries.push_back(materialDataAlbedoMapBinding);
+void Renderer::writeIndirectArgs(DrawList const& drawList)
+{
+    // Arguments are written in sort order, so runs of draws sharing render state have adjacent arguments
+    uint32_t argsSlot = 0;
+    for (auto const& command : drawList.commands())
+    {
+        DrawIndexedIndirectArgs const args = makeDrawArgs(command);
+        m_indirectData.update(argsSlot++, &args);
+    }
 
-            WGPUBindGroupEntry materialDataNormalSamplerBinding{};
-            materialDataNormalSamplerBinding.nextInChain = nullptr;
-            materialDataNormalSamplerBinding.binding = 3;
-            materialDataNormalSamplerBinding.sampler = material->normalTexture->getSampler();
+    // The culling bind group reads the arguments, so it is recreated along with the buffer
+    if (m_indirectData.upload(m_renderbackend->getDevice(), m_renderbackend->getQueue()) && m_cullBindGroup)
+    {
+        wgpuBindGroupRelease(m_cullBindGroup);
+        m_cullBindGroup = nullptr;
+    }
 
-            WGPUBindGroupEntry materialDataNormalMapBinding{};
-            materialDataNormalMapBinding.nextInChain = nullptr;
-            materialDataNormalMapBinding.binding = 4;
-            materialDataNormalMapBinding.textureView = material->normalTexture->getTextureView();
+    m_stats.uniformBytes += m_indirectData.uploadedBytes();
+}
 
-            materialDataBindGroupEntries.push_back(materialDataNormalSamplerBinding);
-            materialDataBindGroupEntries.push_back(materialDataNormalMapBinding);
+void Renderer::writeCullData(DrawList const& drawList, gfx::Frustum const& frustum, glm::mat4 const& viewproject, bool hasCamera)
+{
+    // Runs break wherever execute rebinds render state, so compacted draws of a run share the state bound for the run
+    m_drawRuns.clear();
+    DrawState runState{};
+    uint32_t argsSlot = 0;
+    for (auto const& command : drawList.commands())
+    {
+        DrawState const state = drawState(command);
+        if (m_drawRuns.empty() || state != runState)
+        {
+            m_drawRuns.push_back(DrawRun{ argsSlot, 0 });
+            runState = state;
+        }
+
+        DrawRun& run = m_drawRuns.back();
+        gfx::DrawCullData const cullData{ command.bounds.min, run.first, command.bounds.max, static_cast<uint32_t>(m_drawRuns.size() - 1) };
+        m_drawCullData.update(argsSlot++, &cullData);
+        run.count++;
+    }
 
-            WGPUBindGroupDescriptor materialDataBindGroupDesc{};
-            materialDataBindGroupDesc.nextInChain = nullptr;
-            materialDataBindGroupDesc.label = "Material Data Bind Group";
-            materialDataBindGroupDesc.layout = m_materialDataBindGroupLayout;
-            materialDataBindGroupDesc.entryCount = std::size(materialDataBindGroupEntries);
-            materialDataBindGroupDesc.entries = materialDataBindGroupEntries.data();
+    // Draws are occlusion culled against the pyramid of the previous frame, projected with that frame's camera
+    gfx::CullParams params{};
+    params.occlusionViewProject = m_hizViewProject;
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), std::begin(params.planes));
+    params.depthSize = m_hizDepthSize;
+    params.levelCount = static_cast<uint32_t>(m_hizLevelSizes.size());
+    params.drawCount = argsSlot;
+    params.occlusionEnabled = (m_hizValid && hasCamera) ? 1 : 0;
+    params.compact = m_compactDraws ? 1 : 0;
+    m_cullParams.update(0, &params);
+    m_frameViewProject = viewproject;
+
+    // Culled arguments & run counts are only written on the device
+    WGPUDevice const device = m_renderbackend->getDevice();
+    WGPUQueue const queue = m_renderbackend->getQueue();
+    bool recreated = m_cullParams.upload(device, queue);
+    recreated |= m_drawCullData.upload(device, queue);
+    recreated |= reserveDeviceBuffer(device, m_culledArgsBuffer, "Culled Indirect Draw Buffer",
+        WGPUBufferUsage_Indirect | WGPUBufferUsage_Storage, argsSlot * m_indirectData.stride());
+    recreated |= reserveDeviceBuffer(device, m_runCountBuffer, "Draw Run Count Buffer",
+        WGPUBufferUsage_Indirect | WGPUBufferUsage_Storage | WGPUBufferUsage_CopyDst, m_drawRuns.size() * sizeof(uint32_t));
+
+    if (recreated && m_cullBindGroup)
+    {
+        wgpuBindGroupRelease(m_cullBindGroup);
+        m_cullBindGroup = nullptr;
+    }
+
+    m_stats.uniformBytes += m_cullParams.uploadedBytes() + m_drawCullData.uploadedBytes();
+}
 
-            WGPUBindGroup materialDataBindGroup = wgpuDeviceCreateBindGroup(m_renderbackend->getDevice(), &materialDataBindGroupDesc);
-            m_materialDataBindGroups.push_back(materialDataBindGroup);
+size_t Renderer::validateIndirectArgs(DrawList const& drawList) const
+{
+    size_t mismatches = 0;
+    uint32_t argsSlot = 0;
+    for (auto const& command : drawList.commands())
+    {
+        // Expected arguments are derived independently of writeIndirectArgs, so packing or slot errors show up as mismatches
+        gfx::MeshRange const& range = command.mesh->deviceAllocation()->range();
+        DrawIndexedIndirectArgs const expected = directDrawArgs(range, command.firstInstance, command.instanceCount);
+        DrawIndexedIndirectArgs const* pArgs = static_cast<DrawIndexedIndirectArgs const*>(m_indirectData.data(argsSlot));
+        if (pArgs->indexCount != expected.indexCount || pArgs->instanceCount != expected.instanceCount || pArgs->firstIndex != expected.firstIndex
+            || pArgs->baseVertex != expected.baseVertex || pArgs->firstInstance != expected.firstInstance)
+        {
+            SPDLOG_ERROR("Indirect draw {} mismatch: ({}, {}, {}, {}, {}) written, ({}, {}, {}, {}, {}) expected", argsSlot,
+                pArgs->indexCount, pArgs->instanceCount, pArgs->firstIndex, pArgs->baseVertex, pArgs->firstInstance,
+                expected.indexCount, expected.instanceCount, expected.firstIndex, expected.baseVertex, expected.firstInstance);
+            mismatches++;
         }
+
+        argsSlot++;
     }
 
-    // Dump some draw call stats
-    SPDLOG_TRACE("Opaque Draw Calls: {}", drawList.commands(RENDERER_PASS_OPAQUE).size());
-    return drawList;
+    return mismatches;
 }
 
-void Renderer::execute(gfx::FrameState frame, DrawList const& drawList)
+Renderer::DrawState Renderer::drawState(DrawCommand const& command) const
+{
+    assert(command.mesh != nullptr && command.mesh->deviceAllocation() != nullptr && "Mesh without device data passed to draw command!");
+
+    // Meshes with deferred uploads are drawn using their previous device ranges, which may use another vertex layout
+    gfx::MeshRange const& range = command.mesh->deviceAllocation()->range();
+
+    // Pool buffers are shared by all meshes of a vertex layout, the pipeline matches the uploaded vertex layout
+    return DrawState{
+        (range.layout == gfx::VertexLayout::Voxel) ? m_voxelPipeline : m_pipeline,
+        command.cameraOffset,
+        m_materialSlots[command.materialOffset].bindGroup,
+        m_meshPool->vertexBuffer(range.layout),
+        m_meshPool->indexBuffer(),
+    };
+}
+
+void Renderer::recordCulling(WGPUCommandEncoder encoder)
+{
+    uint32_t const drawCount = m_drawRuns.empty() ? 0 : m_drawRuns.back().first + m_drawRuns.back().count;
+    if (drawCount == 0) {
+        return;
+    }
+
+    if (m_cullBindGroup == nullptr)
+    {
+        auto const bufferBinding = [](uint32_t binding, WGPUBuffer buffer, uint64_t size) {
+            WGPUBindGroupEntry entry{};
+            entry.nextInChain = nullptr;
+            entry.binding = binding;
+            entry.buffer = buffer;
+            entry.offset = 0;
+            entry.size = size;
+            return entry;
+        };
+
+        WGPUBindGroupEntry cullHiZBinding{};
+        cullHiZBinding.nextInChain = nullptr;
+        cullHiZBinding.binding = 8;
+        cullHiZBinding.textureView = m_hizView;
+
+        WGPUBindGroupEntry cullBindGroupEntries[] = {
+            bufferBinding(3, m_cullParams.buffer(), m_cullParams.stride()),
+            bufferBinding(4, m_drawCullData.buffer(), wgpuBufferGetSize(m_drawCullData.buffer())),
+            bufferBinding(5, m_indirectData.buffer(), wgpuBufferGetSize(m_indirectData.buffer())),
+            bufferBinding(6, m_culledArgsBuffer, wgpuBufferGetSize(m_culledArgsBuffer)),
+            bufferBinding(7, m_runCountBuffer, wgpuBufferGetSize(m_runCountBuffer)),
+            cullHiZBinding,
+        };
+        WGPUBindGroupDescriptor cullBindGroupDesc{};
+        cullBindGroupDesc.nextInChain = nullptr;
+        cullBindGroupDesc.label = "Cull Bind Group";
+        cullBindGroupDesc.layout = m_cullBindGroupLayout;
+        cullBindGroupDesc.entryCount = std::size(cullBindGroupEntries);
+        cullBindGroupDesc.entries = cullBindGroupEntries;
+
+        m_cullBindGroup = wgpuDeviceCreateBindGroup(m_renderbackend->getDevice(), &cullBindGroupDesc);
+    }
+
+    // Compacted runs count their surviving draws, so counts start at zero every frame
+    if (m_compactDraws) {
+        wgpuCommandEncoderClearBuffer(encoder, m_runCountBuffer, 0, m_drawRuns.size() * sizeof(uint32_t));
+    }
+
+    WGPUComputePassDescriptor cullPassDesc{};
+    cullPassDesc.nextInChain = nullptr;
+    cullPassDesc.label = RENDERER_PASS_CULLING;
+    cullPassDesc.timestampWrites = nullptr;
+
+    WGPUComputePassEncoder cullPass = wgpuCommandEncoderBeginComputePass(encoder, &cullPassDesc);
+    wgpuComputePassEncoderSetPipeline(cullPass, m_cullPipeline);
+    wgpuComputePassEncoderSetBindGroup(cullPass, 0, m_cullBindGroup, 0, nullptr);
+    wgpuComputePassEncoderDispatchWorkgroups(cullPass, (drawCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1);
+    wgpuComputePassEncoderEnd(cullPass);
+    wgpuComputePassEncoderRelease(cullPass);
+}
+
+void Renderer::recordHiZBuild(WGPUCommandEncoder encoder)
 {
-    // Get backend capabilities for alignment info
-    gfx::BackendCapabilities const backendCaps = m_renderbackend->getBackendCapabilities();
+    WGPUComputePassDescriptor hizPassDesc{};
+    hizPassDesc.nextInChain = nullptr;
+    hizPassDesc.label = RENDERER_PASS_HIZ;
+    hizPassDesc.timestampWrites = nullptr;
+
+    // Every level reads the level written by the previous dispatch
+    WGPUComputePassEncoder hizPass = wgpuCommandEncoderBeginComputePass(encoder, &hizPassDesc);
+    for (size_t level = 0; level < m_hizBindGroups.size(); level++)
+    {
+        if (level <= 1) {
+            wgpuComputePassEncoderSetPipeline(hizPass, (level == 0) ? m_hizDepthPipeline : m_hizDownsamplePipeline);
+        }
+
+        glm::uvec2 const levelSize = m_hizLevelSizes[level];
+        wgpuComputePassEncoderSetBindGroup(hizPass, 0, m_hizBindGroups[level], 0, nullptr);
+        wgpuComputePassEncoderDispatchWorkgroups(hizPass, (levelSize.x + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, (levelSize.y + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, 1);
+    }
+
+    wgpuComputePassEncoderEnd(hizPass);
+    wgpuComputePassEncoderRelease(hizPass);
+
+    // Next frame culls against this frame's depth, projected with this frame's camera
+    m_hizViewProject = m_frameViewProject;
+    m_hizValid = true;
+}
 
+void Renderer::execute(gfx::FrameState frame, DrawList const& drawList)
+{
     // Start command recording for frame
+    core::Timer encodeTimer{};
     WGPUCommandEncoderDescriptor encoderDesc{};
     encoderDesc.nextInChain = nullptr;
     encoderDesc.label = "Frame Command Encoder";
     WGPUCommandEncoder frameCommandEncoder = wgpuDeviceCreateCommandEncoder(m_renderbackend->getDevice(), &encoderDesc);
 
+    // Cull indirect draws before the render pass reads their arguments
+    if (m_gpuCulling) {
+        recordCulling(frameCommandEncoder);
+    }
+
     // Start render pass
     WGPURenderPassColorAttachment colorAttachment{};
     colorAttachment.nextInChain = nullptr;
@@ -768,7 +1825,7 @@ void Renderer::execute(gfx::FrameState frame, DrawList const& drawList)
     WGPURenderPassDepthStencilAttachment depthStencilAttachment{};
     depthStencilAttachment.view = m_depthStencilTargetView;
     depthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
-    depthStencilAttachment.depthStoreOp = WGPUStoreOp_Discard;
+    depthStencilAttachment.depthStoreOp = m_gpuCulling ? WGPUStoreOp_Store : WGPUStoreOp_Discard; // Depth is read by the pyramid build
     depthStencilAttachment.depthClearValue = 1.0F;
     depthStencilAttachment.depthReadOnly = false;
     depthStencilAttachment.stencilLoadOp = WGPULoadOp_Clear;
@@ -793,43 +1850,143 @@ void Renderer::execute(gfx::FrameState frame, DrawList const& drawList)
     gfx::FramebufferSize const swapFramebufferSize = m_renderbackend->getFramebufferSize();
     wgpuRenderPassEncoderSetViewport(renderPass, 0.0F, 0.0F, static_cast<float>(swapFramebufferSize.width), static_cast<float>(swapFramebufferSize.height), 0.0F, 1.0F);
     wgpuRenderPassEncoderSetScissorRect(renderPass, 0, 0, swapFramebufferSize.width, swapFramebufferSize.height);
-    wgpuRenderPassEncoderSetPipeline(renderPass, m_pipeline);
 
-    for (auto const& command : drawList.commands(RENDERER_PASS_OPAQUE))
+    // Object data is shared by all draws, instances select their object transform slot
+    wgpuRenderPassEncoderSetBindGroup(renderPass, 1, m_objectDataBindGroup, 0, nullptr);
+    m_stats.stateChanges = 1;
+
+    // Indirect draws of a run share the currently bound state, with multi-draw support a run is encoded as one command.
+    // Culled runs are compacted in the same order, so runs are numbered as they are flushed
+    WGPUBuffer const indirectBuffer = m_gpuCulling ? m_culledArgsBuffer : m_indirectData.buffer();
+    uint64_t const indirectStride = m_indirectData.stride();
+    uint32_t indirectRunFirst = 0;
+    uint32_t indirectRunCount = 0;
+    uint32_t indirectRunIndex = 0;
+    m_stats.encodedDraws = 0;
+    auto const flushIndirectRun = [&]() {
+        if (indirectRunCount == 0) {
+            return;
+        }
+
+#if     WEBGPU_BACKEND_WGPU
+        if (m_compactDraws)
+        {
+            assert(indirectRunIndex < m_drawRuns.size() && m_drawRuns[indirectRunIndex].first == indirectRunFirst && "Draw run mismatch");
+            wgpuRenderPassEncoderMultiDrawIndexedIndirectCount(renderPass, indirectBuffer, indirectRunFirst * indirectStride,
+                m_runCountBuffer, indirectRunIndex * sizeof(uint32_t), indirectRunCount);
+            m_stats.encodedDraws++;
+            indirectRunIndex++;
+            indirectRunCount = 0;
+            return;
+        }
+
+        if (m_multiDrawIndirect)
+        {
+            wgpuRenderPassEncoderMultiDrawIndexedIndirect(renderPass, indirectBuffer, indirectRunFirst * indirectStride, indirectRunCount);
+            m_stats.encodedDraws++;
+            indirectRunIndex++;
+            indirectRunCount = 0;
+            return;
+        }
+#endif  // WEBGPU_BACKEND_WGPU
+
+        for (uint32_t i = 0; i < indirectRunCount; i++) {
+            wgpuRenderPassEncoderDrawIndexedIndirect(renderPass, indirectBuffer, (indirectRunFirst + i) * indirectStride);
+        }
+
+        m_stats.encodedDraws += indirectRunCount;
+        indirectRunIndex++;
+        indirectRunCount = 0;
+    };
+
+    // Commands are sorted by render state, so state is only rebound when it differs from the previous command
+    DrawState bound{};
+    DrawCommand const* pFirstCommand = drawList.commands().first;
+    for (auto const& command : drawList.commands(RenderPass::Opaque))
     {
-        auto const& mesh = command.mesh;
-        assert(mesh != nullptr && !mesh->isDirty() && "Dirty mesh passed to draw command!");
+        DrawState const state = drawState(command);
+        if (state != bound) {
+            flushIndirectRun();
+        }
 
-        // Bind correct scene data group
-        uint32_t const sceneDataDynamicOffsets[] = {
-            static_cast<uint32_t>(command.cameraOffset * core::alignAddress(sizeof(CameraUniform), backendCaps.minUniformBufferOffsetAlignment)),
-        };
-        wgpuRenderPassEncoderSetBindGroup(renderPass, 0, m_sceneDataBindGroup, std::size(sceneDataDynamicOffsets), sceneDataDynamicOffsets);
+        // Bind pipeline
+        if (state.pipeline != bound.pipeline)
+        {
+            wgpuRenderPassEncoderSetPipeline(renderPass, state.pipeline);
+            m_stats.stateChanges++;
+        }
 
-        // Bind correct object data group
-        uint32_t const objectDataDynamicOffsets[] = {
-            static_cast<uint32_t>(command.objectOffset * core::alignAddress(sizeof(ObjectTranformUniform), backendCaps.minUniformBufferOffsetAlignment)),
-        };
-        wgpuRenderPassEncoderSetBindGroup(renderPass, 1, m_objectDataBindGroup, std::size(objectDataDynamicOffsets), objectDataDynamicOffsets);
+        // Bind correct scene data group
+        if (state.cameraOffset != bound.cameraOffset)
+        {
+            uint32_t const sceneDataDynamicOffsets[] = {
+                static_cast<uint32_t>(state.cameraOffset * m_cameraData.stride()),
+            };
+            wgpuRenderPassEncoderSetBindGroup(renderPass, 0, m_sceneDataBindGroup, std::size(sceneDataDynamicOffsets), sceneDataDynamicOffsets);
+            m_stats.stateChanges++;
+        }
 
         // Bind correct material data group
-        wgpuRenderPassEncoderSetBindGroup(renderPass, 2, m_materialDataBindGroups[command.materialOffset], 0, nullptr);
+        if (state.materialBindGroup != bound.materialBindGroup)
+        {
+            wgpuRenderPassEncoderSetBindGroup(renderPass, 2, state.materialBindGroup, 0, nullptr);
+            m_stats.stateChanges++;
+        }
+
+        // Bind mesh pool buffers
+        if (state.vertexBuffer != bound.vertexBuffer)
+        {
+            wgpuRenderPassEncoderSetVertexBuffer(renderPass, 0, state.vertexBuffer, 0, WGPU_WHOLE_SIZE);
+            m_stats.stateChanges++;
+        }
+
+        if (state.indexBuffer != bound.indexBuffer)
+        {
+            wgpuRenderPassEncoderSetIndexBuffer(renderPass, state.indexBuffer, WGPUIndexFormat_Uint32, 0, WGPU_WHOLE_SIZE);
+            m_stats.stateChanges++;
+        }
+
+        bound = state;
+
+        // Record mesh draw, indirect arguments are stored at the sorted command index
+        if (m_indirectDraws)
+        {
+            uint32_t const argsSlot = static_cast<uint32_t>(&command - pFirstCommand);
+            if (indirectRunCount == 0) {
+                indirectRunFirst = argsSlot;
+            }
 
-        // Record mesh draw
-        wgpuRenderPassEncoderSetVertexBuffer(renderPass, 0, mesh->getVertexBuffer(), 0, mesh->vertexCount() * sizeof(gfx::Vertex));
-        wgpuRenderPassEncoderSetIndexBuffer(renderPass, mesh->getIndexBuffer(), WGPUIndexFormat_Uint32, 0, mesh->indexCount() * sizeof(gfx::IndexType));
-        wgpuRenderPassEncoderDrawIndexed(renderPass, mesh->indexCount(), 1, 0, 0, 0);
+            indirectRunCount++;
+        }
+        else
+        {
+            gfx::MeshRange const& range = command.mesh->deviceAllocation()->range();
+            DrawIndexedIndirectArgs const args = directDrawArgs(range, command.firstInstance, command.instanceCount);
+            wgpuRenderPassEncoderDrawIndexed(renderPass, args.indexCount, args.instanceCount, args.firstIndex, args.baseVertex, args.firstInstance);
+            m_stats.encodedDraws++;
+        }
     }
 
+    flushIndirectRun();
+
     wgpuRenderPassEncoderPopDebugGroup(renderPass);
     wgpuRenderPassEncoderEnd(renderPass);
 
+    // Build the pyramid the next frame is culled against from this frame's depth
+    if (m_gpuCulling) {
+        recordHiZBuild(frameCommandEncoder);
+    }
+
     // Finish command recording
     WGPUCommandBufferDescriptor commandBufDesc{};
     commandBufDesc.nextInChain = nullptr;
     commandBufDesc.label = "Frame Commands";
     WGPUCommandBuffer frameCommands = wgpuCommandEncoderFinish(frameCommandEncoder, &commandBufDesc);
 
+    encodeTimer.tick();
+    m_stats.encodeTime = encodeTimer.delta();
+    SPDLOG_TRACE("Frame commands encoded in {:.3f} ms ({} draws encoded, {} state changes)", m_stats.encodeTime, m_stats.encodedDraws, m_stats.stateChanges);
+
     // Submit work & present
     m_renderbackend->submit(1, &frameCommands);
     m_renderbackend->present(frame);
@@ -1,17 +1,36 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
+#include "core/frame_arena.hpp"
+#include "rendering/frustum.hpp"
+#include "rendering/material.hpp"
 #include "rendering/mesh.hpp"
+#include "rendering/mesh_pool.hpp"
+#include "rendering/occlusion_culling.hpp"
+#include "rendering/occlusion_rasterizer.hpp"
 #include "rendering/render_backend.hpp"
+#include "rendering/uniform_buffer.hpp"
+#include "rendering/upload_manager.hpp"
+#include "components/transform.hpp"
 
 #define RENDERER_PASS_OPAQUE "Opaque Pass"
+#define RENDERER_PASS_CULLING "Culling Pass"
+#define RENDERER_PASS_HIZ "HiZ Pass"
+
+/// @brief Render passes draw commands are recorded for, passes are executed in declaration order.
+enum class RenderPass : uint8_t
+{
+    Opaque = 0,
+};
 
 /// @brief Uniform camera data.
 struct CameraUniform
@@ -36,37 +55,147 @@ struct ObjectTranformUniform
     glm::mat4 normalTransform;
 };
 
-/// @brief Draw command with data offsets and associated mesh.
+/// @brief Indexed indirect draw arguments, matching the layout read by DrawIndexedIndirect.
+struct DrawIndexedIndirectArgs
+{
+    uint32_t    indexCount;
+    uint32_t    instanceCount;
+    uint32_t    firstIndex;
+    int32_t     baseVertex;
+    uint32_t    firstInstance;
+};
+
+/// @brief Calculate the direct indexed draw arguments of an instance batch, read from the current mesh pool range of its mesh.
+/// These are the arguments recorded by the per-draw path, indirect draw arguments are validated against them.
+/// @param range Current mesh pool range of the drawn mesh.
+/// @param firstInstance First instance of the batch.
+/// @param instanceCount Number of instances in the batch.
+/// @return 
+DrawIndexedIndirectArgs directDrawArgs(gfx::MeshRange const& range, uint32_t firstInstance, uint32_t instanceCount);
+
+/// @brief Instanced draw command with data offsets and associated mesh.
+/// Instances index into the instance buffer, which maps each instance to its object transform slot.
 struct DrawCommand
 {
     uint32_t                    cameraOffset;
     uint32_t                    materialOffset;
-    uint32_t                    objectOffset;
+    uint32_t                    firstInstance;
+    uint32_t                    instanceCount;
+    gfx::AABB                   bounds;     // World bounds enclosing all instances, tested by the culling pass
     std::shared_ptr<gfx::Mesh>  mesh;
 };
 
-/// @brief Draw list containing per-pass draw calls sorted by pass name.
+/// @brief Contiguous range of sorted draw commands.
+struct DrawCommandRange
+{
+    DrawCommand const*  first   = nullptr;
+    DrawCommand const*  last    = nullptr;
+
+    DrawCommand const* begin() const { return first; }
+    DrawCommand const* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+};
+
+/// @brief Draw list storing draw commands along with 64-bit sort keys.
+/// Keys are ordered by pass, pipeline, material, mesh and depth, so after sorting commands sharing render state are
+/// adjacent. Keys only affect ordering, fields wider than their key bits may collide without affecting correctness.
 class DrawList
 {
 public:
-    /// @brief Append a draw command to a render pass.
-    /// @param pass Pass name to append draw call to.
+    static constexpr uint32_t PASS_BITS         = 4;
+    static constexpr uint32_t PIPELINE_BITS     = 4;
+    static constexpr uint32_t MATERIAL_BITS     = 20;
+    static constexpr uint32_t MESH_BITS         = 20;
+    static constexpr uint32_t DEPTH_BITS        = 16;
+
+    /// @brief Create a draw command sort key.
+    /// @param pass Render pass the command is recorded for.
+    /// @param pipeline Pipeline index.
+    /// @param material Material slot index.
+    /// @param pMesh Mesh the command draws, only its identity is used.
+    /// @param depth Normalized depth in range [0, 1], commands with equal state are sorted front to back.
+    /// @return The command sort key.
+    static uint64_t makeSortKey(RenderPass pass, uint32_t pipeline, uint32_t material, void const* pMesh, float depth);
+
+    /// @brief Remove all draw commands, keeping allocated storage.
+    void clear();
+
+    /// @brief Append a draw command, commands are only visible through commands() after sorting.
+    /// @param sortKey Sort key created with makeSortKey.
     /// @param command Draw command containing draw data.
-    void append(std::string const& pass, DrawCommand const& command);
+    void append(uint64_t sortKey, DrawCommand&& command);
+
+    /// @brief Sort all appended commands by their sort keys using an LSD radix sort.
+    void sort();
 
-    std::vector<DrawCommand> commands(std::string const& pass) const;
+    /// @brief Retrieve the sorted commands of a render pass.
+    /// @param pass 
+    /// @return 
+    DrawCommandRange commands(RenderPass pass) const;
+
+    /// @brief Retrieve the sorted commands of all render passes.
+    /// @return 
+    DrawCommandRange commands() const;
+
+    /// @brief Retrieve the number of appended commands.
+    /// @return 
+    size_t size() const { return m_commands.size(); }
 
 private:
-    std::unordered_map<std::string, std::vector<DrawCommand>> m_commands{};
+    /// @brief Sort key along with the index of its command.
+    struct SortEntry
+    {
+        uint64_t    key     = 0;
+        uint32_t    index   = 0;
+    };
+
+    std::vector<DrawCommand>    m_commands          = {};   // Commands in append order
+    std::vector<DrawCommand>    m_sortedCommands    = {};   // Commands in sort key order, moved from m_commands
+    std::vector<SortEntry>      m_entries           = {};
+    std::vector<SortEntry>      m_scratch           = {};   // Radix sort ping-pong buffer
+};
+
+/// @brief Renderer counters, updated once per frame.
+struct RendererStats
+{
+    size_t  visibleObjects              = 0;
+    size_t  drawCalls                   = 0;    // Instanced draw calls, one per visible mesh & material pair
+    size_t  encodedDraws                = 0;    // Draw commands encoded, a multi-draw of indirect draws counts once
+    size_t  stateChanges                = 0;    // Pipeline, bind group & buffer bindings encoded, redundant ones are skipped
+    size_t  culledObjects               = 0;    // Objects outside the camera frustum, skipped before uniform data is written
+    size_t  occludedObjects             = 0;    // Objects inside the frustum hidden behind software rasterized occluders
+    size_t  occluders                   = 0;    // Chunk occluders rasterized by the software occlusion rasterizer
+    size_t  uniformBytes                = 0;    // Uniform bytes written to the device, only changed slots are written
+    size_t  materials                   = 0;    // Materials referenced by render components
+    size_t  materialBindGroupsCreated   = 0;    // Material bind groups created this frame, zero in steady state
+    double  encodeTime                  = 0.0;  // CPU time spent encoding frame commands in milliseconds
+    size_t  uploadBytes                 = 0;    // Mesh & texture bytes uploaded through staging buffers
+    size_t  deferredUploads             = 0;    // Dirty meshes & textures deferred to a later frame by the upload budget
+    double  uploadTime                  = 0.0;  // CPU time spent staging & submitting uploads in milliseconds
+    size_t  meshPoolBytes               = 0;    // Mesh pool bytes allocated to uploaded meshes
+    float   meshPoolFragmentation       = 0.0F; // Highest free space fragmentation of the mesh pool buffers
+    size_t  frameArenaBytes             = 0;    // Per-frame data allocated from the frame arena
+    size_t  heapAllocations             = 0;    // Heap allocations during the frame, only tracked with GAME_TRACK_ALLOCATIONS
 };
 
 /// @brief The Renderer system handles rendering the game world entities.
+/// Every entity with a render component owns a persistent slot in the object uniform buffer, every material referenced
+/// by render components owns a slot in the material uniform buffer along with a cached bind group. Slots are only
+/// rewritten when the entity transform, mesh bounds or material data changes. Visible objects sharing a mesh and
+/// material are drawn with a single instanced draw. Mesh data is sub-allocated from the shared buffers of the mesh pool,
+/// so vertex & index buffers are only rebound when the vertex layout changes. If the device supports it, draws read their
+/// arguments from an indirect buffer written in sort order, runs of draws sharing render state are then encoded with a
+/// single multi-draw command. Indirect draws are culled on the GPU against the camera frustum and a hierarchical-Z pyramid
+/// built from the depth of the previous frame, with multi-draw count support surviving draws are compacted per run.
+/// Without GPU culling, objects are tested against the nearest fully solid chunks rasterized into a software depth buffer.
+/// Voxel meshes sample a single block texture array by layer, so chunk draws share one material bind group.
 class Renderer
 {
 public:
     /// @brief Create a new renderer.
     /// @param renderbackend Render backend shared pointer.
-    Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend);
+    /// @param registry ECS registry whose render components are assigned uniform slots.
+    Renderer(std::shared_ptr<gfx::RenderBackend> renderbackend, entt::registry& registry);
     ~Renderer();
 
     Renderer(Renderer const&) = delete;
@@ -81,15 +210,174 @@ public:
     /// @param height 
     void onResize(uint32_t width, uint32_t height);
 
+    /// @brief Set the block textures sampled by voxel meshes, voxel vertices select their block texture by layer.
+    /// Block textures are bound once per frame in the scene data bind group, independent of materials.
+    /// @param blockTextures 2D texture array, uploaded before any other data of the next frame if dirty.
+    void setBlockTextures(std::shared_ptr<gfx::Texture> blockTextures);
+
+    /// @brief Get the block formats supported by the device, loaded textures are compressed to these formats.
+    /// @return 
+    gfx::BlockFormatSupport const& blockFormatSupport() const { return m_blockFormatSupport; }
+
+    /// @brief Retrieve the counters of the last rendered frame.
+    /// @return 
+    RendererStats const& stats() const { return m_stats; }
+
 private:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    /// @brief Key grouping visible objects into instanced draws.
+    struct InstanceBatchKey
+    {
+        gfx::Mesh const*    mesh            = nullptr;
+        uint32_t            materialSlot    = INVALID_SLOT;
+
+        bool operator==(InstanceBatchKey const& other) const { return mesh == other.mesh && materialSlot == other.materialSlot; }
+    };
+
+    /// @brief Hash functor for instance batch keys.
+    struct InstanceBatchKeyHash
+    {
+        size_t operator()(InstanceBatchKey const& key) const;
+    };
+
+    /// @brief Per-frame map of instance batch keys to batch indices.
+    using InstanceBatchMap = std::unordered_map<InstanceBatchKey, uint32_t, InstanceBatchKeyHash, std::equal_to<InstanceBatchKey>,
+        core::FrameAllocator<std::pair<InstanceBatchKey const, uint32_t>>>;
+
+    /// @brief Range of the instance buffer drawn with a single instanced draw.
+    struct InstanceBatch
+    {
+        std::shared_ptr<gfx::Mesh>  mesh            = {};
+        uint32_t                    materialSlot    = INVALID_SLOT;
+        uint32_t                    firstInstance   = 0;
+        uint32_t                    instanceCount   = 0;
+        float                       depth           = 1.0F;     // Nearest normalized depth of the batch instances
+        gfx::AABB                   bounds          = {};       // World bounds enclosing all batch instances
+    };
+
+    /// @brief Render state bound for a draw command, adjacent draws with equal state form a run.
+    struct DrawState
+    {
+        WGPURenderPipeline  pipeline            = nullptr;
+        uint32_t            cameraOffset        = UINT32_MAX;
+        WGPUBindGroup       materialBindGroup   = nullptr;
+        WGPUBuffer          vertexBuffer        = nullptr;
+        WGPUBuffer          indexBuffer         = nullptr;
+
+        bool operator==(DrawState const& other) const
+        {
+            return pipeline == other.pipeline && cameraOffset == other.cameraOffset && materialBindGroup == other.materialBindGroup
+                && vertexBuffer == other.vertexBuffer && indexBuffer == other.indexBuffer;
+        }
+
+        bool operator!=(DrawState const& other) const { return !(*this == other); }
+    };
+
+    /// @brief Range of indirect argument slots encoded with a single multi-draw.
+    struct DrawRun
+    {
+        uint32_t    first   = 0;
+        uint32_t    count   = 0;
+    };
+
+    /// @brief Persistent render state of an entity, mirrors the data in its uniform slots.
+    struct ObjectSlot
+    {
+        bool            valid           = false;            // Uniform data was written since the slot was allocated
+        Transform       transform       = {};               // Transform the object uniform data was calculated from
+        gfx::AABB       localBounds     = {};               // Mesh bounds the world bounds were calculated from
+        gfx::AABB       worldBounds     = {};
+        uint32_t        materialSlot    = INVALID_SLOT;     // Material slot referenced by this object
+    };
+
+    /// @brief Persistent state of a material referenced by render components, keyed by material identity.
+    struct MaterialSlot
+    {
+        std::shared_ptr<gfx::Material>  material    = {};
+        uint32_t                        references  = 0;        // Number of object slots referencing this material
+        WGPUBindGroup                   bindGroup   = nullptr;
+        WGPUTextureView                 albedoView  = nullptr;  // Texture views the bind group was created with
+        WGPUTextureView                 normalView  = nullptr;
+    };
+
+    /// @brief Create the depth-stencil target and the hierarchical-Z pyramid built from it, sized to the framebuffer.
+    void createRenderTargets();
+
+    /// @brief Destroy the render targets along with the bind groups referencing them.
+    void destroyRenderTargets();
+
+    /// @brief Allocate a uniform slot for a new render component.
+    /// @param registry 
+    /// @param entity 
+    void onRenderComponentConstruct(entt::registry& registry, entt::entity entity);
+
+    /// @brief Free the uniform slot of a destroyed render component.
+    /// @param registry 
+    /// @param entity 
+    void onRenderComponentDestroy(entt::registry& registry, entt::entity entity);
+
+    /// @brief Acquire a reference to the slot of a material, allocating a slot if the material has none yet.
+    /// @param material 
+    /// @return The material slot index.
+    uint32_t acquireMaterialSlot(std::shared_ptr<gfx::Material> const& material);
+
+    /// @brief Release a reference to a material slot, freeing the slot once it is no longer referenced.
+    /// @param slotIndex 
+    void releaseMaterialSlot(uint32_t slotIndex);
+
+    /// @brief Create the bind group of a material slot if it does not exist or its textures changed.
+    /// @param slotIndex 
+    void updateMaterialBindGroup(uint32_t slotIndex);
+
     /// @brief Upload GPU scene data that has changed this frame.
     /// @param registry 
     void uploadSceneData(entt::registry const& registry);
 
+    /// @brief Create the device texture & sampler of a texture and upload all of its mip levels.
+    /// @param texture 
+    void uploadTexture(gfx::Texture& texture);
+
     /// @brief Prepare the game frame state.
     /// @param registry 
-    /// @retrurn A drawlist containing all render pass draw commands.
-    DrawList prepare(entt::registry const& registry);
+    /// @retrurn A sorted drawlist containing all render pass draw commands, valid until the next prepare call.
+    DrawList const& prepare(entt::registry const& registry);
+
+    /// @brief Rasterize the nearest fully solid chunks inside the frustum into the software occlusion depth buffer.
+    /// @param registry 
+    /// @param frustum Frustum of the current frame.
+    /// @param viewproject View projection of the current frame.
+    /// @param position Camera position, occluders are selected by their distance to it.
+    void rasterizeOccluders(entt::registry const& registry, gfx::Frustum const& frustum, glm::mat4 const& viewproject, glm::vec3 const& position);
+
+    /// @brief Write the indirect draw arguments of all sorted draw commands, in sort order.
+    /// @param drawList 
+    void writeIndirectArgs(DrawList const& drawList);
+
+    /// @brief Write the per-draw culling inputs & culling parameters, grouping sorted draw commands into runs.
+    /// @param drawList 
+    /// @param frustum Frustum of the current frame.
+    /// @param viewproject View projection of the current frame, the next pyramid is built from depth rendered with it.
+    /// @param hasCamera Boolean indicating a camera was found, without one draws are not occlusion culled.
+    void writeCullData(DrawList const& drawList, gfx::Frustum const& frustum, glm::mat4 const& viewproject, bool hasCamera);
+
+    /// @brief Validate the uploaded indirect draw arguments against the direct draw arguments of each sorted command.
+    /// @param drawList 
+    /// @return The number of draw commands with mismatching arguments.
+    size_t validateIndirectArgs(DrawList const& drawList) const;
+
+    /// @brief Retrieve the render state bound for a draw command.
+    /// @param command 
+    /// @return 
+    DrawState drawState(DrawCommand const& command) const;
+
+    /// @brief Record the culling compute pass, writing the culled indirect arguments of this frame.
+    /// @param encoder 
+    void recordCulling(WGPUCommandEncoder encoder);
+
+    /// @brief Record the compute passes building the hierarchical-Z pyramid from the depth rendered this frame.
+    /// @param encoder 
+    void recordHiZBuild(WGPUCommandEncoder encoder);
 
     /// @brief Execute the game frame render state.
     /// @param registry 
@@ -101,10 +389,15 @@ private:
     // Render pass resources
     WGPUTexture                 m_depthStencilTarget            = nullptr;
     WGPUTextureView             m_depthStencilTargetView        = nullptr;
+    WGPUTextureView             m_depthSampleView               = nullptr;  // Depth aspect view read by the pyramid build
 
-    WGPUBuffer                  m_cameraDataUBO                 = nullptr;
-    WGPUBuffer                  m_objectTransformDataUBO        = nullptr;
-    WGPUBuffer                  m_materialDataUBO               = nullptr;
+    gfx::UniformBuffer          m_cameraData;
+    gfx::UniformBuffer          m_objectTransformData;
+    gfx::UniformBuffer          m_instanceData;
+    gfx::UniformBuffer          m_materialData;
+    gfx::UniformBuffer          m_indirectData;
+    gfx::UploadManager          m_uploadManager;
+    std::shared_ptr<gfx::MeshPool> m_meshPool;  // Shared with mesh allocations, which may outlive the renderer
 
     // Pipeline resources
     WGPUBindGroupLayout         m_sceneDataBindGroupLayout      = nullptr;
@@ -112,9 +405,61 @@ private:
     WGPUBindGroupLayout         m_materialDataBindGroupLayout   = nullptr;
     WGPUPipelineLayout          m_pipelineLayout                = nullptr;
     WGPURenderPipeline          m_pipeline                      = nullptr;
+    WGPURenderPipeline          m_voxelPipeline                 = nullptr;
+    bool                        m_indirectDraws                 = false;    // Draws read their arguments from m_indirectData
+    bool                        m_multiDrawIndirect             = false;
+    bool                        m_gpuCulling                    = false;    // Indirect draws read culled arguments
+    bool                        m_compactDraws                  = false;    // Culled runs are drawn with a multi-draw count
+    bool                        m_softwareOcclusion             = false;    // Objects are occlusion culled on the CPU
+    gfx::BlockFormatSupport     m_blockFormatSupport            = {};       // Block formats textures may be compressed to
 
     // Pipeline bind groups
     WGPUBindGroup               m_sceneDataBindGroup            = nullptr;
+    WGPUTextureView             m_sceneBlockTexturesView        = nullptr;  // Block texture view referenced by the scene data bind group
+    std::shared_ptr<gfx::Texture> m_blockTextures;             // Sampled by voxel meshes, one layer per block texture
+    std::shared_ptr<gfx::Texture> m_defaultTexture;            // Bound in place of missing material textures
     WGPUBindGroup               m_objectDataBindGroup           = nullptr;
-    std::vector<WGPUBindGroup>  m_materialDataBindGroups        = {};
+
+    // Persistent uniform slots, indexed by slot index
+    entt::registry&                                     m_registry;
+    std::unordered_map<entt::entity, uint32_t>          m_objectSlotIndices     = {};
+    std::vector<ObjectSlot>                             m_objectSlots           = {};
+    std::vector<uint32_t>                               m_freeObjectSlots       = {};
+    std::unordered_map<gfx::Material const*, uint32_t>  m_materialSlotIndices   = {};   // Keyed by material identity
+    std::vector<MaterialSlot>                           m_materialSlots         = {};
+    std::vector<uint32_t>                               m_freeMaterialSlots     = {};
+
+    // GPU culling resources, the pyramid is rebuilt from the depth target at the end of every frame
+    WGPUTexture                 m_hizTexture                    = nullptr;
+    WGPUTextureView             m_hizView                       = nullptr;
+    std::vector<WGPUTextureView> m_hizLevelViews                = {};
+    std::vector<WGPUBindGroup>  m_hizBindGroups                 = {};   // Per level, level 0 reads the depth target
+    std::vector<glm::uvec2>     m_hizLevelSizes                 = {};
+    glm::uvec2                  m_hizDepthSize                  = { 0, 0 };
+    glm::mat4                   m_hizViewProject                = glm::mat4(1.0F);  // View projection the pyramid depth was rendered with
+    glm::mat4                   m_frameViewProject              = glm::mat4(1.0F);
+    bool                        m_hizValid                      = false;    // The pyramid holds the depth of a previous frame
+    WGPUBindGroupLayout         m_hizDepthBindGroupLayout       = nullptr;
+    WGPUBindGroupLayout         m_hizDownsampleBindGroupLayout  = nullptr;
+    WGPUBindGroupLayout         m_cullBindGroupLayout           = nullptr;
+    WGPUComputePipeline         m_hizDepthPipeline              = nullptr;
+    WGPUComputePipeline         m_hizDownsamplePipeline         = nullptr;
+    WGPUComputePipeline         m_cullPipeline                  = nullptr;
+    WGPUBindGroup               m_cullBindGroup                 = nullptr;  // Recreated when a referenced resource is recreated
+    gfx::UniformBuffer          m_cullParams;
+    gfx::UniformBuffer          m_drawCullData;
+    WGPUBuffer                  m_culledArgsBuffer              = nullptr;
+    WGPUBuffer                  m_runCountBuffer                = nullptr;
+    std::vector<DrawRun>        m_drawRuns                      = {};
+
+    // Frustum culling state, reused between frames to avoid reallocations
+    gfx::BoundingBoxList        m_cullingBounds                 = {};
+    std::vector<uint8_t>        m_cullingResults                = {};
+    gfx::OcclusionRasterizer    m_occlusionRasterizer           = {};
+
+    // Per-frame render data, either reused between frames or allocated from the frame arena
+    core::FrameArena            m_frameArena                    = {};
+    std::vector<InstanceBatch>  m_instanceBatches               = {};
+    DrawList                    m_drawList                      = {};
+    RendererStats               m_stats                         = {};
 };
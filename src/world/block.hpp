@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace world
+{
+	/// @brief Block identifier stored in chunk palettes.
+	using BlockID = uint16_t;
+
+	static constexpr BlockID BLOCK_AIR		= 0; // Empty block, always present in a new chunk palette
+	static constexpr BlockID BLOCK_STONE	= 1;
+	static constexpr BlockID BLOCK_DIRT		= 2;
+	static constexpr BlockID BLOCK_GRASS	= 3;
+	static constexpr BlockID BLOCK_SAND		= 4;
+	static constexpr BlockID BLOCK_SNOW		= 5;
+	static constexpr BlockID BLOCK_WATER	= 6; // NOTE: rendered as an opaque block until there is a translucent pass
+
+	/// @brief Axis aligned block faces, ordered as (axis * 2 + negative).
+	enum class BlockFace : uint32_t
+	{
+		PosX,
+		NegX,
+		PosY,
+		NegY,
+		PosZ,
+		NegZ,
+	};
+
+	static constexpr uint32_t BLOCK_FACE_COUNT = 6;
+
+	/// @brief Check if a block is solid, i.e. not empty space.
+	/// @param block 
+	/// @return 
+	constexpr bool isSolidBlock(BlockID block)
+	{
+		return block != BLOCK_AIR;
+	}
+
+	/// @brief Retrieve the texture layer used to render a block.
+	/// @param block 
+	/// @return 
+	constexpr uint32_t blockTextureLayer(BlockID block)
+	{
+		return block; // Layers map 1:1 to block ids for now
+	}
+} // namespace world
@@ -0,0 +1,255 @@
+#include "chunk.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace world
+{
+	/// @brief Calculate the smallest power of 2 index width that can address a palette.
+	/// @param paletteSize 
+	/// @return 
+	static uint32_t requiredIndexBits(size_t paletteSize)
+	{
+		if (paletteSize <= 1) {
+			return 0;
+		}
+
+		uint32_t bits = 1;
+		while ((size_t(1) << bits) < paletteSize) {
+			bits *= 2;
+		}
+
+		return bits;
+	}
+
+	Chunk::Chunk(BlockID fill)
+		:
+		m_palette{ PaletteEntry{ fill, CHUNK_VOLUME } },
+		m_liveEntries(1)
+	{
+		//
+	}
+
+	BlockID Chunk::getBlock(uint32_t x, uint32_t y, uint32_t z) const
+	{
+		assert(x < CHUNK_SIZE && y < CHUNK_SIZE && z < CHUNK_SIZE && "Block coordinate out of chunk bounds");
+		return m_palette[readIndex(blockIndex(x, y, z))].block;
+	}
+
+	void Chunk::setBlock(uint32_t x, uint32_t y, uint32_t z, BlockID block)
+	{
+		assert(x < CHUNK_SIZE && y < CHUNK_SIZE && z < CHUNK_SIZE && "Block coordinate out of chunk bounds");
+
+		uint32_t const index = blockIndex(x, y, z);
+		uint32_t const oldEntry = readIndex(index);
+		if (m_palette[oldEntry].block == block) {
+			return;
+		}
+
+		// Acquiring a new entry may repack the index storage, existing entry indices stay valid
+		uint32_t const newEntry = acquirePaletteEntry(block);
+		writeIndex(index, newEntry);
+		m_palette[newEntry].refCount++;
+
+		// Release old entry, shrinking the palette once an index width step can be dropped
+		m_palette[oldEntry].refCount--;
+		if (m_palette[oldEntry].refCount == 0)
+		{
+			m_liveEntries--;
+
+			// NOTE: Keep headroom for one palette doubling before shrinking, avoids repacking on every edit at a width boundary
+			if (m_liveEntries == 1 || requiredIndexBits(m_liveEntries * 2) < m_bitsPerIndex) {
+				compactPalette();
+			}
+		}
+	}
+
+	void Chunk::copyBlocks(BlockID* pBlocks) const
+	{
+		assert(pBlocks != nullptr && "Block output array cannot be a nullptr");
+
+		if (m_bitsPerIndex == 0)
+		{
+			std::fill(pBlocks, pBlocks + CHUNK_VOLUME, m_palette[0].block);
+			return;
+		}
+
+		// Decode a full word of indices at a time instead of going through readIndex
+		uint32_t const mask = (1U << m_bitsPerIndex) - 1;
+		uint32_t const indicesPerWord = 32 / m_bitsPerIndex;
+		for (size_t word = 0; word < m_indices.size(); word++)
+		{
+			uint32_t packed = m_indices[word];
+			BlockID* pOut = pBlocks + word * indicesPerWord;
+			for (uint32_t i = 0; i < indicesPerWord; i++, packed >>= m_bitsPerIndex) {
+				pOut[i] = m_palette[packed & mask].block;
+			}
+		}
+	}
+
+	void Chunk::setBlocks(BlockID const* pBlocks)
+	{
+		assert(pBlocks != nullptr && "Block input array cannot be a nullptr");
+
+		// Generated data mostly consists of long runs, so check the previous block before scanning the palette
+		std::vector<PaletteEntry> palette{};
+		BlockID previous = pBlocks[0];
+		size_t previousEntry = 0;
+		palette.push_back(PaletteEntry{ previous, 0 });
+		for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+		{
+			BlockID const block = pBlocks[i];
+			if (block != previous)
+			{
+				auto const it = std::find_if(palette.begin(), palette.end(), [block](PaletteEntry const& entry) { return entry.block == block; });
+				previousEntry = static_cast<size_t>(it - palette.begin());
+				if (it == palette.end()) {
+					palette.push_back(PaletteEntry{ block, 0 });
+				}
+
+				previous = block;
+			}
+
+			palette[previousEntry].refCount++;
+		}
+
+		uint32_t const bitsPerIndex = requiredIndexBits(palette.size());
+		std::vector<uint32_t> indices((CHUNK_VOLUME * bitsPerIndex + 31) / 32, 0);
+		if (bitsPerIndex > 0)
+		{
+			previous = palette[0].block;
+			previousEntry = 0;
+			for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+			{
+				BlockID const block = pBlocks[i];
+				if (block != previous)
+				{
+					auto const it = std::find_if(palette.begin(), palette.end(), [block](PaletteEntry const& entry) { return entry.block == block; });
+					previousEntry = static_cast<size_t>(it - palette.begin());
+					previous = block;
+				}
+
+				uint32_t const bit = i * bitsPerIndex;
+				indices[bit / 32] |= static_cast<uint32_t>(previousEntry) << (bit % 32);
+			}
+		}
+
+		m_liveEntries = static_cast<uint32_t>(palette.size());
+		m_palette = std::move(palette);
+		m_indices = std::move(indices);
+		m_bitsPerIndex = bitsPerIndex;
+	}
+
+	void Chunk::fill(BlockID block)
+	{
+		m_palette = { PaletteEntry{ block, CHUNK_VOLUME } };
+		m_indices = {};
+		m_bitsPerIndex = 0;
+		m_liveEntries = 1;
+	}
+
+	size_t Chunk::memoryUsage() const
+	{
+		return sizeof(Chunk)
+			+ m_palette.capacity() * sizeof(PaletteEntry)
+			+ m_indices.capacity() * sizeof(uint32_t);
+	}
+
+	uint32_t Chunk::readIndex(uint32_t index) const
+	{
+		if (m_bitsPerIndex == 0) {
+			return 0;
+		}
+
+		uint32_t const bit = index * m_bitsPerIndex;
+		uint32_t const mask = (1U << m_bitsPerIndex) - 1;
+		return (m_indices[bit / 32] >> (bit % 32)) & mask;
+	}
+
+	void Chunk::writeIndex(uint32_t index, uint32_t entry)
+	{
+		assert(m_bitsPerIndex > 0 && "Cannot write indices into uniform chunk storage");
+
+		uint32_t const bit = index * m_bitsPerIndex;
+		uint32_t const mask = (1U << m_bitsPerIndex) - 1;
+		uint32_t const shift = bit % 32;
+		uint32_t& word = m_indices[bit / 32];
+		word = (word & ~(mask << shift)) | ((entry & mask) << shift);
+	}
+
+	uint32_t Chunk::acquirePaletteEntry(BlockID block)
+	{
+		// Palettes are tiny in practice, so a linear scan beats any lookup structure here
+		size_t freeEntry = m_palette.size();
+		for (size_t i = 0; i < m_palette.size(); i++)
+		{
+			if (m_palette[i].refCount == 0)
+			{
+				freeEntry = (freeEntry == m_palette.size()) ? i : freeEntry;
+				continue;
+			}
+
+			if (m_palette[i].block == block) {
+				return static_cast<uint32_t>(i);
+			}
+		}
+
+		// Reuse a released entry if possible
+		m_liveEntries++;
+		if (freeEntry != m_palette.size())
+		{
+			m_palette[freeEntry] = PaletteEntry{ block, 0 };
+			return static_cast<uint32_t>(freeEntry);
+		}
+
+		// Append a new entry, growing the index width if the palette no longer fits
+		m_palette.push_back(PaletteEntry{ block, 0 });
+		uint32_t const bitsPerIndex = requiredIndexBits(m_palette.size());
+		if (bitsPerIndex > m_bitsPerIndex) {
+			repack(bitsPerIndex, {});
+		}
+
+		return static_cast<uint32_t>(m_palette.size() - 1);
+	}
+
+	void Chunk::compactPalette()
+	{
+		std::vector<PaletteEntry> palette{};
+		std::vector<uint32_t> remap(m_palette.size(), 0);
+		palette.reserve(m_liveEntries);
+		for (size_t i = 0; i < m_palette.size(); i++)
+		{
+			if (m_palette[i].refCount == 0) {
+				continue;
+			}
+
+			remap[i] = static_cast<uint32_t>(palette.size());
+			palette.push_back(m_palette[i]);
+		}
+
+		assert(palette.size() == m_liveEntries && "Live palette entry count out of sync");
+		repack(requiredIndexBits(palette.size()), remap);
+		m_palette = std::move(palette);
+	}
+
+	void Chunk::repack(uint32_t bitsPerIndex, std::vector<uint32_t> const& remap)
+	{
+		std::vector<uint32_t> indices((CHUNK_VOLUME * bitsPerIndex + 31) / 32, 0);
+		if (bitsPerIndex > 0)
+		{
+			uint32_t const mask = (1U << bitsPerIndex) - 1;
+			for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+			{
+				uint32_t entry = readIndex(i);
+				entry = remap.empty() ? entry : remap[entry];
+
+				uint32_t const bit = i * bitsPerIndex;
+				indices[bit / 32] |= (entry & mask) << (bit % 32);
+			}
+		}
+
+		m_indices = std::move(indices);
+		m_bitsPerIndex = bitsPerIndex;
+	}
+} // namespace world
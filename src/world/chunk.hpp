@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "block.hpp"
+
+namespace world
+{
+	static constexpr uint32_t CHUNK_SIZE	= 32;								// Chunk size in blocks along each axis
+	static constexpr uint32_t CHUNK_AREA	= CHUNK_SIZE * CHUNK_SIZE;			// Number of blocks in a single chunk layer
+	static constexpr uint32_t CHUNK_VOLUME	= CHUNK_AREA * CHUNK_SIZE;			// Number of blocks in a chunk
+
+	/// @brief Integer division rounding towards negative infinity.
+	/// @param value 
+	/// @param divisor 
+	/// @return 
+	inline int32_t floorDivide(int32_t value, int32_t divisor)
+	{
+		int32_t const quotient = value / divisor;
+		return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+	}
+
+	/// @brief The Chunk class stores a fixed size cube of blocks using a block palette and bit-packed palette indices.
+	/// Uniform chunks store only a single palette entry, the index width grows and shrinks with the number of live palette entries.
+	class Chunk
+	{
+	public:
+		/// @brief Create a new uniform chunk.
+		/// @param fill Block to fill the chunk with.
+		Chunk(BlockID fill = BLOCK_AIR);
+
+		/// @brief Retrieve a block from this chunk.
+		/// @param x Local x coordinate in range [0, CHUNK_SIZE).
+		/// @param y Local y coordinate in range [0, CHUNK_SIZE).
+		/// @param z Local z coordinate in range [0, CHUNK_SIZE).
+		/// @return 
+		BlockID getBlock(uint32_t x, uint32_t y, uint32_t z) const;
+
+		/// @brief Set a block in this chunk, growing or shrinking the palette as needed.
+		/// @param x Local x coordinate in range [0, CHUNK_SIZE).
+		/// @param y Local y coordinate in range [0, CHUNK_SIZE).
+		/// @param z Local z coordinate in range [0, CHUNK_SIZE).
+		/// @param block 
+		void setBlock(uint32_t x, uint32_t y, uint32_t z, BlockID block);
+
+		/// @brief Decode all blocks in this chunk into a flat array, ordered by linear block index.
+		/// @param pBlocks Output array of at least CHUNK_VOLUME blocks.
+		void copyBlocks(BlockID* pBlocks) const;
+
+		/// @brief Replace all blocks in this chunk, building the palette in a first pass and packing indices in a second pass.
+		/// @param pBlocks Input array of CHUNK_VOLUME blocks, ordered by linear block index.
+		void setBlocks(BlockID const* pBlocks);
+
+		/// @brief Fill the entire chunk with a single block, resetting it to uniform storage.
+		/// @param block 
+		void fill(BlockID block);
+
+		/// @brief Check if this chunk consists of a single block type.
+		/// @return 
+		bool isUniform() const { return m_bitsPerIndex == 0; }
+
+		/// @brief Retrieve the number of live (referenced) palette entries.
+		/// @return 
+		size_t paletteSize() const { return m_liveEntries; }
+
+		/// @brief Retrieve the number of bits used per packed palette index.
+		/// @return 
+		uint32_t bitsPerIndex() const { return m_bitsPerIndex; }
+
+		/// @brief Retrieve the host memory used by this chunk in bytes.
+		/// @return 
+		size_t memoryUsage() const;
+
+		/// @brief Calculate the linear block index for a local block coordinate.
+		/// @param x 
+		/// @param y 
+		/// @param z 
+		/// @return 
+		static constexpr uint32_t blockIndex(uint32_t x, uint32_t y, uint32_t z) { return x + z * CHUNK_SIZE + y * CHUNK_AREA; }
+
+	private:
+		/// @brief Palette entry with a reference count of blocks using it.
+		struct PaletteEntry
+		{
+			BlockID		block;
+			uint32_t	refCount;
+		};
+
+		/// @brief Read a packed palette index.
+		/// @param index Linear block index.
+		/// @return 
+		uint32_t readIndex(uint32_t index) const;
+
+		/// @brief Write a packed palette index.
+		/// @param index Linear block index.
+		/// @param entry Palette entry index to store.
+		void writeIndex(uint32_t index, uint32_t entry);
+
+		/// @brief Find a live palette entry for a block, or claim a new one, growing the index width if needed.
+		/// @param block 
+		/// @return The palette entry index.
+		uint32_t acquirePaletteEntry(BlockID block);
+
+		/// @brief Drop all unreferenced palette entries and repack indices using the smallest fitting index width.
+		void compactPalette();
+
+		/// @brief Repack the index storage with a new index width, remapping palette entries.
+		/// @param bitsPerIndex New index width.
+		/// @param remap Palette entry remap table, may be empty to keep palette indices as-is.
+		void repack(uint32_t bitsPerIndex, std::vector<uint32_t> const& remap);
+
+	private:
+		std::vector<PaletteEntry>	m_palette		= {};
+		std::vector<uint32_t>		m_indices		= {};	// Bit-packed palette indices, empty for uniform chunks
+		uint32_t					m_bitsPerIndex	= 0;	// Always a power of 2 so indices never straddle words
+		uint32_t					m_liveEntries	= 0;
+	};
+
+	/// @brief Neighbouring chunks used for face culling across chunk borders, indexed by BlockFace.
+	/// Missing neighbours (nullptr) are treated as empty space.
+	using ChunkNeighbors = std::array<Chunk const*, BLOCK_FACE_COUNT>;
+} // namespace world
@@ -0,0 +1,221 @@
+#include "chunk_mesher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace world
+{
+	size_t ChunkMesher::mesh(Chunk const& chunk, ChunkNeighbors const& neighbors, std::vector<gfx::VoxelVertex>& vertices, std::vector<gfx::IndexType>& indices)
+	{
+		vertices.clear();
+		indices.clear();
+		gatherBlocks(chunk, neighbors);
+
+		size_t quadCount = 0;
+		int32_t const size = static_cast<int32_t>(CHUNK_SIZE);
+		for (uint32_t axis = 0; axis < 3; axis++)
+		{
+			uint32_t const u = (axis + 1) % 3; // Quad width axis
+			uint32_t const v = (axis + 2) % 3; // Quad height axis
+
+			for (uint32_t negative = 0; negative < 2; negative++)
+			{
+				int32_t const direction = negative ? -1 : 1;
+				uint32_t const face = axis * 2 + negative;
+
+				for (int32_t slice = 0; slice < size; slice++)
+				{
+					// Build face mask for this slice, storing the block and corner occlusion of each visible face
+					int32_t position[3]{};
+					int32_t neighbor[3]{};
+					position[axis] = slice;
+					neighbor[axis] = slice + direction;
+					for (int32_t j = 0; j < size; j++)
+					{
+						position[v] = neighbor[v] = j;
+						for (int32_t i = 0; i < size; i++)
+						{
+							position[u] = neighbor[u] = i;
+							BlockID const block = paddedBlock(position[0], position[1], position[2]);
+							BlockID const adjacent = paddedBlock(neighbor[0], neighbor[1], neighbor[2]);
+							if (!isSolidBlock(block) || isSolidBlock(adjacent))
+							{
+								m_mask[i + j * size] = 0;
+								continue;
+							}
+
+							m_mask[i + j * size] = block | (faceOcclusion(neighbor, u, v) << 16);
+						}
+					}
+
+					// Greedily merge equal mask cells into quads, first along u then along v
+					uint32_t const plane = static_cast<uint32_t>(negative ? slice : slice + 1);
+					for (int32_t j = 0; j < size; j++)
+					{
+						for (int32_t i = 0; i < size;)
+						{
+							uint32_t const cell = m_mask[i + j * size];
+							if (cell == 0)
+							{
+								i++;
+								continue;
+							}
+
+							int32_t width = 1;
+							while (i + width < size && m_mask[(i + width) + j * size] == cell) {
+								width++;
+							}
+
+							int32_t height = 1;
+							for (; j + height < size; height++)
+							{
+								uint32_t const* pRow = &m_mask[i + (j + height) * size];
+								if (std::any_of(pRow, pRow + width, [cell](uint32_t c) { return c != cell; })) {
+									break;
+								}
+							}
+
+							// Emit quad corners in order (0, 0), (w, 0), (w, h), (0, h) along the u/v axes
+							BlockID const block = static_cast<BlockID>(cell & 0xFFFFU);
+							uint32_t const occlusion = cell >> 16;
+							uint32_t const cornerU[] = { 0, 1, 1, 0 };
+							uint32_t const cornerV[] = { 0, 0, 1, 1 };
+							uint32_t ao[4]{};
+
+							gfx::IndexType const base = static_cast<gfx::IndexType>(vertices.size());
+							for (uint32_t corner = 0; corner < 4; corner++)
+							{
+								uint32_t p[3]{};
+								p[axis] = plane;
+								p[u] = static_cast<uint32_t>(i) + cornerU[corner] * static_cast<uint32_t>(width);
+								p[v] = static_cast<uint32_t>(j) + cornerV[corner] * static_cast<uint32_t>(height);
+								ao[corner] = (occlusion >> (corner * 2)) & 3U;
+
+								vertices.push_back(gfx::VoxelVertex::pack(p[0], p[1], p[2], face, ao[corner], blockTextureLayer(block)));
+							}
+
+							// Flip the quad diagonal to interpolate occlusion along the more occluded corners, avoids anisotropy artifacts
+							bool const flip = (ao[0] + ao[2]) > (ao[1] + ao[3]);
+							gfx::IndexType const a = base, b = base + 1, c = base + 2, d = base + 3;
+							if (!flip && !negative) {
+								indices.insert(indices.end(), { a, b, c, a, c, d });
+							}
+							else if (!flip && negative) {
+								indices.insert(indices.end(), { a, c, b, a, d, c });
+							}
+							else if (flip && !negative) {
+								indices.insert(indices.end(), { a, b, d, b, c, d });
+							}
+							else {
+								indices.insert(indices.end(), { a, d, b, b, d, c });
+							}
+
+							// Clear merged cells so they are not emitted twice
+							for (int32_t y = 0; y < height; y++) {
+								std::fill_n(&m_mask[i + (j + y) * size], width, 0U);
+							}
+
+							quadCount++;
+							i += width;
+						}
+					}
+				}
+			}
+		}
+
+		return quadCount;
+	}
+
+	size_t ChunkMesher::mesh(Chunk const& chunk, ChunkNeighbors const& neighbors, gfx::Mesh& mesh)
+	{
+		std::vector<gfx::VoxelVertex> vertices{};
+		std::vector<gfx::IndexType> indices{};
+		size_t const quadCount = this->mesh(chunk, neighbors, vertices, indices);
+
+		mesh.setBuffers(std::move(vertices), std::move(indices));
+		return quadCount;
+	}
+
+	uint32_t ChunkMesher::faceOcclusion(int32_t const* pAdjacent, uint32_t u, uint32_t v) const
+	{
+		auto const solidAt = [&](int32_t du, int32_t dv) -> uint32_t {
+			int32_t p[3] = { pAdjacent[0], pAdjacent[1], pAdjacent[2] };
+			p[u] += du;
+			p[v] += dv;
+			return isSolidBlock(paddedBlock(p[0], p[1], p[2])) ? 1 : 0;
+		};
+
+		// Corner order matches quad emission: (-u, -v), (+u, -v), (+u, +v), (-u, +v)
+		int32_t const cornerU[] = { -1, 1, 1, -1 };
+		int32_t const cornerV[] = { -1, -1, 1, 1 };
+
+		uint32_t occlusion = 0;
+		for (uint32_t corner = 0; corner < 4; corner++)
+		{
+			uint32_t const side1 = solidAt(cornerU[corner], 0);
+			uint32_t const side2 = solidAt(0, cornerV[corner]);
+			uint32_t const diagonal = solidAt(cornerU[corner], cornerV[corner]);
+			uint32_t const ao = (side1 && side2) ? 0 : 3 - (side1 + side2 + diagonal);
+			occlusion |= ao << (corner * 2);
+		}
+
+		return occlusion;
+	}
+
+	void ChunkMesher::gatherBlocks(Chunk const& chunk, ChunkNeighbors const& neighbors)
+	{
+		std::fill(m_blocks.begin(), m_blocks.end(), BLOCK_AIR);
+
+		// Copy chunk interior row by row
+		chunk.copyBlocks(m_chunkBlocks.data());
+		for (uint32_t y = 0; y < CHUNK_SIZE; y++)
+		{
+			for (uint32_t z = 0; z < CHUNK_SIZE; z++)
+			{
+				BlockID const* pRow = &m_chunkBlocks[Chunk::blockIndex(0, y, z)];
+				BlockID* pPaddedRow = &m_blocks[1 + (z + 1) * PADDED_SIZE + (y + 1) * PADDED_SIZE * PADDED_SIZE];
+				std::copy_n(pRow, CHUNK_SIZE, pPaddedRow);
+			}
+		}
+
+		// Copy the bordering layer of each neighbour
+		auto const setPadded = [&](int32_t x, int32_t y, int32_t z, BlockID block) {
+			m_blocks[(x + 1) + (z + 1) * PADDED_SIZE + (y + 1) * PADDED_SIZE * PADDED_SIZE] = block;
+		};
+
+		int32_t const size = static_cast<int32_t>(CHUNK_SIZE);
+		uint32_t const last = CHUNK_SIZE - 1;
+		for (uint32_t a = 0; a < CHUNK_SIZE; a++)
+		{
+			for (uint32_t b = 0; b < CHUNK_SIZE; b++)
+			{
+				int32_t const ia = static_cast<int32_t>(a);
+				int32_t const ib = static_cast<int32_t>(b);
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::PosX)]) {
+					setPadded(size, ia, ib, pNeighbor->getBlock(0, a, b));
+				}
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::NegX)]) {
+					setPadded(-1, ia, ib, pNeighbor->getBlock(last, a, b));
+				}
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::PosY)]) {
+					setPadded(ia, size, ib, pNeighbor->getBlock(a, 0, b));
+				}
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::NegY)]) {
+					setPadded(ia, -1, ib, pNeighbor->getBlock(a, last, b));
+				}
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::PosZ)]) {
+					setPadded(ia, ib, size, pNeighbor->getBlock(a, b, 0));
+				}
+
+				if (Chunk const* pNeighbor = neighbors[static_cast<size_t>(BlockFace::NegZ)]) {
+					setPadded(ia, ib, -1, pNeighbor->getBlock(a, b, last));
+				}
+			}
+		}
+	}
+} // namespace world
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "block.hpp"
+#include "chunk.hpp"
+#include "rendering/mesh.hpp"
+#include "rendering/vertex_layout.hpp"
+
+namespace world
+{
+	/// @brief The ChunkMesher class converts chunk block data into greedily merged quads using the packed voxel vertex layout.
+	/// Faces are only merged if their per-corner ambient occlusion matches.
+	/// Scratch buffers are reused between calls, so a mesher instance must not be shared between threads.
+	class ChunkMesher
+	{
+	public:
+		/// @brief Mesh a chunk into host-side vertex and index buffers.
+		/// @param chunk Chunk to mesh.
+		/// @param neighbors Neighbouring chunks, used to cull faces on chunk borders.
+		/// @param vertices Output vertex buffer, cleared before meshing.
+		/// @param indices Output index buffer, cleared before meshing.
+		/// @return The number of quads emitted.
+		size_t mesh(Chunk const& chunk, ChunkNeighbors const& neighbors, std::vector<gfx::VoxelVertex>& vertices, std::vector<gfx::IndexType>& indices);
+
+		/// @brief Mesh a chunk directly into a mesh object, marking it dirty.
+		/// @param chunk Chunk to mesh.
+		/// @param neighbors Neighbouring chunks, used to cull faces on chunk borders.
+		/// @param mesh Mesh to store the chunk geometry in.
+		/// @return The number of quads emitted.
+		size_t mesh(Chunk const& chunk, ChunkNeighbors const& neighbors, gfx::Mesh& mesh);
+
+	private:
+		static constexpr uint32_t PADDED_SIZE = CHUNK_SIZE + 2; // Chunk size including a 1 block border of neighbour data
+
+		/// @brief Fill the padded block array with chunk data and the bordering layer of each neighbour.
+		/// @param chunk 
+		/// @param neighbors 
+		void gatherBlocks(Chunk const& chunk, ChunkNeighbors const& neighbors);
+
+		/// @brief Calculate the per-corner ambient occlusion of a block face.
+		/// @param pAdjacent Padded coordinate of the empty block in front of the face.
+		/// @param u Face width axis.
+		/// @param v Face height axis.
+		/// @return 4 packed 2 bit occlusion values, 3 being unoccluded.
+		uint32_t faceOcclusion(int32_t const* pAdjacent, uint32_t u, uint32_t v) const;
+
+		/// @brief Retrieve a block from the padded block array, coordinates are offset by the 1 block border.
+		/// @param x 
+		/// @param y 
+		/// @param z 
+		/// @return 
+		BlockID paddedBlock(int32_t x, int32_t y, int32_t z) const { return m_blocks[(x + 1) + (z + 1) * PADDED_SIZE + (y + 1) * PADDED_SIZE * PADDED_SIZE]; }
+
+	private:
+		std::vector<BlockID>	m_chunkBlocks	= std::vector<BlockID>(CHUNK_VOLUME);
+		std::vector<BlockID>	m_blocks		= std::vector<BlockID>(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE);
+		std::vector<uint32_t>	m_mask			= std::vector<uint32_t>(CHUNK_AREA);	// Visible face block (low 16 bits) and corner occlusion (high 16 bits)
+	};
+} // namespace world
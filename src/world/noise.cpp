@@ -0,0 +1,338 @@
+#include "noise.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#if		defined(__AVX2__)
+#define NOISE_HAS_AVX2	1
+#else
+#define NOISE_HAS_AVX2	0
+#endif	// defined(__AVX2__)
+
+#if		defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_HAS_SSE2	1
+#else
+#define NOISE_HAS_SSE2	0
+#endif	// defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#if		NOISE_HAS_AVX2
+#include <immintrin.h>
+#elif	NOISE_HAS_SSE2
+#include <emmintrin.h>
+#endif	// NOISE_HAS_AVX2
+
+// NOTE: Every kernel below is written against the same lane operations in the same order, and this file is built without
+// floating point contraction, so scalar and SIMD evaluation return bit-identical results on every platform.
+
+namespace world
+{
+	static constexpr uint32_t	HASH_PRIME_X		= 0x8DA6B343U;
+	static constexpr uint32_t	HASH_PRIME_Y		= 0xD8163841U;
+	static constexpr uint32_t	HASH_MIX			= 0x27D4EB2DU;
+	static constexpr uint32_t	OCTAVE_SEED_STEP	= 0x9E3779B9U;	// Golden ratio, decorrelates octave seeds
+	static constexpr float		NOISE_SCALE			= 0.6324555F;		// 1 / (max gradient length * sqrt(0.5)), maps noise to [-1, 1]
+
+	/// @brief Single lane operations used as the scalar fallback and for batch remainders.
+	struct ScalarLanes
+	{
+		using Float = float;
+		using Int = uint32_t;
+		static constexpr size_t WIDTH = 1;
+
+		static Float load(float const* p) { return *p; }
+		static void store(float* p, Float v) { *p = v; }
+		static Float set(float v) { return v; }
+		static Int seti(uint32_t v) { return v; }
+
+		static Float add(Float a, Float b) { return a + b; }
+		static Float sub(Float a, Float b) { return a - b; }
+		static Float mul(Float a, Float b) { return a * b; }
+
+		static Float floor(Float v)
+		{
+			Float const truncated = static_cast<Float>(static_cast<int32_t>(v));
+			return (truncated > v) ? truncated - 1.0F : truncated;
+		}
+
+		static Float abs(Float v) { return fromBits(toBits(v) & 0x7FFFFFFFU); }
+		static Int toInt(Float v) { return static_cast<uint32_t>(static_cast<int32_t>(v)); }
+
+		static Int addi(Int a, Int b) { return a + b; }
+		static Int xori(Int a, Int b) { return a ^ b; }
+		static Int muli(Int a, Int b) { return a * b; }
+		template<int N> static Int srli(Int v) { return v >> N; }
+		template<int N> static Int slli(Int v) { return v << N; }
+
+		static Int testBit(Int v, uint32_t bit) { return (v & bit) ? 0xFFFFFFFFU : 0U; }
+		static Float select(Int mask, Float a, Float b) { return fromBits((toBits(a) & mask) | (toBits(b) & ~mask)); }
+		static Float flipSign(Float v, Int signBit) { return fromBits(toBits(v) ^ (signBit & 0x80000000U)); }
+
+	private:
+		static uint32_t toBits(Float v) { uint32_t bits; std::memcpy(&bits, &v, sizeof(bits)); return bits; }
+		static Float fromBits(uint32_t bits) { Float v; std::memcpy(&v, &bits, sizeof(v)); return v; }
+	};
+
+#if		NOISE_HAS_SSE2 || NOISE_HAS_AVX2
+	/// @brief 4 lane SSE2 operations.
+	struct SSE2Lanes
+	{
+		using Float = __m128;
+		using Int = __m128i;
+		static constexpr size_t WIDTH = 4;
+
+		static Float load(float const* p) { return _mm_loadu_ps(p); }
+		static void store(float* p, Float v) { _mm_storeu_ps(p, v); }
+		static Float set(float v) { return _mm_set1_ps(v); }
+		static Int seti(uint32_t v) { return _mm_set1_epi32(static_cast<int32_t>(v)); }
+
+		static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+
+		static Float floor(Float v)
+		{
+			// SSE2 has no floor instruction, round towards zero and correct negative values
+			Float const truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+			return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0F)));
+		}
+
+		static Float abs(Float v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+		static Int toInt(Float v) { return _mm_cvttps_epi32(v); }
+
+		static Int addi(Int a, Int b) { return _mm_add_epi32(a, b); }
+		static Int xori(Int a, Int b) { return _mm_xor_si128(a, b); }
+
+		static Int muli(Int a, Int b)
+		{
+			// SSE2 lacks a 32 bit low multiply, multiply even and odd lanes as 64 bit and interleave the low halves
+			Int const even = _mm_mul_epu32(a, b);
+			Int const odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+			return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+		}
+
+		template<int N> static Int srli(Int v) { return _mm_srli_epi32(v, N); }
+		template<int N> static Int slli(Int v) { return _mm_slli_epi32(v, N); }
+
+		static Int testBit(Int v, uint32_t bit) { Int const b = seti(bit); return _mm_cmpeq_epi32(_mm_and_si128(v, b), b); }
+		static Float select(Int mask, Float a, Float b) { Float const m = _mm_castsi128_ps(mask); return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+		static Float flipSign(Float v, Int signBit) { return _mm_xor_ps(v, _mm_castsi128_ps(_mm_and_si128(signBit, seti(0x80000000U)))); }
+	};
+#endif	// NOISE_HAS_SSE2 || NOISE_HAS_AVX2
+
+#if		NOISE_HAS_AVX2
+	/// @brief 8 lane AVX2 operations.
+	struct AVX2Lanes
+	{
+		using Float = __m256;
+		using Int = __m256i;
+		static constexpr size_t WIDTH = 8;
+
+		static Float load(float const* p) { return _mm256_loadu_ps(p); }
+		static void store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+		static Float set(float v) { return _mm256_set1_ps(v); }
+		static Int seti(uint32_t v) { return _mm256_set1_epi32(static_cast<int32_t>(v)); }
+
+		static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float floor(Float v) { return _mm256_floor_ps(v); }
+		static Float abs(Float v) { return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF))); }
+		static Int toInt(Float v) { return _mm256_cvttps_epi32(v); }
+
+		static Int addi(Int a, Int b) { return _mm256_add_epi32(a, b); }
+		static Int xori(Int a, Int b) { return _mm256_xor_si256(a, b); }
+		static Int muli(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+		template<int N> static Int srli(Int v) { return _mm256_srli_epi32(v, N); }
+		template<int N> static Int slli(Int v) { return _mm256_slli_epi32(v, N); }
+
+		static Int testBit(Int v, uint32_t bit) { Int const b = seti(bit); return _mm256_cmpeq_epi32(_mm256_and_si256(v, b), b); }
+		static Float select(Int mask, Float a, Float b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+		static Float flipSign(Float v, Int signBit) { return _mm256_xor_ps(v, _mm256_castsi256_ps(_mm256_and_si256(signBit, seti(0x80000000U)))); }
+	};
+#endif	// NOISE_HAS_AVX2
+
+	/// @brief Hash a lattice point, the lattice coordinates are pre-multiplied by their hash primes.
+	/// @param seed 
+	/// @param hx 
+	/// @param hy 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Int hashLattice(typename Lanes::Int seed, typename Lanes::Int hx, typename Lanes::Int hy)
+	{
+		typename Lanes::Int hash = Lanes::xori(Lanes::xori(hx, hy), seed);
+		hash = Lanes::muli(hash, Lanes::seti(HASH_MIX));
+		return Lanes::xori(hash, Lanes::template srli<15>(hash));
+	}
+
+	/// @brief Dot a lattice offset with one of 8 gradients (+-1, +-2) or (+-2, +-1) selected by the lattice hash.
+	/// @param hash 
+	/// @param x 
+	/// @param y 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Float gradient(typename Lanes::Int hash, typename Lanes::Float x, typename Lanes::Float y)
+	{
+		typename Lanes::Int const swap = Lanes::testBit(hash, 4);
+		typename Lanes::Float const u = Lanes::flipSign(Lanes::select(swap, y, x), Lanes::template slli<31>(hash));
+		typename Lanes::Float const v = Lanes::flipSign(Lanes::select(swap, x, y), Lanes::template slli<30>(hash));
+		return Lanes::add(u, Lanes::add(v, v));
+	}
+
+	/// @brief Quintic interpolation curve, has zero first and second derivatives at 0 and 1.
+	/// @param t 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Float fade(typename Lanes::Float t)
+	{
+		typename Lanes::Float curve = Lanes::sub(Lanes::mul(t, Lanes::set(6.0F)), Lanes::set(15.0F));
+		curve = Lanes::add(Lanes::mul(t, curve), Lanes::set(10.0F));
+		return Lanes::mul(Lanes::mul(Lanes::mul(t, t), t), curve);
+	}
+
+	/// @brief Linearly interpolate between a and b.
+	/// @param a 
+	/// @param b 
+	/// @param t 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Float lerp(typename Lanes::Float a, typename Lanes::Float b, typename Lanes::Float t)
+	{
+		return Lanes::add(a, Lanes::mul(t, Lanes::sub(b, a)));
+	}
+
+	/// @brief Evaluate 2D gradient noise.
+	/// @param seed 
+	/// @param x 
+	/// @param y 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Float gradientNoise(typename Lanes::Int seed, typename Lanes::Float x, typename Lanes::Float y)
+	{
+		using Float = typename Lanes::Float;
+		using Int = typename Lanes::Int;
+
+		Float const x0 = Lanes::floor(x);
+		Float const y0 = Lanes::floor(y);
+		Float const fx0 = Lanes::sub(x, x0);
+		Float const fy0 = Lanes::sub(y, y0);
+		Float const fx1 = Lanes::sub(fx0, Lanes::set(1.0F));
+		Float const fy1 = Lanes::sub(fy0, Lanes::set(1.0F));
+
+		// (i + 1) * prime == i * prime + prime, saves 2 multiplies
+		Int const hx0 = Lanes::muli(Lanes::toInt(x0), Lanes::seti(HASH_PRIME_X));
+		Int const hy0 = Lanes::muli(Lanes::toInt(y0), Lanes::seti(HASH_PRIME_Y));
+		Int const hx1 = Lanes::addi(hx0, Lanes::seti(HASH_PRIME_X));
+		Int const hy1 = Lanes::addi(hy0, Lanes::seti(HASH_PRIME_Y));
+
+		Float const n00 = gradient<Lanes>(hashLattice<Lanes>(seed, hx0, hy0), fx0, fy0);
+		Float const n10 = gradient<Lanes>(hashLattice<Lanes>(seed, hx1, hy0), fx1, fy0);
+		Float const n01 = gradient<Lanes>(hashLattice<Lanes>(seed, hx0, hy1), fx0, fy1);
+		Float const n11 = gradient<Lanes>(hashLattice<Lanes>(seed, hx1, hy1), fx1, fy1);
+
+		Float const u = fade<Lanes>(fx0);
+		Float const v = fade<Lanes>(fy0);
+		return Lanes::mul(lerp<Lanes>(lerp<Lanes>(n00, n10, u), lerp<Lanes>(n01, n11, u), v), Lanes::set(NOISE_SCALE));
+	}
+
+	/// @brief Evaluate 2D fractal noise.
+	/// @param params 
+	/// @param seed 
+	/// @param x 
+	/// @param y 
+	/// @return 
+	template<typename Lanes>
+	static typename Lanes::Float fractalNoise(NoiseParams const& params, uint32_t seed, typename Lanes::Float x, typename Lanes::Float y)
+	{
+		using Float = typename Lanes::Float;
+
+		Float sum = Lanes::set(0.0F);
+		float frequency = params.frequency;
+		float amplitude = 1.0F;
+		float amplitudeSum = 0.0F;
+		for (uint32_t octave = 0; octave < params.octaves; octave++)
+		{
+			Float const frequencies = Lanes::set(frequency);
+			Float value = gradientNoise<Lanes>(Lanes::seti(seed + octave * OCTAVE_SEED_STEP), Lanes::mul(x, frequencies), Lanes::mul(y, frequencies));
+			if (params.type == NoiseType::Ridged)
+			{
+				value = Lanes::sub(Lanes::set(1.0F), Lanes::abs(value));
+				value = Lanes::mul(value, value);
+			}
+
+			sum = Lanes::add(sum, Lanes::mul(value, Lanes::set(amplitude)));
+			amplitudeSum += amplitude;
+			frequency *= params.lacunarity;
+			amplitude *= params.gain;
+		}
+
+		return (amplitudeSum > 0.0F) ? Lanes::mul(sum, Lanes::set(1.0F / amplitudeSum)) : sum;
+	}
+
+	/// @brief Evaluate fractal noise for all full lane groups in a batch.
+	/// @param params 
+	/// @param seed 
+	/// @param pX 
+	/// @param pY 
+	/// @param pOut 
+	/// @param count 
+	/// @return The number of samples evaluated, remaining samples are left for a narrower lane type.
+	template<typename Lanes>
+	static size_t fractalNoiseBatch(NoiseParams const& params, uint32_t seed, float const* pX, float const* pY, float* pOut, size_t count)
+	{
+		size_t i = 0;
+		for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+			Lanes::store(pOut + i, fractalNoise<Lanes>(params, seed, Lanes::load(pX + i), Lanes::load(pY + i)));
+		}
+
+		return i;
+	}
+
+	SimdLevel bestSimdLevel()
+	{
+#if		NOISE_HAS_AVX2
+		return SimdLevel::AVX2;
+#elif	NOISE_HAS_SSE2
+		return SimdLevel::SSE2;
+#else
+		return SimdLevel::Scalar;
+#endif	// NOISE_HAS_AVX2
+	}
+
+	char const* toString(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::Scalar:	return "Scalar";
+		case SimdLevel::SSE2:	return "SSE2";
+		case SimdLevel::AVX2:	return "AVX2";
+		}
+
+		return "Unknown";
+	}
+
+	float gradientNoise(uint32_t seed, float x, float y)
+	{
+		return gradientNoise<ScalarLanes>(seed, x, y);
+	}
+
+	void fractalNoise(NoiseParams const& params, uint32_t seed, float const* pX, float const* pY, float* pOut, size_t count, SimdLevel level)
+	{
+		assert(pX != nullptr && pY != nullptr && pOut != nullptr && "Noise sample arrays cannot be a nullptr");
+
+		size_t done = 0;
+#if		NOISE_HAS_AVX2
+		if (level >= SimdLevel::AVX2) {
+			done += fractalNoiseBatch<AVX2Lanes>(params, seed, pX + done, pY + done, pOut + done, count - done);
+		}
+#endif	// NOISE_HAS_AVX2
+
+#if		NOISE_HAS_SSE2 || NOISE_HAS_AVX2
+		if (level >= SimdLevel::SSE2) {
+			done += fractalNoiseBatch<SSE2Lanes>(params, seed, pX + done, pY + done, pOut + done, count - done);
+		}
+#endif	// NOISE_HAS_SSE2 || NOISE_HAS_AVX2
+
+		(void)(level);
+		fractalNoiseBatch<ScalarLanes>(params, seed, pX + done, pY + done, pOut + done, count - done);
+	}
+} // namespace world
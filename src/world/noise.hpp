@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace world
+{
+	/// @brief SIMD instruction sets used to evaluate noise, all levels produce bit-identical results.
+	enum class SimdLevel
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+	};
+
+	/// @brief Fractal noise types.
+	enum class NoiseType
+	{
+		Fbm,	// Fractal brownian motion, in range [-1, 1]
+		Ridged,	// Ridged multifractal, sharp ridges in range [0, 1]
+	};
+
+	/// @brief Fractal noise parameters.
+	struct NoiseParams
+	{
+		NoiseType	type		= NoiseType::Fbm;
+		uint32_t	octaves		= 4;
+		float		frequency	= 0.01F;	// Frequency of the first octave
+		float		lacunarity	= 2.0F;		// Frequency multiplier per octave
+		float		gain		= 0.5F;		// Amplitude multiplier per octave
+	};
+
+	/// @brief Retrieve the widest SIMD level this build was compiled with.
+	/// @return 
+	SimdLevel bestSimdLevel();
+
+	/// @brief Retrieve a human readable name for a SIMD level.
+	/// @param level 
+	/// @return 
+	char const* toString(SimdLevel level);
+
+	/// @brief Evaluate a single 2D gradient noise sample.
+	/// @param seed Noise seed.
+	/// @param x 
+	/// @param y 
+	/// @return Noise value in range [-1, 1].
+	float gradientNoise(uint32_t seed, float x, float y);
+
+	/// @brief Evaluate 2D fractal noise for a batch of sample positions.
+	/// @param params Fractal noise parameters.
+	/// @param seed Noise seed, each octave uses a different seed derived from it.
+	/// @param pX Sample x coordinates.
+	/// @param pY Sample y coordinates.
+	/// @param pOut Output noise values.
+	/// @param count Number of samples.
+	/// @param level SIMD level to evaluate with, clamped to the best level available in this build.
+	void fractalNoise(NoiseParams const& params, uint32_t seed, float const* pX, float const* pY, float* pOut, size_t count, SimdLevel level = bestSimdLevel());
+} // namespace world
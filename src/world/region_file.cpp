@@ -0,0 +1,304 @@
+#include "region_file.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace world
+{
+	static constexpr uint32_t REGION_MAGIC				= 0x47525856U;	// "VXRG"
+	static constexpr uint32_t REGION_VERSION			= 1;
+	static constexpr uint32_t REGION_TABLE_OFFSET		= REGION_SECTOR_SIZE;	// Offset table follows the header sector
+	static constexpr uint32_t REGION_TABLE_SECTORS		= (REGION_CHUNK_COUNT * 2 * sizeof(uint32_t) + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE;
+	static constexpr uint32_t REGION_FIRST_DATA_SECTOR	= 1 + REGION_TABLE_SECTORS;
+
+	/// @brief Run of identical blocks in encoded chunk data.
+	struct BlockRun
+	{
+		BlockID		block;
+		uint16_t	length; // Chunk volume fits in 16 bits, so a run never needs splitting
+	};
+
+	static_assert(CHUNK_VOLUME <= UINT16_MAX, "Block runs cannot cover a full chunk");
+
+	/// @brief Calculate the number of sectors needed to store a number of bytes.
+	/// @param bytes 
+	/// @return 
+	static uint32_t sectorsFor(size_t bytes)
+	{
+		return static_cast<uint32_t>((bytes + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+	}
+
+	RegionFile::RegionFile(std::string path)
+		:
+		m_path(std::move(path))
+	{
+		//
+	}
+
+	bool RegionFile::readChunkData(uint32_t index, std::vector<uint8_t>& data)
+	{
+		assert(index < REGION_CHUNK_COUNT && "Chunk index out of region bounds");
+
+		if (!loadTable()) {
+			return false;
+		}
+
+		ChunkEntry const& entry = m_entries[index];
+		if (entry.sectorOffset == 0 || !mapFile()) {
+			return false;
+		}
+
+		size_t const offset = static_cast<size_t>(entry.sectorOffset) * REGION_SECTOR_SIZE;
+		if (offset + entry.byteSize > m_file.size())
+		{
+			SPDLOG_ERROR("Region file {} chunk {} points past the end of the file", m_path, index);
+			return false;
+		}
+
+		data.assign(m_file.data() + offset, m_file.data() + offset + entry.byteSize);
+		return true;
+	}
+
+	bool RegionFile::writeChunkData(uint32_t index, std::vector<uint8_t> const& data)
+	{
+		assert(index < REGION_CHUNK_COUNT && "Chunk index out of region bounds");
+		assert(!data.empty() && "Chunk data cannot be empty");
+
+		if (!loadTable()) {
+			return false;
+		}
+
+		// Always write to a new run of sectors, the current run stays allocated until the table entry points away from it
+		ChunkEntry const previous = m_entries[index];
+		uint32_t const sectorCount = sectorsFor(data.size());
+		ChunkEntry const entry{ allocateSectors(sectorCount), static_cast<uint32_t>(data.size()) };
+
+		// The mapping is remapped on the next read, so it also covers the sectors written here
+		m_file.close();
+
+		// Create a region file with an empty offset table first
+		if (!std::filesystem::exists(m_path))
+		{
+			std::vector<uint8_t> emptyFile(static_cast<size_t>(REGION_FIRST_DATA_SECTOR) * REGION_SECTOR_SIZE, 0);
+			Header const header{ REGION_MAGIC, REGION_VERSION, REGION_CHUNK_COUNT, REGION_SECTOR_SIZE };
+			std::memcpy(emptyFile.data(), &header, sizeof(header));
+
+			std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<char const*>(emptyFile.data()), static_cast<std::streamsize>(emptyFile.size()));
+			if (!file)
+			{
+				SPDLOG_ERROR("Failed to create region file {}", m_path);
+				return false;
+			}
+		}
+
+		// Write chunk data padded to whole sectors before its table entry, an interrupted write leaves the old entry & data valid
+		std::fstream file(m_path, std::ios::binary | std::ios::in | std::ios::out);
+		std::vector<uint8_t> const padding(static_cast<size_t>(sectorCount) * REGION_SECTOR_SIZE - data.size(), 0);
+		file.seekp(static_cast<std::streamoff>(entry.sectorOffset) * REGION_SECTOR_SIZE);
+		file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+		file.write(reinterpret_cast<char const*>(padding.data()), static_cast<std::streamsize>(padding.size()));
+		file.seekp(static_cast<std::streamoff>(REGION_TABLE_OFFSET + index * sizeof(ChunkEntry)));
+		file.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+		if (!file)
+		{
+			SPDLOG_ERROR("Failed to write chunk {} to region file {}", index, m_path);
+			return false;
+		}
+
+		// The old run is only reused once the table no longer references it
+		m_entries[index] = entry;
+		if (previous.sectorOffset != 0) {
+			markSectors(previous.sectorOffset, sectorsFor(previous.byteSize), false);
+		}
+
+		markSectors(entry.sectorOffset, sectorCount, true);
+		return true;
+	}
+
+	void RegionFile::encodeChunk(Chunk const& chunk, std::vector<uint8_t>& data)
+	{
+		std::vector<BlockID> blocks(CHUNK_VOLUME);
+		chunk.copyBlocks(blocks.data());
+
+		std::vector<BlockRun> runs{};
+		for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+		{
+			if (!runs.empty() && runs.back().block == blocks[i])
+			{
+				runs.back().length++;
+				continue;
+			}
+
+			runs.push_back(BlockRun{ blocks[i], 1 });
+		}
+
+		// Encoded as a run count followed by the runs
+		uint32_t const runCount = static_cast<uint32_t>(runs.size());
+		data.resize(sizeof(runCount) + runs.size() * sizeof(BlockRun));
+		std::memcpy(data.data(), &runCount, sizeof(runCount));
+		std::memcpy(data.data() + sizeof(runCount), runs.data(), runs.size() * sizeof(BlockRun));
+	}
+
+	bool RegionFile::decodeChunk(std::vector<uint8_t> const& data, Chunk& chunk)
+	{
+		uint32_t runCount = 0;
+		if (data.size() < sizeof(runCount)) {
+			return false;
+		}
+
+		std::memcpy(&runCount, data.data(), sizeof(runCount));
+		if (data.size() != sizeof(runCount) + static_cast<size_t>(runCount) * sizeof(BlockRun)) {
+			return false;
+		}
+
+		std::vector<BlockRun> runs(runCount);
+		std::memcpy(runs.data(), data.data() + sizeof(runCount), runs.size() * sizeof(BlockRun));
+
+		std::vector<BlockID> blocks(CHUNK_VOLUME);
+		uint32_t offset = 0;
+		for (auto const& run : runs)
+		{
+			if (run.length > CHUNK_VOLUME - offset) {
+				return false;
+			}
+
+			std::fill_n(blocks.begin() + offset, run.length, run.block);
+			offset += run.length;
+		}
+
+		if (offset != CHUNK_VOLUME) {
+			return false;
+		}
+
+		chunk.setBlocks(blocks.data());
+		return true;
+	}
+
+	glm::ivec3 RegionFile::toRegionCoord(glm::ivec3 const& coord)
+	{
+		return glm::ivec3(
+			floorDivide(coord.x, REGION_SIZE_XZ),
+			floorDivide(coord.y, REGION_SIZE_Y),
+			floorDivide(coord.z, REGION_SIZE_XZ)
+		);
+	}
+
+	uint32_t RegionFile::toChunkIndex(glm::ivec3 const& coord)
+	{
+		glm::ivec3 const region = toRegionCoord(coord);
+		glm::ivec3 const local = coord - region * glm::ivec3(REGION_SIZE_XZ, REGION_SIZE_Y, REGION_SIZE_XZ);
+		return static_cast<uint32_t>(local.x + local.z * REGION_SIZE_XZ + local.y * REGION_SIZE_XZ * REGION_SIZE_XZ);
+	}
+
+	bool RegionFile::loadTable()
+	{
+		if (m_tableLoaded) {
+			return true;
+		}
+
+		// Region files that do not exist yet start out empty
+		m_entries.assign(REGION_CHUNK_COUNT, ChunkEntry{ 0, 0 });
+		m_usedSectors.assign(REGION_FIRST_DATA_SECTOR, true);
+		if (!std::filesystem::exists(m_path))
+		{
+			m_tableLoaded = true;
+			return true;
+		}
+
+		if (!mapFile()) {
+			return false;
+		}
+
+		Header header{};
+		size_t const tableSize = m_entries.size() * sizeof(ChunkEntry);
+		if (m_file.size() >= REGION_TABLE_OFFSET + tableSize) {
+			std::memcpy(&header, m_file.data(), sizeof(header));
+		}
+
+		if (header.magic != REGION_MAGIC || header.version != REGION_VERSION
+			|| header.chunkCount != REGION_CHUNK_COUNT || header.sectorSize != REGION_SECTOR_SIZE)
+		{
+			SPDLOG_ERROR("Region file {} has an invalid header", m_path);
+			return false;
+		}
+
+		// Rebuild the sector allocation map from the offset table, entries are bounded by the file size first so a corrupt
+		// entry cannot grow the allocation map past the file
+		std::memcpy(m_entries.data(), m_file.data() + REGION_TABLE_OFFSET, tableSize);
+		for (auto& entry : m_entries)
+		{
+			if (entry.sectorOffset == 0) {
+				continue;
+			}
+
+			if (entry.sectorOffset < REGION_FIRST_DATA_SECTOR) {
+				SPDLOG_ERROR("Region file {} has a chunk overlapping its offset table, dropping it", m_path);
+				entry = ChunkEntry{ 0, 0 };
+				continue;
+			}
+
+			if (static_cast<uint64_t>(entry.sectorOffset) * REGION_SECTOR_SIZE + entry.byteSize > m_file.size()) {
+				SPDLOG_ERROR("Region file {} has a chunk pointing past the end of the file, dropping it", m_path);
+				entry = ChunkEntry{ 0, 0 };
+				continue;
+			}
+
+			markSectors(entry.sectorOffset, sectorsFor(entry.byteSize), true);
+		}
+
+		m_tableLoaded = true;
+		return true;
+	}
+
+	bool RegionFile::mapFile()
+	{
+		if (m_file.isOpen()) {
+			return true;
+		}
+
+		if (!m_file.open(m_path))
+		{
+			SPDLOG_ERROR("Failed to map region file {}", m_path);
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32_t RegionFile::allocateSectors(uint32_t sectorCount) const
+	{
+		// First fit, a free run at the end of the allocation map extends past the end of the file
+		uint32_t runStart = REGION_FIRST_DATA_SECTOR;
+		uint32_t runLength = 0;
+		for (uint32_t sector = REGION_FIRST_DATA_SECTOR; sector < m_usedSectors.size(); sector++)
+		{
+			if (m_usedSectors[sector])
+			{
+				runStart = sector + 1;
+				runLength = 0;
+				continue;
+			}
+
+			if (++runLength == sectorCount) {
+				return runStart;
+			}
+		}
+
+		return runStart;
+	}
+
+	void RegionFile::markSectors(uint32_t first, uint32_t count, bool used)
+	{
+		if (first + count > m_usedSectors.size()) {
+			m_usedSectors.resize(first + count, false);
+		}
+
+		std::fill_n(m_usedSectors.begin() + first, count, used);
+	}
+} // namespace world
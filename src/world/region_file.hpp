@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "core/files.hpp"
+#include "chunk.hpp"
+
+namespace world
+{
+	static constexpr int32_t	REGION_SIZE_XZ		= 32;											// Region size in chunks along the x and z axes
+	static constexpr int32_t	REGION_SIZE_Y		= 8;											// Region size in chunks along the y axis
+	static constexpr uint32_t	REGION_CHUNK_COUNT	= REGION_SIZE_XZ * REGION_SIZE_XZ * REGION_SIZE_Y;	// Number of chunks in a region
+	static constexpr uint32_t	REGION_SECTOR_SIZE	= 4096;											// Chunk data is stored in whole sectors
+
+	/// @brief The RegionFile class stores compressed chunk data for a box of chunks in a single file.
+	/// The file starts with a header sector followed by an offset table with an entry per chunk, chunk data is stored in
+	/// runs of sectors after the table. Reads go through a memory mapping, so loading a chunk only touches its own sectors.
+	/// NOTE: Region files are stored in native (little endian) byte order.
+	class RegionFile
+	{
+	public:
+		/// @brief Create a new region file handle, the file itself is created on the first write.
+		/// @param path Region file path.
+		RegionFile(std::string path);
+
+		RegionFile(RegionFile const&) = delete;
+		RegionFile& operator=(RegionFile const&) = delete;
+
+		/// @brief Read the compressed data of a chunk.
+		/// @param index Chunk index in this region.
+		/// @param data Output chunk data.
+		/// @return A boolean indicating the chunk is stored in this region.
+		bool readChunkData(uint32_t index, std::vector<uint8_t>& data);
+
+		/// @brief Write the compressed data of a chunk to a new run of sectors, its current sectors are freed once the write succeeded.
+		/// @param index Chunk index in this region.
+		/// @param data Chunk data.
+		/// @return A boolean indicating success.
+		bool writeChunkData(uint32_t index, std::vector<uint8_t> const& data);
+
+		/// @brief Compress a chunk into run-length encoded block data.
+		/// @param chunk 
+		/// @param data Output chunk data.
+		static void encodeChunk(Chunk const& chunk, std::vector<uint8_t>& data);
+
+		/// @brief Decompress run-length encoded block data into a chunk.
+		/// @param data 
+		/// @param chunk Output chunk.
+		/// @return A boolean indicating the data was valid.
+		static bool decodeChunk(std::vector<uint8_t> const& data, Chunk& chunk);
+
+		/// @brief Convert a chunk coordinate to the coordinate of the region containing it.
+		/// @param coord Chunk coordinate.
+		/// @return 
+		static glm::ivec3 toRegionCoord(glm::ivec3 const& coord);
+
+		/// @brief Convert a chunk coordinate to the index of the chunk in its region.
+		/// @param coord Chunk coordinate.
+		/// @return 
+		static uint32_t toChunkIndex(glm::ivec3 const& coord);
+
+	private:
+		/// @brief Region file header, padded to a full sector.
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t chunkCount;
+			uint32_t sectorSize;
+		};
+
+		/// @brief Offset table entry, chunks that are not stored have a sector offset of 0.
+		struct ChunkEntry
+		{
+			uint32_t sectorOffset;
+			uint32_t byteSize;
+		};
+
+		/// @brief Load the offset table from disk if that has not happened yet.
+		/// @return A boolean indicating the region file is valid or does not exist yet.
+		bool loadTable();
+
+		/// @brief Map the region file for reading if it is not mapped yet.
+		/// @return A boolean indicating success.
+		bool mapFile();
+
+		/// @brief Find a run of free sectors, sectors past the end of the file are always free.
+		/// @param sectorCount 
+		/// @return The first sector of the run.
+		uint32_t allocateSectors(uint32_t sectorCount) const;
+
+		/// @brief Mark a run of sectors as used or free.
+		/// @param first 
+		/// @param count 
+		/// @param used 
+		void markSectors(uint32_t first, uint32_t count, bool used);
+
+	private:
+		std::string				m_path			= {};
+		core::fs::MappedFile	m_file			= {};
+		bool					m_tableLoaded	= false;
+		std::vector<ChunkEntry>	m_entries		= {};
+		std::vector<bool>		m_usedSectors	= {};	// Sector allocation map, grows with the file
+	};
+} // namespace world
@@ -0,0 +1,116 @@
+#include "region_storage.hpp"
+
+#include <cassert>
+#include <filesystem>
+#include <utility>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace world
+{
+	RegionStorage::RegionStorage(std::string directory, size_t maxOpenRegions)
+		:
+		m_directory(std::move(directory)),
+		m_maxOpenRegions(maxOpenRegions)
+	{
+		assert(maxOpenRegions > 0 && "Open region limit cannot be 0");
+
+		std::error_code error{};
+		std::filesystem::create_directories(m_directory, error);
+		if (error) {
+			SPDLOG_ERROR("Failed to create save directory {}: {}", m_directory, error.message());
+		}
+	}
+
+	bool RegionStorage::loadChunk(glm::ivec3 const& coord, Chunk& chunk)
+	{
+		// Only the region lock is held while copying out of the mapping, so page faults do not stall other regions
+		std::vector<uint8_t> data{};
+		{
+			std::shared_ptr<Region> const region = acquireRegion(RegionFile::toRegionCoord(coord));
+			std::lock_guard<std::mutex> guard(region->lock);
+			if (!region->file.readChunkData(RegionFile::toChunkIndex(coord), data)) {
+				return false;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(m_lock);
+			m_stats.chunksLoaded++;
+			m_stats.bytesRead += data.size();
+		}
+
+		if (!RegionFile::decodeChunk(data, chunk))
+		{
+			SPDLOG_ERROR("Chunk ({}, {}, {}) has corrupt region data", coord.x, coord.y, coord.z);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RegionStorage::saveChunk(glm::ivec3 const& coord, Chunk const& chunk)
+	{
+		std::vector<uint8_t> data{};
+		RegionFile::encodeChunk(chunk, data);
+
+		{
+			std::shared_ptr<Region> const region = acquireRegion(RegionFile::toRegionCoord(coord));
+			std::lock_guard<std::mutex> guard(region->lock);
+			if (!region->file.writeChunkData(RegionFile::toChunkIndex(coord), data)) {
+				return false;
+			}
+		}
+
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_stats.chunksSaved++;
+		m_stats.bytesWritten += data.size();
+		return true;
+	}
+
+	RegionStorageStats RegionStorage::stats() const
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		RegionStorageStats stats = m_stats;
+		stats.openRegions = m_regions.size();
+		return stats;
+	}
+
+	std::shared_ptr<RegionStorage::Region> RegionStorage::acquireRegion(glm::ivec3 const& regionCoord)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		auto const it = m_regions.find(regionCoord);
+		if (it != m_regions.end())
+		{
+			it->second->lastUse = ++m_useCounter;
+			return it->second;
+		}
+
+		// Region pointers are only copied under m_lock, so a region referenced by the map alone is not in use & cannot be
+		// acquired while it is closed. Regions in use are skipped, which may exceed the limit until they are released
+		while (m_regions.size() >= m_maxOpenRegions)
+		{
+			auto leastRecent = m_regions.end();
+			for (auto candidate = m_regions.begin(); candidate != m_regions.end(); ++candidate)
+			{
+				if (candidate->second.use_count() == 1 && (leastRecent == m_regions.end() || candidate->second->lastUse < leastRecent->second->lastUse)) {
+					leastRecent = candidate;
+				}
+			}
+
+			if (leastRecent == m_regions.end()) {
+				break;
+			}
+
+			m_regions.erase(leastRecent);
+			m_stats.closedRegions++;
+		}
+
+		std::string const fileName = "r." + std::to_string(regionCoord.x) + "." + std::to_string(regionCoord.y) + "." + std::to_string(regionCoord.z) + ".region";
+		std::string const path = (std::filesystem::path(m_directory) / fileName).string();
+		std::shared_ptr<Region> region = std::make_shared<Region>(path);
+		region->lastUse = ++m_useCounter;
+		m_regions.emplace(regionCoord, region);
+		return region;
+	}
+} // namespace world
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "chunk.hpp"
+#include "region_file.hpp"
+#include "world.hpp"
+
+namespace world
+{
+	/// @brief Region storage counters, accumulated since the storage was created.
+	struct RegionStorageStats
+	{
+		size_t	openRegions		= 0;
+		size_t	closedRegions	= 0;	// Least recently used regions closed to stay within the open region limit
+		size_t	chunksLoaded	= 0;
+		size_t	chunksSaved		= 0;
+		size_t	bytesRead		= 0;	// Compressed chunk bytes read from region files
+		size_t	bytesWritten	= 0;	// Compressed chunk bytes written to region files
+	};
+
+	/// @brief The RegionStorage class loads and saves chunks in region files stored in a save directory.
+	/// Safe to use from multiple threads at once. Every region file has its own lock, so chunks in different regions are read
+	/// & written in parallel, and chunk data is compressed and decompressed outside of any lock. The number of open region
+	/// files is bounded, the least recently used region is closed once the limit is exceeded.
+	class RegionStorage
+	{
+	public:
+		static constexpr size_t DEFAULT_MAX_OPEN_REGIONS = 16;
+
+		/// @brief Create a new region storage, the save directory is created if it does not exist yet.
+		/// @param directory Save directory.
+		/// @param maxOpenRegions Maximum number of region files kept open, regions in use are never closed.
+		RegionStorage(std::string directory, size_t maxOpenRegions = DEFAULT_MAX_OPEN_REGIONS);
+
+		RegionStorage(RegionStorage const&) = delete;
+		RegionStorage& operator=(RegionStorage const&) = delete;
+
+		/// @brief Load a chunk from its region file.
+		/// @param coord Chunk coordinate.
+		/// @param chunk Chunk to store loaded blocks in.
+		/// @return A boolean indicating the chunk was saved before and loaded successfully.
+		bool loadChunk(glm::ivec3 const& coord, Chunk& chunk);
+
+		/// @brief Save a chunk to its region file.
+		/// @param coord Chunk coordinate.
+		/// @param chunk 
+		/// @return A boolean indicating success.
+		bool saveChunk(glm::ivec3 const& coord, Chunk const& chunk);
+
+		/// @brief Retrieve the storage counters.
+		/// @return 
+		RegionStorageStats stats() const;
+
+	private:
+		/// @brief Open region file, reads & writes of its chunks are guarded by its own lock.
+		struct Region
+		{
+			Region(std::string path) : file(std::move(path)) {}
+
+			std::mutex	lock;
+			RegionFile	file;
+			uint64_t	lastUse	= 0;	// Value of m_useCounter when the region was last acquired, guarded by m_lock
+		};
+
+		/// @brief Retrieve the region containing a region coordinate, opening it if needed.
+		/// Opening a region closes the least recently used regions that are not in use, once the open region limit is exceeded.
+		/// @param regionCoord Region coordinate.
+		/// @return The region, kept open for as long as the returned pointer is held.
+		std::shared_ptr<Region> acquireRegion(glm::ivec3 const& regionCoord);
+
+	private:
+		std::string																	m_directory			= {};
+		size_t																		m_maxOpenRegions	= DEFAULT_MAX_OPEN_REGIONS;
+		mutable std::mutex															m_lock				= {};
+		std::unordered_map<glm::ivec3, std::shared_ptr<Region>, ChunkCoordHash>	m_regions			= {};	// Open regions, guarded by m_lock
+		uint64_t																	m_useCounter		= 0;	// Guarded by m_lock
+		RegionStorageStats															m_stats				= {};	// Guarded by m_lock
+	};
+} // namespace world
@@ -0,0 +1,181 @@
+#include "terrain_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace world
+{
+	static constexpr float CONTINENT_AMPLITUDE	= 64.0F;	// Height range of rolling terrain around sea level
+	static constexpr float MOUNTAIN_AMPLITUDE	= 96.0F;	// Height range of ridges added on top of high continents
+	static constexpr float WARP_AMPLITUDE		= 48.0F;	// Maximum domain warp offset in blocks
+
+	// Noise layers, each layer derives its own seed from the world seed
+	static constexpr NoiseParams WARP_NOISE			= { NoiseType::Fbm, 3, 1.0F / 256.0F, 2.0F, 0.5F };
+	static constexpr NoiseParams CONTINENT_NOISE	= { NoiseType::Fbm, 5, 1.0F / 512.0F, 2.0F, 0.5F };
+	static constexpr NoiseParams MOUNTAIN_NOISE		= { NoiseType::Ridged, 4, 1.0F / 192.0F, 2.0F, 0.5F };
+	static constexpr NoiseParams CLIMATE_NOISE		= { NoiseType::Fbm, 3, 1.0F / 1024.0F, 2.0F, 0.5F };
+
+	enum NoiseLayer : uint32_t
+	{
+		NoiseLayerWarpX,
+		NoiseLayerWarpZ,
+		NoiseLayerContinent,
+		NoiseLayerMountain,
+		NoiseLayerTemperature,
+		NoiseLayerMoisture,
+	};
+
+	/// @brief Top and filler blocks used by a biome.
+	struct BiomeBlocks
+	{
+		BlockID top;
+		BlockID filler;
+	};
+
+	/// @brief Retrieve the surface blocks of a biome.
+	/// @param biome 
+	/// @return 
+	static BiomeBlocks biomeBlocks(Biome biome)
+	{
+		switch (biome)
+		{
+		case Biome::Ocean:		return { BLOCK_SAND, BLOCK_SAND };
+		case Biome::Beach:		return { BLOCK_SAND, BLOCK_SAND };
+		case Biome::Plains:		return { BLOCK_GRASS, BLOCK_DIRT };
+		case Biome::Desert:		return { BLOCK_SAND, BLOCK_SAND };
+		case Biome::Mountains:	return { BLOCK_STONE, BLOCK_STONE };
+		case Biome::Tundra:		return { BLOCK_SNOW, BLOCK_DIRT };
+		}
+
+		return { BLOCK_STONE, BLOCK_STONE };
+	}
+
+	TerrainGenerator::TerrainGenerator(uint32_t seed, SimdLevel simdLevel)
+		:
+		m_seed(seed),
+		m_simdLevel(simdLevel)
+	{
+		//
+	}
+
+	void TerrainGenerator::sampleColumns(int32_t originX, int32_t originZ, TerrainColumn* pColumns) const
+	{
+		assert(pColumns != nullptr && "Column output array cannot be a nullptr");
+
+		using Layer = std::array<float, CHUNK_AREA>;
+		Layer x{}, z{}, warpedX{}, warpedZ{}, continent{}, mountain{}, temperature{}, moisture{};
+		for (uint32_t i = 0; i < CHUNK_AREA; i++)
+		{
+			x[i] = static_cast<float>(originX + static_cast<int32_t>(i % CHUNK_SIZE));
+			z[i] = static_cast<float>(originZ + static_cast<int32_t>(i / CHUNK_SIZE));
+		}
+
+		// Domain warp the height layers to break up the regular shapes of the underlying noise
+		fractalNoise(WARP_NOISE, m_seed + NoiseLayerWarpX, x.data(), z.data(), warpedX.data(), CHUNK_AREA, m_simdLevel);
+		fractalNoise(WARP_NOISE, m_seed + NoiseLayerWarpZ, x.data(), z.data(), warpedZ.data(), CHUNK_AREA, m_simdLevel);
+		for (uint32_t i = 0; i < CHUNK_AREA; i++)
+		{
+			warpedX[i] = x[i] + warpedX[i] * WARP_AMPLITUDE;
+			warpedZ[i] = z[i] + warpedZ[i] * WARP_AMPLITUDE;
+		}
+
+		fractalNoise(CONTINENT_NOISE, m_seed + NoiseLayerContinent, warpedX.data(), warpedZ.data(), continent.data(), CHUNK_AREA, m_simdLevel);
+		fractalNoise(MOUNTAIN_NOISE, m_seed + NoiseLayerMountain, warpedX.data(), warpedZ.data(), mountain.data(), CHUNK_AREA, m_simdLevel);
+		fractalNoise(CLIMATE_NOISE, m_seed + NoiseLayerTemperature, x.data(), z.data(), temperature.data(), CHUNK_AREA, m_simdLevel);
+		fractalNoise(CLIMATE_NOISE, m_seed + NoiseLayerMoisture, x.data(), z.data(), moisture.data(), CHUNK_AREA, m_simdLevel);
+
+		for (uint32_t i = 0; i < CHUNK_AREA; i++)
+		{
+			// Ridges only rise from high continents, so coasts and lowlands stay smooth
+			float const mountainMask = std::clamp((continent[i] - 0.05F) * 4.0F, 0.0F, 1.0F);
+			float const ridge = mountain[i] * mountain[i];
+			float const height = static_cast<float>(SEA_LEVEL) + continent[i] * CONTINENT_AMPLITUDE + mountainMask * ridge * MOUNTAIN_AMPLITUDE;
+
+			TerrainColumn& column = pColumns[i];
+			column.height = static_cast<int32_t>(std::floor(height));
+
+			// Temperature drops with altitude
+			float const heat = temperature[i] - static_cast<float>(std::max(column.height - SEA_LEVEL, 0)) / 256.0F;
+			if (column.height < SEA_LEVEL - 2) {
+				column.biome = Biome::Ocean;
+			}
+			else if (column.height <= SEA_LEVEL + 2) {
+				column.biome = Biome::Beach;
+			}
+			else if (mountainMask > 0.5F && column.height > SEA_LEVEL + 48) {
+				column.biome = Biome::Mountains;
+			}
+			else if (heat < -0.25F) {
+				column.biome = Biome::Tundra;
+			}
+			else if (heat > 0.2F && moisture[i] < 0.0F) {
+				column.biome = Biome::Desert;
+			}
+			else {
+				column.biome = Biome::Plains;
+			}
+		}
+	}
+
+	void TerrainGenerator::generate(glm::ivec3 const& coord, Chunk& chunk) const
+	{
+		int32_t const size = static_cast<int32_t>(CHUNK_SIZE);
+		std::array<TerrainColumn, CHUNK_AREA> columns{};
+		sampleColumns(coord.x * size, coord.z * size, columns.data());
+
+		// Chunks entirely above the surface and water, or below all surface layers, are uniform
+		auto const [ minColumn, maxColumn ] = std::minmax_element(columns.begin(), columns.end(),
+			[](TerrainColumn const& a, TerrainColumn const& b) { return a.height < b.height; });
+
+		int32_t const baseY = coord.y * size;
+		if (baseY > std::max(maxColumn->height, SEA_LEVEL))
+		{
+			chunk.fill(BLOCK_AIR);
+			return;
+		}
+
+		if (baseY + size - 1 <= minColumn->height - SURFACE_DEPTH)
+		{
+			chunk.fill(BLOCK_STONE);
+			return;
+		}
+
+		// Resolve column surface blocks once, then write blocks in linear index order
+		std::array<BiomeBlocks, CHUNK_AREA> surfaces{};
+		for (uint32_t i = 0; i < CHUNK_AREA; i++)
+		{
+			surfaces[i] = biomeBlocks(columns[i].biome);
+			if (columns[i].biome == Biome::Mountains && columns[i].height >= SNOW_LINE) {
+				surfaces[i].top = BLOCK_SNOW;
+			}
+		}
+
+		std::vector<BlockID> blocks(CHUNK_VOLUME, BLOCK_AIR);
+		for (uint32_t y = 0; y < CHUNK_SIZE; y++)
+		{
+			int32_t const worldY = baseY + static_cast<int32_t>(y);
+			BlockID* pLayer = &blocks[Chunk::blockIndex(0, y, 0)];
+			for (uint32_t i = 0; i < CHUNK_AREA; i++)
+			{
+				int32_t const height = columns[i].height;
+				if (worldY > height) {
+					pLayer[i] = (worldY <= SEA_LEVEL) ? BLOCK_WATER : BLOCK_AIR;
+				}
+				else if (worldY == height) {
+					pLayer[i] = surfaces[i].top;
+				}
+				else if (worldY > height - SURFACE_DEPTH) {
+					pLayer[i] = surfaces[i].filler;
+				}
+				else {
+					pLayer[i] = BLOCK_STONE;
+				}
+			}
+		}
+
+		chunk.setBlocks(blocks.data());
+	}
+} // namespace world
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "block.hpp"
+#include "chunk.hpp"
+#include "noise.hpp"
+
+namespace world
+{
+	/// @brief Terrain biomes, selected per column from height, temperature and moisture.
+	enum class Biome : uint8_t
+	{
+		Ocean,
+		Beach,
+		Plains,
+		Desert,
+		Mountains,
+		Tundra,
+	};
+
+	/// @brief Terrain surface data of a single block column.
+	struct TerrainColumn
+	{
+		int32_t	height;	// World-space y coordinate of the top solid block
+		Biome	biome;
+	};
+
+	/// @brief The TerrainGenerator class fills chunks from seeded, domain warped fractal noise with biome layering.
+	/// Generation is deterministic for a seed regardless of the SIMD level, and safe to run from multiple threads at once.
+	class TerrainGenerator
+	{
+	public:
+		static constexpr int32_t SEA_LEVEL		= 0;
+		static constexpr int32_t SNOW_LINE		= 96;
+		static constexpr int32_t SURFACE_DEPTH	= 4;	// Number of top / filler blocks above stone
+
+		/// @brief Create a new terrain generator.
+		/// @param seed World seed.
+		/// @param simdLevel SIMD level used to evaluate noise.
+		TerrainGenerator(uint32_t seed, SimdLevel simdLevel = bestSimdLevel());
+
+		/// @brief Sample the surface columns covered by a chunk.
+		/// @param originX World-space x coordinate of the first column.
+		/// @param originZ World-space z coordinate of the first column.
+		/// @param pColumns Output array of CHUNK_AREA columns, indexed as (x + z * CHUNK_SIZE).
+		void sampleColumns(int32_t originX, int32_t originZ, TerrainColumn* pColumns) const;
+
+		/// @brief Generate the blocks of a chunk.
+		/// @param coord Chunk coordinate.
+		/// @param chunk Chunk to store generated blocks in.
+		void generate(glm::ivec3 const& coord, Chunk& chunk) const;
+
+		/// @brief Retrieve the world seed.
+		/// @return 
+		uint32_t seed() const { return m_seed; }
+
+		/// @brief Retrieve the SIMD level used to evaluate noise.
+		/// @return 
+		SimdLevel simdLevel() const { return m_simdLevel; }
+
+	private:
+		uint32_t	m_seed		= 0;
+		SimdLevel	m_simdLevel	= SimdLevel::Scalar;
+	};
+} // namespace world
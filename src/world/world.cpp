@@ -0,0 +1,183 @@
+#include "world.hpp"
+
+#include <cassert>
+
+#include "components/chunk_component.hpp"
+#include "components/transform.hpp"
+
+namespace world
+{
+	World::World(entt::registry& registry)
+		:
+		m_registry(registry)
+	{
+		m_registry.on_destroy<ChunkComponent>().connect<&World::onChunkDestroyed>(this);
+	}
+
+	World::~World()
+	{
+		m_registry.on_destroy<ChunkComponent>().disconnect<&World::onChunkDestroyed>(this);
+	}
+
+	entt::entity World::createChunk(glm::ivec3 const& coord, BlockID fill)
+	{
+		assert(m_chunks.find(coord) == m_chunks.end() && "Chunk already exists at coordinate");
+
+		entt::entity const entity = m_registry.create();
+		m_registry.emplace<ChunkComponent>(entity, ChunkComponent{ coord, Chunk(fill) });
+		m_registry.emplace<Transform>(entity, Transform{ glm::vec3(coord) * static_cast<float>(CHUNK_SIZE) });
+		m_chunks[coord] = entity;
+
+		// Missing chunks already mesh as empty space, so only solid chunks affect their neighbours
+		if (isSolidBlock(fill)) {
+			markNeighborsDirty(coord);
+		}
+
+		return entity;
+	}
+
+	void World::destroyChunk(glm::ivec3 const& coord)
+	{
+		auto const& it = m_chunks.find(coord);
+		if (it == m_chunks.end()) {
+			return;
+		}
+
+		m_registry.destroy(it->second); // Chunk index is updated by destroy signal
+	}
+
+	entt::entity World::findChunk(glm::ivec3 const& coord) const
+	{
+		auto const& it = m_chunks.find(coord);
+		if (it == m_chunks.end()) {
+			return entt::null;
+		}
+
+		return it->second;
+	}
+
+	Chunk* World::getChunk(glm::ivec3 const& coord)
+	{
+		entt::entity const entity = findChunk(coord);
+		if (entity == entt::null) {
+			return nullptr;
+		}
+
+		return &m_registry.get<ChunkComponent>(entity).chunk;
+	}
+
+	Chunk const* World::getChunk(glm::ivec3 const& coord) const
+	{
+		entt::entity const entity = findChunk(coord);
+		if (entity == entt::null) {
+			return nullptr;
+		}
+
+		return &m_registry.get<ChunkComponent>(entity).chunk;
+	}
+
+	ChunkNeighbors World::getNeighbors(glm::ivec3 const& coord) const
+	{
+		return ChunkNeighbors{
+			getChunk(coord + glm::ivec3(1, 0, 0)),
+			getChunk(coord - glm::ivec3(1, 0, 0)),
+			getChunk(coord + glm::ivec3(0, 1, 0)),
+			getChunk(coord - glm::ivec3(0, 1, 0)),
+			getChunk(coord + glm::ivec3(0, 0, 1)),
+			getChunk(coord - glm::ivec3(0, 0, 1)),
+		};
+	}
+
+	BlockID World::getBlock(glm::ivec3 const& position) const
+	{
+		Chunk const* pChunk = getChunk(toChunkCoord(position));
+		if (pChunk == nullptr) {
+			return BLOCK_AIR;
+		}
+
+		glm::uvec3 const local = toLocalCoord(position);
+		return pChunk->getBlock(local.x, local.y, local.z);
+	}
+
+	void World::setBlock(glm::ivec3 const& position, BlockID block)
+	{
+		glm::ivec3 const coord = toChunkCoord(position);
+		entt::entity const entity = findChunk(coord);
+		if (entity == entt::null) {
+			return;
+		}
+
+		glm::uvec3 const local = toLocalCoord(position);
+		ChunkComponent& chunk = m_registry.get<ChunkComponent>(entity);
+		chunk.chunk.setBlock(local.x, local.y, local.z, block);
+		chunk.modified = true;
+		chunk.dirty = true;
+
+		// Border blocks affect face culling in the neighbouring chunk
+		uint32_t const last = CHUNK_SIZE - 1;
+		for (int32_t axis = 0; axis < 3; axis++)
+		{
+			glm::ivec3 offset(0);
+			offset[axis] = 1;
+			if (local[axis] == 0) {
+				markDirty(coord - offset);
+			}
+			else if (local[axis] == last) {
+				markDirty(coord + offset);
+			}
+		}
+	}
+
+	void World::markDirty(glm::ivec3 const& coord)
+	{
+		entt::entity const entity = findChunk(coord);
+		if (entity == entt::null) {
+			return;
+		}
+
+		m_registry.get<ChunkComponent>(entity).dirty = true;
+	}
+
+	size_t World::memoryUsage() const
+	{
+		size_t bytes = 0;
+		for (auto const& [_entity, chunk] : m_registry.view<ChunkComponent>().each()) {
+			bytes += chunk.chunk.memoryUsage();
+		}
+
+		return bytes;
+	}
+
+	glm::ivec3 World::toChunkCoord(glm::ivec3 const& position)
+	{
+		int32_t const size = static_cast<int32_t>(CHUNK_SIZE);
+		return glm::ivec3(
+			floorDivide(position.x, size),
+			floorDivide(position.y, size),
+			floorDivide(position.z, size)
+		);
+	}
+
+	glm::uvec3 World::toLocalCoord(glm::ivec3 const& position)
+	{
+		return glm::uvec3(position - toChunkCoord(position) * static_cast<int32_t>(CHUNK_SIZE));
+	}
+
+	void World::markNeighborsDirty(glm::ivec3 const& coord)
+	{
+		for (int32_t axis = 0; axis < 3; axis++)
+		{
+			glm::ivec3 offset(0);
+			offset[axis] = 1;
+			markDirty(coord + offset);
+			markDirty(coord - offset);
+		}
+	}
+
+	void World::onChunkDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		ChunkComponent const& chunk = registry.get<ChunkComponent>(entity);
+		m_chunks.erase(chunk.coordinate);
+		markNeighborsDirty(chunk.coordinate);
+	}
+} // namespace world
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "block.hpp"
+#include "chunk.hpp"
+
+namespace world
+{
+	/// @brief Hash functor for chunk coordinates.
+	struct ChunkCoordHash
+	{
+		size_t operator()(glm::ivec3 const& coord) const
+		{
+			// Large primes mix each axis into a single hash value
+			return (static_cast<size_t>(coord.x) * 73856093U)
+				^ (static_cast<size_t>(coord.y) * 19349663U)
+				^ (static_cast<size_t>(coord.z) * 83492791U);
+		}
+	};
+
+	/// @brief The World class indexes chunk entities stored in the ECS registry by their chunk coordinate.
+	class World
+	{
+	public:
+		/// @brief Create a new world backed by an ECS registry.
+		/// @param registry Registry that owns all chunk entities.
+		World(entt::registry& registry);
+		~World();
+
+		World(World const&) = delete;
+		World& operator=(World const&) = delete;
+
+		/// @brief Create a new chunk entity, the chunk must not exist yet.
+		/// @param coord Chunk coordinate.
+		/// @param fill Block to initially fill the chunk with.
+		/// @return The created chunk entity.
+		entt::entity createChunk(glm::ivec3 const& coord, BlockID fill = BLOCK_AIR);
+
+		/// @brief Destroy a chunk entity if it exists.
+		/// @param coord Chunk coordinate.
+		void destroyChunk(glm::ivec3 const& coord);
+
+		/// @brief Find the chunk entity at a chunk coordinate.
+		/// @param coord Chunk coordinate.
+		/// @return The chunk entity or entt::null if the chunk does not exist.
+		entt::entity findChunk(glm::ivec3 const& coord) const;
+
+		/// @brief Retrieve the chunk at a chunk coordinate.
+		/// @param coord Chunk coordinate.
+		/// @return A chunk pointer or nullptr if the chunk does not exist.
+		Chunk* getChunk(glm::ivec3 const& coord);
+
+		/// @brief Retrieve the chunk at a chunk coordinate.
+		/// @param coord Chunk coordinate.
+		/// @return A chunk pointer or nullptr if the chunk does not exist.
+		Chunk const* getChunk(glm::ivec3 const& coord) const;
+
+		/// @brief Retrieve the 6 face neighbours of a chunk.
+		/// @param coord Chunk coordinate.
+		/// @return Neighbouring chunks indexed by BlockFace, nullptr for missing chunks.
+		ChunkNeighbors getNeighbors(glm::ivec3 const& coord) const;
+
+		/// @brief Retrieve a block using world-space block coordinates.
+		/// @param position World-space block coordinate.
+		/// @return The block at the given position, or air if its chunk does not exist.
+		BlockID getBlock(glm::ivec3 const& position) const;
+
+		/// @brief Set a block using world-space block coordinates, does nothing if its chunk does not exist.
+		/// Marks the chunk dirty, along with neighbouring chunks when the block lies on a chunk border.
+		/// @param position World-space block coordinate.
+		/// @param block 
+		void setBlock(glm::ivec3 const& position, BlockID block);
+
+		/// @brief Retrieve the number of chunks in this world.
+		/// @return 
+		size_t chunkCount() const { return m_chunks.size(); }
+
+		/// @brief Retrieve the host memory used by all chunk block storage in bytes.
+		/// @return 
+		size_t memoryUsage() const;
+
+		/// @brief Convert a world-space block coordinate to a chunk coordinate.
+		/// @param position 
+		/// @return 
+		static glm::ivec3 toChunkCoord(glm::ivec3 const& position);
+
+		/// @brief Convert a world-space block coordinate to a chunk-local block coordinate.
+		/// @param position 
+		/// @return 
+		static glm::uvec3 toLocalCoord(glm::ivec3 const& position);
+
+		/// @brief Mark a chunk dirty so it gets remeshed, does nothing if the chunk does not exist.
+		/// @param coord Chunk coordinate.
+		void markDirty(glm::ivec3 const& coord);
+
+		/// @brief Mark the 6 face neighbours of a chunk dirty, their border faces depend on this chunk.
+		/// @param coord Chunk coordinate.
+		void markNeighborsDirty(glm::ivec3 const& coord);
+
+	private:
+
+		/// @brief Remove destroyed chunk entities from the chunk index.
+		/// @param registry 
+		/// @param entity 
+		void onChunkDestroyed(entt::registry& registry, entt::entity entity);
+
+	private:
+		entt::registry&													m_registry;
+		std::unordered_map<glm::ivec3, entt::entity, ChunkCoordHash>	m_chunks	= {};
+	};
+} // namespace world
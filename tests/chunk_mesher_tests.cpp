@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <vector>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/chunk_mesher.hpp"
+#include "rendering/vertex_layout.hpp"
+#include "test_utils.hpp"
+
+using namespace world;
+
+static ChunkNeighbors const NO_NEIGHBORS{};
+
+/// @brief Check that every index references an emitted vertex, with 2 triangles per quad.
+/// @param quadCount 
+/// @param vertices 
+/// @param indices 
+/// @return 
+static bool isValidQuadMesh(size_t quadCount, std::vector<gfx::VoxelVertex> const& vertices, std::vector<gfx::IndexType> const& indices)
+{
+	if (vertices.size() != quadCount * 4 || indices.size() != quadCount * 6) {
+		return false;
+	}
+
+	for (gfx::IndexType const index : indices)
+	{
+		if (index >= vertices.size()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// @brief Check that empty chunks & fully enclosed chunks emit no geometry.
+static void testEmptyMeshes()
+{
+	ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+
+	Chunk const air{};
+	TEST_CHECK(mesher.mesh(air, NO_NEIGHBORS, vertices, indices) == 0);
+	TEST_CHECK(vertices.empty() && indices.empty());
+
+	// Solid neighbours hide all border faces of a solid chunk
+	Chunk const stone(BLOCK_STONE);
+	ChunkNeighbors neighbors{};
+	neighbors.fill(&stone);
+	TEST_CHECK(mesher.mesh(stone, neighbors, vertices, indices) == 0);
+	TEST_CHECK(vertices.empty() && indices.empty());
+}
+
+/// @brief Check that a single block emits one quad per face, spanning exactly the block.
+static void testSingleBlock()
+{
+	ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+
+	Chunk chunk{};
+	chunk.setBlock(4, 5, 6, BLOCK_DIRT);
+	size_t const quadCount = mesher.mesh(chunk, NO_NEIGHBORS, vertices, indices);
+	TEST_CHECK(quadCount == BLOCK_FACE_COUNT);
+	TEST_CHECK(isValidQuadMesh(quadCount, vertices, indices));
+
+	uint32_t faceMask = 0;
+	for (gfx::VoxelVertex const& vertex : vertices)
+	{
+		uint32_t const x = vertex.positionFace & 63U;
+		uint32_t const y = (vertex.positionFace >> 6) & 63U;
+		uint32_t const z = (vertex.positionFace >> 12) & 63U;
+		uint32_t const face = (vertex.positionFace >> 18) & 7U;
+		uint32_t const ao = (vertex.positionFace >> 21) & 3U;
+		TEST_CHECK(x >= 4 && x <= 5 && y >= 5 && y <= 6 && z >= 6 && z <= 7);
+		TEST_CHECK(ao == 3);
+		TEST_CHECK(vertex.material == blockTextureLayer(BLOCK_DIRT));
+		faceMask |= 1U << face;
+	}
+
+	TEST_CHECK(faceMask == (1U << BLOCK_FACE_COUNT) - 1);
+}
+
+/// @brief Check that coplanar faces are merged into a single quad per chunk side.
+static void testGreedyMerge()
+{
+	ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+
+	Chunk const stone(BLOCK_STONE);
+	size_t const quadCount = mesher.mesh(stone, NO_NEIGHBORS, vertices, indices);
+	TEST_CHECK(quadCount == BLOCK_FACE_COUNT);
+	TEST_CHECK(isValidQuadMesh(quadCount, vertices, indices));
+
+	// Different blocks are never merged
+	Chunk row{};
+	row.setBlock(0, 0, 0, BLOCK_STONE);
+	row.setBlock(1, 0, 0, BLOCK_STONE);
+	TEST_CHECK(mesher.mesh(row, NO_NEIGHBORS, vertices, indices) == BLOCK_FACE_COUNT);
+
+	row.setBlock(1, 0, 0, BLOCK_SAND);
+	TEST_CHECK(mesher.mesh(row, NO_NEIGHBORS, vertices, indices) == 10);
+}
+
+/// @brief Check that faces touching solid neighbour chunks are culled.
+static void testNeighborCulling()
+{
+	ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+
+	Chunk const stone(BLOCK_STONE);
+	ChunkNeighbors neighbors{};
+	neighbors[static_cast<size_t>(BlockFace::PosX)] = &stone;
+	neighbors[static_cast<size_t>(BlockFace::NegY)] = &stone;
+	TEST_CHECK(mesher.mesh(stone, neighbors, vertices, indices) == BLOCK_FACE_COUNT - 2);
+}
+
+/// @brief Check the worst case input, where no faces can be merged.
+static void testCheckerboard()
+{
+	std::vector<BlockID> blocks(CHUNK_VOLUME, BLOCK_AIR);
+	for (uint32_t y = 0; y < CHUNK_SIZE; y++)
+	{
+		for (uint32_t z = 0; z < CHUNK_SIZE; z++)
+		{
+			for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
+				blocks[Chunk::blockIndex(x, y, z)] = ((x + y + z) % 2 == 0) ? BLOCK_STONE : BLOCK_AIR;
+			}
+		}
+	}
+
+	Chunk chunk{};
+	chunk.setBlocks(blocks.data());
+
+	ChunkMesher mesher{};
+	std::vector<gfx::VoxelVertex> vertices{};
+	std::vector<gfx::IndexType> indices{};
+	size_t const quadCount = mesher.mesh(chunk, NO_NEIGHBORS, vertices, indices);
+	TEST_CHECK(quadCount == (CHUNK_VOLUME / 2) * BLOCK_FACE_COUNT);
+	TEST_CHECK(isValidQuadMesh(quadCount, vertices, indices));
+}
+
+int main()
+{
+	testEmptyMeshes();
+	testSingleBlock();
+	testGreedyMerge();
+	testNeighborCulling();
+	testCheckerboard();
+
+	return test::report("ChunkMesherTests");
+}
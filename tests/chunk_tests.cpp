@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <vector>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "test_utils.hpp"
+
+using namespace world;
+
+/// @brief Check that new chunks are uniform and store no packed indices.
+static void testUniformChunk()
+{
+	Chunk const air{};
+	TEST_CHECK(air.isUniform());
+	TEST_CHECK(air.paletteSize() == 1);
+	TEST_CHECK(air.bitsPerIndex() == 0);
+	TEST_CHECK(air.getBlock(0, 0, 0) == BLOCK_AIR);
+	TEST_CHECK(air.getBlock(CHUNK_SIZE - 1, CHUNK_SIZE - 1, CHUNK_SIZE - 1) == BLOCK_AIR);
+
+	Chunk const stone(BLOCK_STONE);
+	TEST_CHECK(stone.isUniform());
+	TEST_CHECK(stone.getBlock(7, 11, 13) == BLOCK_STONE);
+}
+
+/// @brief Check that the palette index width grows with new blocks and shrinks back once blocks are removed.
+static void testPaletteGrowth()
+{
+	Chunk chunk{};
+	chunk.setBlock(1, 2, 3, BLOCK_STONE);
+	TEST_CHECK(!chunk.isUniform());
+	TEST_CHECK(chunk.paletteSize() == 2);
+	TEST_CHECK(chunk.bitsPerIndex() == 1);
+	TEST_CHECK(chunk.getBlock(1, 2, 3) == BLOCK_STONE);
+	TEST_CHECK(chunk.getBlock(3, 2, 1) == BLOCK_AIR);
+
+	chunk.setBlock(4, 5, 6, BLOCK_DIRT);
+	chunk.setBlock(7, 8, 9, BLOCK_GRASS);
+	TEST_CHECK(chunk.paletteSize() == 4);
+	TEST_CHECK(chunk.bitsPerIndex() == 2);
+
+	chunk.setBlock(10, 11, 12, BLOCK_SAND);
+	TEST_CHECK(chunk.paletteSize() == 5);
+	TEST_CHECK(chunk.bitsPerIndex() == 4);
+
+	// Existing blocks survive repacking
+	TEST_CHECK(chunk.getBlock(1, 2, 3) == BLOCK_STONE);
+	TEST_CHECK(chunk.getBlock(4, 5, 6) == BLOCK_DIRT);
+	TEST_CHECK(chunk.getBlock(7, 8, 9) == BLOCK_GRASS);
+	TEST_CHECK(chunk.getBlock(10, 11, 12) == BLOCK_SAND);
+
+	// Removing every non-air block returns the chunk to uniform storage
+	chunk.setBlock(1, 2, 3, BLOCK_AIR);
+	chunk.setBlock(4, 5, 6, BLOCK_AIR);
+	chunk.setBlock(7, 8, 9, BLOCK_AIR);
+	chunk.setBlock(10, 11, 12, BLOCK_AIR);
+	TEST_CHECK(chunk.isUniform());
+	TEST_CHECK(chunk.paletteSize() == 1);
+	TEST_CHECK(chunk.getBlock(1, 2, 3) == BLOCK_AIR);
+}
+
+/// @brief Check that bulk block writes & reads match per-block access.
+static void testBulkRoundTrip()
+{
+	std::vector<BlockID> blocks(CHUNK_VOLUME, BLOCK_AIR);
+	uint32_t state = 1337;
+	for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+	{
+		state = state * 1664525U + 1013904223U;
+		blocks[i] = static_cast<BlockID>((state >> 16) % (BLOCK_WATER + 1));
+	}
+
+	Chunk chunk{};
+	chunk.setBlocks(blocks.data());
+	TEST_CHECK(chunk.paletteSize() == BLOCK_WATER + 1);
+	TEST_CHECK(chunk.bitsPerIndex() == 4);
+
+	bool matches = true;
+	for (uint32_t y = 0; y < CHUNK_SIZE; y++)
+	{
+		for (uint32_t z = 0; z < CHUNK_SIZE; z++)
+		{
+			for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
+				matches = matches && (chunk.getBlock(x, y, z) == blocks[Chunk::blockIndex(x, y, z)]);
+			}
+		}
+	}
+	TEST_CHECK(matches);
+
+	std::vector<BlockID> copied(CHUNK_VOLUME, BLOCK_AIR);
+	chunk.copyBlocks(copied.data());
+	TEST_CHECK(copied == blocks);
+
+	// Uniform input results in uniform storage
+	std::vector<BlockID> const uniform(CHUNK_VOLUME, BLOCK_STONE);
+	chunk.setBlocks(uniform.data());
+	TEST_CHECK(chunk.isUniform());
+	TEST_CHECK(chunk.getBlock(5, 5, 5) == BLOCK_STONE);
+}
+
+/// @brief Check that uniform chunks use a fraction of the memory of a dense block array.
+static void testMemoryUsage()
+{
+	Chunk chunk(BLOCK_STONE);
+	size_t const uniformUsage = chunk.memoryUsage();
+	TEST_CHECK(uniformUsage < CHUNK_VOLUME * sizeof(BlockID) / 64);
+
+	chunk.setBlock(0, 0, 0, BLOCK_DIRT);
+	TEST_CHECK(chunk.memoryUsage() > uniformUsage);
+	TEST_CHECK(chunk.memoryUsage() < CHUNK_VOLUME * sizeof(BlockID));
+
+	chunk.fill(BLOCK_AIR);
+	TEST_CHECK(chunk.isUniform());
+	TEST_CHECK(chunk.getBlock(0, 0, 0) == BLOCK_AIR);
+}
+
+/// @brief Check that floor division rounds towards negative infinity.
+static void testFloorDivide()
+{
+	TEST_CHECK(floorDivide(0, 32) == 0);
+	TEST_CHECK(floorDivide(31, 32) == 0);
+	TEST_CHECK(floorDivide(32, 32) == 1);
+	TEST_CHECK(floorDivide(-1, 32) == -1);
+	TEST_CHECK(floorDivide(-32, 32) == -1);
+	TEST_CHECK(floorDivide(-33, 32) == -2);
+}
+
+int main()
+{
+	testUniformChunk();
+	testPaletteGrowth();
+	testBulkRoundTrip();
+	testMemoryUsage();
+	testFloorDivide();
+
+	return test::report("ChunkTests");
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "core/frame_arena.hpp"
+#include "core/memory.hpp"
+#include "test_utils.hpp"
+
+using namespace core;
+
+using FrameMap = std::unordered_map<uint32_t, uint32_t, std::hash<uint32_t>, std::equal_to<uint32_t>, FrameAllocator<std::pair<uint32_t const, uint32_t>>>;
+
+/// @brief Build per-frame containers the way the renderer does, all storage comes from the frame arena.
+/// @param arena
+/// @param elementCount
+/// @return A checksum of the container contents.
+static uint64_t buildFrameContainers(FrameArena& arena, uint32_t elementCount)
+{
+	FrameVector<uint32_t> values{ FrameAllocator<uint32_t>(arena) };
+	values.reserve(elementCount);
+	for (uint32_t i = 0; i < elementCount; i++) {
+		values.push_back(i * 3);
+	}
+
+	FrameMap slots(elementCount, std::hash<uint32_t>{}, std::equal_to<uint32_t>{}, FrameAllocator<std::pair<uint32_t const, uint32_t>>(arena));
+	for (uint32_t const value : values) {
+		slots.emplace(value, value + 1);
+	}
+
+	uint64_t checksum = 0;
+	for (auto const& [key, value] : slots) {
+		checksum += static_cast<uint64_t>(key) * value;
+	}
+
+	return checksum;
+}
+
+/// @brief Check that steady state frames do not allocate from the heap once the frame buffers have grown.
+static void testSteadyStateAllocations()
+{
+	uint32_t const elementCount = 4096;
+	FrameArena arena(1024);
+
+	// The first frames overflow & grow both frame buffers to their high water mark
+	uint64_t expected = 0;
+	for (uint32_t frame = 0; frame < 2 * FrameArena::FRAMES_IN_FLIGHT; frame++)
+	{
+		arena.reset();
+		expected = buildFrameContainers(arena, elementCount);
+	}
+
+	size_t const allocationsBefore = heapAllocationCount();
+	bool checksumsMatch = true;
+	size_t overflowAllocations = 0;
+	for (uint32_t frame = 0; frame < 8; frame++)
+	{
+		arena.reset();
+		checksumsMatch &= buildFrameContainers(arena, elementCount) == expected;
+		overflowAllocations += arena.overflowAllocations();
+	}
+
+	size_t const allocationsAfter = heapAllocationCount();
+	TEST_CHECK(allocationsBefore > 0);	// Tracking is enabled, the warm up frames did allocate
+	TEST_CHECK(allocationsAfter == allocationsBefore);
+	TEST_CHECK(overflowAllocations == 0);
+	TEST_CHECK(checksumsMatch);
+}
+
+/// @brief Check that allocations respect their alignment, both in the frame buffer and in heap overflow.
+static void testAlignment()
+{
+	FrameArena arena(4096);
+	for (size_t const alignment : { 1, 2, 4, 8, 16, 64, 256 })
+	{
+		void* pMemory = arena.allocate(3, alignment);
+		TEST_CHECK(reinterpret_cast<uintptr_t>(pMemory) % alignment == 0);
+	}
+
+	// Exceeds the frame buffer, so served from the heap
+	void* pOverflow = arena.allocate(8192, 128);
+	TEST_CHECK(arena.overflowAllocations() == 1);
+	TEST_CHECK(reinterpret_cast<uintptr_t>(pOverflow) % 128 == 0);
+	std::memset(pOverflow, 0xAB, 8192);
+}
+
+/// @brief Check that allocations stay valid for FRAMES_IN_FLIGHT frames, and their memory is reused afterwards.
+static void testDoubleBufferLifetime()
+{
+	static_assert(FrameArena::FRAMES_IN_FLIGHT == 2, "Lifetime test assumes double buffering");
+	FrameArena arena(1024);
+
+	arena.reset();
+	uint8_t* pFirst = static_cast<uint8_t*>(arena.allocate(64, 8));
+	std::memset(pFirst, 0x11, 64);
+
+	arena.reset();
+	uint8_t* pSecond = static_cast<uint8_t*>(arena.allocate(64, 8));
+	std::memset(pSecond, 0x22, 64);
+	TEST_CHECK(pSecond != pFirst);
+
+	bool firstIntact = true;
+	for (size_t i = 0; i < 64; i++) {
+		firstIntact &= pFirst[i] == 0x11;
+	}
+	TEST_CHECK(firstIntact);
+
+	// The first frame buffer is reused two frames later
+	arena.reset();
+	TEST_CHECK(arena.used() == 0);
+	TEST_CHECK(static_cast<uint8_t*>(arena.allocate(64, 8)) == pFirst);
+}
+
+/// @brief Check that overflowing a frame falls back to the heap & grows the frame buffer on its next reuse.
+static void testOverflowFallback()
+{
+	FrameArena arena(256);
+	arena.reset();
+	size_t const capacity = arena.capacity();
+
+	void* pFits = arena.allocate(128, 8);
+	void* pOverflow = arena.allocate(4096, 8);
+	TEST_CHECK(pFits != nullptr && pOverflow != nullptr);
+	TEST_CHECK(arena.overflowAllocations() == 1);
+	TEST_CHECK(arena.used() == 128 + 4096);
+	std::memset(pOverflow, 0xCD, 4096);
+
+	// The other frame buffer is untouched, the overflowing one grows once it is reused
+	arena.reset();
+	TEST_CHECK(arena.capacity() == capacity);
+	arena.reset();
+	TEST_CHECK(arena.capacity() >= 128 + 4096);
+	TEST_CHECK(arena.overflowAllocations() == 0);
+
+	size_t const allocationsBefore = heapAllocationCount();
+	arena.allocate(128, 8);
+	arena.allocate(4096, 8);
+	TEST_CHECK(arena.overflowAllocations() == 0);
+	TEST_CHECK(heapAllocationCount() == allocationsBefore);
+}
+
+int main()
+{
+	testSteadyStateAllocations();
+	testAlignment();
+	testDoubleBufferLifetime();
+	testOverflowFallback();
+
+	return test::report("FrameArenaTests");
+}
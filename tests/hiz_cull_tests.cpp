@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "rendering/occlusion_culling.hpp"
+#include "test_utils.hpp"
+
+using namespace gfx;
+
+static glm::uvec2 const DEPTH_SIZE = { 256, 128 };
+static constexpr float WALL_DISTANCE = 50.0F;
+
+/// @brief Create the projection of a camera at the origin looking down the negative z axis, covering the depth target.
+/// @return
+static glm::mat4 createProjection()
+{
+	return glm::perspective(glm::radians(60.0F), static_cast<float>(DEPTH_SIZE.x) / static_cast<float>(DEPTH_SIZE.y), 0.1F, 100.0F);
+}
+
+/// @brief Calculate the depth target value of a view space distance along the camera axis.
+/// @param project
+/// @param distance
+/// @return
+static float depthAt(glm::mat4 const& project, float distance)
+{
+	glm::vec4 const clip = project * glm::vec4(0.0F, 0.0F, -distance, 1.0F);
+	return clip.z / clip.w;
+}
+
+/// @brief Create a box from its center & half size.
+/// @param center
+/// @param extent
+/// @return
+static AABB createBox(glm::vec3 const& center, float extent)
+{
+	return AABB{ center - glm::vec3(extent), center + glm::vec3(extent) };
+}
+
+/// @brief Check that every pyramid texel holds the farthest depth of the texels it covers, repeating edge values of odd sizes.
+static void testOddSizeReduction()
+{
+	glm::uvec2 const depthSize = { 5, 3 };
+	std::vector<float> depth(depthSize.x * depthSize.y);
+	for (size_t i = 0; i < depth.size(); i++) {
+		depth[i] = static_cast<float>((i * 7) % depth.size()) / static_cast<float>(depth.size());
+	}
+
+	HiZPyramid pyramid{};
+	pyramid.build(depthSize, depth.data());
+	TEST_CHECK(pyramid.levelCount() == 3);
+	TEST_CHECK(HiZPyramid::baseSize(depthSize) == glm::uvec2(3, 2));
+
+	auto const source = [&](uint32_t x, uint32_t y) {
+		return depth[std::min(y, depthSize.y - 1) * depthSize.x + std::min(x, depthSize.x - 1)];
+	};
+
+	bool baseMatches = true;
+	for (uint32_t y = 0; y < 2; y++)
+	{
+		for (uint32_t x = 0; x < 3; x++)
+		{
+			float const expected = std::max(std::max(source(x * 2, y * 2), source(x * 2 + 1, y * 2)),
+				std::max(source(x * 2, y * 2 + 1), source(x * 2 + 1, y * 2 + 1)));
+			baseMatches = baseMatches && (pyramid.texel(0, x, y) == expected);
+		}
+	}
+
+	TEST_CHECK(baseMatches);
+
+	// Level 1 is 2x1, the odd base column is repeated into its second texel
+	TEST_CHECK(pyramid.texel(1, 0, 0) == std::max(std::max(pyramid.texel(0, 0, 0), pyramid.texel(0, 1, 0)), std::max(pyramid.texel(0, 0, 1), pyramid.texel(0, 1, 1))));
+	TEST_CHECK(pyramid.texel(1, 1, 0) == std::max(pyramid.texel(0, 2, 0), pyramid.texel(0, 2, 1)));
+	TEST_CHECK(pyramid.texel(2, 0, 0) == *std::max_element(depth.begin(), depth.end()));
+
+	// A single row reduces along x only
+	std::vector<float> const row = { 0.1F, 0.7F, 0.3F, 0.2F, 0.9F, 0.4F, 0.5F };
+	pyramid.build(glm::uvec2(7, 1), row.data());
+	TEST_CHECK(pyramid.levelCount() == 3);
+	TEST_CHECK(pyramid.texel(0, 0, 0) == 0.7F && pyramid.texel(0, 1, 0) == 0.3F && pyramid.texel(0, 2, 0) == 0.9F && pyramid.texel(0, 3, 0) == 0.5F);
+	TEST_CHECK(pyramid.texel(1, 0, 0) == 0.7F && pyramid.texel(1, 1, 0) == 0.9F);
+	TEST_CHECK(pyramid.texel(2, 0, 0) == 0.9F);
+}
+
+/// @brief Check pyramid level counts, and that boxes are tested against the finest level covering them with 2x2 texels.
+static void testLevelSelection()
+{
+	TEST_CHECK(HiZPyramid::levelCount(glm::uvec2(1, 1)) == 1);
+	TEST_CHECK(HiZPyramid::levelCount(glm::uvec2(2, 2)) == 1);
+	TEST_CHECK(HiZPyramid::levelCount(glm::uvec2(3, 3)) == 2);
+	TEST_CHECK(HiZPyramid::levelCount(DEPTH_SIZE) == 8);
+	TEST_CHECK(HiZPyramid::levelCount(glm::uvec2(1920, 1080)) == 11);
+
+	// The left half of the target holds a wall, the right half is empty, so only levels finer than the top are split
+	glm::mat4 const project = createProjection();
+	std::vector<float> depth(DEPTH_SIZE.x * DEPTH_SIZE.y, 1.0F);
+	for (uint32_t y = 0; y < DEPTH_SIZE.y; y++) {
+		std::fill_n(depth.begin() + y * DEPTH_SIZE.x, DEPTH_SIZE.x / 2, depthAt(project, WALL_DISTANCE));
+	}
+
+	HiZPyramid pyramid{};
+	pyramid.build(DEPTH_SIZE, depth.data());
+	TEST_CHECK(pyramid.texel(pyramid.levelCount() - 1, 0, 0) == 1.0F);
+
+	// Small & medium boxes behind the wall are tested against fine enough levels to stay within the wall
+	TEST_CHECK(pyramid.isOccluded(project, createBox(glm::vec3(-40.0F, 0.0F, -80.0F), 2.0F)));
+	TEST_CHECK(pyramid.isOccluded(project, createBox(glm::vec3(-60.0F, 10.0F, -80.0F), 10.0F)));
+
+	// Boxes reaching into the empty half are kept
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, -80.0F), 2.0F)));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(40.0F, 0.0F, -80.0F), 2.0F)));
+}
+
+/// @brief Check that boxes in front of a depth wall stay visible and boxes behind it are culled.
+static void testDepthWall()
+{
+	glm::mat4 const project = createProjection();
+	std::vector<float> const depth(DEPTH_SIZE.x * DEPTH_SIZE.y, depthAt(project, WALL_DISTANCE));
+
+	HiZPyramid pyramid{};
+	pyramid.build(DEPTH_SIZE, depth.data());
+
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, -20.0F), 2.0F)));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(5.0F, -3.0F, -45.0F), 1.0F)));
+	TEST_CHECK(pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, -80.0F), 2.0F)));
+	TEST_CHECK(pyramid.isOccluded(project, createBox(glm::vec3(-10.0F, 5.0F, -60.0F), 4.0F)));
+
+	// Boxes intersecting the wall have their nearest depth in front of it
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, -WALL_DISTANCE - 1.0F), 2.0F)));
+
+	// An empty pyramid occludes nothing
+	HiZPyramid const empty{};
+	TEST_CHECK(!empty.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, -80.0F), 2.0F)));
+}
+
+/// @brief Check that boxes extending beyond the depth target or crossing the camera plane are never occluded.
+static void testOffscreenAndNearPlane()
+{
+	glm::mat4 const project = createProjection();
+	std::vector<float> const depth(DEPTH_SIZE.x * DEPTH_SIZE.y, depthAt(project, WALL_DISTANCE));
+
+	HiZPyramid pyramid{};
+	pyramid.build(DEPTH_SIZE, depth.data());
+
+	// Half width of the view at 80 units is about 92, half height about 46
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(-92.0F, 0.0F, -80.0F), 4.0F)));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 46.0F, -80.0F), 4.0F)));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(300.0F, 0.0F, -80.0F), 4.0F)));
+
+	// Boxes around or behind the camera
+	TEST_CHECK(!pyramid.isOccluded(project, AABB{ glm::vec3(-1.0F, -1.0F, -80.0F), glm::vec3(1.0F, 1.0F, 5.0F) }));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, 0.0F), 1.0F)));
+	TEST_CHECK(!pyramid.isOccluded(project, createBox(glm::vec3(0.0F, 0.0F, 80.0F), 2.0F)));
+}
+
+/// @brief Check that draws are only culled against the frustum when occlusion culling is disabled.
+static void testFrustumOnly()
+{
+	glm::mat4 const project = createProjection();
+	std::vector<float> const depth(DEPTH_SIZE.x * DEPTH_SIZE.y, depthAt(project, WALL_DISTANCE));
+
+	HiZPyramid pyramid{};
+	pyramid.build(DEPTH_SIZE, depth.data());
+
+	auto const createDraw = [](glm::vec3 const& center, float extent) {
+		return DrawCullData{ center - glm::vec3(extent), 0, center + glm::vec3(extent), 0 };
+	};
+
+	std::vector<DrawCullData> const draws = {
+		createDraw(glm::vec3(0.0F, 0.0F, -20.0F), 2.0F),	// In front of the wall
+		createDraw(glm::vec3(0.0F, 0.0F, -80.0F), 2.0F),	// Behind the wall
+		createDraw(glm::vec3(0.0F, 0.0F, 80.0F), 2.0F),		// Behind the camera
+		createDraw(glm::vec3(300.0F, 0.0F, -80.0F), 2.0F),	// Outside the frustum
+	};
+
+	Frustum const frustum = Frustum::fromMatrix(project);
+	CullParams params{};
+	params.occlusionViewProject = project;
+	std::copy(std::begin(frustum.planes), std::end(frustum.planes), std::begin(params.planes));
+	params.depthSize = DEPTH_SIZE;
+	params.levelCount = pyramid.levelCount();
+	params.drawCount = static_cast<uint32_t>(draws.size());
+
+	std::vector<uint8_t> visible{};
+	params.occlusionEnabled = 0;
+	TEST_CHECK(cullDraws(params, pyramid, draws, visible) == 2);
+	TEST_CHECK(visible == std::vector<uint8_t>({ 1, 1, 0, 0 }));
+
+	params.occlusionEnabled = 1;
+	TEST_CHECK(cullDraws(params, pyramid, draws, visible) == 1);
+	TEST_CHECK(visible == std::vector<uint8_t>({ 1, 0, 0, 0 }));
+}
+
+int main()
+{
+	testOddSizeReduction();
+	testLevelSelection();
+	testDepthWall();
+	testOffscreenAndNearPlane();
+	testFrustumOnly();
+
+	return test::report("HiZCullTests");
+}
@@ -0,0 +1,251 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <webgpu/webgpu.h>
+
+#include "rendering/mesh.hpp"
+#include "rendering/mesh_pool.hpp"
+#include "rendering/upload_manager.hpp"
+#include "systems/renderer.hpp"
+#include "test_utils.hpp"
+
+/// @brief Return code reported to CTest when no adapter is available, registered as the test's skip return code.
+static constexpr int TEST_SKIPPED = 77;
+
+static constexpr uint32_t STATIC_MESH_COUNT = 8;
+static constexpr uint32_t STATIC_MESH_VERTICES = 6999;
+static constexpr uint32_t VOXEL_MESH_COUNT = 2;
+static constexpr uint32_t VOXEL_MESH_VERTICES = 1200;
+
+/// @brief Headless device along with the instance & adapter it was created from.
+struct HeadlessDevice
+{
+	WGPUInstance	instance	= nullptr;
+	WGPUAdapter		adapter		= nullptr;
+	WGPUDevice		device		= nullptr;
+	WGPUQueue		queue		= nullptr;
+};
+
+/// @brief Create a device without a surface, native adapter & device requests complete before returning.
+/// @return The headless device, with a null device if no adapter is available.
+static HeadlessDevice createHeadlessDevice()
+{
+	HeadlessDevice headless{};
+	headless.instance = wgpuCreateInstance(nullptr);
+	if (!headless.instance) {
+		return headless;
+	}
+
+	WGPURequestAdapterOptions adapterOptions{};
+	adapterOptions.nextInChain = nullptr;
+	adapterOptions.compatibleSurface = nullptr;
+	adapterOptions.powerPreference = WGPUPowerPreference_Undefined;
+	wgpuInstanceRequestAdapter(headless.instance, &adapterOptions, [](WGPURequestAdapterStatus status, WGPUAdapter adapter, char const*, void* pUserData) {
+		if (status == WGPURequestAdapterStatus_Success) {
+			*static_cast<WGPUAdapter*>(pUserData) = adapter;
+		}
+	}, &headless.adapter);
+
+	if (!headless.adapter) {
+		return headless;
+	}
+
+	WGPUDeviceDescriptor deviceDesc{};
+	deviceDesc.nextInChain = nullptr;
+	deviceDesc.label = "Indirect Args Test Device";
+	wgpuAdapterRequestDevice(headless.adapter, &deviceDesc, [](WGPURequestDeviceStatus status, WGPUDevice device, char const*, void* pUserData) {
+		if (status == WGPURequestDeviceStatus_Success) {
+			*static_cast<WGPUDevice*>(pUserData) = device;
+		}
+	}, &headless.device);
+
+	if (headless.device) {
+		headless.queue = wgpuDeviceGetQueue(headless.device);
+	}
+
+	return headless;
+}
+
+/// @brief Release a headless device.
+/// @param headless
+static void releaseHeadlessDevice(HeadlessDevice& headless)
+{
+	if (headless.queue) wgpuQueueRelease(headless.queue);
+	if (headless.device) wgpuDeviceRelease(headless.device);
+	if (headless.adapter) wgpuAdapterRelease(headless.adapter);
+	if (headless.instance) wgpuInstanceRelease(headless.instance);
+	headless = HeadlessDevice{};
+}
+
+/// @brief Compare two sets of draw arguments field by field.
+/// @param a
+/// @param b
+/// @return
+static bool sameArgs(DrawIndexedIndirectArgs const& a, DrawIndexedIndirectArgs const& b)
+{
+	return a.indexCount == b.indexCount && a.instanceCount == b.instanceCount && a.firstIndex == b.firstIndex
+		&& a.baseVertex == b.baseVertex && a.firstInstance == b.firstInstance;
+}
+
+/// @brief Create a static mesh with a triangle list index buffer covering all of its vertices.
+/// @param vertexCount Number of vertices, a multiple of 3.
+/// @return
+static std::shared_ptr<gfx::Mesh> createStaticMesh(uint32_t vertexCount)
+{
+	std::vector<gfx::IndexType> indices(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; i++) {
+		indices[i] = i;
+	}
+
+	return std::make_shared<gfx::Mesh>(std::vector<gfx::Vertex>(vertexCount, gfx::Vertex{}), std::move(indices));
+}
+
+/// @brief Create a voxel mesh with a triangle list index buffer covering all of its vertices.
+/// @param vertexCount Number of vertices, a multiple of 3.
+/// @return
+static std::shared_ptr<gfx::Mesh> createVoxelMesh(uint32_t vertexCount)
+{
+	std::vector<gfx::IndexType> indices(vertexCount);
+	for (uint32_t i = 0; i < vertexCount; i++) {
+		indices[i] = i;
+	}
+
+	return std::make_shared<gfx::Mesh>(std::vector<gfx::VoxelVertex>(vertexCount, gfx::VoxelVertex{}), std::move(indices));
+}
+
+/// @brief Check that direct draw arguments map the mesh range & instance batch onto the DrawIndexed parameters.
+static void testDirectDrawArgs()
+{
+	gfx::MeshRange range{};
+	range.layout = gfx::VertexLayout::Voxel;
+	range.vertexOffset = 4096;
+	range.vertexCount = 600;
+	range.indexOffset = 12288;
+	range.indexCount = 900;
+
+	DrawIndexedIndirectArgs const args = directDrawArgs(range, 17, 5);
+	TEST_CHECK(args.indexCount == 900);
+	TEST_CHECK(args.instanceCount == 5);
+	TEST_CHECK(args.firstIndex == 12288);
+	TEST_CHECK(args.baseVertex == 4096);
+	TEST_CHECK(args.firstInstance == 17);
+}
+
+/// @brief Check that draw arguments of several meshes & instance batches follow their pool ranges through a compaction,
+/// and that arguments written before the compaction are reported as stale for every moved mesh.
+/// @param headless
+static void testPoolCompaction(HeadlessDevice const& headless)
+{
+	auto pool = std::make_shared<gfx::MeshPool>(headless.device);
+	gfx::UploadManager uploadManager(headless.device, headless.queue);
+	uploadManager.beginFrame();
+
+	std::vector<DrawCommand> commands;
+	uint32_t firstInstance = 0;
+	auto const addCommand = [&](std::shared_ptr<gfx::Mesh> mesh, uint32_t instanceCount) {
+		mesh->setDeviceAllocation(pool->upload(uploadManager, *mesh));
+		commands.push_back(DrawCommand{ 0, 0, firstInstance, instanceCount, mesh->bounds(), std::move(mesh) });
+		firstInstance += instanceCount;
+	};
+
+	for (uint32_t i = 0; i < STATIC_MESH_COUNT; i++) {
+		addCommand(createStaticMesh(STATIC_MESH_VERTICES), 1 + (i % 4) * 3);
+	}
+
+	for (uint32_t i = 0; i < VOXEL_MESH_COUNT; i++) {
+		addCommand(createVoxelMesh(VOXEL_MESH_VERTICES), 2 + i);
+	}
+
+	// Static meshes are packed back to back, indices of all meshes share one buffer
+	std::vector<DrawIndexedIndirectArgs> written;
+	uint32_t expectedFirstInstance = 0;
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		DrawCommand const& command = commands[i];
+		DrawIndexedIndirectArgs const args = directDrawArgs(command.mesh->deviceAllocation()->range(), command.firstInstance, command.instanceCount);
+		TEST_CHECK(args.indexCount == command.mesh->indexCount());
+		TEST_CHECK(args.firstInstance == expectedFirstInstance && args.instanceCount == command.instanceCount);
+		TEST_CHECK(args.firstIndex == i * STATIC_MESH_VERTICES || i >= STATIC_MESH_COUNT);
+		TEST_CHECK(args.baseVertex == static_cast<int32_t>(i * STATIC_MESH_VERTICES) || i >= STATIC_MESH_COUNT);
+
+		written.push_back(args);
+		expectedFirstInstance += command.instanceCount;
+	}
+
+	// Releasing every other static mesh leaves holes smaller than the next upload, which forces a compaction
+	std::vector<DrawCommand> survivors;
+	std::vector<DrawIndexedIndirectArgs> survivorArgs;
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		if (i < STATIC_MESH_COUNT && i % 2 == 0)
+		{
+			commands[i].mesh->releaseDeviceAllocation();
+			continue;
+		}
+
+		survivors.push_back(commands[i]);
+		survivorArgs.push_back(written[i]);
+	}
+
+	size_t const compactions = pool->stats().compactions;
+	addCommand(createStaticMesh(STATIC_MESH_VERTICES * 3), 6);
+	TEST_CHECK(pool->stats().compactions == compactions + 1);
+
+	// Compaction keeps the order of live static ranges, voxel vertices & indices live in other buffers and stay put
+	size_t staleArgs = 0;
+	int32_t expectedBaseVertex = 0;
+	for (size_t i = 0; i < survivors.size(); i++)
+	{
+		DrawCommand const& command = survivors[i];
+		gfx::MeshRange const& range = command.mesh->deviceAllocation()->range();
+		DrawIndexedIndirectArgs const args = directDrawArgs(range, command.firstInstance, command.instanceCount);
+		TEST_CHECK(args.indexCount == survivorArgs[i].indexCount && args.firstIndex == survivorArgs[i].firstIndex);
+		TEST_CHECK(args.instanceCount == survivorArgs[i].instanceCount && args.firstInstance == survivorArgs[i].firstInstance);
+
+		if (range.layout == gfx::VertexLayout::Static)
+		{
+			TEST_CHECK(args.baseVertex == expectedBaseVertex);
+			expectedBaseVertex += static_cast<int32_t>(range.vertexCount);
+		}
+		else
+		{
+			TEST_CHECK(args.baseVertex == survivorArgs[i].baseVertex);
+		}
+
+		if (!sameArgs(args, survivorArgs[i])) {
+			staleArgs++;
+		}
+	}
+
+	// Every surviving static mesh moved, so arguments written before the upload no longer match any of them
+	TEST_CHECK(staleArgs == STATIC_MESH_COUNT / 2);
+
+	DrawCommand const& grown = commands.back();
+	DrawIndexedIndirectArgs const grownArgs = directDrawArgs(grown.mesh->deviceAllocation()->range(), grown.firstInstance, grown.instanceCount);
+	TEST_CHECK(grownArgs.baseVertex == expectedBaseVertex);
+	TEST_CHECK(grownArgs.indexCount == STATIC_MESH_VERTICES * 3);
+	TEST_CHECK(grownArgs.firstInstance == expectedFirstInstance && grownArgs.instanceCount == 6);
+
+	uploadManager.submit();
+	commands.clear();
+	survivors.clear();
+}
+
+int main()
+{
+	testDirectDrawArgs();
+
+	HeadlessDevice headless = createHeadlessDevice();
+	if (!headless.device)
+	{
+		std::printf("IndirectArgsTests: no adapter available, skipping mesh pool checks\n");
+		releaseHeadlessDevice(headless);
+		return (test::failureCount() > 0) ? test::report("IndirectArgsTests") : TEST_SKIPPED;
+	}
+
+	testPoolCompaction(headless);
+	releaseHeadlessDevice(headless);
+
+	return test::report("IndirectArgsTests");
+}
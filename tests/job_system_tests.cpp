@@ -0,0 +1,129 @@
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "core/job_system.hpp"
+#include "test_utils.hpp"
+
+using namespace core;
+
+/// @brief Check that all jobs run before waiting on their counter returns.
+/// @param workerCount 
+static void testRunAndWait(uint32_t workerCount)
+{
+	JobSystem jobSystem(workerCount);
+	TEST_CHECK(jobSystem.workerCount() == workerCount);
+
+	std::atomic<uint32_t> executed = 0;
+	JobCounter counter{};
+	for (uint32_t i = 0; i < 1'000; i++) {
+		jobSystem.run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+	}
+
+	jobSystem.wait(counter);
+	TEST_CHECK(counter.isDone());
+	TEST_CHECK(counter.pending() == 0);
+	TEST_CHECK(executed.load() == 1'000);
+}
+
+/// @brief Check that queued jobs can be executed manually when there are no worker threads.
+static void testExecutePending()
+{
+	JobSystem jobSystem(0);
+
+	uint32_t executed = 0;
+	JobCounter counter{};
+	for (uint32_t i = 0; i < 10; i++) {
+		jobSystem.run([&executed]() { executed++; }, &counter);
+	}
+
+	TEST_CHECK(counter.pending() == 10);
+	TEST_CHECK(jobSystem.executePending(4) == 4);
+	TEST_CHECK(executed == 4);
+	TEST_CHECK(jobSystem.executePending(100) == 6);
+	TEST_CHECK(executed == 10);
+	TEST_CHECK(counter.isDone());
+}
+
+/// @brief Check that continuations only start once their dependency completed.
+/// @param workerCount 
+static void testRunAfter(uint32_t workerCount)
+{
+	JobSystem jobSystem(workerCount);
+
+	std::atomic<uint32_t> executed = 0;
+	std::atomic<uint32_t> observed = 0;
+	JobCounter dependency{};
+	JobCounter counter{};
+	for (uint32_t i = 0; i < 64; i++) {
+		jobSystem.run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &dependency);
+	}
+
+	jobSystem.runAfter(dependency, [&executed, &observed]() { observed = executed.load(); }, &counter);
+	jobSystem.wait(counter);
+	TEST_CHECK(dependency.isDone());
+	TEST_CHECK(observed.load() == 64);
+
+	// Continuations of completed counters run right away
+	bool ran = false;
+	JobCounter lateCounter{};
+	jobSystem.runAfter(dependency, [&ran]() { ran = true; }, &lateCounter);
+	jobSystem.wait(lateCounter);
+	TEST_CHECK(ran);
+}
+
+/// @brief Check that jobs spawned from jobs are tracked by the counter they are scheduled with.
+/// @param workerCount 
+static void testNestedJobs(uint32_t workerCount)
+{
+	JobSystem jobSystem(workerCount);
+
+	std::atomic<uint32_t> executed = 0;
+	JobCounter counter{};
+	for (uint32_t i = 0; i < 16; i++)
+	{
+		jobSystem.run([&jobSystem, &executed, &counter]() {
+			for (uint32_t j = 0; j < 16; j++) {
+				jobSystem.run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+		}, &counter);
+	}
+
+	jobSystem.wait(counter);
+	TEST_CHECK(executed.load() == 16 * 16);
+}
+
+/// @brief Check that parallel for visits every index exactly once, including partial batches.
+/// @param workerCount 
+static void testParallelFor(uint32_t workerCount)
+{
+	JobSystem jobSystem(workerCount);
+
+	std::vector<std::atomic<uint32_t>> visits(1'003);
+	jobSystem.parallelFor(visits.size(), 64, [&visits](size_t i) { visits[i].fetch_add(1, std::memory_order_relaxed); });
+
+	bool visitedOnce = true;
+	for (std::atomic<uint32_t> const& count : visits) {
+		visitedOnce = visitedOnce && (count.load() == 1);
+	}
+	TEST_CHECK(visitedOnce);
+
+	// Empty ranges return immediately
+	jobSystem.parallelFor(0, 64, [&visitedOnce](size_t) { visitedOnce = false; });
+	TEST_CHECK(visitedOnce);
+}
+
+int main()
+{
+	for (uint32_t const workerCount : { 0U, 1U, 4U })
+	{
+		testRunAndWait(workerCount);
+		testRunAfter(workerCount);
+		testNestedJobs(workerCount);
+		testParallelFor(workerCount);
+	}
+
+	testExecutePending();
+
+	return test::report("JobSystemTests");
+}
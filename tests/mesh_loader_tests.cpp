@@ -0,0 +1,255 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "assets/mesh_loader.hpp"
+#include "test_utils.hpp"
+
+using namespace assets;
+
+static constexpr uint32_t TRIANGLE_BUFFER_SIZE = 150;	// 3 vertices with position, normal, tangent & texcoord, 3 u16 indices
+static constexpr gfx::IndexType TAMPERED_INDEX = 0;		// Last index of a tampered baked mesh, the source mesh ends with 2
+
+/// @brief Encode binary data as base64, for embedding buffers in glTF data URIs.
+/// @param data
+/// @return
+static std::string encodeBase64(std::vector<uint8_t> const& data)
+{
+	static char const* const ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string encoded{};
+	for (size_t i = 0; i < data.size(); i += 3)
+	{
+		uint32_t const remaining = static_cast<uint32_t>(data.size() - i);
+		uint32_t const bits = (static_cast<uint32_t>(data[i]) << 16)
+			| ((remaining > 1) ? static_cast<uint32_t>(data[i + 1]) << 8 : 0U)
+			| ((remaining > 2) ? static_cast<uint32_t>(data[i + 2]) : 0U);
+
+		encoded += ALPHABET[(bits >> 18) & 63];
+		encoded += ALPHABET[(bits >> 12) & 63];
+		encoded += (remaining > 1) ? ALPHABET[(bits >> 6) & 63] : '=';
+		encoded += (remaining > 2) ? ALPHABET[bits & 63] : '=';
+	}
+
+	return encoded;
+}
+
+/// @brief Create a glTF file holding a single indexed triangle, with its buffer embedded as a data URI.
+/// @param padding Number of trailing newlines, changes the file size without changing the mesh.
+/// @return
+static std::string createTriangleGLTF(size_t padding)
+{
+	float const attributes[] = {
+		0.0F, 0.0F, 0.0F,	1.0F, 0.0F, 0.0F,	0.0F, 1.0F, 0.0F,				// Positions
+		0.0F, 0.0F, 1.0F,	0.0F, 0.0F, 1.0F,	0.0F, 0.0F, 1.0F,				// Normals
+		1.0F, 0.0F, 0.0F, 1.0F,	1.0F, 0.0F, 0.0F, 1.0F,	1.0F, 0.0F, 0.0F, 1.0F,	// Tangents
+		0.0F, 0.0F,	1.0F, 0.0F,	0.0F, 1.0F,										// Texcoords
+	};
+	uint16_t const indices[] = { 0, 1, 2 };
+
+	std::vector<uint8_t> buffer(TRIANGLE_BUFFER_SIZE);
+	std::memcpy(buffer.data(), attributes, sizeof(attributes));
+	std::memcpy(buffer.data() + sizeof(attributes), indices, sizeof(indices));
+
+	return std::string("{\"asset\":{\"version\":\"2.0\"},")
+		+ "\"buffers\":[{\"byteLength\":" + std::to_string(TRIANGLE_BUFFER_SIZE)
+		+ ",\"uri\":\"data:application/octet-stream;base64," + encodeBase64(buffer) + "\"}],"
+		+ "\"bufferViews\":["
+		+ "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},"
+		+ "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":36},"
+		+ "{\"buffer\":0,\"byteOffset\":72,\"byteLength\":48},"
+		+ "{\"buffer\":0,\"byteOffset\":120,\"byteLength\":24},"
+		+ "{\"buffer\":0,\"byteOffset\":144,\"byteLength\":6}],"
+		+ "\"accessors\":["
+		+ "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\",\"min\":[0,0,0],\"max\":[1,1,0]},"
+		+ "{\"bufferView\":1,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+		+ "{\"bufferView\":2,\"componentType\":5126,\"count\":3,\"type\":\"VEC4\"},"
+		+ "{\"bufferView\":3,\"componentType\":5126,\"count\":3,\"type\":\"VEC2\"},"
+		+ "{\"bufferView\":4,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+		+ "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TANGENT\":2,\"TEXCOORD_0\":3},\"indices\":4,\"mode\":4}]}]}"
+		+ std::string(padding, '\n');
+}
+
+/// @brief Write a file, keeping its modification time if it already exists.
+/// @param path
+/// @param contents
+/// @param keepTime Restore the previous modification time after writing.
+static void writeFile(std::filesystem::path const& path, std::string const& contents, bool keepTime)
+{
+	std::filesystem::file_time_type const modifiedTime = keepTime ? std::filesystem::last_write_time(path) : std::filesystem::file_time_type{};
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+	}
+
+	if (keepTime) {
+		std::filesystem::last_write_time(path, modifiedTime);
+	}
+}
+
+/// @brief Read a whole file.
+/// @param path
+/// @return
+static std::string readFile(std::filesystem::path const& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// @brief Overwrite the last index of a baked mesh, so loads using the bake can be told apart from loads parsing the source.
+/// Baked meshes end with their index data.
+/// @param bakedPath
+static void tamperBakedIndex(std::filesystem::path const& bakedPath)
+{
+	std::string baked = readFile(bakedPath);
+	std::memcpy(&baked[baked.size() - sizeof(gfx::IndexType)], &TAMPERED_INDEX, sizeof(gfx::IndexType));
+	writeFile(bakedPath, baked, true);
+}
+
+/// @brief Check if a loaded mesh was read from a tampered baked mesh.
+/// @param mesh
+/// @return
+static bool isTampered(std::shared_ptr<gfx::Mesh> const& mesh)
+{
+	return mesh && mesh->indices().size() == 3 && mesh->indices()[2] == TAMPERED_INDEX;
+}
+
+/// @brief Check if a loaded mesh holds the source triangle.
+/// @param mesh
+/// @return
+static bool isSourceTriangle(std::shared_ptr<gfx::Mesh> const& mesh)
+{
+	return mesh && mesh->vertexCount() == 3 && mesh->indices().size() == 3
+		&& mesh->indices()[0] == 0 && mesh->indices()[1] == 1 && mesh->indices()[2] == 2;
+}
+
+/// @brief Test fixture writing a source mesh into a clean temporary directory.
+struct SourceMesh
+{
+	std::filesystem::path	directory;
+	std::filesystem::path	path;
+	std::filesystem::path	bakedPath;
+
+	explicit SourceMesh(char const* name)
+		:
+		directory(std::filesystem::temp_directory_path() / "voxel_game_mesh_loader_tests" / name),
+		path(directory / "triangle.gltf"),
+		bakedPath(directory / (std::string("triangle.gltf") + MeshLoader::BAKED_MESH_EXTENSION))
+	{
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		writeFile(path, createTriangleGLTF(1), false);
+	}
+
+	~SourceMesh()
+	{
+		std::error_code error{};
+		std::filesystem::remove_all(directory, error);
+	}
+};
+
+/// @brief Check that the first load bakes the mesh, and that later loads of an unchanged source use the bake.
+static void testBakeReuse()
+{
+	SourceMesh source("reuse");
+	MeshLoader loader{};
+
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(std::filesystem::exists(source.bakedPath));
+
+	tamperBakedIndex(source.bakedPath);
+	TEST_CHECK(isTampered(loader.load(source.path.string())));
+}
+
+/// @brief Check that a source size change rebakes the mesh, even if its modification time is unchanged.
+static void testSizeChangeRebakes()
+{
+	SourceMesh source("size");
+	MeshLoader loader{};
+
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	tamperBakedIndex(source.bakedPath);
+
+	writeFile(source.path, createTriangleGLTF(2), true);
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+}
+
+/// @brief Check that a touched source with unchanged contents keeps & restamps the bake, while changed contents of the
+/// same size rebake the mesh.
+static void testTouchedSource()
+{
+	SourceMesh source("touched");
+	MeshLoader loader{};
+
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	tamperBakedIndex(source.bakedPath);
+
+	// Matching contents keep the bake
+	std::filesystem::file_time_type const touchedTime = std::filesystem::last_write_time(source.path) + std::chrono::seconds(10);
+	std::filesystem::last_write_time(source.path, touchedTime);
+	TEST_CHECK(isTampered(loader.load(source.path.string())));
+
+	// The bake now stores the touched time, so a source edit hidden behind that time is not hashed
+	std::string edited = readFile(source.path);
+	edited.back() = ' ';
+	writeFile(source.path, edited, true);
+	TEST_CHECK(isTampered(loader.load(source.path.string())));
+
+	// Touching the edited source hashes it again, the changed contents rebake the mesh
+	std::filesystem::last_write_time(source.path, touchedTime + std::chrono::seconds(10));
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+}
+
+/// @brief Check that baked meshes with a corrupted header or size are rejected & rebaked.
+static void testCorruptBake()
+{
+	SourceMesh source("corrupt");
+	MeshLoader loader{};
+
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	std::string const baked = readFile(source.bakedPath);
+
+	// Invalid magic
+	std::string corrupted = baked;
+	corrupted[0] = static_cast<char>(~corrupted[0]);
+	writeFile(source.bakedPath, corrupted, true);
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(readFile(source.bakedPath) == baked);
+
+	// Header cut short
+	writeFile(source.bakedPath, baked.substr(0, 20), true);
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(readFile(source.bakedPath) == baked);
+
+	// Index data cut short
+	writeFile(source.bakedPath, baked.substr(0, baked.size() - sizeof(gfx::IndexType)), true);
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(readFile(source.bakedPath) == baked);
+
+	// Trailing data
+	writeFile(source.bakedPath, baked + std::string(sizeof(gfx::IndexType), '\0'), true);
+	TEST_CHECK(isSourceTriangle(loader.load(source.path.string())));
+	TEST_CHECK(readFile(source.bakedPath) == baked);
+
+	// A missing source fails the load, even with a valid bake next to it
+	std::filesystem::remove(source.path);
+	TEST_CHECK(loader.load(source.path.string()) == nullptr);
+}
+
+int main()
+{
+	testBakeReuse();
+	testSizeChangeRebakes();
+	testTouchedSource();
+	testCorruptBake();
+
+	return test::report("MeshLoaderTests");
+}
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "rendering/occlusion_rasterizer.hpp"
+#include "test_utils.hpp"
+
+using namespace gfx;
+
+/// @brief Create a view projection mapping x & y to pixel coordinates and z to depth, so boxes can be placed on pixels.
+/// @return
+static glm::mat4 createScreenProjection()
+{
+	glm::mat4 viewproject(1.0F);
+	viewproject[0][0] = 2.0F / static_cast<float>(OcclusionRasterizer::WIDTH);
+	viewproject[1][1] = -2.0F / static_cast<float>(OcclusionRasterizer::HEIGHT);
+	viewproject[3][0] = -1.0F;
+	viewproject[3][1] = 1.0F;
+	return viewproject;
+}
+
+/// @brief Create a box from pixel & depth ranges.
+/// @param xMin
+/// @param xMax
+/// @param yMin
+/// @param yMax
+/// @param zMin
+/// @param zMax
+/// @return
+static AABB createScreenBox(float xMin, float xMax, float yMin, float yMax, float zMin, float zMax)
+{
+	return AABB{ glm::vec3(xMin, yMin, zMin), glm::vec3(xMax, yMax, zMax) };
+}
+
+/// @brief Check that boxes entirely behind an occluder are hidden, including behind adjacent occluders.
+static void testHidden()
+{
+	OcclusionRasterizer rasterizer{};
+	rasterizer.begin(createScreenProjection());
+	TEST_CHECK(rasterizer.rasterizeOccluder(createScreenBox(64.0F, 128.0F, 32.0F, 96.0F, 0.3F, 0.4F)));
+	TEST_CHECK(rasterizer.rasterizeOccluder(createScreenBox(128.0F, 192.0F, 32.0F, 96.0F, 0.3F, 0.4F)));
+
+	// Front faces are stored, the nearest depth is kept
+	TEST_CHECK(std::fabs(rasterizer.depth()[64 * OcclusionRasterizer::WIDTH + 100] - 0.3F) < 1e-5F);
+	TEST_CHECK(rasterizer.depth()[0] == 1.0F);
+
+	TEST_CHECK(rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+	TEST_CHECK(rasterizer.isOccluded(createScreenBox(70.0F, 90.0F, 40.0F, 88.0F, 0.45F, 0.5F)));
+
+	// Occluders sharing an edge leave no gap between them
+	TEST_CHECK(rasterizer.isOccluded(createScreenBox(120.0F, 136.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+}
+
+/// @brief Check that boxes in front of or beside the occluders stay visible.
+static void testVisible()
+{
+	OcclusionRasterizer rasterizer{};
+	rasterizer.begin(createScreenProjection());
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+
+	TEST_CHECK(rasterizer.rasterizeOccluder(createScreenBox(64.0F, 192.0F, 32.0F, 96.0F, 0.3F, 0.4F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 50.0F, 60.0F, 0.1F, 0.2F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 50.0F, 60.0F, 0.25F, 0.7F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(10.0F, 30.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 100.0F, 120.0F, 0.6F, 0.7F)));
+
+	// Beginning a new view clears the depth buffer
+	rasterizer.begin(createScreenProjection());
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.0F, 120.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+}
+
+/// @brief Check that boxes only partly behind an occluder stay visible, also when the visible part is smaller than a pixel.
+static void testPartiallyVisible()
+{
+	OcclusionRasterizer rasterizer{};
+	rasterizer.begin(createScreenProjection());
+	TEST_CHECK(rasterizer.rasterizeOccluder(createScreenBox(64.0F, 100.7F, 32.3F, 96.0F, 0.3F, 0.4F)));
+
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(90.0F, 110.0F, 50.0F, 60.0F, 0.6F, 0.7F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(80.0F, 90.0F, 90.0F, 100.0F, 0.6F, 0.7F)));
+
+	// Column 100 & row 32 are covered as their centers lie inside the occluder, boxes beyond its edges share those pixels
+	TEST_CHECK(std::fabs(rasterizer.depth()[64 * OcclusionRasterizer::WIDTH + 100] - 0.3F) < 1e-5F);
+	TEST_CHECK(std::fabs(rasterizer.depth()[32 * OcclusionRasterizer::WIDTH + 80] - 0.3F) < 1e-5F);
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(100.75F, 100.95F, 50.0F, 60.0F, 0.6F, 0.7F)));
+	TEST_CHECK(!rasterizer.isOccluded(createScreenBox(80.0F, 90.0F, 32.05F, 32.25F, 0.6F, 0.7F)));
+}
+
+/// @brief Check that boxes crossing the camera plane are never occluded, and are not rasterized as occluders.
+static void testNearPlane()
+{
+	// Camera at the origin looking down the negative z axis
+	float const aspect = static_cast<float>(OcclusionRasterizer::WIDTH) / static_cast<float>(OcclusionRasterizer::HEIGHT);
+	glm::mat4 const project = glm::perspective(glm::radians(60.0F), aspect, 0.1F, 500.0F);
+
+	OcclusionRasterizer rasterizer{};
+	rasterizer.begin(project);
+	TEST_CHECK(rasterizer.rasterizeOccluder(AABB{ glm::vec3(-40.0F, -20.0F, -40.0F), glm::vec3(40.0F, 20.0F, -30.0F) }));
+	TEST_CHECK(rasterizer.isOccluded(AABB{ glm::vec3(-2.0F, -2.0F, -82.0F), glm::vec3(2.0F, 2.0F, -78.0F) }));
+	TEST_CHECK(!rasterizer.isOccluded(AABB{ glm::vec3(-2.0F, -2.0F, -22.0F), glm::vec3(2.0F, 2.0F, -18.0F) }));
+
+	// Boxes reaching behind the camera
+	TEST_CHECK(!rasterizer.isOccluded(AABB{ glm::vec3(-2.0F, -2.0F, -80.0F), glm::vec3(2.0F, 2.0F, 1.0F) }));
+	TEST_CHECK(!rasterizer.isOccluded(AABB{ glm::vec3(-2.0F, -2.0F, -0.05F), glm::vec3(2.0F, 2.0F, 0.05F) }));
+
+	// Occluders crossing the camera plane are skipped, so they hide nothing
+	rasterizer.begin(project);
+	TEST_CHECK(!rasterizer.rasterizeOccluder(AABB{ glm::vec3(-40.0F, -20.0F, -40.0F), glm::vec3(40.0F, 20.0F, 5.0F) }));
+	TEST_CHECK(!rasterizer.isOccluded(AABB{ glm::vec3(-2.0F, -2.0F, -82.0F), glm::vec3(2.0F, 2.0F, -78.0F) }));
+}
+
+int main()
+{
+	testHidden();
+	testVisible();
+	testPartiallyVisible();
+	testNearPlane();
+
+	return test::report("OcclusionRasterizerTests");
+}
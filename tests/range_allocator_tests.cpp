@@ -0,0 +1,168 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/range_allocator.hpp"
+#include "test_utils.hpp"
+
+using namespace core;
+
+/// @brief Check that ranges are handed out back to back and allocation fails once the address space is full.
+static void testAllocate()
+{
+	RangeAllocator allocator(100);
+	TEST_CHECK(allocator.capacity() == 100);
+	TEST_CHECK(allocator.allocate(10) == 0);
+	TEST_CHECK(allocator.allocate(20) == 10);
+	TEST_CHECK(allocator.allocate(30) == 30);
+	TEST_CHECK(allocator.used() == 60);
+	TEST_CHECK(allocator.allocationCount() == 3);
+	TEST_CHECK(allocator.largestFreeRange() == 40);
+
+	TEST_CHECK(allocator.allocate(41) == RangeAllocator::INVALID_OFFSET);
+	TEST_CHECK(allocator.allocate(40) == 60);
+	TEST_CHECK(allocator.freeRangeCount() == 0);
+	TEST_CHECK(allocator.allocate(1) == RangeAllocator::INVALID_OFFSET);
+
+	RangeAllocator empty(0);
+	TEST_CHECK(empty.allocate(1) == RangeAllocator::INVALID_OFFSET);
+}
+
+/// @brief Check that released ranges are merged with their free neighbours.
+static void testCoalesce()
+{
+	RangeAllocator allocator(100);
+	uint64_t const a = allocator.allocate(10);
+	uint64_t const b = allocator.allocate(10);
+	uint64_t const c = allocator.allocate(10);
+
+	allocator.free(a);
+	TEST_CHECK(allocator.freeRangeCount() == 2);
+
+	// Merges with the free tail
+	allocator.free(c);
+	TEST_CHECK(allocator.freeRangeCount() == 2);
+	TEST_CHECK(allocator.largestFreeRange() == 80);
+
+	// Merges with free ranges on both sides
+	allocator.free(b);
+	TEST_CHECK(allocator.freeRangeCount() == 1);
+	TEST_CHECK(allocator.largestFreeRange() == 100);
+	TEST_CHECK(allocator.used() == 0);
+	TEST_CHECK(allocator.allocationCount() == 0);
+	TEST_CHECK(allocator.fragmentation() == 0.0F);
+}
+
+/// @brief Check that allocations use the smallest fitting free range, and fragmentation is reported against it.
+static void testBestFit()
+{
+	RangeAllocator allocator(100);
+	uint64_t const a = allocator.allocate(10);
+	allocator.allocate(5);
+	uint64_t const c = allocator.allocate(20);
+	allocator.allocate(5);
+
+	// Free ranges: [0, 10), [15, 35) and [40, 100)
+	allocator.free(a);
+	allocator.free(c);
+	TEST_CHECK(allocator.freeRangeCount() == 3);
+	TEST_CHECK(std::fabs(allocator.fragmentation() - 30.0F / 90.0F) < 1e-5F);
+
+	TEST_CHECK(allocator.allocate(8) == 0);
+	TEST_CHECK(allocator.allocate(18) == 15);
+	TEST_CHECK(allocator.allocate(30) == 40);
+	TEST_CHECK(allocator.allocate(2) == 8);
+}
+
+/// @brief Check that compaction packs live ranges in offset order, reporting a move per range.
+static void testCompact()
+{
+	RangeAllocator allocator(100);
+	uint64_t const a = allocator.allocate(10);
+	uint64_t const b = allocator.allocate(20);
+	uint64_t const c = allocator.allocate(30);
+	uint64_t const d = allocator.allocate(15);
+	allocator.free(a);
+	allocator.free(c);
+	TEST_CHECK(allocator.fragmentation() > 0.0F);
+
+	std::vector<RangeMove> moves{};
+	allocator.compact(100, moves);
+	TEST_CHECK(moves.size() == 2);
+	TEST_CHECK(moves[0].from == b && moves[0].to == 0 && moves[0].size == 20);
+	TEST_CHECK(moves[1].from == d && moves[1].to == 20 && moves[1].size == 15);
+	TEST_CHECK(allocator.used() == 35);
+	TEST_CHECK(allocator.freeRangeCount() == 1);
+	TEST_CHECK(allocator.largestFreeRange() == 65);
+	TEST_CHECK(allocator.fragmentation() == 0.0F);
+
+	// Moved ranges are released at their new offsets
+	allocator.free(0);
+	TEST_CHECK(allocator.used() == 15);
+	TEST_CHECK(allocator.allocate(20) == 0);
+
+	// Compaction can also grow the address space
+	allocator.compact(200, moves);
+	TEST_CHECK(allocator.capacity() == 200);
+	TEST_CHECK(allocator.largestFreeRange() == 200 - allocator.used());
+	for (RangeMove const& move : moves) {
+		TEST_CHECK(move.to <= move.from);
+	}
+}
+
+/// @brief Check allocator invariants under random churn with compaction.
+static void testChurn()
+{
+	RangeAllocator allocator(4096);
+	std::vector<uint64_t> live{};
+	std::vector<RangeMove> moves{};
+	uint32_t state = 1337;
+	bool consistent = true;
+	for (uint32_t i = 0; i < 10'000; i++)
+	{
+		state = state * 1664525U + 1013904223U;
+		if (!live.empty() && (state >> 16) % 2 == 0)
+		{
+			size_t const victim = (state >> 8) % live.size();
+			allocator.free(live[victim]);
+			live[victim] = live.back();
+			live.pop_back();
+			continue;
+		}
+
+		uint64_t const size = 1 + (state >> 20) % 64;
+		uint64_t offset = allocator.allocate(size);
+		if (offset == RangeAllocator::INVALID_OFFSET && allocator.capacity() - allocator.used() >= size)
+		{
+			allocator.compact(allocator.capacity(), moves);
+			for (uint64_t& liveOffset : live)
+			{
+				for (RangeMove const& move : moves) {
+					liveOffset = (move.from == liveOffset) ? move.to : liveOffset;
+				}
+			}
+
+			offset = allocator.allocate(size);
+			consistent = consistent && (offset != RangeAllocator::INVALID_OFFSET);
+		}
+
+		if (offset != RangeAllocator::INVALID_OFFSET) {
+			live.push_back(offset);
+		}
+
+		consistent = consistent && (allocator.allocationCount() == live.size()) && (allocator.used() <= allocator.capacity());
+	}
+
+	TEST_CHECK(consistent);
+}
+
+int main()
+{
+	testAllocate();
+	testCoalesce();
+	testBestFit();
+	testCompact();
+	testChurn();
+
+	return test::report("RangeAllocatorTests");
+}
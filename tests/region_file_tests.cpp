@@ -0,0 +1,294 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/region_file.hpp"
+#include "world/region_storage.hpp"
+#include "test_utils.hpp"
+
+using namespace world;
+
+/// @brief Check if two chunks store the same blocks.
+/// @param lhs 
+/// @param rhs 
+/// @return 
+static bool sameBlocks(Chunk const& lhs, Chunk const& rhs)
+{
+	std::vector<BlockID> lhsBlocks(CHUNK_VOLUME);
+	std::vector<BlockID> rhsBlocks(CHUNK_VOLUME);
+	lhs.copyBlocks(lhsBlocks.data());
+	rhs.copyBlocks(rhsBlocks.data());
+	return lhsBlocks == rhsBlocks;
+}
+
+/// @brief Create a chunk with layered terrain-like blocks & some random noise.
+/// @param seed 
+/// @return 
+static Chunk makeChunk(uint32_t seed)
+{
+	std::vector<BlockID> blocks(CHUNK_VOLUME, BLOCK_AIR);
+	uint32_t state = seed;
+	for (uint32_t i = 0; i < CHUNK_VOLUME; i++)
+	{
+		state = state * 1664525U + 1013904223U;
+		uint32_t const y = i / CHUNK_AREA;
+		blocks[i] = (y < 12) ? BLOCK_STONE : (y < 16) ? BLOCK_DIRT : BLOCK_AIR;
+		if ((state >> 16) % 13 == 0) {
+			blocks[i] = static_cast<BlockID>((state >> 8) % (BLOCK_WATER + 1));
+		}
+	}
+
+	Chunk chunk{};
+	chunk.setBlocks(blocks.data());
+	return chunk;
+}
+
+/// @brief Check that chunks survive encoding & decoding, and that invalid data is rejected.
+static void testEncodeDecode()
+{
+	std::vector<uint8_t> data{};
+	for (Chunk const& chunk : { Chunk{}, Chunk(BLOCK_STONE), makeChunk(1), makeChunk(2) })
+	{
+		RegionFile::encodeChunk(chunk, data);
+
+		Chunk decoded(BLOCK_SAND);
+		TEST_CHECK(RegionFile::decodeChunk(data, decoded));
+		TEST_CHECK(sameBlocks(chunk, decoded));
+	}
+
+	// Uniform chunks encode to a single run
+	RegionFile::encodeChunk(Chunk(BLOCK_STONE), data);
+	TEST_CHECK(data.size() == sizeof(uint32_t) + 2 * sizeof(uint16_t));
+
+	Chunk decoded{};
+	TEST_CHECK(!RegionFile::decodeChunk({}, decoded));
+
+	RegionFile::encodeChunk(makeChunk(3), data);
+	data.pop_back();
+	TEST_CHECK(!RegionFile::decodeChunk(data, decoded));
+
+	// Runs must cover the chunk exactly
+	std::vector<uint8_t> const shortRuns{ 1, 0, 0, 0, BLOCK_STONE, 0, 1, 0 };
+	TEST_CHECK(!RegionFile::decodeChunk(shortRuns, decoded));
+}
+
+/// @brief Check region coordinates & chunk indices, including negative chunk coordinates.
+static void testCoordinates()
+{
+	TEST_CHECK(RegionFile::toRegionCoord(glm::ivec3(0, 0, 0)) == glm::ivec3(0, 0, 0));
+	TEST_CHECK(RegionFile::toRegionCoord(glm::ivec3(31, 7, 31)) == glm::ivec3(0, 0, 0));
+	TEST_CHECK(RegionFile::toRegionCoord(glm::ivec3(32, 8, -1)) == glm::ivec3(1, 1, -1));
+	TEST_CHECK(RegionFile::toRegionCoord(glm::ivec3(-33, -9, -32)) == glm::ivec3(-2, -2, -1));
+
+	TEST_CHECK(RegionFile::toChunkIndex(glm::ivec3(0, 0, 0)) == 0);
+	TEST_CHECK(RegionFile::toChunkIndex(glm::ivec3(-1, -1, -1)) == REGION_CHUNK_COUNT - 1);
+	TEST_CHECK(RegionFile::toChunkIndex(glm::ivec3(1, 0, 0)) == 1);
+	TEST_CHECK(RegionFile::toChunkIndex(glm::ivec3(0, 0, 1)) == REGION_SIZE_XZ);
+	TEST_CHECK(RegionFile::toChunkIndex(glm::ivec3(0, 1, 0)) == REGION_SIZE_XZ * REGION_SIZE_XZ);
+}
+
+/// @brief Check that chunk data round-trips through a region file, also after reopening it.
+/// @param directory Scratch directory.
+static void testReadWrite(std::filesystem::path const& directory)
+{
+	std::string const path = (directory / "r.0.0.0.region").string();
+	std::vector<uint8_t> small{};
+	std::vector<uint8_t> large{};
+	RegionFile::encodeChunk(Chunk(BLOCK_STONE), small);
+	RegionFile::encodeChunk(makeChunk(4), large);
+	TEST_CHECK(large.size() > REGION_SECTOR_SIZE);
+
+	std::vector<uint8_t> data{};
+	{
+		RegionFile region(path);
+		TEST_CHECK(!region.readChunkData(0, data));
+		TEST_CHECK(!std::filesystem::exists(path));
+
+		TEST_CHECK(region.writeChunkData(0, small));
+		TEST_CHECK(region.writeChunkData(REGION_CHUNK_COUNT - 1, large));
+		TEST_CHECK(region.readChunkData(0, data) && data == small);
+		TEST_CHECK(region.readChunkData(REGION_CHUNK_COUNT - 1, data) && data == large);
+		TEST_CHECK(!region.readChunkData(1, data));
+
+		// Growing & shrinking chunk data keeps its neighbours intact
+		TEST_CHECK(region.writeChunkData(0, large));
+		TEST_CHECK(region.readChunkData(0, data) && data == large);
+		TEST_CHECK(region.writeChunkData(0, small));
+		TEST_CHECK(region.readChunkData(0, data) && data == small);
+		TEST_CHECK(region.readChunkData(REGION_CHUNK_COUNT - 1, data) && data == large);
+	}
+
+	{
+		RegionFile region(path);
+		TEST_CHECK(region.readChunkData(0, data) && data == small);
+		TEST_CHECK(region.readChunkData(REGION_CHUNK_COUNT - 1, data) && data == large);
+
+		Chunk decoded{};
+		TEST_CHECK(RegionFile::decodeChunk(data, decoded) && sameBlocks(decoded, makeChunk(4)));
+	}
+}
+
+/// @brief Check that rewriting chunks reuses freed sectors instead of growing the file.
+/// @param directory Scratch directory.
+static void testSectorReuse(std::filesystem::path const& directory)
+{
+	std::string const path = (directory / "r.1.0.0.region").string();
+	std::vector<uint8_t> small{};
+	std::vector<uint8_t> large{};
+	RegionFile::encodeChunk(Chunk(BLOCK_DIRT), small);
+	RegionFile::encodeChunk(makeChunk(5), large);
+
+	RegionFile region(path);
+	TEST_CHECK(region.writeChunkData(0, large));
+	TEST_CHECK(region.writeChunkData(1, large));
+
+	uintmax_t maxFileSize = 0;
+	for (uint32_t i = 0; i < 64; i++)
+	{
+		TEST_CHECK(region.writeChunkData(i % 2, (i % 3 == 0) ? small : large));
+		maxFileSize = std::max(maxFileSize, std::filesystem::file_size(path));
+	}
+
+	// Only the run being written is allocated on top of the live chunks, so two chunks never need more than three runs
+	uintmax_t const largeBytes = (large.size() + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE * REGION_SECTOR_SIZE;
+	uintmax_t const tableBytes = REGION_SECTOR_SIZE + (REGION_CHUNK_COUNT * 8 + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE * REGION_SECTOR_SIZE;
+	TEST_CHECK(maxFileSize <= tableBytes + 3 * largeBytes);
+
+	std::vector<uint8_t> data{};
+	TEST_CHECK(region.readChunkData(0, data) && data == large);
+	TEST_CHECK(region.readChunkData(1, data) && data == small);
+}
+
+/// @brief Check that offset table entries pointing past the end of the file are dropped instead of marking sectors.
+/// @param directory Scratch directory.
+static void testCorruptTable(std::filesystem::path const& directory)
+{
+	std::string const path = (directory / "r.2.0.0.region").string();
+	std::vector<uint8_t> small{};
+	RegionFile::encodeChunk(Chunk(BLOCK_SAND), small);
+	{
+		RegionFile region(path);
+		TEST_CHECK(region.writeChunkData(0, small));
+	}
+
+	// Entries are stored as (sector offset, byte size) pairs following the header sector
+	{
+		uint32_t const farEntry[] = { 0x7FFFFFFFU, 64 };
+		uint32_t const longEntry[] = { 0x00000100U, 0xFFFFFFFFU };
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(REGION_SECTOR_SIZE + 1 * sizeof(farEntry));
+		file.write(reinterpret_cast<char const*>(farEntry), sizeof(farEntry));
+		file.seekp(REGION_SECTOR_SIZE + 2 * sizeof(longEntry));
+		file.write(reinterpret_cast<char const*>(longEntry), sizeof(longEntry));
+		TEST_CHECK(static_cast<bool>(file));
+	}
+
+	uintmax_t const fileSize = std::filesystem::file_size(path);
+	std::vector<uint8_t> data{};
+	RegionFile region(path);
+	TEST_CHECK(!region.readChunkData(1, data));
+	TEST_CHECK(!region.readChunkData(2, data));
+	TEST_CHECK(region.readChunkData(0, data) && data == small);
+
+	// New chunks are allocated right after the live data, not after the corrupt entries
+	TEST_CHECK(region.writeChunkData(3, small));
+	TEST_CHECK(region.readChunkData(3, data) && data == small);
+	TEST_CHECK(std::filesystem::file_size(path) <= fileSize + REGION_SECTOR_SIZE);
+}
+
+/// @brief Check that region storage closes least recently used regions beyond its limit, without losing chunks.
+/// @param directory Scratch directory.
+static void testStorageEviction(std::filesystem::path const& directory)
+{
+	world::RegionStorage storage((directory / "storage").string(), 2);
+	glm::ivec3 const coords[] = {
+		glm::ivec3(0, 0, 0),
+		glm::ivec3(REGION_SIZE_XZ, 0, 0),
+		glm::ivec3(0, REGION_SIZE_Y, 0),
+		glm::ivec3(-1, -1, -1),
+		glm::ivec3(5 * REGION_SIZE_XZ + 3, 1, -7 * REGION_SIZE_XZ + 2),
+	};
+
+	for (uint32_t i = 0; i < std::size(coords); i++)
+	{
+		TEST_CHECK(storage.saveChunk(coords[i], makeChunk(100 + i)));
+		TEST_CHECK(storage.stats().openRegions <= 2);
+	}
+
+	TEST_CHECK(storage.stats().closedRegions == std::size(coords) - 2);
+	for (uint32_t i = 0; i < std::size(coords); i++)
+	{
+		Chunk loaded{};
+		TEST_CHECK(storage.loadChunk(coords[i], loaded) && sameBlocks(loaded, makeChunk(100 + i)));
+		TEST_CHECK(storage.stats().openRegions <= 2);
+	}
+
+	Chunk missing{};
+	TEST_CHECK(!storage.loadChunk(coords[0] + glm::ivec3(1, 0, 0), missing));
+}
+
+/// @brief Check that concurrent loads & saves across more regions than the open region limit keep all chunks intact.
+/// @param directory Scratch directory.
+static void testStorageConcurrency(std::filesystem::path const& directory)
+{
+	uint32_t const threadCount = 4;
+	uint32_t const chunksPerThread = 24;
+	world::RegionStorage storage((directory / "concurrent").string(), 2);
+
+	auto const chunkCoord = [](uint32_t thread, uint32_t i) {
+		return glm::ivec3(static_cast<int32_t>(i % 3) * REGION_SIZE_XZ + static_cast<int32_t>(thread), 0, static_cast<int32_t>(i));
+	};
+
+	std::vector<std::thread> threads{};
+	std::vector<int> failures(threadCount, 0);
+	for (uint32_t thread = 0; thread < threadCount; thread++)
+	{
+		threads.emplace_back([&, thread]() {
+			for (uint32_t i = 0; i < chunksPerThread; i++)
+			{
+				Chunk const chunk(static_cast<BlockID>(1 + (thread + i) % BLOCK_WATER));
+				Chunk loaded{};
+				failures[thread] += !storage.saveChunk(chunkCoord(thread, i), chunk);
+				failures[thread] += !storage.loadChunk(chunkCoord(thread, i), loaded) || !sameBlocks(loaded, chunk);
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (uint32_t thread = 0; thread < threadCount; thread++)
+	{
+		TEST_CHECK(failures[thread] == 0);
+		for (uint32_t i = 0; i < chunksPerThread; i++)
+		{
+			Chunk loaded{};
+			TEST_CHECK(storage.loadChunk(chunkCoord(thread, i), loaded) && sameBlocks(loaded, Chunk(static_cast<BlockID>(1 + (thread + i) % BLOCK_WATER))));
+		}
+	}
+}
+
+int main()
+{
+	std::filesystem::path const directory = std::filesystem::temp_directory_path() / "voxel_game_region_tests";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	testEncodeDecode();
+	testCoordinates();
+	testReadWrite(directory);
+	testSectorReuse(directory);
+	testCorruptTable(directory);
+	testStorageEviction(directory);
+	testStorageConcurrency(directory);
+
+	std::filesystem::remove_all(directory);
+	return test::report("RegionFileTests");
+}
@@ -0,0 +1,134 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/noise.hpp"
+#include "world/terrain_generator.hpp"
+#include "test_utils.hpp"
+
+using namespace world;
+
+static constexpr uint32_t WORLD_SEED = 1337;
+
+/// @brief Retrieve all SIMD levels available in this build, up to the best level.
+/// @return
+static std::vector<SimdLevel> simdLevels()
+{
+	std::vector<SimdLevel> levels{};
+	for (SimdLevel const level : { SimdLevel::SSE2, SimdLevel::AVX2 })
+	{
+		if (level <= bestSimdLevel()) {
+			levels.push_back(level);
+		}
+	}
+
+	return levels;
+}
+
+/// @brief Check that SIMD noise evaluation is bit-identical to scalar evaluation, including batch remainders,
+/// negative coordinates and coordinates far from the origin.
+static void testNoiseDeterminism()
+{
+	size_t const count = 1027;
+	std::vector<float> x(count), y(count);
+	uint32_t state = WORLD_SEED;
+	for (size_t i = 0; i < count; i++)
+	{
+		state = state * 1664525U + 1013904223U;
+		x[i] = (static_cast<float>(state >> 8) / 16777216.0F - 0.5F) * 200000.0F;
+		state = state * 1664525U + 1013904223U;
+		y[i] = (static_cast<float>(state >> 8) / 16777216.0F - 0.5F) * 200000.0F;
+	}
+
+	for (NoiseType const type : { NoiseType::Fbm, NoiseType::Ridged })
+	{
+		NoiseParams params{};
+		params.type = type;
+		params.octaves = 6;
+
+		std::vector<float> scalar(count);
+		fractalNoise(params, WORLD_SEED, x.data(), y.data(), scalar.data(), count, SimdLevel::Scalar);
+		for (SimdLevel const level : simdLevels())
+		{
+			std::vector<float> simd(count);
+			fractalNoise(params, WORLD_SEED, x.data(), y.data(), simd.data(), count, level);
+			TEST_CHECK(std::memcmp(scalar.data(), simd.data(), count * sizeof(float)) == 0);
+		}
+	}
+}
+
+/// @brief Check that generated column heights, biomes & blocks are identical for the scalar & SIMD generators.
+static void testTerrainDeterminism()
+{
+	TerrainGenerator const scalarGenerator(WORLD_SEED, SimdLevel::Scalar);
+	for (SimdLevel const level : simdLevels())
+	{
+		TerrainGenerator const simdGenerator(WORLD_SEED, level);
+		for (int32_t const cx : { -37, -1, 0, 5, 1021 })
+		{
+			for (int32_t const cz : { -512, -2, 0, 3, 77 })
+			{
+				int32_t const size = static_cast<int32_t>(CHUNK_SIZE);
+				std::array<TerrainColumn, CHUNK_AREA> scalarColumns{}, simdColumns{};
+				scalarGenerator.sampleColumns(cx * size, cz * size, scalarColumns.data());
+				simdGenerator.sampleColumns(cx * size, cz * size, simdColumns.data());
+
+				bool columnsMatch = true;
+				for (size_t i = 0; i < CHUNK_AREA; i++) {
+					columnsMatch &= scalarColumns[i].height == simdColumns[i].height && scalarColumns[i].biome == simdColumns[i].biome;
+				}
+				TEST_CHECK(columnsMatch);
+
+				// Chunks around the surface hold the most varied blocks
+				for (int32_t cy = -2; cy <= 4; cy++)
+				{
+					Chunk scalarChunk{}, simdChunk{};
+					scalarGenerator.generate(glm::ivec3(cx, cy, cz), scalarChunk);
+					simdGenerator.generate(glm::ivec3(cx, cy, cz), simdChunk);
+
+					std::vector<BlockID> scalarBlocks(CHUNK_VOLUME), simdBlocks(CHUNK_VOLUME);
+					scalarChunk.copyBlocks(scalarBlocks.data());
+					simdChunk.copyBlocks(simdBlocks.data());
+					TEST_CHECK(scalarBlocks == simdBlocks);
+				}
+			}
+		}
+	}
+}
+
+/// @brief Check that generation only depends on the seed, not on generator instances.
+static void testSeedDeterminism()
+{
+	TerrainGenerator const first(WORLD_SEED);
+	TerrainGenerator const second(WORLD_SEED);
+	TerrainGenerator const other(WORLD_SEED + 1);
+
+	std::array<TerrainColumn, CHUNK_AREA> firstColumns{}, secondColumns{}, otherColumns{};
+	first.sampleColumns(0, 0, firstColumns.data());
+	second.sampleColumns(0, 0, secondColumns.data());
+	other.sampleColumns(0, 0, otherColumns.data());
+
+	bool sameSeedMatches = true;
+	bool otherSeedDiffers = false;
+	for (size_t i = 0; i < CHUNK_AREA; i++)
+	{
+		sameSeedMatches &= firstColumns[i].height == secondColumns[i].height;
+		otherSeedDiffers |= firstColumns[i].height != otherColumns[i].height;
+	}
+
+	TEST_CHECK(sameSeedMatches);
+	TEST_CHECK(otherSeedDiffers);
+}
+
+int main()
+{
+	testNoiseDeterminism();
+	testTerrainDeterminism();
+	testSeedDeterminism();
+
+	return test::report("TerrainGeneratorTests");
+}
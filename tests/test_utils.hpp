@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace test
+{
+	/// @brief Retrieve the number of failed checks in this test executable.
+	/// @return 
+	inline int& failureCount()
+	{
+		static int s_failureCount = 0;
+		return s_failureCount;
+	}
+
+	/// @brief Report the test result, to be returned from main.
+	/// @param name Test executable name.
+	/// @return EXIT_SUCCESS if all checks passed, EXIT_FAILURE otherwise.
+	inline int report(char const* name)
+	{
+		if (failureCount() > 0)
+		{
+			std::fprintf(stderr, "%s: %d check(s) failed\n", name, failureCount());
+			return EXIT_FAILURE;
+		}
+
+		std::printf("%s: all checks passed\n", name);
+		return EXIT_SUCCESS;
+	}
+} // namespace test
+
+/// @brief Check a condition, failed checks are reported but do not stop the test.
+#define TEST_CHECK(condition)																	\
+	do {																						\
+		if (!(condition)) {																		\
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);	\
+			test::failureCount()++;																\
+		}																						\
+	} while (false)
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "rendering/texture_compression.hpp"
+#include "test_utils.hpp"
+
+using namespace gfx;
+
+static constexpr BlockFormat FORMATS[] = { BlockFormat::BC1, BlockFormat::BC5, BlockFormat::BC7, BlockFormat::ETC2RGB8 };
+
+/// @brief Sentinel written past the end of output buffers, to detect writes beyond the expected size.
+static constexpr uint8_t GUARD_BYTE = 0xCD;
+static constexpr size_t GUARD_SIZE = 64;
+
+/// @brief Compress & decompress an RGBA image, checking that neither step writes past its output.
+/// @param format
+/// @param width
+/// @param height
+/// @param texels
+/// @param blocks Output compressed blocks.
+/// @return The decompressed image.
+static std::vector<uint8_t> roundTrip(BlockFormat format, uint32_t width, uint32_t height, std::vector<uint8_t> const& texels, std::vector<uint8_t>& blocks)
+{
+	size_t const blockSize = compressedSize(format, width, height);
+	blocks.assign(blockSize + GUARD_SIZE, GUARD_BYTE);
+	compressImage(format, width, height, texels.data(), blocks.data());
+	TEST_CHECK(std::all_of(blocks.begin() + blockSize, blocks.end(), [](uint8_t value) { return value == GUARD_BYTE; }));
+	blocks.resize(blockSize);
+
+	std::vector<uint8_t> decoded(texels.size() + GUARD_SIZE, GUARD_BYTE);
+	decompressImage(format, width, height, blocks.data(), decoded.data());
+	TEST_CHECK(std::all_of(decoded.begin() + texels.size(), decoded.end(), [](uint8_t value) { return value == GUARD_BYTE; }));
+	decoded.resize(texels.size());
+	return decoded;
+}
+
+/// @brief Create a solid RGBA image.
+/// @param width
+/// @param height
+/// @param color
+/// @return
+static std::vector<uint8_t> createSolidImage(uint32_t width, uint32_t height, std::vector<uint8_t> const& color)
+{
+	std::vector<uint8_t> texels(static_cast<size_t>(width) * height * 4);
+	for (size_t i = 0; i < texels.size(); i++) {
+		texels[i] = color[i % 4];
+	}
+
+	return texels;
+}
+
+/// @brief Create an RGBA image of smooth gradients with hard edges every 16 texels & a small amount of per texel noise.
+/// @param width
+/// @param height
+/// @return
+static std::vector<uint8_t> createGradientImage(uint32_t width, uint32_t height)
+{
+	std::vector<uint8_t> texels(static_cast<size_t>(width) * height * 4);
+	uint32_t state = 0x9E3779B9U;
+	for (uint32_t y = 0; y < height; y++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			state = state * 1664525U + 1013904223U;
+			int const noise = static_cast<int>(state >> 29) - 4;
+			bool const edge = ((x / 16) + (y / 16)) % 2 == 0;
+
+			uint8_t* pTexel = texels.data() + (static_cast<size_t>(y) * width + x) * 4;
+			pTexel[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(x * 128 / width) + noise + 32, 0, 255));
+			pTexel[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(y * 128 / height) + (edge ? 48 : 0) + noise + 32, 0, 255));
+			pTexel[2] = static_cast<uint8_t>(std::clamp(160 - static_cast<int>(x * 96 / width) + noise, 0, 255));
+			pTexel[3] = static_cast<uint8_t>(255 - y * 64 / height);
+		}
+	}
+
+	return texels;
+}
+
+/// @brief Check block sizes & compressed image sizes, partial edge blocks count as full blocks.
+static void testCompressedSize()
+{
+	TEST_CHECK(blockBytes(BlockFormat::None) == 0);
+	TEST_CHECK(blockBytes(BlockFormat::BC1) == 8 && blockBytes(BlockFormat::ETC2RGB8) == 8);
+	TEST_CHECK(blockBytes(BlockFormat::BC5) == 16 && blockBytes(BlockFormat::BC7) == 16);
+
+	TEST_CHECK(compressedSize(BlockFormat::BC1, 8, 8) == 32);
+	TEST_CHECK(compressedSize(BlockFormat::BC1, 5, 3) == 16);
+	TEST_CHECK(compressedSize(BlockFormat::BC7, 1, 1) == 16);
+	TEST_CHECK(compressedSize(BlockFormat::BC5, 9, 4) == 48);
+	TEST_CHECK(compressedSize(BlockFormat::ETC2RGB8, 13, 7) == 64);
+	TEST_CHECK(compressedSize(BlockFormat::None, 16, 16) == 0);
+}
+
+/// @brief Check that solid images of colors representable by a format round-trip exactly.
+static void testSolidBlocks()
+{
+	// BC1 stores RGB565 endpoints, BC7 mode 6 shares a p-bit over all channels of an endpoint, and ETC2 adds the same
+	// modifier to all channels of a 5 bit base color
+	std::vector<std::pair<BlockFormat, std::vector<uint8_t>>> const cases = {
+		{ BlockFormat::BC1, { 0, 0, 0, 255 } },
+		{ BlockFormat::BC1, { 255, 255, 255, 255 } },
+		{ BlockFormat::BC1, { 165, 162, 66, 255 } },
+		{ BlockFormat::BC5, { 37, 201, 0, 255 } },
+		{ BlockFormat::BC5, { 128, 128, 0, 255 } },
+		{ BlockFormat::BC7, { 255, 255, 255, 255 } },
+		{ BlockFormat::BC7, { 200, 100, 50, 128 } },
+		{ BlockFormat::BC7, { 31, 77, 143, 201 } },
+		{ BlockFormat::ETC2RGB8, { 0, 0, 0, 255 } },
+		{ BlockFormat::ETC2RGB8, { 255, 255, 255, 255 } },
+		{ BlockFormat::ETC2RGB8, { 134, 68, 200, 255 } },
+	};
+
+	for (auto const& [format, color] : cases)
+	{
+		std::vector<uint8_t> const texels = createSolidImage(8, 8, color);
+		std::vector<uint8_t> blocks;
+		std::vector<uint8_t> const decoded = roundTrip(format, 8, 8, texels, blocks);
+		TEST_CHECK(std::isinf(computePsnr(format, texels.data(), decoded.data(), 64)));
+	}
+
+	// Channels not stored by a format decode to 0, alpha to 255
+	std::vector<uint8_t> const texels = createSolidImage(4, 4, { 37, 201, 90, 17 });
+	std::vector<uint8_t> blocks;
+	std::vector<uint8_t> const decoded = roundTrip(BlockFormat::BC5, 4, 4, texels, blocks);
+	TEST_CHECK(decoded[0] == 37 && decoded[1] == 201 && decoded[2] == 0 && decoded[3] == 255);
+}
+
+/// @brief Check that every format meets its minimum PSNR on a small image of gradients, edges & noise.
+static void testMinimumPsnr()
+{
+	std::vector<uint8_t> const texels = createGradientImage(32, 32);
+	for (BlockFormat const format : FORMATS)
+	{
+		std::vector<uint8_t> blocks;
+		std::vector<uint8_t> const decoded = roundTrip(format, 32, 32, texels, blocks);
+		double const psnr = computePsnr(format, texels.data(), decoded.data(), 32 * 32);
+		TEST_CHECK(psnr >= minimumPsnr(format));
+	}
+
+	TEST_CHECK(std::isinf(minimumPsnr(BlockFormat::None)));
+}
+
+/// @brief Check that BC7 blocks whose first texel lies near the high endpoint swap their endpoints, as the anchor index
+/// MSB is implicitly 0.
+static void testBC7AnchorSwap()
+{
+	// A diagonal ramp from bright to dark puts the first texel at the high end of the principal axis
+	std::vector<uint8_t> texels(4 * 4 * 4);
+	for (uint32_t i = 0; i < 16; i++)
+	{
+		uint8_t const value = static_cast<uint8_t>(250 - ((i % 4) + (i / 4)) * 36);
+		texels[i * 4 + 0] = value;
+		texels[i * 4 + 1] = value;
+		texels[i * 4 + 2] = static_cast<uint8_t>(value / 2);
+		texels[i * 4 + 3] = 255;
+	}
+
+	std::vector<uint8_t> blocks;
+	std::vector<uint8_t> const decoded = roundTrip(BlockFormat::BC7, 4, 4, texels, blocks);
+	TEST_CHECK(computePsnr(BlockFormat::BC7, texels.data(), decoded.data(), 16) >= minimumPsnr(BlockFormat::BC7));
+	TEST_CHECK(std::abs(static_cast<int>(decoded[0]) - static_cast<int>(texels[0])) <= 4);
+
+	// Mode 6 stores the red endpoints in bits 7-13 & 14-20, the first endpoint is the bright one after the swap
+	TEST_CHECK((blocks[0] & 0x7F) == (1 << 6));
+	uint32_t const red0 = ((blocks[0] >> 7) | (blocks[1] << 1)) & 0x7F;
+	uint32_t const red1 = ((blocks[1] >> 6) | (blocks[2] << 2)) & 0x7F;
+	TEST_CHECK(red0 > red1);
+
+	// The anchor texel keeps a 3 bit index, so the swapped first texel lies near endpoint 0
+	uint32_t const anchorIndex = (blocks[8] >> 1) & 0x7;
+	TEST_CHECK(anchorIndex < 4);
+}
+
+/// @brief Check that ETC2 uses individual mode for sub blocks with distant colors & differential mode otherwise.
+static void testETC2Modes()
+{
+	// The differential bit is bit 33 of the big endian block, stored in the second bit of the fourth byte
+	auto const isDifferential = [](std::vector<uint8_t> const& blocks) { return (blocks[3] & 0x2) != 0; };
+
+	std::vector<uint8_t> smooth(4 * 4 * 4);
+	std::vector<uint8_t> split(4 * 4 * 4);
+	for (uint32_t i = 0; i < 16; i++)
+	{
+		uint8_t const ramp = static_cast<uint8_t>(100 + (i % 4) * 6);
+		uint8_t const side = (i % 4 < 2) ? 20 : 230;
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			smooth[i * 4 + c] = ramp;
+			split[i * 4 + c] = static_cast<uint8_t>(c == 1 ? 255 - side : side);
+		}
+
+		smooth[i * 4 + 3] = 255;
+		split[i * 4 + 3] = 255;
+	}
+
+	std::vector<uint8_t> blocks;
+	std::vector<uint8_t> decoded = roundTrip(BlockFormat::ETC2RGB8, 4, 4, smooth, blocks);
+	TEST_CHECK(isDifferential(blocks));
+	TEST_CHECK(computePsnr(BlockFormat::ETC2RGB8, smooth.data(), decoded.data(), 16) >= minimumPsnr(BlockFormat::ETC2RGB8));
+
+	decoded = roundTrip(BlockFormat::ETC2RGB8, 4, 4, split, blocks);
+	TEST_CHECK(!isDifferential(blocks));
+	TEST_CHECK(computePsnr(BlockFormat::ETC2RGB8, split.data(), decoded.data(), 16) >= minimumPsnr(BlockFormat::ETC2RGB8));
+}
+
+/// @brief Check that images with partial edge blocks round-trip without writing outside the image or block data.
+static void testPartialEdgeBlocks()
+{
+	for (BlockFormat const format : FORMATS)
+	{
+		// Solid images only round-trip exactly if the repeated edge texels do not leak other colors into edge blocks
+		std::vector<uint8_t> const solid = createSolidImage(5, 3, { 255, 255, 255, 255 });
+		std::vector<uint8_t> blocks;
+		std::vector<uint8_t> decoded = roundTrip(format, 5, 3, solid, blocks);
+		TEST_CHECK(blocks.size() == compressedSize(format, 5, 3));
+		TEST_CHECK(std::isinf(computePsnr(format, solid.data(), decoded.data(), 5 * 3)));
+
+		// Crop of the gradient image, so edge blocks hold the same content as full blocks
+		std::vector<uint8_t> const source = createGradientImage(32, 32);
+		std::vector<uint8_t> gradient(13 * 7 * 4);
+		for (uint32_t y = 0; y < 7; y++) {
+			std::copy_n(source.begin() + y * 32 * 4, 13 * 4, gradient.begin() + y * 13 * 4);
+		}
+
+		decoded = roundTrip(format, 13, 7, gradient, blocks);
+		TEST_CHECK(blocks.size() == compressedSize(format, 13, 7));
+		TEST_CHECK(computePsnr(format, gradient.data(), decoded.data(), 13 * 7) >= minimumPsnr(format));
+	}
+}
+
+int main()
+{
+	testCompressedSize();
+	testSolidBlocks();
+	testMinimumPsnr();
+	testBC7AnchorSwap();
+	testETC2Modes();
+	testPartialEdgeBlocks();
+
+	return test::report("TextureCompressionTests");
+}